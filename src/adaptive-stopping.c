@@ -0,0 +1,464 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <time.h>
+#include "adaptive-stopping.h"
+#include "montecarlo.h"
+#include "streaming-statistics.h"
+#include "analytic-distribution.h"
+
+/**
+ *	@brief  Compares two doubles, for `qsort()`.
+ *
+ *	@param  a	: Pointer to the first double.
+ *	@param  b	: Pointer to the second double.
+ *	@return int	: Negative, zero, or positive, if the first double is less than, equal to, or greater than the second.
+ */
+static int
+compareDoubles(const void *  a, const void *  b)
+{
+	double	x = *(const double *) a;
+	double	y = *(const double *) b;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ *	@brief  Calculates a quantile of a set of samples and the half-width of its distribution-free
+ *		confidence interval, between the order statistics whose ranks are `z` standard deviations
+ *		of the binomial distribution below and above the rank of the quantile.
+ *
+ *	@param  sortedSamples	: The samples, sorted in ascending order.
+ *	@param  numberOfSamples	: The number of samples.
+ *	@param  probability	: The probability of the quantile, in (0, 1).
+ *	@param  estimate	: Pointer to where the function writes the quantile.
+ *	@param  halfWidth	: Pointer to where the function writes the half-width of its confidence interval.
+ */
+static void
+calculateQuantileConfidenceInterval(
+	const double *	sortedSamples,
+	size_t		numberOfSamples,
+	double		probability,
+	double *	estimate,
+	double *	halfWidth)
+{
+	double	n = (double) numberOfSamples;
+	double	rankDeviation = kAdaptiveStoppingConfidenceIntervalZ * sqrt(n * probability * (1.0 - probability));
+	double	lowerRank = fmax(floor(n * probability - rankDeviation), 1.0);
+	double	upperRank = fmin(ceil(n * probability + rankDeviation), n);
+	double	rank = fmin(fmax(ceil(n * probability), 1.0), n);
+
+	/*
+	 *	The ranks are one-based.
+	 */
+	*estimate = sortedSamples[(size_t) rank - 1];
+	*halfWidth = (sortedSamples[(size_t) upperRank - 1] - sortedSamples[(size_t) lowerRank - 1]) / 2.0;
+
+	return;
+}
+
+CommonConstantReturnType
+runAdaptiveMonteCarloIterations(
+	CommandLineArguments *		arguments,
+	const CalibrationLookupTable *	lookupTable,
+	MonteCarloOutputSamples *	monteCarloOutputSamples,
+	StreamingStatistics *		streamingStatistics,
+	QuantileSketch *		quantileSketches,
+	Histogram *			histograms,
+	AdaptiveStoppingResult *	result)
+{
+	size_t			maximumNumberOfSamples = arguments->common.numberOfMonteCarloIterations;
+	size_t			numberOfSamples = 0;
+	size_t			nextNumberOfSamples;
+	StreamingStatistics	batchStreamingStatistics[kOutputDistributionIndexCalibratedSensorOutputMax];
+	StreamingStatistics *	meanStatistics = (streamingStatistics != NULL) ? streamingStatistics : batchStreamingStatistics;
+	double *		sortedSamples = NULL;
+	OutputDistributionIndex	variantLowerBound;
+	OutputDistributionIndex	variantUpperBound;
+	struct timespec		start;
+	struct timespec		now;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	getSelectedOutputBounds(arguments, &variantLowerBound, &variantUpperBound);
+	*result = (AdaptiveStoppingResult) {0};
+	result->maximumNumberOfSamples = maximumNumberOfSamples;
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		initializeStreamingStatistics(&meanStatistics[variant]);
+
+		if (quantileSketches != NULL)
+		{
+			initializeQuantileSketch(&quantileSketches[variant]);
+		}
+	}
+
+	if (arguments->isTargetQuantileSelected)
+	{
+		sortedSamples = (double *) checkedMalloc(maximumNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	}
+
+	nextNumberOfSamples = (maximumNumberOfSamples < kAdaptiveStoppingInitialNumberOfSamples) ? maximumNumberOfSamples : kAdaptiveStoppingInitialNumberOfSamples;
+
+	while (numberOfSamples < maximumNumberOfSamples)
+	{
+		double	halfWidthRatio = 0.0;
+
+		/*
+		 *	Each batch draws from its own streams of the seed, so that the
+		 *	samples of a run do not depend on the batch sizes before it.
+		 *	With Philox, the sampling strategies, and the quasi-random
+		 *	sequences, the samples depend only on their index.
+		 */
+		if (runNativeMonteCarloIterationRange(
+			arguments,
+			lookupTable,
+			monteCarloOutputSamples,
+			streamingStatistics,
+			quantileSketches,
+			histograms,
+			numberOfSamples,
+			nextNumberOfSamples,
+			result->numberOfBatches * arguments->numberOfThreads) != kCommonConstantReturnTypeSuccess)
+		{
+			free(sortedSamples);
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+		{
+			double	target = arguments->targetHalfWidth;
+
+			if (arguments->isTargetQuantileSelected)
+			{
+				for (size_t i = 0; i < nextNumberOfSamples; i++)
+				{
+					sortedSamples[i] = arguments->isSinglePrecisionEnabled ?
+								(double) monteCarloOutputSamples->asFloat[variant][i] :
+								monteCarloOutputSamples->asDouble[variant][i];
+				}
+
+				qsort(sortedSamples, nextNumberOfSamples, sizeof(double), compareDoubles);
+				calculateQuantileConfidenceInterval(
+					sortedSamples,
+					nextNumberOfSamples,
+					arguments->targetQuantile,
+					&result->estimate[variant],
+					&result->halfWidth[variant]);
+			}
+			else
+			{
+				MeanAndVariance	meanAndVariance;
+
+				/*
+				 *	Fold the samples of the new batch into the running
+				 *	statistics, unless the batch already did so.
+				 */
+				if (streamingStatistics == NULL)
+				{
+					if (arguments->isSinglePrecisionEnabled)
+					{
+						addFloatSamplesToStreamingStatistics(
+							&meanStatistics[variant],
+							&monteCarloOutputSamples->asFloat[variant][numberOfSamples],
+							nextNumberOfSamples - numberOfSamples);
+					}
+					else
+					{
+						addDoubleSamplesToStreamingStatistics(
+							&meanStatistics[variant],
+							&monteCarloOutputSamples->asDouble[variant][numberOfSamples],
+							nextNumberOfSamples - numberOfSamples);
+					}
+				}
+
+				meanAndVariance = getStreamingStatisticsMeanAndVariance(&meanStatistics[variant]);
+				result->estimate[variant] = meanAndVariance.mean;
+				result->halfWidth[variant] = kAdaptiveStoppingConfidenceIntervalZ * sqrt(meanAndVariance.variance / (double) nextNumberOfSamples);
+			}
+
+			if (arguments->isTargetHalfWidthRelative)
+			{
+				target *= fabs(result->estimate[variant]);
+			}
+
+			/*
+			 *	A zero target (relative to a zero estimate) is only met by a
+			 *	zero half-width.
+			 */
+			if (result->halfWidth[variant] > target)
+			{
+				halfWidthRatio = (target > 0.0) ? fmax(halfWidthRatio, result->halfWidth[variant] / target) : INFINITY;
+			}
+		}
+
+		numberOfSamples = nextNumberOfSamples;
+		result->numberOfBatches++;
+		result->isTargetMet = (halfWidthRatio == 0.0);
+
+		/*
+		 *	A batch that reaches the maximum number of samples stops the run
+		 *	for that reason, even if it also ends after the time limit. The
+		 *	limit is on wall-clock time, as the CPU time of `clock()` sums
+		 *	over the threads.
+		 */
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		result->isTimeLimitReached = arguments->isTimeLimitSelected &&
+						(numberOfSamples < maximumNumberOfSamples) &&
+						((double)(now.tv_sec - start.tv_sec) + 1e-9 * (double)(now.tv_nsec - start.tv_nsec) >= arguments->timeLimitSeconds);
+
+		if (result->isTargetMet || result->isTimeLimitReached)
+		{
+			break;
+		}
+
+		/*
+		 *	The half-width shrinks with the square root of the number of
+		 *	samples, so project the number of samples that meets the target,
+		 *	and clamp the growth of the batch.
+		 */
+		{
+			double	projectedNumberOfSamples = (double) numberOfSamples * halfWidthRatio * halfWidthRatio;
+			double	minimumNumberOfSamples = (double) numberOfSamples + kAdaptiveStoppingInitialNumberOfSamples;
+			double	maximumGrowthNumberOfSamples = (double) numberOfSamples * kAdaptiveStoppingMaximumGrowthFactor;
+
+			projectedNumberOfSamples = fmin(fmax(projectedNumberOfSamples, minimumNumberOfSamples), maximumGrowthNumberOfSamples);
+			nextNumberOfSamples = (projectedNumberOfSamples >= (double) maximumNumberOfSamples) ?
+						maximumNumberOfSamples :
+						(size_t) projectedNumberOfSamples;
+		}
+	}
+
+	result->numberOfSamples = numberOfSamples;
+	free(sortedSamples);
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+void
+printAdaptiveStoppingReport(CommandLineArguments *  arguments, const AdaptiveStoppingResult *  result, const char **  outputVariableDescriptions)
+{
+	OutputDistributionIndex	variantLowerBound;
+	OutputDistributionIndex	variantUpperBound;
+
+	getSelectedOutputBounds(arguments, &variantLowerBound, &variantUpperBound);
+
+	printf("\nAdaptive stopping (target 95%% confidence interval half-width of the ");
+
+	if (arguments->isTargetQuantileSelected)
+	{
+		printf("quantile %g", arguments->targetQuantile);
+	}
+	else
+	{
+		printf("mean");
+	}
+
+	if (arguments->isTargetHalfWidthRelative)
+	{
+		printf(": %g%% of the estimate):\n", arguments->targetHalfWidth * 100.0);
+	}
+	else
+	{
+		printf(": %g Pa):\n", arguments->targetHalfWidth);
+	}
+
+	printf("\tUsed %zu samples in %zu batches (maximum %zu): %s.\n",
+		result->numberOfSamples,
+		result->numberOfBatches,
+		result->maximumNumberOfSamples,
+		result->isTargetMet ? "target met" : (result->isTimeLimitReached ? "time limit reached" : "sample limit reached"));
+
+	for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+	{
+		printf("\t%s: %.6e Pa +/- %.3e Pa\n", outputVariableDescriptions[variant], result->estimate[variant], result->halfWidth[variant]);
+	}
+
+	return;
+}
+
+CommonConstantReturnType
+runAdaptiveStoppingSelfTest(void)
+{
+	const size_t			numberOfSamples = kAdaptiveStoppingSelfTestNumberOfSamples;
+	const size_t			maximumNumberOfSamples = kAdaptiveStoppingSelfTestMaximumNumberOfSamples;
+	const double			probability = kAdaptiveStoppingSelfTestQuantile;
+	const double			probabilityStep = 0.01;
+	double *			samples = (double *) checkedMalloc(maximumNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	MonteCarloOutputSamples		monteCarloOutputSamples = {0};
+	StreamingStatistics		streamingStatistics[kOutputDistributionIndexCalibratedSensorOutputMax];
+	CommandLineArguments		arguments = {0};
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	printf(
+		"Adaptive stopping self-test (targets met by about %zu samples, at most %zu samples, quantile %g):\n",
+		numberOfSamples,
+		maximumNumberOfSamples,
+		probability);
+
+	arguments.common.numberOfMonteCarloIterations = maximumNumberOfSamples;
+	arguments.numberOfThreads = 1;
+	arguments.seed = kDefaultMonteCarloSeed;
+	arguments.randomNumberGeneratorType = kRandomNumberGeneratorTypePhilox;
+	arguments.samplingStrategy = kSamplingStrategyIndependent;
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		AnalyticOutputDistribution	distribution;
+		MeanAndVariance			exact;
+		AdaptiveStoppingResult		meanResult;
+		AdaptiveStoppingResult		capResult;
+		AdaptiveStoppingResult		capAndTimeLimitResult;
+		AdaptiveStoppingResult		quantileResult;
+		double				meanTarget;
+		double				quantileTarget;
+		double				exactQuantile;
+		bool				isMeanPassed;
+		bool				isCapPassed;
+		bool				isQuantilePassed;
+
+		initializeAnalyticOutputDistribution(
+			&distribution,
+			variant,
+			kDefaultInputDistributionAoutUniformDistLow,
+			kDefaultInputDistributionAoutUniformDistHigh,
+			kDefaultInputDistributionVddUniformDistLow,
+			kDefaultInputDistributionVddUniformDistHigh);
+		exact = getAnalyticOutputMeanAndVariance(&distribution);
+		exactQuantile = getAnalyticOutputQuantile(&distribution, probability);
+		arguments.common.outputSelect = variant;
+		monteCarloOutputSamples.asDouble[variant] = samples;
+
+		/*
+		 *	The target of the mean is the half-width of its interval with
+		 *	`numberOfSamples` samples of the exact variance. The run must
+		 *	meet it with about that many samples, and stop there.
+		 */
+		meanTarget = kAdaptiveStoppingConfidenceIntervalZ * sqrt(exact.variance / (double) numberOfSamples);
+		arguments.isTargetQuantileSelected = false;
+		arguments.targetHalfWidth = meanTarget;
+		if (runAdaptiveMonteCarloIterations(&arguments, NULL, &monteCarloOutputSamples, streamingStatistics, NULL, NULL, &meanResult) != kCommonConstantReturnTypeSuccess)
+		{
+			free(samples);
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		isMeanPassed =	meanResult.isTargetMet &&
+				(meanResult.halfWidth[variant] <= meanTarget) &&
+				(meanResult.numberOfSamples >= numberOfSamples / 2) &&
+				(meanResult.numberOfSamples <= 2 * numberOfSamples) &&
+				(meanResult.numberOfSamples == streamingStatistics[variant].numberOfSamples) &&
+				(fabs(meanResult.estimate[variant] - exact.mean) <= 2.0 * meanResult.halfWidth[variant]);
+
+		/*
+		 *	A target that needs 16 times more samples than the maximum must
+		 *	stop at the maximum.
+		 */
+		arguments.targetHalfWidth = kAdaptiveStoppingConfidenceIntervalZ * sqrt(exact.variance / (16.0 * (double) maximumNumberOfSamples));
+		if (runAdaptiveMonteCarloIterations(&arguments, NULL, &monteCarloOutputSamples, streamingStatistics, NULL, NULL, &capResult) != kCommonConstantReturnTypeSuccess)
+		{
+			free(samples);
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		/*
+		 *	A first batch that reaches both the maximum and a zero time
+		 *	limit must report the maximum as the reason to stop.
+		 */
+		arguments.common.numberOfMonteCarloIterations = kAdaptiveStoppingInitialNumberOfSamples;
+		arguments.isTimeLimitSelected = true;
+		arguments.timeLimitSeconds = 0.0;
+		if (runAdaptiveMonteCarloIterations(&arguments, NULL, &monteCarloOutputSamples, NULL, NULL, NULL, &capAndTimeLimitResult) != kCommonConstantReturnTypeSuccess)
+		{
+			free(samples);
+
+			return kCommonConstantReturnTypeError;
+		}
+		arguments.common.numberOfMonteCarloIterations = maximumNumberOfSamples;
+		arguments.isTimeLimitSelected = false;
+
+		isCapPassed =	!capResult.isTargetMet &&
+				!capResult.isTimeLimitReached &&
+				(capResult.numberOfSamples == maximumNumberOfSamples) &&
+				(streamingStatistics[variant].numberOfSamples == maximumNumberOfSamples) &&
+				!capAndTimeLimitResult.isTimeLimitReached &&
+				(capAndTimeLimitResult.numberOfSamples == kAdaptiveStoppingInitialNumberOfSamples);
+
+		/*
+		 *	The target of the quantile is the half-width of its interval with
+		 *	`numberOfSamples` samples, from the exact density at the quantile
+		 *	(the inverse of the slope of the exact quantile function). The
+		 *	interval must contain the exact quantile.
+		 */
+		quantileTarget = kAdaptiveStoppingConfidenceIntervalZ * sqrt(probability * (1.0 - probability) / (double) numberOfSamples) *
+					fabs(getAnalyticOutputQuantile(&distribution, probability + probabilityStep) -
+						getAnalyticOutputQuantile(&distribution, probability - probabilityStep)) / (2.0 * probabilityStep);
+		arguments.isTargetQuantileSelected = true;
+		arguments.targetQuantile = probability;
+		arguments.targetHalfWidth = quantileTarget;
+		if (runAdaptiveMonteCarloIterations(&arguments, NULL, &monteCarloOutputSamples, NULL, NULL, NULL, &quantileResult) != kCommonConstantReturnTypeSuccess)
+		{
+			free(samples);
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		isQuantilePassed =	quantileResult.isTargetMet &&
+					(quantileResult.halfWidth[variant] <= quantileTarget) &&
+					(quantileResult.numberOfSamples <= 2 * numberOfSamples) &&
+					(fabs(quantileResult.estimate[variant] - exactQuantile) <= quantileResult.halfWidth[variant]);
+
+		monteCarloOutputSamples.asDouble[variant] = NULL;
+
+		printf(
+			"\tVariant %u: mean target met with %zu samples: %s, maximum of %zu samples reached: %s, "
+			"quantile %.6e Pa +/- %.3e Pa with %zu samples (exact %.6e Pa): %s\n",
+			variant,
+			meanResult.numberOfSamples,
+			isMeanPassed ? "PASS" : "FAIL",
+			capResult.numberOfSamples,
+			isCapPassed ? "PASS" : "FAIL",
+			quantileResult.estimate[variant],
+			quantileResult.halfWidth[variant],
+			quantileResult.numberOfSamples,
+			exactQuantile,
+			isQuantilePassed ? "PASS" : "FAIL");
+
+		if (!(isMeanPassed && isCapPassed && isQuantilePassed))
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+	}
+
+	free(samples);
+
+	return result;
+}
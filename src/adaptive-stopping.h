@@ -0,0 +1,102 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "utilities.h"
+#include "calibration-lookup-table.h"
+#include "streaming-statistics.h"
+#include "quantile-sketch.h"
+#include "histogram.h"
+
+/*
+ *	Outcome of a run of the native Monte Carlo mode with adaptive stopping:
+ *	the number of samples and batches that it used out of the maximum number
+ *	of samples, why it stopped, and the estimate (mean or quantile) and
+ *	confidence interval half-width of each selected output, indexed by
+ *	`OutputDistributionIndex`.
+ */
+typedef struct
+{
+	size_t	numberOfSamples;
+	size_t	maximumNumberOfSamples;
+	size_t	numberOfBatches;
+	bool	isTargetMet;
+	bool	isTimeLimitReached;
+	double	estimate[kOutputDistributionIndexCalibratedSensorOutputMax];
+	double	halfWidth[kOutputDistributionIndexCalibratedSensorOutputMax];
+} AdaptiveStoppingResult;
+
+/**
+ *	@brief  Runs the native Monte Carlo iterations in batches, until the half-width of the confidence
+ *		interval of the mean (or of the quantile of `arguments->targetQuantile`) of each selected
+ *		output meets `arguments->targetHalfWidth`, or until the number of iterations of
+ *		`arguments->common.numberOfMonteCarloIterations` or the time limit is reached. The
+ *		confidence interval of the mean assumes independent samples, so it is conservative for
+ *		the antithetic strategy and the quasi-random sequences. The confidence interval of a
+ *		quantile is the distribution-free interval between two order statistics.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  lookupTable			: Pointer to the lookup tables of the selected variants, or `NULL`.
+ *	@param  monteCarloOutputSamples		: Pointer to the arrays of `arguments->common.numberOfMonteCarloIterations` samples,
+ *						  where the function writes the output samples, as in `runNativeMonteCarloIterations()`.
+ *	@param  streamingStatistics		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` statistics, where the
+ *						  function folds the output samples into, instead of storing them, or `NULL`.
+ *	@param  quantileSketches		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` quantile sketches, where the
+ *						  function adds the output samples to, or `NULL`.
+ *	@param  histograms			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` initialized histograms,
+ *						  where the function counts the output samples, or `NULL`.
+ *	@param  result				: Pointer to where the function writes the outcome of the run.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runAdaptiveMonteCarloIterations(
+					CommandLineArguments *		arguments,
+					const CalibrationLookupTable *	lookupTable,
+					MonteCarloOutputSamples *	monteCarloOutputSamples,
+					StreamingStatistics *		streamingStatistics,
+					QuantileSketch *		quantileSketches,
+					Histogram *			histograms,
+					AdaptiveStoppingResult *	result);
+
+/**
+ *	@brief  Prints the outcome of a run with adaptive stopping: the target, the number of samples and
+ *		batches used, why the run stopped, and the estimate and half-width of each selected output.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  result				: Pointer to the outcome of the run.
+ *	@param  outputVariableDescriptions	: An array of strings containing the descriptions of the outputs.
+ */
+void	printAdaptiveStoppingReport(CommandLineArguments *  arguments, const AdaptiveStoppingResult *  result, const char **  outputVariableDescriptions);
+
+/**
+ *	@brief  Checks adaptive stopping against the exact distributions of the outputs: a target set
+ *		from the exact variance is met with about the number of samples that it implies, a target
+ *		out of reach stops at the maximum number of samples, and the interval of a quantile
+ *		contains the exact quantile.
+ *
+ *	@return		: `kCommonConstantReturnTypeSuccess` if all checks pass,
+ *			   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runAdaptiveStoppingSelfTest(void);
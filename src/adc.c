@@ -0,0 +1,405 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+#include "adc.h"
+#include "calibration.h"
+#include "calibration-fixed-point.h"
+
+/*
+ *	Maximum number of characters per line of an ADC code input file.
+ */
+#define kAdcCodeInputFileMaxCharsPerLine	(256)
+
+/**
+ *	@brief  Parses an unsigned decimal integer that fits in 32 bits.
+ *
+ *	@param  string	: The string to parse.
+ *	@param  end	: Pointer to where the function writes a pointer to the first character after the integer.
+ *	@param  value	: Pointer to where the function writes the parsed value.
+ *	@return		: `kCommonConstantReturnTypeSuccess` if successful,
+ *			   else `kCommonConstantReturnTypeError`.
+ */
+static CommonConstantReturnType
+parseUnsigned32(const char *  string, char **  end, uint32_t *  value)
+{
+	unsigned long	parsedValue;
+
+	if (!isdigit((unsigned char)*string))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	errno = 0;
+	parsedValue = strtoul(string, end, 10);
+
+	if ((errno != 0) || (parsedValue > UINT32_MAX))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	*value = (uint32_t)parsedValue;
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+CommonConstantReturnType
+parseAdcCodePair(const char *  string, uint32_t *  AoutCode, uint32_t *  VddCode)
+{
+	char *	end;
+
+	if ((parseUnsigned32(string, &end, AoutCode) != kCommonConstantReturnTypeSuccess) || (*end != ','))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	if (parseUnsigned32(end + 1, &end, VddCode) != kCommonConstantReturnTypeSuccess)
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	while (isspace((unsigned char)*end))
+	{
+		end++;
+	}
+
+	return (*end == '\0') ? kCommonConstantReturnTypeSuccess : kCommonConstantReturnTypeError;
+}
+
+/**
+ *	@brief  Checks that a pair of ADC codes can be calibrated by the fixed-point kernels: both
+ *		codes must fit in the bit depth of the ADC, `VddCode` must not be zero, and
+ *		`AoutCode` must not be greater than `VddCode`.
+ *
+ *	@param  AoutCode	: ADC code of the Aout channel.
+ *	@param  VddCode		: ADC code of the Vdd channel.
+ *	@param  bitDepth	: The bit depth of the ADC.
+ *	@return bool		: `true` if the pair is valid, else `false`.
+ */
+static bool
+isValidAdcCodePair(uint32_t AoutCode, uint32_t VddCode, uint32_t bitDepth)
+{
+	return (VddCode >> bitDepth == 0) && (VddCode != 0) && (AoutCode <= VddCode);
+}
+
+/**
+ *	@brief  Calibrates a single pair of ADC codes given via the command line, and prints the
+ *		outputs of the fixed-point kernels, the single-precision path, and the
+ *		double-precision reference.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  outputVariableDescriptions	: An array of strings containing the descriptions of the outputs.
+ */
+static void
+printAdcCodePairCalibration(CommandLineArguments *  arguments, const char **  outputVariableDescriptions)
+{
+	OutputDistributionIndex	variantLowerBound;
+	OutputDistributionIndex	variantUpperBound;
+	double			Aout = convertAdcCodeToVoltage(arguments->adcAoutCode, arguments->adcBitDepth, arguments->adcReferenceVoltage);
+	double			Vdd = convertAdcCodeToVoltage(arguments->adcVddCode, arguments->adcBitDepth, arguments->adcReferenceVoltage);
+
+	getSelectedOutputBounds(arguments, &variantLowerBound, &variantUpperBound);
+
+	printf(
+		"ADC codes: AoutCode = %" PRIu32 ", VddCode = %" PRIu32 " (%" PRIu32 "-bit ADC, %.3lf V reference: Aout = %.6lf V, Vdd = %.6lf V).\n",
+		arguments->adcAoutCode,
+		arguments->adcVddCode,
+		arguments->adcBitDepth,
+		arguments->adcReferenceVoltage,
+		Aout,
+		Vdd);
+
+	for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+	{
+		int32_t	PaFixedPoint = getCalibrationFunctionFixedPoint(variant)(arguments->adcAoutCode, arguments->adcVddCode);
+		float	PaFloat;
+
+		calculateCalibratedSensorOutputFromAdcCodesBatchFloat(
+			variant,
+			arguments->adcBitDepth,
+			arguments->adcReferenceVoltage,
+			&arguments->adcAoutCode,
+			&arguments->adcVddCode,
+			&PaFloat,
+			1);
+
+		printf("\n%s:\n", outputVariableDescriptions[variant]);
+		printf("\tFixed-point (Q16.16)   : %.6lf Pa\n", convertFixedPointOutputToPascal(PaFixedPoint));
+		printf("\tSingle precision       : %.6lf Pa\n", (double)PaFloat);
+		printf("\tDouble precision       : %.6lf Pa\n", calculateCalibratedSensorOutput(variant, Aout, Vdd));
+	}
+
+	return;
+}
+
+/**
+ *	@brief  Calibrates a block of ADC code pairs read from the input file, and writes one CSV
+ *		row per pair.
+ *
+ *	@param  arguments		: Pointer to command-line arguments struct.
+ *	@param  lookupTable		: Pointer to the lookup tables of the selected variants, to calibrate via
+ *					  the tables instead of the fixed-point kernels, or `NULL`.
+ *	@param  outputFile		: The file to write the CSV rows to.
+ *	@param  AoutCode		: Array of `blockSize` ADC codes of the Aout channel.
+ *	@param  VddCode			: Array of `blockSize` ADC codes of the Vdd channel.
+ *	@param  blockSize		: The number of pairs in the block.
+ */
+static void
+writeAdcCodeBlockCalibration(
+	CommandLineArguments *		arguments,
+	const CalibrationLookupTable *	lookupTable,
+	FILE *				outputFile,
+	const uint32_t *		AoutCode,
+	const uint32_t *		VddCode,
+	size_t				blockSize)
+{
+	OutputDistributionIndex		variantLowerBound;
+	OutputDistributionIndex		variantUpperBound;
+	double				Pa[kOutputDistributionIndexCalibratedSensorOutputMax][kMonteCarloSampleBlockSize];
+	int32_t				PaFixedPoint[kMonteCarloSampleBlockSize];
+	float				PaFloat[kMonteCarloSampleBlockSize];
+	double				AoutCodeAsDouble[kMonteCarloSampleBlockSize];
+	double				VddCodeAsDouble[kMonteCarloSampleBlockSize];
+
+	getSelectedOutputBounds(arguments, &variantLowerBound, &variantUpperBound);
+
+	/*
+	 *	The reference voltage and bit depth cancel out of `Aout / Vdd`, so
+	 *	the lookup tables can take the codes directly.
+	 */
+	if (lookupTable != NULL)
+	{
+		for (size_t i = 0; i < blockSize; i++)
+		{
+			AoutCodeAsDouble[i] = (double)AoutCode[i];
+			VddCodeAsDouble[i] = (double)VddCode[i];
+		}
+	}
+
+	for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+	{
+		if (lookupTable != NULL)
+		{
+			calculateCalibratedSensorOutputBatchLookupTable(
+				lookupTable,
+				variant,
+				AoutCodeAsDouble,
+				VddCodeAsDouble,
+				Pa[variant],
+				blockSize);
+		}
+		else if (arguments->isSinglePrecisionEnabled)
+		{
+			calculateCalibratedSensorOutputFromAdcCodesBatchFloat(
+				variant,
+				arguments->adcBitDepth,
+				arguments->adcReferenceVoltage,
+				AoutCode,
+				VddCode,
+				PaFloat,
+				blockSize);
+
+			for (size_t i = 0; i < blockSize; i++)
+			{
+				Pa[variant][i] = (double)PaFloat[i];
+			}
+		}
+		else
+		{
+			getCalibrationBatchFunctionFixedPoint(variant)(AoutCode, VddCode, PaFixedPoint, blockSize);
+
+			for (size_t i = 0; i < blockSize; i++)
+			{
+				Pa[variant][i] = convertFixedPointOutputToPascal(PaFixedPoint[i]);
+			}
+		}
+	}
+
+	for (size_t i = 0; i < blockSize; i++)
+	{
+		fprintf(outputFile, "%" PRIu32 ",%" PRIu32, AoutCode[i], VddCode[i]);
+
+		for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+		{
+			fprintf(outputFile, ",%.6lf", Pa[variant][i]);
+		}
+
+		fprintf(outputFile, "\n");
+	}
+
+	return;
+}
+
+/**
+ *	@brief  Calibrates all ADC code pairs of the input file in blocks of `kMonteCarloSampleBlockSize`
+ *		pairs, so that the memory use does not depend on the size of the file.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  lookupTable			: Pointer to the lookup tables of the selected variants, or `NULL`.
+ *	@param  outputVariableDescriptions	: An array of strings containing the descriptions of the outputs.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+static CommonConstantReturnType
+calibrateAdcCodeInputFile(
+	CommandLineArguments *		arguments,
+	const CalibrationLookupTable *	lookupTable,
+	const char **			outputVariableDescriptions)
+{
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+	OutputDistributionIndex		variantLowerBound;
+	OutputDistributionIndex		variantUpperBound;
+	FILE *				inputFile;
+	FILE *				outputFile = stdout;
+	char				line[kAdcCodeInputFileMaxCharsPerLine];
+	uint32_t			AoutCode[kMonteCarloSampleBlockSize];
+	uint32_t			VddCode[kMonteCarloSampleBlockSize];
+	size_t				blockSize = 0;
+	size_t				lineNumber = 0;
+	size_t				numberOfPairs = 0;
+	clock_t				start = clock();
+
+	inputFile = fopen(arguments->common.inputFilePath, "r");
+
+	if (inputFile == NULL)
+	{
+		fprintf(stderr, "Error: Could not open input file \"%s\".\n", arguments->common.inputFilePath);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	if (arguments->common.isWriteToFileEnabled)
+	{
+		outputFile = fopen(arguments->common.outputFilePath, "w");
+
+		if (outputFile == NULL)
+		{
+			fprintf(stderr, "Error: Could not open output file \"%s\".\n", arguments->common.outputFilePath);
+			fclose(inputFile);
+
+			return kCommonConstantReturnTypeError;
+		}
+	}
+
+	getSelectedOutputBounds(arguments, &variantLowerBound, &variantUpperBound);
+
+	fprintf(outputFile, "AoutCode,VddCode");
+
+	for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+	{
+		fprintf(outputFile, ",%s", outputVariableDescriptions[variant]);
+	}
+
+	fprintf(outputFile, "\n");
+
+	while (fgets(line, sizeof(line), inputFile) != NULL)
+	{
+		lineNumber++;
+
+		if ((line[0] == '#') || (strspn(line, " \t\r\n") == strlen(line)))
+		{
+			continue;
+		}
+
+		if ((parseAdcCodePair(line, &AoutCode[blockSize], &VddCode[blockSize]) != kCommonConstantReturnTypeSuccess) ||
+			!isValidAdcCodePair(AoutCode[blockSize], VddCode[blockSize], arguments->adcBitDepth))
+		{
+			fprintf(
+				stderr,
+				"Error: Line %zu of \"%s\" is not a valid pair of %" PRIu32 "-bit ADC codes `AoutCode,VddCode` with 0 < VddCode and AoutCode <= VddCode.\n",
+				lineNumber,
+				arguments->common.inputFilePath,
+				arguments->adcBitDepth);
+			result = kCommonConstantReturnTypeError;
+
+			break;
+		}
+
+		blockSize++;
+
+		if (blockSize == kMonteCarloSampleBlockSize)
+		{
+			writeAdcCodeBlockCalibration(arguments, lookupTable, outputFile, AoutCode, VddCode, blockSize);
+			numberOfPairs += blockSize;
+			blockSize = 0;
+		}
+	}
+
+	if (result == kCommonConstantReturnTypeSuccess)
+	{
+		writeAdcCodeBlockCalibration(arguments, lookupTable, outputFile, AoutCode, VddCode, blockSize);
+		numberOfPairs += blockSize;
+	}
+
+	if (arguments->common.isTimingEnabled)
+	{
+		fprintf(
+			stderr,
+			"Calibrated %zu pairs of ADC codes in %lf seconds of CPU time.\n",
+			numberOfPairs,
+			((double)(clock() - start)) / CLOCKS_PER_SEC);
+	}
+
+	fclose(inputFile);
+
+	if (outputFile != stdout)
+	{
+		fclose(outputFile);
+	}
+
+	return result;
+}
+
+CommonConstantReturnType
+runAdcCodeCalibration(
+	CommandLineArguments *		arguments,
+	const CalibrationLookupTable *	lookupTable,
+	const char **			outputVariableDescriptions)
+{
+	if (arguments->common.isInputFromFileEnabled)
+	{
+		return calibrateAdcCodeInputFile(arguments, lookupTable, outputVariableDescriptions);
+	}
+
+	if (!isValidAdcCodePair(arguments->adcAoutCode, arguments->adcVddCode, arguments->adcBitDepth))
+	{
+		fprintf(
+			stderr,
+			"Error: The ADC codes (-a option) must fit in %" PRIu32 " bits, with 0 < VddCode and AoutCode <= VddCode.\n",
+			arguments->adcBitDepth);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	printAdcCodePairCalibration(arguments, outputVariableDescriptions);
+
+	return kCommonConstantReturnTypeSuccess;
+}
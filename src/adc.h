@@ -0,0 +1,63 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "utilities.h"
+#include "calibration-lookup-table.h"
+
+/**
+ *	@brief  Runs the ADC code input mode: calibrates raw (AoutCode, VddCode) pairs of an ADC,
+ *		either a single pair given via the command line, or the pairs of an input file
+ *		with one `AoutCode,VddCode` pair per line (empty lines and lines starting with
+ *		`#` are skipped).
+ *
+ *		For a single pair, prints the output of each selected variant as calculated by
+ *		the fixed-point kernel, the single-precision path, and the double-precision
+ *		reference. For an input file, streams the pairs through the fixed-point batch
+ *		kernels (or the single-precision path, if `arguments->isSinglePrecisionEnabled`,
+ *		or the lookup tables, if given) in blocks, and writes one CSV row of outputs per
+ *		pair to the output file, if one is given, else to standard output.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  lookupTable			: Pointer to the lookup tables of the selected variants, to calibrate input files
+ *						  via the tables, or `NULL`.
+ *	@param  outputVariableDescriptions	: An array of strings containing the descriptions of the outputs.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runAdcCodeCalibration(
+					CommandLineArguments *		arguments,
+					const CalibrationLookupTable *	lookupTable,
+					const char **			outputVariableDescriptions);
+
+/**
+ *	@brief  Parses a pair of ADC codes in the format `AoutCode,VddCode`, as given on the command
+ *		line or on a line of an input file. Trailing whitespace is ignored.
+ *
+ *	@param  string		: The string to parse.
+ *	@param  AoutCode	: Pointer to where the function writes the ADC code of the Aout channel.
+ *	@param  VddCode		: Pointer to where the function writes the ADC code of the Vdd channel.
+ *	@return			: `kCommonConstantReturnTypeSuccess` if successful,
+ *				   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	parseAdcCodePair(const char *  string, uint32_t *  AoutCode, uint32_t *  VddCode);
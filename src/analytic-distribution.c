@@ -0,0 +1,632 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <time.h>
+#include "analytic-distribution.h"
+#include "calibration.h"
+#include "calibration-inverse.h"
+
+/*
+ *	The PDF of the ratio has at most three pieces between its four breakpoints,
+ *	and the square root configurations split one of them where the output
+ *	changes sign.
+ */
+#define kAnalyticDistributionMaximumNumberOfPieces	(4)
+
+/**
+ *	@brief  Returns the integral over the Vdd interval of `max(ratio * Vdd - c, 0)`, or, with
+ *		`isBelow`, of `max(c - ratio * Vdd, 0)`.
+ *
+ *	@param  distribution	: Pointer to the distribution.
+ *	@param  ratio		: The ratio, positive.
+ *	@param  c		: The Aout bound, in Volts.
+ *	@param  isBelow		: `true` for the integral of `max(c - ratio * Vdd, 0)`.
+ *	@return double		: The integral.
+ */
+static double
+getIntegralOfPositivePart(const AnalyticOutputDistribution *  distribution, double ratio, double c, bool isBelow)
+{
+	double	atLow = isBelow ? fmax(c - ratio * distribution->VddLow, 0.0) : fmax(ratio * distribution->VddLow - c, 0.0);
+	double	atHigh = isBelow ? fmax(c - ratio * distribution->VddHigh, 0.0) : fmax(ratio * distribution->VddHigh - c, 0.0);
+
+	return (isBelow ? (atLow * atLow - atHigh * atHigh) : (atHigh * atHigh - atLow * atLow)) / (2.0 * ratio);
+}
+
+/**
+ *	@brief  Returns the probability that the ratio `Aout / Vdd` is at most a value, or, with
+ *		`isAbove`, greater than it: the integral over Vdd of the probability that Aout is at
+ *		most (or greater than) the value times Vdd.
+ *
+ *	@param  distribution	: Pointer to the distribution.
+ *	@param  ratio		: The value of the ratio.
+ *	@param  isAbove		: `true` for the probability that the ratio is greater than the value.
+ *	@return double		: The probability.
+ */
+static double
+getRatioProbability(const AnalyticOutputDistribution *  distribution, double ratio, bool isAbove)
+{
+	double	normalization = (distribution->AoutHigh - distribution->AoutLow) * (distribution->VddHigh - distribution->VddLow);
+	double	integral;
+
+	if (ratio <= 0.0)
+	{
+		return isAbove ? 1.0 : 0.0;
+	}
+
+	if (isAbove)
+	{
+		integral = getIntegralOfPositivePart(distribution, ratio, distribution->AoutHigh, true) -
+				getIntegralOfPositivePart(distribution, ratio, distribution->AoutLow, true);
+	}
+	else
+	{
+		integral = getIntegralOfPositivePart(distribution, ratio, distribution->AoutLow, false) -
+				getIntegralOfPositivePart(distribution, ratio, distribution->AoutHigh, false);
+	}
+
+	return fmin(fmax(integral / normalization, 0.0), 1.0);
+}
+
+/**
+ *	@brief  Returns the output of the variant for a ratio `Aout / Vdd`.
+ *
+ *	@param  distribution	: Pointer to the distribution.
+ *	@param  ratio		: The ratio.
+ *	@return double		: The output, in Pascal.
+ */
+static double
+getOutputOfRatio(const AnalyticOutputDistribution *  distribution, double ratio)
+{
+	double	scaled = distribution->gain * ratio + distribution->offset;
+
+	if (!distribution->isSquareRoot)
+	{
+		return scaled;
+	}
+
+	return copysign(scaled * scaled, scaled) * distribution->outputScale;
+}
+
+/**
+ *	@brief  Returns the ratio `Aout / Vdd` at which the variant outputs a value.
+ *
+ *	@param  distribution	: Pointer to the distribution.
+ *	@param  Pa		: The output, in Pascal.
+ *	@return double		: The ratio.
+ */
+static double
+getRatioOfOutput(const AnalyticOutputDistribution *  distribution, double Pa)
+{
+	double	scaled = distribution->isSquareRoot ? copysign(sqrt(fabs(Pa) / distribution->outputScale), Pa) : Pa;
+
+	return (scaled - distribution->offset) / distribution->gain;
+}
+
+/**
+ *	@brief  Returns whether the output increases with the ratio `Aout / Vdd`.
+ *
+ *	@param  distribution	: Pointer to the distribution.
+ *	@return bool		: `true` if the output increases with the ratio.
+ */
+static bool
+isOutputIncreasing(const AnalyticOutputDistribution *  distribution)
+{
+	return (distribution->gain * distribution->outputScale) > 0.0;
+}
+
+CommonConstantReturnType
+initializeAnalyticOutputDistribution(
+	AnalyticOutputDistribution *	distribution,
+	OutputDistributionIndex		variant,
+	double				AoutLow,
+	double				AoutHigh,
+	double				VddLow,
+	double				VddHigh)
+{
+	if ((variant >= kOutputDistributionIndexCalibratedSensorOutputMax) || !(AoutLow > 0.0) || !(AoutLow < AoutHigh) || !(VddLow > 0.0) || !(VddLow < VddHigh))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	distribution->variant = variant;
+	distribution->AoutLow = AoutLow;
+	distribution->AoutHigh = AoutHigh;
+	distribution->VddLow = VddLow;
+	distribution->VddHigh = VddHigh;
+
+	/*
+	 *	The coefficients of each variant in the ratio, as in
+	 *	`updateCalibrationSupplyVoltage()` for a supply voltage of 1 V.
+	 */
+	switch (variant)
+	{
+		case kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear500Pa:
+			distribution->isSquareRoot = false;
+			distribution->gain = kSensorCalibrationConstantSDP8x6Linear500Pa1;
+			distribution->offset = -kSensorCalibrationConstantSDP8x6Linear500Pa2;
+			distribution->outputScale = 1.0;
+			break;
+
+		case kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear125Pa:
+			distribution->isSquareRoot = false;
+			distribution->gain = kSensorCalibrationConstantSDP8x6Linear125Pa1;
+			distribution->offset = -kSensorCalibrationConstantSDP8x6Linear125Pa2;
+			distribution->outputScale = 1.0;
+			break;
+
+		case kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt500Pa:
+			distribution->isSquareRoot = true;
+			distribution->gain = 1.0 / kSensorCalibrationConstantSDP8x6Sqrt500Pa2;
+			distribution->offset = -kSensorCalibrationConstantSDP8x6Sqrt500Pa3;
+			distribution->outputScale = kSensorCalibrationConstantSDP8x6Sqrt500Pa4;
+			break;
+
+		default:
+			distribution->isSquareRoot = true;
+			distribution->gain = 1.0 / kSensorCalibrationConstantSDP8x6Sqrt125Pa2;
+			distribution->offset = -kSensorCalibrationConstantSDP8x6Sqrt125Pa3;
+			distribution->outputScale = kSensorCalibrationConstantSDP8x6Sqrt125Pa4;
+			break;
+	}
+
+	/*
+	 *	The PDF of the ratio changes form where Aout / Vdd reaches a corner of
+	 *	the inputs.
+	 */
+	distribution->ratioBreakpoints[0] = AoutLow / VddHigh;
+	distribution->ratioBreakpoints[1] = fmin(AoutLow / VddLow, AoutHigh / VddHigh);
+	distribution->ratioBreakpoints[2] = fmax(AoutLow / VddLow, AoutHigh / VddHigh);
+	distribution->ratioBreakpoints[3] = AoutHigh / VddLow;
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+double
+getAnalyticOutputCdf(const AnalyticOutputDistribution *  distribution, double Pa)
+{
+	return getRatioProbability(distribution, getRatioOfOutput(distribution, Pa), !isOutputIncreasing(distribution));
+}
+
+double
+getAnalyticOutputProbabilityGT(const AnalyticOutputDistribution *  distribution, double Pa)
+{
+	return getRatioProbability(distribution, getRatioOfOutput(distribution, Pa), isOutputIncreasing(distribution));
+}
+
+double
+getAnalyticOutputQuantile(const AnalyticOutputDistribution *  distribution, double probability)
+{
+	double	ratioProbability = isOutputIncreasing(distribution) ? probability : 1.0 - probability;
+	double	low = distribution->ratioBreakpoints[0];
+	double	high = distribution->ratioBreakpoints[3];
+
+	/*
+	 *	Bisect the probability of the nearer tail of the ratio, which keeps
+	 *	its relative accuracy for extreme quantiles.
+	 */
+	for (int i = 0; i < kAnalyticDistributionNumberOfBisections; i++)
+	{
+		double	middle = 0.5 * (low + high);
+		bool	isBelowQuantile;
+
+		if ((middle == low) || (middle == high))
+		{
+			break;
+		}
+
+		isBelowQuantile = (ratioProbability <= 0.5) ?
+					(getRatioProbability(distribution, middle, false) < ratioProbability) :
+					(getRatioProbability(distribution, middle, true) > 1.0 - ratioProbability);
+
+		if (isBelowQuantile)
+		{
+			low = middle;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return getOutputOfRatio(distribution, 0.5 * (low + high));
+}
+
+/**
+ *	@brief  Splits the support of the ratio into the pieces on which both its PDF and the output
+ *		have a single closed form, and gets, for each piece, the integrals of `ratio^n` times the
+ *		PDF, for n from 0 to 4, and the coefficients of the output as a polynomial in the ratio.
+ *
+ *	@param  distribution	: Pointer to the distribution.
+ *	@param  moments		: Array of `kAnalyticDistributionMaximumNumberOfPieces` arrays, where the function writes the integrals.
+ *	@param  coefficients	: Array of `kAnalyticDistributionMaximumNumberOfPieces` arrays, where the function writes the
+ *				  coefficients of the output, from the constant term up.
+ *	@return size_t		: The number of pieces.
+ */
+static size_t
+getPieces(const AnalyticOutputDistribution *  distribution, double moments[][5], double coefficients[][3])
+{
+	double	normalization = 2.0 * (distribution->AoutHigh - distribution->AoutLow) * (distribution->VddHigh - distribution->VddLow);
+	double	points[5];
+	size_t	numberOfPoints = 0;
+	size_t	numberOfPieces = 0;
+	double	signChangeRatio = -distribution->offset / distribution->gain;
+
+	for (size_t i = 0; i < 4; i++)
+	{
+		points[numberOfPoints++] = distribution->ratioBreakpoints[i];
+
+		if (distribution->isSquareRoot &&
+			(signChangeRatio > distribution->ratioBreakpoints[i]) &&
+			(i < 3) &&
+			(signChangeRatio < distribution->ratioBreakpoints[i + 1]))
+		{
+			points[numberOfPoints++] = signChangeRatio;
+		}
+	}
+
+	for (size_t i = 0; i + 1 < numberOfPoints; i++)
+	{
+		double	low = points[i];
+		double	high = points[i + 1];
+		double	middle = 0.5 * (low + high);
+		double	constantTerm = 0.0;
+		double	inverseSquareTerm = 0.0;
+
+		if (!(high > low))
+		{
+			continue;
+		}
+
+		/*
+		 *	The PDF is (H^2 - L^2) / (2 * area), with H = min(VddHigh, AoutHigh / ratio)
+		 *	and L = max(VddLow, AoutLow / ratio).
+		 */
+		if (distribution->AoutHigh / middle >= distribution->VddHigh)
+		{
+			constantTerm += distribution->VddHigh * distribution->VddHigh;
+		}
+		else
+		{
+			inverseSquareTerm += distribution->AoutHigh * distribution->AoutHigh;
+		}
+
+		if (distribution->AoutLow / middle <= distribution->VddLow)
+		{
+			constantTerm -= distribution->VddLow * distribution->VddLow;
+		}
+		else
+		{
+			inverseSquareTerm -= distribution->AoutLow * distribution->AoutLow;
+		}
+
+		constantTerm /= normalization;
+		inverseSquareTerm /= normalization;
+
+		for (int n = 0; n < 5; n++)
+		{
+			moments[numberOfPieces][n] = constantTerm * (pow(high, n + 1) - pow(low, n + 1)) / (n + 1) +
+							inverseSquareTerm * ((n == 1) ? log(high / low) : (pow(high, n - 1) - pow(low, n - 1)) / (n - 1));
+		}
+
+		if (distribution->isSquareRoot)
+		{
+			double	scale = copysign(distribution->outputScale, distribution->gain * middle + distribution->offset);
+
+			coefficients[numberOfPieces][0] = scale * distribution->offset * distribution->offset;
+			coefficients[numberOfPieces][1] = scale * 2.0 * distribution->offset * distribution->gain;
+			coefficients[numberOfPieces][2] = scale * distribution->gain * distribution->gain;
+		}
+		else
+		{
+			coefficients[numberOfPieces][0] = distribution->offset;
+			coefficients[numberOfPieces][1] = distribution->gain;
+			coefficients[numberOfPieces][2] = 0.0;
+		}
+
+		numberOfPieces++;
+	}
+
+	return numberOfPieces;
+}
+
+MeanAndVariance
+getAnalyticOutputMeanAndVariance(const AnalyticOutputDistribution *  distribution)
+{
+	double		moments[kAnalyticDistributionMaximumNumberOfPieces][5];
+	double		coefficients[kAnalyticDistributionMaximumNumberOfPieces][3];
+	size_t		numberOfPieces = getPieces(distribution, moments, coefficients);
+	MeanAndVariance	result = { .mean = 0.0, .variance = 0.0 };
+
+	for (size_t piece = 0; piece < numberOfPieces; piece++)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			result.mean += coefficients[piece][i] * moments[piece][i];
+		}
+	}
+
+	/*
+	 *	The variance is the integral of the square of the output minus the
+	 *	mean, a polynomial of degree at most 4 in the ratio.
+	 */
+	for (size_t piece = 0; piece < numberOfPieces; piece++)
+	{
+		double	centered[3] = { coefficients[piece][0] - result.mean, coefficients[piece][1], coefficients[piece][2] };
+
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				result.variance += centered[i] * centered[j] * moments[piece][i + j];
+			}
+		}
+	}
+
+	result.variance = fmax(result.variance, 0.0);
+
+	return result;
+}
+
+void
+printAnalyticDistributionReport(
+	CommandLineArguments *	arguments,
+	const double *		monteCarloMeans,
+	QuantileSketch *	quantileSketches,
+	const char **		outputVariableDescriptions)
+{
+	const double			probabilities[kQuantileSketchNumberOfQuantiles] = kQuantileSketchProbabilities;
+	const double			deviations[] = { 0.05, 0.50, 1.00, 2.00 };
+	OutputDistributionIndex		outputSelectLowerBound;
+	OutputDistributionIndex		outputSelectUpperBound;
+	AnalyticOutputDistribution	distributions[kOutputDistributionIndexCalibratedSensorOutputMax];
+	double				queryMicroseconds[3];
+	volatile double			sink = 0.0;
+	clock_t				start;
+
+	getSelectedOutputBounds(arguments, &outputSelectLowerBound, &outputSelectUpperBound);
+
+	for (OutputDistributionIndex variant = outputSelectLowerBound; variant < outputSelectUpperBound; variant++)
+	{
+		initializeAnalyticOutputDistribution(
+			&distributions[variant],
+			variant,
+			kDefaultInputDistributionAoutUniformDistLow,
+			kDefaultInputDistributionAoutUniformDistHigh,
+			kDefaultInputDistributionVddUniformDistLow,
+			kDefaultInputDistributionVddUniformDistHigh);
+	}
+
+	/*
+	 *	Time each kind of query on the first selected output.
+	 */
+	start = clock();
+
+	for (int i = 0; i < kAnalyticDistributionTimingNumberOfQueries; i++)
+	{
+		sink += getAnalyticOutputProbabilityGT(&distributions[outputSelectLowerBound], (double)i);
+	}
+
+	queryMicroseconds[0] = ((double)(clock() - start)) * 1e6 / CLOCKS_PER_SEC / kAnalyticDistributionTimingNumberOfQueries;
+	start = clock();
+
+	for (int i = 0; i < kAnalyticDistributionTimingNumberOfQueries; i++)
+	{
+		sink += getAnalyticOutputQuantile(&distributions[outputSelectLowerBound], ((double)i + 0.5) / kAnalyticDistributionTimingNumberOfQueries);
+	}
+
+	queryMicroseconds[1] = ((double)(clock() - start)) * 1e6 / CLOCKS_PER_SEC / kAnalyticDistributionTimingNumberOfQueries;
+	start = clock();
+
+	for (int i = 0; i < kAnalyticDistributionTimingNumberOfQueries; i++)
+	{
+		sink += getAnalyticOutputMeanAndVariance(&distributions[outputSelectLowerBound]).variance;
+	}
+
+	queryMicroseconds[2] = ((double)(clock() - start)) * 1e6 / CLOCKS_PER_SEC / kAnalyticDistributionTimingNumberOfQueries;
+	(void)sink;
+
+	printf(
+		"\nExact distribution (Aout uniform in [%g, %g] V, Vdd uniform in [%g, %g] V; %.3f us per probability, %.3f us per quantile, %.3f us per mean and variance):\n",
+		kDefaultInputDistributionAoutUniformDistLow,
+		kDefaultInputDistributionAoutUniformDistHigh,
+		kDefaultInputDistributionVddUniformDistLow,
+		kDefaultInputDistributionVddUniformDistHigh,
+		queryMicroseconds[0],
+		queryMicroseconds[1],
+		queryMicroseconds[2]);
+
+	for (OutputDistributionIndex variant = outputSelectLowerBound; variant < outputSelectUpperBound; variant++)
+	{
+		AnalyticOutputDistribution *	distribution = &distributions[variant];
+		MeanAndVariance			meanAndVariance = getAnalyticOutputMeanAndVariance(distribution);
+
+		printf(
+			"\t%s: mean %.6lf Pa, standard deviation %.6lf Pa,",
+			outputVariableDescriptions[variant],
+			meanAndVariance.mean,
+			sqrt(meanAndVariance.variance));
+
+		for (size_t i = 0; i < kQuantileSketchNumberOfQuantiles; i++)
+		{
+			printf("%s p%g %.6lf Pa", (i == 0) ? "" : ",", probabilities[i] * 100.0, getAnalyticOutputQuantile(distribution, probabilities[i]));
+		}
+
+		printf("\n");
+
+		/*
+		 *	The probabilities of `printCalibratedValueAndProbabilities()`, for the
+		 *	exact mean.
+		 */
+		for (size_t i = 0; i < sizeof(deviations) / sizeof(deviations[0]); i++)
+		{
+			printf(
+				"\t\tProbability that the output is %3g%% or more smaller than the mean: %.6e, %3g%% or more greater: %.6e\n",
+				deviations[i] * 100.0,
+				1.0 - getAnalyticOutputProbabilityGT(distribution, meanAndVariance.mean * (1.0 - deviations[i])),
+				deviations[i] * 100.0,
+				getAnalyticOutputProbabilityGT(distribution, meanAndVariance.mean * (1.0 + deviations[i])));
+		}
+
+		/*
+		 *	The error of the Monte Carlo mean, in standard errors of the mean of
+		 *	its number of samples, and the errors in probability of the
+		 *	quantiles of its sketches.
+		 */
+		if (monteCarloMeans != NULL)
+		{
+			double	standardError = sqrt(meanAndVariance.variance / (double)arguments->common.numberOfMonteCarloIterations);
+
+			printf(
+				"\t\tMonte Carlo mean %.6lf Pa: error %.3e Pa, %.2f standard errors of %zu samples\n",
+				monteCarloMeans[variant],
+				monteCarloMeans[variant] - meanAndVariance.mean,
+				(monteCarloMeans[variant] - meanAndVariance.mean) / standardError,
+				arguments->common.numberOfMonteCarloIterations);
+		}
+
+		if (quantileSketches != NULL)
+		{
+			double	quantiles[kQuantileSketchNumberOfQuantiles];
+
+			getQuantileSketchQuantiles(&quantileSketches[variant], quantiles);
+			printf("\t\tMonte Carlo quantiles, error in probability:");
+
+			for (size_t i = 0; i < kQuantileSketchNumberOfQuantiles; i++)
+			{
+				printf("%s p%g %.3e", (i == 0) ? "" : ",", probabilities[i] * 100.0, getAnalyticOutputCdf(distribution, quantiles[i]) - probabilities[i]);
+			}
+
+			printf("\n");
+		}
+	}
+
+	return;
+}
+
+CommonConstantReturnType
+runAnalyticDistributionSelfTest(void)
+{
+	const size_t			numberOfGridPoints = kAnalyticDistributionSelfTestNumberOfGridPoints;
+	const size_t			numberOfIntegrationPoints = kAnalyticDistributionSelfTestNumberOfIntegrationPoints;
+	double				AoutLow = kDefaultInputDistributionAoutUniformDistLow;
+	double				AoutHigh = kDefaultInputDistributionAoutUniformDistHigh;
+	double				VddLow = kDefaultInputDistributionVddUniformDistLow;
+	double				VddHigh = kDefaultInputDistributionVddUniformDistHigh;
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	printf(
+		"Analytic distribution self-test (%zu x %zu grid of inputs, %zu integration points over Vdd):\n",
+		numberOfGridPoints,
+		numberOfGridPoints,
+		numberOfIntegrationPoints);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		CalibrationFunction		calibrationFunction = getCalibrationFunction(variant);
+		InverseCalibrationFunction	inverseCalibrationFunction = getInverseCalibrationFunction(variant);
+		AnalyticOutputDistribution	distribution;
+		MeanAndVariance			exact;
+		double				sum = 0.0;
+		double				sumOfSquares = 0.0;
+		double				gridMean;
+		double				gridVariance;
+		double				maximumProbabilityError = 0.0;
+		double				maximumQuantileError = 0.0;
+		bool				isIncreasingInAout = calibrationFunction(AoutHigh, VddLow) > calibrationFunction(AoutLow, VddLow);
+		bool				passed;
+
+		initializeAnalyticOutputDistribution(&distribution, variant, AoutLow, AoutHigh, VddLow, VddHigh);
+		exact = getAnalyticOutputMeanAndVariance(&distribution);
+
+		for (size_t i = 0; i < numberOfGridPoints; i++)
+		{
+			double	Aout = AoutLow + (AoutHigh - AoutLow) * ((double)i + 0.5) / (double)numberOfGridPoints;
+
+			for (size_t j = 0; j < numberOfGridPoints; j++)
+			{
+				double	Vdd = VddLow + (VddHigh - VddLow) * ((double)j + 0.5) / (double)numberOfGridPoints;
+				double	deviation = calibrationFunction(Aout, Vdd) - exact.mean;
+
+				sum += deviation;
+				sumOfSquares += deviation * deviation;
+			}
+		}
+
+		gridMean = exact.mean + sum / (double)(numberOfGridPoints * numberOfGridPoints);
+		gridVariance = sumOfSquares / (double)(numberOfGridPoints * numberOfGridPoints) - (gridMean - exact.mean) * (gridMean - exact.mean);
+
+		/*
+		 *	Compare the CDF at the thresholds that split the output range evenly
+		 *	to its integral over Vdd of the fraction of Aout on the side of the
+		 *	Aout of the threshold where the output is at most the threshold, and
+		 *	check that the quantile of the CDF at each threshold is the threshold.
+		 */
+		for (int k = 1; k <= kAnalyticDistributionSelfTestNumberOfThresholds; k++)
+		{
+			double	minimumOutput = getAnalyticOutputQuantile(&distribution, 0.0);
+			double	maximumOutput = getAnalyticOutputQuantile(&distribution, 1.0);
+			double	threshold = minimumOutput + (maximumOutput - minimumOutput) * k / (kAnalyticDistributionSelfTestNumberOfThresholds + 1);
+			double	integratedProbability = 0.0;
+			double	probability = getAnalyticOutputCdf(&distribution, threshold);
+
+			for (size_t i = 0; i < numberOfIntegrationPoints; i++)
+			{
+				double	Vdd = VddLow + (VddHigh - VddLow) * ((double)i + 0.5) / (double)numberOfIntegrationPoints;
+				double	AoutAtThreshold = fmin(fmax(inverseCalibrationFunction(threshold, Vdd), AoutLow), AoutHigh);
+
+				integratedProbability += (isIncreasingInAout ? (AoutAtThreshold - AoutLow) : (AoutHigh - AoutAtThreshold)) /
+								((AoutHigh - AoutLow) * (double)numberOfIntegrationPoints);
+			}
+
+			maximumProbabilityError = fmax(maximumProbabilityError, fabs(probability - integratedProbability));
+			maximumProbabilityError = fmax(maximumProbabilityError, fabs(probability + getAnalyticOutputProbabilityGT(&distribution, threshold) - 1.0));
+			maximumQuantileError = fmax(maximumQuantileError, fabs(getAnalyticOutputQuantile(&distribution, probability) - threshold) / (maximumOutput - minimumOutput));
+		}
+
+		passed = (fabs(gridMean - exact.mean) <= kAnalyticDistributionSelfTestMaximumRelativeError * fabs(exact.mean)) &&
+				(fabs(gridVariance - exact.variance) <= kAnalyticDistributionSelfTestMaximumRelativeError * exact.variance) &&
+				(maximumProbabilityError <= kAnalyticDistributionSelfTestMaximumProbabilityError) &&
+				(maximumQuantileError <= kAnalyticDistributionSelfTestMaximumProbabilityError);
+		printf(
+			"\tVariant %u: mean %.9lf Pa (grid %.9lf Pa), variance %.9lf Pa^2 (grid %.9lf Pa^2), maximum CDF error %.3e, maximum quantile error %.3e: %s\n",
+			variant,
+			exact.mean,
+			gridMean,
+			exact.variance,
+			gridVariance,
+			maximumProbabilityError,
+			maximumQuantileError,
+			passed ? "PASS" : "FAIL");
+
+		if (!passed)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,139 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "common.h"
+#include "utilities.h"
+#include "quantile-sketch.h"
+
+/*
+ *	Exact distribution of an output for independent uniform inputs Aout and
+ *	Vdd with positive bounds. Each output is a monotone function of the ratio
+ *	r = Aout / Vdd:
+ *		linear configurations		: Pa = gain * r + offset.
+ *		square root configurations	: s = gain * r + offset, and Pa = sign(s) * s * s * outputScale.
+ *	The PDF of the ratio is of the form a + b / r^2 between each pair of the
+ *	sorted `ratioBreakpoints`, and zero outside them.
+ */
+typedef struct
+{
+	OutputDistributionIndex	variant;
+	double			AoutLow;
+	double			AoutHigh;
+	double			VddLow;
+	double			VddHigh;
+	bool			isSquareRoot;
+	double			gain;
+	double			offset;
+	double			outputScale;
+	double			ratioBreakpoints[4];
+} AnalyticOutputDistribution;
+
+/**
+ *	@brief  Sets up the exact distribution of an output for independent uniform inputs.
+ *
+ *	@param  distribution	: Pointer to the distribution to set up.
+ *	@param  variant		: The sensor variant / configuration.
+ *	@param  AoutLow		: Lower bound of the uniform Aout (in Volts).
+ *	@param  AoutHigh	: Upper bound of the uniform Aout (in Volts).
+ *	@param  VddLow		: Lower bound of the uniform Vdd (in Volts).
+ *	@param  VddHigh		: Upper bound of the uniform Vdd (in Volts).
+ *	@return			: `kCommonConstantReturnTypeSuccess` if successful, else `kCommonConstantReturnTypeError`
+ *				  if the variant is invalid or the bounds are not positive and increasing.
+ */
+CommonConstantReturnType	initializeAnalyticOutputDistribution(
+					AnalyticOutputDistribution *	distribution,
+					OutputDistributionIndex		variant,
+					double				AoutLow,
+					double				AoutHigh,
+					double				VddLow,
+					double				VddHigh);
+
+/**
+ *	@brief  Returns the exact probability that the output is at most a value.
+ *
+ *	@param  distribution	: Pointer to the distribution.
+ *	@param  Pa		: The value, in Pascal.
+ *	@return double		: The probability.
+ */
+double	getAnalyticOutputCdf(const AnalyticOutputDistribution *  distribution, double Pa);
+
+/**
+ *	@brief  Returns the exact probability that the output is greater than a value, like
+ *		`UxHwDoubleProbabilityGT()`. Computed directly rather than as one minus the CDF,
+ *		so that it keeps its relative accuracy in the upper tail.
+ *
+ *	@param  distribution	: Pointer to the distribution.
+ *	@param  Pa		: The value, in Pascal.
+ *	@return double		: The probability.
+ */
+double	getAnalyticOutputProbabilityGT(const AnalyticOutputDistribution *  distribution, double Pa);
+
+/**
+ *	@brief  Returns the exact quantile of the output, by bisection of the CDF of the ratio.
+ *
+ *	@param  distribution	: Pointer to the distribution.
+ *	@param  probability	: The probability of the quantile, in [0, 1].
+ *	@return double		: The quantile, in Pascal.
+ */
+double	getAnalyticOutputQuantile(const AnalyticOutputDistribution *  distribution, double probability);
+
+/**
+ *	@brief  Returns the exact mean and variance of the output, integrated in closed form over
+ *		each piece of the PDF of the ratio.
+ *
+ *	@param  distribution		: Pointer to the distribution.
+ *	@return MeanAndVariance		: The mean and variance.
+ */
+MeanAndVariance	getAnalyticOutputMeanAndVariance(const AnalyticOutputDistribution *  distribution);
+
+/**
+ *	@brief  Prints, for each selected output, its exact mean, standard deviation, quantiles, and
+ *		the probabilities that `printCalibratedValueAndProbabilities()` asks for, with the time
+ *		per query. For a Monte Carlo run, also prints the error of its mean in standard errors
+ *		and, with quantile sketches, the error in probability of its quantiles.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  monteCarloMeans			: The means of the outputs of the Monte Carlo run, indexed by
+ *						  `OutputDistributionIndex`, or `NULL` outside Monte Carlo mode.
+ *	@param  quantileSketches		: The quantile sketches of the outputs of the run, or `NULL`.
+ *	@param  outputVariableDescriptions	: The descriptions of the outputs, indexed by `OutputDistributionIndex`.
+ */
+void	printAnalyticDistributionReport(
+		CommandLineArguments *	arguments,
+		const double *		monteCarloMeans,
+		QuantileSketch *	quantileSketches,
+		const char **		outputVariableDescriptions);
+
+/**
+ *	@brief  Checks the exact mean and variance of each variant against a midpoint rule over a
+ *		grid of the inputs, its CDF against an integral over Vdd with the inverse calibration,
+ *		and its quantiles against its CDF.
+ *
+ *	@return	: `kCommonConstantReturnTypeSuccess` if all variants are within
+ *		  `kAnalyticDistributionSelfTestMaximumRelativeError` and
+ *		  `kAnalyticDistributionSelfTestMaximumProbabilityError`, else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runAnalyticDistributionSelfTest(void);
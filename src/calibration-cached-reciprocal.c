@@ -0,0 +1,375 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <time.h>
+#include "calibration-cached-reciprocal.h"
+#include "calibration.h"
+
+typedef void	(*CachedCalibrationBatchFunction)(double gain, double offset, double outputScale, const double *  Aout, double *  Pa, size_t numberOfSamples);
+
+/**
+ *	@brief  Cached-reciprocal batch kernel of the linear configurations.
+ *
+ *	@param  gain		: The cached gain, `k1 / Vdd`.
+ *	@param  offset		: The cached offset, `-k2`.
+ *	@param  outputScale	: Unused.
+ *	@param  Aout		: Array of `numberOfSamples` ratiometric analog voltage values (in Volts).
+ *	@param  Pa		: Array of `numberOfSamples` values, where the function writes the calibrated outputs (in Pascal).
+ *	@param  numberOfSamples	: The number of samples in each of the arrays.
+ */
+static void
+calculateLinearConfigurationOutputBatchCached(
+	double		gain,
+	double		offset,
+	double		outputScale,
+	const double *	Aout,
+	double *	Pa,
+	size_t		numberOfSamples)
+{
+	(void)outputScale;
+
+	for (size_t i = 0; i < numberOfSamples; i++)
+	{
+		Pa[i] = gain * Aout[i] + offset;
+	}
+
+	return;
+}
+
+/**
+ *	@brief  Cached-reciprocal batch kernel of the square root configurations.
+ *
+ *	@param  gain		: The cached gain, `1 / (Vdd * k2)`.
+ *	@param  offset		: The cached offset, `-k3`.
+ *	@param  outputScale	: The output scaling constant, `k4`.
+ *	@param  Aout		: Array of `numberOfSamples` ratiometric analog voltage values (in Volts).
+ *	@param  Pa		: Array of `numberOfSamples` values, where the function writes the calibrated outputs (in Pascal).
+ *	@param  numberOfSamples	: The number of samples in each of the arrays.
+ */
+static void
+calculateSquareRootConfigurationOutputBatchCached(
+	double		gain,
+	double		offset,
+	double		outputScale,
+	const double *	Aout,
+	double *	Pa,
+	size_t		numberOfSamples)
+{
+	for (size_t i = 0; i < numberOfSamples; i++)
+	{
+		double	scaled = gain * Aout[i] + offset;
+
+		Pa[i] = copysign(scaled * scaled * outputScale, scaled);
+	}
+
+	return;
+}
+
+/*
+ *	Dispatch table of the cached-reciprocal batch kernels, indexed by `OutputDistributionIndex`.
+ */
+static const CachedCalibrationBatchFunction	cachedCalibrationBatchFunctions[kOutputDistributionIndexCalibratedSensorOutputMax] =
+						{
+							calculateLinearConfigurationOutputBatchCached,
+							calculateLinearConfigurationOutputBatchCached,
+							calculateSquareRootConfigurationOutputBatchCached,
+							calculateSquareRootConfigurationOutputBatchCached,
+						};
+
+
+void
+updateCalibrationSupplyVoltage(CalibrationSupplyVoltageCache *  cache, double Vdd)
+{
+	double	reciprocalVdd = 1.0 / Vdd;
+
+	cache->Vdd = Vdd;
+
+	cache->gain[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear500Pa] = kSensorCalibrationConstantSDP8x6Linear500Pa1 * reciprocalVdd;
+	cache->offset[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear500Pa] = -kSensorCalibrationConstantSDP8x6Linear500Pa2;
+	cache->outputScale[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear500Pa] = 1.0;
+
+	cache->gain[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear125Pa] = kSensorCalibrationConstantSDP8x6Linear125Pa1 * reciprocalVdd;
+	cache->offset[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear125Pa] = -kSensorCalibrationConstantSDP8x6Linear125Pa2;
+	cache->outputScale[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear125Pa] = 1.0;
+
+	cache->gain[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt500Pa] = reciprocalVdd / kSensorCalibrationConstantSDP8x6Sqrt500Pa2;
+	cache->offset[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt500Pa] = -kSensorCalibrationConstantSDP8x6Sqrt500Pa3;
+	cache->outputScale[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt500Pa] = kSensorCalibrationConstantSDP8x6Sqrt500Pa4;
+
+	cache->gain[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt125Pa] = reciprocalVdd / kSensorCalibrationConstantSDP8x6Sqrt125Pa2;
+	cache->offset[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt125Pa] = -kSensorCalibrationConstantSDP8x6Sqrt125Pa3;
+	cache->outputScale[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt125Pa] = kSensorCalibrationConstantSDP8x6Sqrt125Pa4;
+
+	return;
+}
+
+double
+calculateCalibratedSensorOutputCached(const CalibrationSupplyVoltageCache *  cache, OutputDistributionIndex variant, double Aout)
+{
+	double	Pa;
+
+	if (variant >= kOutputDistributionIndexCalibratedSensorOutputMax)
+	{
+		return NAN;
+	}
+
+	cachedCalibrationBatchFunctions[variant](cache->gain[variant], cache->offset[variant], cache->outputScale[variant], &Aout, &Pa, 1);
+
+	return Pa;
+}
+
+CommonConstantReturnType
+calculateCalibratedSensorOutputBatchCached(
+	const CalibrationSupplyVoltageCache *	cache,
+	OutputDistributionIndex			variant,
+	const double *				Aout,
+	double *				Pa,
+	size_t					numberOfSamples)
+{
+	if (variant >= kOutputDistributionIndexCalibratedSensorOutputMax)
+	{
+		fprintf(stderr, "Error: No cached-reciprocal calibration kernel for output %d.\n", variant);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	cachedCalibrationBatchFunctions[variant](
+		cache->gain[variant],
+		cache->offset[variant],
+		cache->outputScale[variant],
+		Aout,
+		Pa,
+		numberOfSamples);
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+CommonConstantReturnType
+runCachedReciprocalCalibrationSelfTest(void)
+{
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+	double				Aout[kCalibrationKernelSelfTestNumberOfRatios];
+	double				Pa[kCalibrationKernelSelfTestNumberOfRatios];
+	CalibrationSupplyVoltageCache	cache;
+
+	printf(
+		"Cached-reciprocal calibration self-test (maximum allowed difference to scalar reference: %.1e Pa):\n",
+		kCachedReciprocalCalibrationMaximumAbsoluteError);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		double	maximumAbsoluteError = 0.0;
+		bool	passed;
+
+		for (size_t v = 0; v < kCalibrationKernelSelfTestNumberOfSupplyVoltages; v++)
+		{
+			double	vddFraction = (double)v / (kCalibrationKernelSelfTestNumberOfSupplyVoltages - 1);
+			double	vddValue = kDefaultInputDistributionVddUniformDistLow +
+						vddFraction * (kDefaultInputDistributionVddUniformDistHigh - kDefaultInputDistributionVddUniformDistLow);
+
+			updateCalibrationSupplyVoltage(&cache, vddValue);
+
+			for (size_t r = 0; r < kCalibrationKernelSelfTestNumberOfRatios; r++)
+			{
+				Aout[r] = ((double)r / (kCalibrationKernelSelfTestNumberOfRatios - 1)) * vddValue;
+			}
+
+			calculateCalibratedSensorOutputBatchCached(&cache, variant, Aout, Pa, kCalibrationKernelSelfTestNumberOfRatios);
+
+			for (size_t r = 0; r < kCalibrationKernelSelfTestNumberOfRatios; r++)
+			{
+				maximumAbsoluteError = fmax(maximumAbsoluteError, fabs(Pa[r] - calculateCalibratedSensorOutput(variant, Aout[r], vddValue)));
+			}
+		}
+
+		passed = (maximumAbsoluteError <= kCachedReciprocalCalibrationMaximumAbsoluteError);
+		printf(
+			"\t%-18s: outputDistributions[%d]: maximum absolute difference %.3e Pa: %s\n",
+			"cached-reciprocal",
+			variant,
+			maximumAbsoluteError,
+			passed ? "PASS" : "FAIL");
+
+		if (!passed)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+	}
+
+	return result;
+}
+
+/**
+ *	@brief  Times a batch calibration kernel over a stream of samples.
+ *
+ *	@param  calibrationBatchFunction	: The batch calibration kernel.
+ *	@param  Aout				: Array of `numberOfSamples` Aout samples.
+ *	@param  Vdd				: Array of `numberOfSamples` Vdd samples.
+ *	@param  Pa				: Array of `numberOfSamples` values, where the kernel writes the outputs.
+ *	@param  numberOfSamples			: The number of samples of the stream.
+ *	@return double				: The best time of `kCalibrationKernelBenchmarkNumberOfRuns` runs, in seconds.
+ */
+static double
+timeCalibrationBatchFunction(
+	CalibrationBatchFunction	calibrationBatchFunction,
+	const double *			Aout,
+	const double *			Vdd,
+	double *			Pa,
+	size_t				numberOfSamples)
+{
+	double	bestSeconds = INFINITY;
+
+	for (int run = 0; run < kCalibrationKernelBenchmarkNumberOfRuns; run++)
+	{
+		clock_t	start = clock();
+
+		calibrationBatchFunction(Aout, Vdd, Pa, numberOfSamples);
+
+		double	seconds = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+
+		if (seconds < bestSeconds)
+		{
+			bestSeconds = seconds;
+		}
+	}
+
+	return bestSeconds;
+}
+
+/**
+ *	@brief  Times the cached-reciprocal calibration over a stream of samples in which Vdd
+ *		changes once every `updateRatio` Aout samples, including the cache updates.
+ *
+ *	@param  variant		: The sensor variant / configuration.
+ *	@param  Aout		: Array of `numberOfSamples` Aout samples.
+ *	@param  Vdd		: Array of `numberOfSamples` Vdd samples, of which only every `updateRatio`-th is used.
+ *	@param  Pa		: Array of `numberOfSamples` values, where the function writes the outputs.
+ *	@param  numberOfSamples	: The number of Aout samples of the stream.
+ *	@param  updateRatio	: The number of Aout samples per Vdd sample.
+ *	@return double		: The best time of `kCalibrationKernelBenchmarkNumberOfRuns` runs, in seconds.
+ */
+static double
+timeCachedReciprocalStream(
+	OutputDistributionIndex	variant,
+	const double *		Aout,
+	const double *		Vdd,
+	double *		Pa,
+	size_t			numberOfSamples,
+	size_t			updateRatio)
+{
+	double				bestSeconds = INFINITY;
+	CalibrationSupplyVoltageCache	cache;
+
+	for (int run = 0; run < kCalibrationKernelBenchmarkNumberOfRuns; run++)
+	{
+		clock_t	start = clock();
+
+		for (size_t blockStart = 0; blockStart < numberOfSamples; blockStart += updateRatio)
+		{
+			size_t	blockSize = numberOfSamples - blockStart;
+
+			if (blockSize > updateRatio)
+			{
+				blockSize = updateRatio;
+			}
+
+			updateCalibrationSupplyVoltage(&cache, Vdd[blockStart]);
+			calculateCalibratedSensorOutputBatchCached(&cache, variant, &Aout[blockStart], &Pa[blockStart], blockSize);
+		}
+
+		double	seconds = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+
+		if (seconds < bestSeconds)
+		{
+			bestSeconds = seconds;
+		}
+	}
+
+	return bestSeconds;
+}
+
+void
+runCachedReciprocalCalibrationBenchmark(size_t numberOfSamples)
+{
+	double *			Aout = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *			Vdd = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *			heldVdd = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *			Pa = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	CalibrationKernelImplementation	implementation = getCalibrationKernelImplementation();
+
+	setCalibrationKernelBenchmarkInputs(Aout, Vdd, numberOfSamples);
+
+	printf(
+		"Cached-reciprocal calibration benchmark (%zu Aout samples, best of %d runs, ns per Aout sample):\n",
+		numberOfSamples,
+		kCalibrationKernelBenchmarkNumberOfRuns);
+
+	for (size_t updateRatio = 1; updateRatio <= kCachedReciprocalBenchmarkMaximumUpdateRatio; updateRatio *= kCachedReciprocalBenchmarkUpdateRatioStep)
+	{
+		/*
+		 *	The per-sample kernels see the same stream: each Vdd sample is
+		 *	held for `updateRatio` Aout samples.
+		 */
+		for (size_t i = 0; i < numberOfSamples; i++)
+		{
+			heldVdd[i] = Vdd[i - (i % updateRatio)];
+		}
+
+		for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+		{
+			double	scalarSeconds = timeCalibrationBatchFunction(
+							getCalibrationBatchFunction(kCalibrationKernelImplementationScalar, variant),
+							Aout,
+							heldVdd,
+							Pa,
+							numberOfSamples);
+			double	selectedSeconds = timeCalibrationBatchFunction(
+							getCalibrationBatchFunction(implementation, variant),
+							Aout,
+							heldVdd,
+							Pa,
+							numberOfSamples);
+			double	cachedSeconds = timeCachedReciprocalStream(variant, Aout, Vdd, Pa, numberOfSamples, updateRatio);
+
+			printf(
+				"\tAout:Vdd %5zu:1: outputDistributions[%d]: scalar %.3lf, %s %.3lf, cached-reciprocal %.3lf\n",
+				updateRatio,
+				variant,
+				scalarSeconds * 1e9 / numberOfSamples,
+				getCalibrationKernelImplementationName(implementation),
+				selectedSeconds * 1e9 / numberOfSamples,
+				cachedSeconds * 1e9 / numberOfSamples);
+		}
+	}
+
+	free(Aout);
+	free(Vdd);
+	free(heldVdd);
+	free(Pa);
+
+	return;
+}
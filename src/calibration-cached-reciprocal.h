@@ -0,0 +1,108 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "common.h"
+#include "utilities-config.h"
+
+/*
+ *	Streaming calibration for a supply voltage that is sampled far less often
+ *	than the analog output. `updateCalibrationSupplyVoltage()` computes the
+ *	reciprocal of Vdd once and folds it into per-variant coefficients, so that
+ *	calibrating an Aout sample takes no division:
+ *		linear configurations		: Pa = gain * Aout + offset, with gain = k1 / Vdd and offset = -k2.
+ *		square root configurations	: s = gain * Aout + offset, with gain = 1 / (Vdd * k2) and offset = -k3,
+ *						  and Pa = sign(s) * s * s * k4.
+ *
+ *	The square root configurations take the sign from `s` instead of `Aout / Vdd - k1`,
+ *	which is equivalent because `k1 == k2 * k3` (see `calibration-inverse.c`). The
+ *	outputs round differently from the scalar reference, within
+ *	`kCachedReciprocalCalibrationMaximumAbsoluteError`.
+ */
+typedef struct
+{
+	double	Vdd;
+	double	gain[kOutputDistributionIndexCalibratedSensorOutputMax];
+	double	offset[kOutputDistributionIndexCalibratedSensorOutputMax];
+	double	outputScale[kOutputDistributionIndexCalibratedSensorOutputMax];
+} CalibrationSupplyVoltageCache;
+
+/**
+ *	@brief  Recomputes the cached reciprocal of the supply voltage and the per-variant
+ *		coefficients. Call once per new Vdd sample.
+ *
+ *	@param  cache	: Pointer to the cache to update.
+ *	@param  Vdd	: Supply voltage (in Volts).
+ */
+void	updateCalibrationSupplyVoltage(CalibrationSupplyVoltageCache *  cache, double Vdd);
+
+/**
+ *	@brief  Calibrates a single Aout sample of a single SDP8x6 variant, using the supply voltage
+ *		of the last call to `updateCalibrationSupplyVoltage()`.
+ *
+ *	@param  cache		: Pointer to the updated cache.
+ *	@param  variant		: The sensor variant / configuration.
+ *	@param  Aout		: Ratiometric analog voltage value (in Volts).
+ *	@return double		: The calibrated differential pressure (in Pascal), or `NAN` if the variant is invalid.
+ */
+double	calculateCalibratedSensorOutputCached(const CalibrationSupplyVoltageCache *  cache, OutputDistributionIndex variant, double Aout);
+
+/**
+ *	@brief  Calibrates a batch of Aout samples of a single SDP8x6 variant, all using the supply
+ *		voltage of the last call to `updateCalibrationSupplyVoltage()`.
+ *
+ *	@param  cache			: Pointer to the updated cache.
+ *	@param  variant			: The sensor variant / configuration.
+ *	@param  Aout			: Array of `numberOfSamples` ratiometric analog voltage values (in Volts).
+ *	@param  Pa			: Array of `numberOfSamples` values, where the function writes the calibrated outputs (in Pascal).
+ *	@param  numberOfSamples		: The number of samples in each of the arrays.
+ *	@return				: `kCommonConstantReturnTypeSuccess` if successful,
+ *					   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	calculateCalibratedSensorOutputBatchCached(
+					const CalibrationSupplyVoltageCache *	cache,
+					OutputDistributionIndex			variant,
+					const double *				Aout,
+					double *				Pa,
+					size_t					numberOfSamples);
+
+/**
+ *	@brief  Checks the cached-reciprocal calibration of all variants against the scalar reference,
+ *		over the same Aout/Vdd grid as the calibration kernel self-test.
+ *
+ *	@return			: `kCommonConstantReturnTypeSuccess` if all variants are within
+ *				   `kCachedReciprocalCalibrationMaximumAbsoluteError`, else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runCachedReciprocalCalibrationSelfTest(void);
+
+/**
+ *	@brief  Times a stream of samples in which Vdd changes once every `updateRatio` Aout samples,
+ *		for update ratios from 1 to `kCachedReciprocalBenchmarkMaximumUpdateRatio`, and prints
+ *		the time per Aout sample (in ns) of the scalar reference, of the selected batch
+ *		calibration kernel, and of the cached-reciprocal calibration, which includes the
+ *		cache updates.
+ *
+ *	@param  numberOfSamples	: The number of Aout samples of the stream.
+ */
+void	runCachedReciprocalCalibrationBenchmark(size_t numberOfSamples);
@@ -0,0 +1,361 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "calibration.h"
+#include "calibration-fixed-point.h"
+
+/*
+ *	Converts a (non-negative) calibration constant to fixed point with
+ *	`fractionalBits` fractional bits, rounding to nearest. The constants are
+ *	compile-time constants, so this is folded by the compiler and no floating
+ *	point arithmetic remains in the kernels.
+ */
+#define kFixedPointFromDouble(value, fractionalBits)	((int64_t)((value) * (double)((int64_t)1 << (fractionalBits)) + 0.5))
+
+/**
+ *	@brief  Shifts a fixed-point value right by `shift` bits, rounding to nearest (ties
+ *		towards positive infinity). Relies on `>>` of negative values being an
+ *		arithmetic shift, as it is on all the compilers this code targets.
+ *
+ *	@param  value	: The fixed-point value.
+ *	@param  shift	: The number of fractional bits to remove. Must be positive.
+ *	@return int64_t	: The rounded, shifted value.
+ */
+static inline int64_t
+shiftRightRounded(int64_t value, int shift)
+{
+	return (value + ((int64_t)1 << (shift - 1))) >> shift;
+}
+
+/**
+ *	@brief  Calculates the ratio `AoutCode / VddCode` with `kFixedPointRatioFractionalBits`
+ *		fractional bits, rounding to nearest.
+ *
+ *	@param  AoutCode	: ADC code of the Aout channel.
+ *	@param  VddCode		: ADC code of the Vdd channel. Must not be zero.
+ *	@return int64_t		: The fixed-point ratio.
+ */
+static inline int64_t
+calculateAdcCodeRatioFixedPoint(uint32_t AoutCode, uint32_t VddCode)
+{
+	return (int64_t)((((uint64_t)AoutCode << kFixedPointRatioFractionalBits) + (VddCode >> 1)) / VddCode);
+}
+
+/**
+ *	@brief  Fixed-point calibration routine for the linear configurations.
+ *
+ *	@param  ratio	: The ratio `Aout / Vdd`, with `kFixedPointRatioFractionalBits` fractional bits.
+ *	@param  k1	: First calibration constant (gain), with `kFixedPointCoefficientFractionalBits` fractional bits.
+ *	@param  k2	: Second calibration constant (offset), with `kFixedPointCoefficientFractionalBits` fractional bits.
+ *	@return int32_t	: The calibrated differential pressure (in Pascal), with `kFixedPointOutputFractionalBits` fractional bits.
+ */
+static inline int32_t
+calculateLinearConfigurationOutputFixedPoint(int64_t ratio, int64_t k1, int64_t k2)
+{
+	int64_t	product = k1 * ratio - (k2 << kFixedPointRatioFractionalBits);
+
+	return (int32_t)shiftRightRounded(
+				product,
+				kFixedPointRatioFractionalBits + kFixedPointCoefficientFractionalBits - kFixedPointOutputFractionalBits);
+}
+
+/**
+ *	@brief  Fixed-point calibration routine for the square root configurations. The sign is
+ *		taken with integer comparisons and the square with an integer multiply, so there
+ *		is neither a branch nor a call to `pow()`.
+ *
+ *	@param  ratio		: The ratio `Aout / Vdd`, with `kFixedPointRatioFractionalBits` fractional bits.
+ *	@param  k1		: Ratio at which the output changes sign, with `kFixedPointRatioFractionalBits` fractional bits.
+ *	@param  inverseK2	: Reciprocal of the ratio scaling constant, with `kFixedPointCoefficientFractionalBits` fractional bits.
+ *	@param  k3		: Offset of the scaled ratio, with `kFixedPointRatioFractionalBits` fractional bits.
+ *	@param  k4		: Output scaling constant, with `kFixedPointCoefficientFractionalBits` fractional bits.
+ *	@return int32_t		: The calibrated differential pressure (in Pascal), with `kFixedPointOutputFractionalBits` fractional bits.
+ */
+static inline int32_t
+calculateSquareRootConfigurationOutputFixedPoint(int64_t ratio, int64_t k1, int64_t inverseK2, int64_t k3, int64_t k4)
+{
+	int64_t	scaled = shiftRightRounded(ratio * inverseK2, kFixedPointCoefficientFractionalBits) - k3;
+	int64_t	square = shiftRightRounded(scaled * scaled, kFixedPointRatioFractionalBits);
+	int64_t	signOfOutput = (ratio > k1) - (ratio < k1);
+
+	return (int32_t)(signOfOutput * shiftRightRounded(
+						square * k4,
+						kFixedPointRatioFractionalBits + kFixedPointCoefficientFractionalBits - kFixedPointOutputFractionalBits));
+}
+
+/*
+ *	Generate the specialized fixed-point kernels of a variant, with the
+ *	calibration constants converted to fixed point at compile time.
+ */
+#define DEFINE_LINEAR_CONFIGURATION_FIXED_POINT_KERNELS(variantName, k1, k2)					\
+	static int32_t												\
+	calculate##variantName##OutputFixedPoint(uint32_t AoutCode, uint32_t VddCode)				\
+	{													\
+		return calculateLinearConfigurationOutputFixedPoint(						\
+				calculateAdcCodeRatioFixedPoint(AoutCode, VddCode),				\
+				kFixedPointFromDouble((k1), kFixedPointCoefficientFractionalBits),		\
+				kFixedPointFromDouble((k2), kFixedPointCoefficientFractionalBits));		\
+	}													\
+														\
+	static void												\
+	calculate##variantName##OutputBatchFixedPoint(const uint32_t *  AoutCode, const uint32_t *  VddCode, int32_t *  Pa, size_t numberOfSamples)	\
+	{													\
+		for (size_t i = 0; i < numberOfSamples; i++)							\
+		{												\
+			Pa[i] = calculate##variantName##OutputFixedPoint(AoutCode[i], VddCode[i]);		\
+		}												\
+	}
+
+#define DEFINE_SQUARE_ROOT_CONFIGURATION_FIXED_POINT_KERNELS(variantName, k1, k2, k3, k4)			\
+	static int32_t												\
+	calculate##variantName##OutputFixedPoint(uint32_t AoutCode, uint32_t VddCode)				\
+	{													\
+		return calculateSquareRootConfigurationOutputFixedPoint(					\
+				calculateAdcCodeRatioFixedPoint(AoutCode, VddCode),				\
+				kFixedPointFromDouble((k1), kFixedPointRatioFractionalBits),			\
+				kFixedPointFromDouble(1.0 / (k2), kFixedPointCoefficientFractionalBits),	\
+				kFixedPointFromDouble((k3), kFixedPointRatioFractionalBits),			\
+				kFixedPointFromDouble((k4), kFixedPointCoefficientFractionalBits));		\
+	}													\
+														\
+	static void												\
+	calculate##variantName##OutputBatchFixedPoint(const uint32_t *  AoutCode, const uint32_t *  VddCode, int32_t *  Pa, size_t numberOfSamples)	\
+	{													\
+		for (size_t i = 0; i < numberOfSamples; i++)							\
+		{												\
+			Pa[i] = calculate##variantName##OutputFixedPoint(AoutCode[i], VddCode[i]);		\
+		}												\
+	}
+
+DEFINE_LINEAR_CONFIGURATION_FIXED_POINT_KERNELS(
+	SDP8x6Linear500Pa,
+	kSensorCalibrationConstantSDP8x6Linear500Pa1,
+	kSensorCalibrationConstantSDP8x6Linear500Pa2)
+
+DEFINE_LINEAR_CONFIGURATION_FIXED_POINT_KERNELS(
+	SDP8x6Linear125Pa,
+	kSensorCalibrationConstantSDP8x6Linear125Pa1,
+	kSensorCalibrationConstantSDP8x6Linear125Pa2)
+
+DEFINE_SQUARE_ROOT_CONFIGURATION_FIXED_POINT_KERNELS(
+	SDP8x6Sqrt500Pa,
+	kSensorCalibrationConstantSDP8x6Sqrt500Pa1,
+	kSensorCalibrationConstantSDP8x6Sqrt500Pa2,
+	kSensorCalibrationConstantSDP8x6Sqrt500Pa3,
+	kSensorCalibrationConstantSDP8x6Sqrt500Pa4)
+
+DEFINE_SQUARE_ROOT_CONFIGURATION_FIXED_POINT_KERNELS(
+	SDP8x6Sqrt125Pa,
+	kSensorCalibrationConstantSDP8x6Sqrt125Pa1,
+	kSensorCalibrationConstantSDP8x6Sqrt125Pa2,
+	kSensorCalibrationConstantSDP8x6Sqrt125Pa3,
+	kSensorCalibrationConstantSDP8x6Sqrt125Pa4)
+
+/*
+ *	Dispatch tables of the specialized fixed-point kernels, indexed by `OutputDistributionIndex`.
+ */
+static const CalibrationFunctionFixedPoint	calibrationFunctionsFixedPoint[kOutputDistributionIndexCalibratedSensorOutputMax] =
+						{
+							calculateSDP8x6Linear500PaOutputFixedPoint,
+							calculateSDP8x6Linear125PaOutputFixedPoint,
+							calculateSDP8x6Sqrt500PaOutputFixedPoint,
+							calculateSDP8x6Sqrt125PaOutputFixedPoint,
+						};
+
+static const CalibrationBatchFunctionFixedPoint	calibrationBatchFunctionsFixedPoint[kOutputDistributionIndexCalibratedSensorOutputMax] =
+						{
+							calculateSDP8x6Linear500PaOutputBatchFixedPoint,
+							calculateSDP8x6Linear125PaOutputBatchFixedPoint,
+							calculateSDP8x6Sqrt500PaOutputBatchFixedPoint,
+							calculateSDP8x6Sqrt125PaOutputBatchFixedPoint,
+						};
+
+
+CalibrationFunctionFixedPoint
+getCalibrationFunctionFixedPoint(OutputDistributionIndex variant)
+{
+	if (variant >= kOutputDistributionIndexCalibratedSensorOutputMax)
+	{
+		return NULL;
+	}
+
+	return calibrationFunctionsFixedPoint[variant];
+}
+
+CalibrationBatchFunctionFixedPoint
+getCalibrationBatchFunctionFixedPoint(OutputDistributionIndex variant)
+{
+	if (variant >= kOutputDistributionIndexCalibratedSensorOutputMax)
+	{
+		return NULL;
+	}
+
+	return calibrationBatchFunctionsFixedPoint[variant];
+}
+
+double
+convertFixedPointOutputToPascal(int32_t Pa)
+{
+	return ldexp((double)Pa, -kFixedPointOutputFractionalBits);
+}
+
+double
+convertAdcCodeToVoltage(uint32_t code, uint32_t bitDepth, double referenceVoltage)
+{
+	return ldexp((double)code * referenceVoltage, -(int)bitDepth);
+}
+
+CommonConstantReturnType
+calculateCalibratedSensorOutputFromAdcCodesBatchFloat(
+	OutputDistributionIndex	variant,
+	uint32_t		bitDepth,
+	double			referenceVoltage,
+	const uint32_t *	AoutCode,
+	const uint32_t *	VddCode,
+	float *			Pa,
+	size_t			numberOfSamples)
+{
+	CalibrationBatchFunctionFloat	calibrationBatchFunction = getCalibrationBatchFunctionFloat(variant);
+	float				voltsPerCode = (float)ldexp(referenceVoltage, -(int)bitDepth);
+	float				Aout[kMonteCarloSampleBlockSize];
+	float				Vdd[kMonteCarloSampleBlockSize];
+
+	if (calibrationBatchFunction == NULL)
+	{
+		fprintf(stderr, "Error: Invalid sensor variant %d.\n", variant);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	for (size_t blockStart = 0; blockStart < numberOfSamples; blockStart += kMonteCarloSampleBlockSize)
+	{
+		size_t	blockSize = (numberOfSamples - blockStart < kMonteCarloSampleBlockSize) ?
+					(numberOfSamples - blockStart) :
+					kMonteCarloSampleBlockSize;
+
+		for (size_t i = 0; i < blockSize; i++)
+		{
+			Aout[i] = (float)AoutCode[blockStart + i] * voltsPerCode;
+			Vdd[i] = (float)VddCode[blockStart + i] * voltsPerCode;
+		}
+
+		calibrationBatchFunction(Aout, Vdd, &Pa[blockStart], blockSize);
+	}
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+CommonConstantReturnType
+runFixedPointCalibrationSelfTest(void)
+{
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+	uint32_t			numberOfCodes = (uint32_t)1 << kDefaultAdcBitDepth;
+	uint32_t *			AoutCode = (uint32_t *) checkedMalloc(numberOfCodes * sizeof(uint32_t), __FILE__, __LINE__);
+	uint32_t *			VddCode = (uint32_t *) checkedMalloc(numberOfCodes * sizeof(uint32_t), __FILE__, __LINE__);
+	int32_t *			PaFixedPoint = (int32_t *) checkedMalloc(numberOfCodes * sizeof(int32_t), __FILE__, __LINE__);
+	float *				PaFloat = (float *) checkedMalloc(numberOfCodes * sizeof(float), __FILE__, __LINE__);
+
+	printf(
+		"Fixed-point calibration self-test (%d-bit ADC codes, maximum allowed difference to double-precision reference: %.1e Pa):\n",
+		kDefaultAdcBitDepth,
+		kFixedPointCalibrationMaximumAbsoluteError);
+
+	for (uint32_t i = 0; i < numberOfCodes; i++)
+	{
+		AoutCode[i] = i;
+	}
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		CalibrationBatchFunctionFixedPoint	calibrationBatchFunction = getCalibrationBatchFunctionFixedPoint(variant);
+		double					maximumAbsoluteErrorFixedPoint = 0.0;
+		double					maximumAbsoluteErrorFloat = 0.0;
+		bool					passed;
+
+		/*
+		 *	Sweep all valid Aout codes (up to the Vdd code) for every
+		 *	`kFixedPointSelfTestVddCodeStride`-th Vdd code. The reference
+		 *	voltage cancels out of the ratio, so the double-precision
+		 *	reference can take the codes directly.
+		 */
+		for (uint32_t vddCode = 1; vddCode < numberOfCodes; vddCode += kFixedPointSelfTestVddCodeStride)
+		{
+			uint32_t	numberOfAoutCodes = vddCode + 1;
+
+			for (uint32_t i = 0; i < numberOfAoutCodes; i++)
+			{
+				VddCode[i] = vddCode;
+			}
+
+			calibrationBatchFunction(AoutCode, VddCode, PaFixedPoint, numberOfAoutCodes);
+			calculateCalibratedSensorOutputFromAdcCodesBatchFloat(
+				variant,
+				kDefaultAdcBitDepth,
+				kDefaultAdcReferenceVoltage,
+				AoutCode,
+				VddCode,
+				PaFloat,
+				numberOfAoutCodes);
+
+			for (uint32_t i = 0; i < numberOfAoutCodes; i++)
+			{
+				double	reference = calculateCalibratedSensorOutput(variant, (double)AoutCode[i], (double)VddCode[i]);
+
+				maximumAbsoluteErrorFixedPoint = fmax(
+									maximumAbsoluteErrorFixedPoint,
+									fabs(convertFixedPointOutputToPascal(PaFixedPoint[i]) - reference));
+				maximumAbsoluteErrorFloat = fmax(maximumAbsoluteErrorFloat, fabs((double)PaFloat[i] - reference));
+			}
+		}
+
+		passed = (maximumAbsoluteErrorFixedPoint <= kFixedPointCalibrationMaximumAbsoluteError);
+		printf(
+			"\t%-18s: outputDistributions[%d]: maximum absolute difference %.3e Pa: %s\n",
+			"fixed-point",
+			variant,
+			maximumAbsoluteErrorFixedPoint,
+			passed ? "PASS" : "FAIL");
+		printf(
+			"\t%-18s: outputDistributions[%d]: maximum absolute difference %.3e Pa\n",
+			"float",
+			variant,
+			maximumAbsoluteErrorFloat);
+
+		if (!passed)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+	}
+
+	free(AoutCode);
+	free(VddCode);
+	free(PaFixedPoint);
+	free(PaFloat);
+
+	return result;
+}
@@ -0,0 +1,116 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "common.h"
+#include "utilities-config.h"
+
+/*
+ *	Per-variant fixed-point calibration kernels, which take the raw codes of the
+ *	Aout and Vdd channels of an ADC and return the calibrated output in Pascal as
+ *	a Q16.16 (`kFixedPointOutputFractionalBits`) fixed-point value. They only use
+ *	integer arithmetic, so they need neither an FPU nor libm:
+ *		CalibrationFunctionFixedPoint		: Calibrates a single (AoutCode, VddCode) pair.
+ *		CalibrationBatchFunctionFixedPoint	: Calibrates a batch of (AoutCode, VddCode) pairs stored as a structure of arrays.
+ *
+ *	The calibration only depends on the ratio `Aout / Vdd`. When both channels are
+ *	sampled by the same ADC, the ADC reference voltage and bit depth cancel out of
+ *	that ratio, so the kernels do not need them. `VddCode` must not be zero, and,
+ *	as Aout is ratiometric to Vdd, `AoutCode` must not be greater than `VddCode`,
+ *	which bounds all intermediate values.
+ */
+typedef int32_t	(*CalibrationFunctionFixedPoint)(uint32_t AoutCode, uint32_t VddCode);
+typedef void	(*CalibrationBatchFunctionFixedPoint)(const uint32_t *  AoutCode, const uint32_t *  VddCode, int32_t *  Pa, size_t numberOfSamples);
+
+/**
+ *	@brief  Returns the specialized fixed-point kernel for a single SDP8x6 variant.
+ *
+ *	@param  variant				: The sensor variant / configuration to calibrate for.
+ *	@return CalibrationFunctionFixedPoint	: The kernel of the variant, or `NULL` if the variant is invalid.
+ */
+CalibrationFunctionFixedPoint	getCalibrationFunctionFixedPoint(OutputDistributionIndex variant);
+
+/**
+ *	@brief  Returns the specialized fixed-point batch kernel for a single SDP8x6 variant.
+ *
+ *	@param  variant					: The sensor variant / configuration to calibrate for.
+ *	@return CalibrationBatchFunctionFixedPoint	: The batch kernel, or `NULL` if the variant is invalid.
+ */
+CalibrationBatchFunctionFixedPoint	getCalibrationBatchFunctionFixedPoint(OutputDistributionIndex variant);
+
+/**
+ *	@brief  Converts a Q16.16 fixed-point output of the fixed-point kernels to Pascal.
+ *
+ *	@param  Pa	: The fixed-point output.
+ *	@return double	: The output in Pascal.
+ */
+double	convertFixedPointOutputToPascal(int32_t Pa);
+
+/**
+ *	@brief  Converts an ADC code to Volts, as `code * referenceVoltage / 2^bitDepth`.
+ *
+ *	@param  code			: The ADC code.
+ *	@param  bitDepth		: The bit depth of the ADC.
+ *	@param  referenceVoltage	: The reference voltage of the ADC (in Volts).
+ *	@return double			: The voltage (in Volts).
+ */
+double	convertAdcCodeToVoltage(uint32_t code, uint32_t bitDepth, double referenceVoltage);
+
+/**
+ *	@brief  Calculates the calibrated sensor output of a single SDP8x6 variant for a batch of
+ *		(AoutCode, VddCode) pairs in single precision (float32): converts the codes to
+ *		Volts and calibrates them with the single-precision batch kernel. This is the
+ *		floating-point counterpart of the fixed-point batch kernels, for comparison.
+ *
+ *	@param  variant			: The sensor variant / configuration to calibrate for.
+ *	@param  bitDepth		: The bit depth of the ADC.
+ *	@param  referenceVoltage	: The reference voltage of the ADC (in Volts).
+ *	@param  AoutCode		: Array of `numberOfSamples` ADC codes of the Aout channel.
+ *	@param  VddCode			: Array of `numberOfSamples` ADC codes of the Vdd channel.
+ *	@param  Pa			: Array of `numberOfSamples` values, where the function writes the calibrated outputs (in Pascal).
+ *	@param  numberOfSamples		: The number of samples in each of the arrays.
+ *	@return				: `kCommonConstantReturnTypeSuccess` if successful,
+ *					   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	calculateCalibratedSensorOutputFromAdcCodesBatchFloat(
+					OutputDistributionIndex	variant,
+					uint32_t		bitDepth,
+					double			referenceVoltage,
+					const uint32_t *	AoutCode,
+					const uint32_t *	VddCode,
+					float *			Pa,
+					size_t			numberOfSamples);
+
+/**
+ *	@brief  Checks the fixed-point kernels, and the single-precision ADC code path, against the
+ *		double-precision reference for pairs of codes of a `kDefaultAdcBitDepth`-bit ADC,
+ *		and prints the maximum absolute difference of each variant. Only the fixed-point
+ *		kernels are checked against `kFixedPointCalibrationMaximumAbsoluteError`; the
+ *		single-precision difference is printed for comparison.
+ *
+ *	@return			: `kCommonConstantReturnTypeSuccess` if all variants are within the
+ *				   bound, else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runFixedPointCalibrationSelfTest(void);
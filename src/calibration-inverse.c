@@ -0,0 +1,409 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <time.h>
+#include "calibration-inverse.h"
+#include "calibration-kernels.h"
+#include "calibration-simd.h"
+
+/*
+ *	Generate the specialized scalar inverse kernels of a variant, with the
+ *	calibration constants folded in at compile time.
+ */
+#define DEFINE_LINEAR_CONFIGURATION_INVERSE_KERNELS(variantName, k1, k2)					\
+	static double												\
+	calculate##variantName##InverseOutput(double Pa, double Vdd)						\
+	{													\
+		return calculateLinearConfigurationInverseOutput(Pa, Vdd, (k1), (k2));				\
+	}													\
+														\
+	static void												\
+	calculate##variantName##InverseOutputBatch(const double *  Pa, const double *  Vdd, double *  Aout, size_t numberOfSamples)	\
+	{													\
+		for (size_t i = 0; i < numberOfSamples; i++)							\
+		{												\
+			Aout[i] = calculateLinearConfigurationInverseOutput(Pa[i], Vdd[i], (k1), (k2));		\
+		}												\
+	}
+
+#define DEFINE_SQUARE_ROOT_CONFIGURATION_INVERSE_KERNELS(variantName, k2, k3, k4)				\
+	static double												\
+	calculate##variantName##InverseOutput(double Pa, double Vdd)						\
+	{													\
+		return calculateSquareRootConfigurationInverseOutput(Pa, Vdd, (k2), (k3), (k4));		\
+	}													\
+														\
+	static void												\
+	calculate##variantName##InverseOutputBatch(const double *  Pa, const double *  Vdd, double *  Aout, size_t numberOfSamples)	\
+	{													\
+		for (size_t i = 0; i < numberOfSamples; i++)							\
+		{												\
+			Aout[i] = calculateSquareRootConfigurationInverseOutput(Pa[i], Vdd[i], (k2), (k3), (k4));	\
+		}												\
+	}
+
+DEFINE_LINEAR_CONFIGURATION_INVERSE_KERNELS(
+	SDP8x6Linear500Pa,
+	kSensorCalibrationConstantSDP8x6Linear500Pa1,
+	kSensorCalibrationConstantSDP8x6Linear500Pa2)
+
+DEFINE_LINEAR_CONFIGURATION_INVERSE_KERNELS(
+	SDP8x6Linear125Pa,
+	kSensorCalibrationConstantSDP8x6Linear125Pa1,
+	kSensorCalibrationConstantSDP8x6Linear125Pa2)
+
+DEFINE_SQUARE_ROOT_CONFIGURATION_INVERSE_KERNELS(
+	SDP8x6Sqrt500Pa,
+	kSensorCalibrationConstantSDP8x6Sqrt500Pa2,
+	kSensorCalibrationConstantSDP8x6Sqrt500Pa3,
+	kSensorCalibrationConstantSDP8x6Sqrt500Pa4)
+
+DEFINE_SQUARE_ROOT_CONFIGURATION_INVERSE_KERNELS(
+	SDP8x6Sqrt125Pa,
+	kSensorCalibrationConstantSDP8x6Sqrt125Pa2,
+	kSensorCalibrationConstantSDP8x6Sqrt125Pa3,
+	kSensorCalibrationConstantSDP8x6Sqrt125Pa4)
+
+/*
+ *	The sign split of the square root inverse assumes that the output changes
+ *	sign where the scaled ratio is zero, i.e., that `k1 == k2 * k3`.
+ */
+_Static_assert(
+	kSensorCalibrationConstantSDP8x6Sqrt500Pa1 == kSensorCalibrationConstantSDP8x6Sqrt500Pa2 * kSensorCalibrationConstantSDP8x6Sqrt500Pa3,
+	"The square root inverse requires k1 == k2 * k3");
+_Static_assert(
+	kSensorCalibrationConstantSDP8x6Sqrt125Pa1 == kSensorCalibrationConstantSDP8x6Sqrt125Pa2 * kSensorCalibrationConstantSDP8x6Sqrt125Pa3,
+	"The square root inverse requires k1 == k2 * k3");
+
+/*
+ *	Dispatch tables of the specialized scalar inverse kernels, indexed by `OutputDistributionIndex`.
+ */
+static const InverseCalibrationFunction		inverseCalibrationFunctions[kOutputDistributionIndexCalibratedSensorOutputMax] =
+						{
+							calculateSDP8x6Linear500PaInverseOutput,
+							calculateSDP8x6Linear125PaInverseOutput,
+							calculateSDP8x6Sqrt500PaInverseOutput,
+							calculateSDP8x6Sqrt125PaInverseOutput,
+						};
+
+static const InverseCalibrationBatchFunction	scalarInverseCalibrationBatchFunctions[kOutputDistributionIndexCalibratedSensorOutputMax] =
+						{
+							calculateSDP8x6Linear500PaInverseOutputBatch,
+							calculateSDP8x6Linear125PaInverseOutputBatch,
+							calculateSDP8x6Sqrt500PaInverseOutputBatch,
+							calculateSDP8x6Sqrt125PaInverseOutputBatch,
+						};
+
+
+InverseCalibrationFunction
+getInverseCalibrationFunction(OutputDistributionIndex variant)
+{
+	if (variant >= kOutputDistributionIndexCalibratedSensorOutputMax)
+	{
+		return NULL;
+	}
+
+	return inverseCalibrationFunctions[variant];
+}
+
+InverseCalibrationBatchFunction
+getInverseCalibrationBatchFunction(CalibrationKernelImplementation implementation, OutputDistributionIndex variant)
+{
+	if (variant >= kOutputDistributionIndexCalibratedSensorOutputMax)
+	{
+		return NULL;
+	}
+
+	switch (implementation)
+	{
+		case kCalibrationKernelImplementationScalar:
+		case kCalibrationKernelImplementationScalarBranchFree:
+			return scalarInverseCalibrationBatchFunctions[variant];
+
+		default:
+			return getVectorizedInverseCalibrationBatchFunction(implementation, variant);
+	}
+}
+
+double
+calculateInverseCalibratedSensorOutput(OutputDistributionIndex variant, double Pa, double Vdd)
+{
+	InverseCalibrationFunction	inverseCalibrationFunction = getInverseCalibrationFunction(variant);
+
+	if (inverseCalibrationFunction == NULL)
+	{
+		return NAN;
+	}
+
+	return inverseCalibrationFunction(Pa, Vdd);
+}
+
+CommonConstantReturnType
+calculateInverseCalibratedSensorOutputBatch(
+	OutputDistributionIndex	variant,
+	const double *		Pa,
+	const double *		Vdd,
+	double *		Aout,
+	size_t			numberOfSamples)
+{
+	InverseCalibrationBatchFunction	inverseCalibrationBatchFunction = getInverseCalibrationBatchFunction(
+										getCalibrationKernelImplementation(),
+										variant);
+
+	if (inverseCalibrationBatchFunction == NULL)
+	{
+		fprintf(stderr, "Error: No inverse calibration kernel for output %d.\n", variant);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	inverseCalibrationBatchFunction(Pa, Vdd, Aout, numberOfSamples);
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+/**
+ *	@brief  Fills the (Pa, Vdd) inputs of the inverse calibration self-test: for supply voltages
+ *		across the default input range, sweeps Pa over the outputs of a variant for Aout/Vdd
+ *		in [0, 1], and adds `+0.0` and `-0.0`, where the square root configurations change sign.
+ *
+ *	@param  variant	: The sensor variant / configuration.
+ *	@param  Pa	: Array of `kCalibrationKernelSelfTestNumberOfSamples` values, where the function writes the Pa values.
+ *	@param  Vdd	: Array of `kCalibrationKernelSelfTestNumberOfSamples` values, where the function writes the Vdd values.
+ */
+static void
+setInverseSelfTestInputs(OutputDistributionIndex variant, double *  Pa, double *  Vdd)
+{
+	double	lowestPa = calculateCalibratedSensorOutput(variant, 0.0, 1.0);
+	double	highestPa = calculateCalibratedSensorOutput(variant, 1.0, 1.0);
+
+	for (size_t v = 0; v < kCalibrationKernelSelfTestNumberOfSupplyVoltages; v++)
+	{
+		double	vddFraction = (double)v / (kCalibrationKernelSelfTestNumberOfSupplyVoltages - 1);
+		double	vddValue = kDefaultInputDistributionVddUniformDistLow +
+					vddFraction * (kDefaultInputDistributionVddUniformDistHigh - kDefaultInputDistributionVddUniformDistLow);
+		size_t	rowStart = v * (kCalibrationKernelSelfTestNumberOfRatios + 2);
+
+		for (size_t r = 0; r < kCalibrationKernelSelfTestNumberOfRatios; r++)
+		{
+			Vdd[rowStart + r] = vddValue;
+			Pa[rowStart + r] = lowestPa + ((double)r / (kCalibrationKernelSelfTestNumberOfRatios - 1)) * (highestPa - lowestPa);
+		}
+
+		Vdd[rowStart + kCalibrationKernelSelfTestNumberOfRatios] = vddValue;
+		Pa[rowStart + kCalibrationKernelSelfTestNumberOfRatios] = 0.0;
+		Vdd[rowStart + kCalibrationKernelSelfTestNumberOfRatios + 1] = vddValue;
+		Pa[rowStart + kCalibrationKernelSelfTestNumberOfRatios + 1] = -0.0;
+	}
+
+	return;
+}
+
+/**
+ *	@brief  Checks the round trips of the scalar inverse of a variant through the scalar reference,
+ *		and prints the maximum errors.
+ *
+ *	@param  variant	: The sensor variant / configuration.
+ *	@param  Pa	: Array of `kCalibrationKernelSelfTestNumberOfSamples` Pa inputs of the self-test.
+ *	@param  Vdd	: Array of `kCalibrationKernelSelfTestNumberOfSamples` Vdd inputs of the self-test.
+ *	@return bool	: `true` if both round trips are within their bounds, else `false`.
+ */
+static bool
+checkInverseCalibrationRoundTrips(OutputDistributionIndex variant, const double *  Pa, const double *  Vdd)
+{
+	CalibrationFunction		calibrationFunction = getCalibrationFunction(variant);
+	InverseCalibrationFunction	inverseCalibrationFunction = getInverseCalibrationFunction(variant);
+	double				maximumAoutError = 0.0;
+	double				maximumPaError = 0.0;
+	bool				passed;
+
+	for (size_t i = 0; i < kCalibrationKernelSelfTestNumberOfSamples; i++)
+	{
+		/*
+		 *	Aout -> Pa -> Aout, over the same ratios as the forward self-test.
+		 */
+		double	Aout = ((double)(i % kCalibrationKernelSelfTestNumberOfRatios) / (kCalibrationKernelSelfTestNumberOfRatios - 1)) * Vdd[i];
+		double	roundTripAout = inverseCalibrationFunction(calibrationFunction(Aout, Vdd[i]), Vdd[i]);
+
+		/*
+		 *	Pa -> Aout -> Pa.
+		 */
+		double	roundTripPa = calibrationFunction(inverseCalibrationFunction(Pa[i], Vdd[i]), Vdd[i]);
+
+		maximumAoutError = fmax(maximumAoutError, fabs(roundTripAout - Aout));
+		maximumPaError = fmax(maximumPaError, fabs(roundTripPa - Pa[i]));
+	}
+
+	passed = (maximumAoutError <= kInverseCalibrationMaximumAoutRoundTripError) && (maximumPaError <= kInverseCalibrationMaximumPaRoundTripError);
+	printf(
+		"\t%-18s: outputDistributions[%d]: maximum Aout -> Pa -> Aout error %.3e V, Pa -> Aout -> Pa error %.3e Pa: %s\n",
+		"round-trip",
+		variant,
+		maximumAoutError,
+		maximumPaError,
+		passed ? "PASS" : "FAIL");
+
+	return passed;
+}
+
+CommonConstantReturnType
+runInverseCalibrationSelfTest(void)
+{
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+	double *			Pa = (double *) checkedMalloc(kCalibrationKernelSelfTestNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *			Vdd = (double *) checkedMalloc(kCalibrationKernelSelfTestNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *			AoutReference = (double *) checkedMalloc(kCalibrationKernelSelfTestNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *			Aout = (double *) checkedMalloc(kCalibrationKernelSelfTestNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+
+	printf(
+		"Inverse calibration self-test (maximum allowed distance to scalar inverse: %d ULP, round-trip bounds: %.1e V, %.1e Pa):\n",
+		kCalibrationKernelMaximumUlpDistance,
+		kInverseCalibrationMaximumAoutRoundTripError,
+		kInverseCalibrationMaximumPaRoundTripError);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		setInverseSelfTestInputs(variant, Pa, Vdd);
+		scalarInverseCalibrationBatchFunctions[variant](Pa, Vdd, AoutReference, kCalibrationKernelSelfTestNumberOfSamples);
+
+		for (CalibrationKernelImplementation implementation = kCalibrationKernelImplementationSSE2; implementation < kCalibrationKernelImplementationMax; implementation++)
+		{
+			uint64_t	maximumUlpDistance = 0;
+			bool		passed;
+
+			if (!isCalibrationKernelImplementationSupported(implementation))
+			{
+				continue;
+			}
+
+			getInverseCalibrationBatchFunction(implementation, variant)(Pa, Vdd, Aout, kCalibrationKernelSelfTestNumberOfSamples);
+
+			for (size_t i = 0; i < kCalibrationKernelSelfTestNumberOfSamples; i++)
+			{
+				uint64_t	ulpDistance = calculateUlpDistance(Aout[i], AoutReference[i]);
+
+				if (ulpDistance > maximumUlpDistance)
+				{
+					maximumUlpDistance = ulpDistance;
+				}
+			}
+
+			passed = (maximumUlpDistance <= kCalibrationKernelMaximumUlpDistance);
+			printf(
+				"\t%-18s: outputDistributions[%d]: maximum distance %" PRIu64 " ULP: %s\n",
+				getCalibrationKernelImplementationName(implementation),
+				variant,
+				maximumUlpDistance,
+				passed ? "PASS" : "FAIL");
+
+			if (!passed)
+			{
+				result = kCommonConstantReturnTypeError;
+			}
+		}
+
+		if (!checkInverseCalibrationRoundTrips(variant, Pa, Vdd))
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+	}
+
+	free(Pa);
+	free(Vdd);
+	free(AoutReference);
+	free(Aout);
+
+	return result;
+}
+
+void
+runInverseCalibrationBenchmark(size_t numberOfSamples)
+{
+	double *	Aout = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *	Vdd = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *	Pa = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+
+	setCalibrationKernelBenchmarkInputs(Aout, Vdd, numberOfSamples);
+
+	printf("Inverse calibration benchmark (%zu samples, best of %d runs):\n", numberOfSamples, kCalibrationKernelBenchmarkNumberOfRuns);
+
+	for (CalibrationKernelImplementation implementation = 0; implementation < kCalibrationKernelImplementationMax; implementation++)
+	{
+		if (!isCalibrationKernelImplementationSupported(implementation))
+		{
+			printf("\t%-18s: not supported on this CPU\n", getCalibrationKernelImplementationName(implementation));
+
+			continue;
+		}
+
+		for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+		{
+			InverseCalibrationBatchFunction	inverseCalibrationBatchFunction = getInverseCalibrationBatchFunction(implementation, variant);
+			double				bestSeconds = INFINITY;
+
+			/*
+			 *	Invert the outputs of the benchmark inputs, so that the
+			 *	pressures cover the outputs of the default input ranges.
+			 */
+			calculateCalibratedSensorOutputBatchWithImplementation(
+				kCalibrationKernelImplementationScalar,
+				variant,
+				Aout,
+				Vdd,
+				Pa,
+				numberOfSamples);
+
+			for (int run = 0; run < kCalibrationKernelBenchmarkNumberOfRuns; run++)
+			{
+				clock_t	start = clock();
+
+				inverseCalibrationBatchFunction(Pa, Vdd, Aout, numberOfSamples);
+
+				double	seconds = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+
+				if (seconds < bestSeconds)
+				{
+					bestSeconds = seconds;
+				}
+			}
+
+			printf(
+				"\t%-18s: outputDistributions[%d]: %.3lf ns/sample\n",
+				getCalibrationKernelImplementationName(implementation),
+				variant,
+				bestSeconds * 1e9 / numberOfSamples);
+		}
+	}
+
+	free(Aout);
+	free(Vdd);
+	free(Pa);
+
+	return;
+}
@@ -0,0 +1,113 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "common.h"
+#include "utilities-config.h"
+#include "calibration.h"
+
+/*
+ *	Per-variant inverse calibration kernels, which calculate the Aout at which a
+ *	variant outputs a given differential pressure, for a given supply voltage,
+ *	e.g., to turn pressure setpoints and alarm limits into Aout thresholds:
+ *		InverseCalibrationFunction	: Inverts a single (Pa, Vdd) pair.
+ *		InverseCalibrationBatchFunction	: Inverts a batch of (Pa, Vdd) pairs stored as a structure of arrays.
+ *
+ *	All variants are monotonically increasing in `Aout / Vdd`, so the inverse is
+ *	unique. The inverse is not clamped to the valid range of Aout, [0, Vdd].
+ */
+typedef double	(*InverseCalibrationFunction)(double Pa, double Vdd);
+typedef void	(*InverseCalibrationBatchFunction)(const double *  Pa, const double *  Vdd, double *  Aout, size_t numberOfSamples);
+
+/**
+ *	@brief  Calculates the Aout at which a single SDP8x6 variant outputs `Pa`, for the supply
+ *		voltage `Vdd`. The square root configurations are inverted separately for
+ *		positive and negative pressures.
+ *
+ *	@param  variant		: The sensor variant / configuration.
+ *	@param  Pa		: The differential pressure (in Pascal).
+ *	@param  Vdd		: Supply voltage (in Volts).
+ *	@return double		: The ratiometric analog voltage value (in Volts).
+ */
+double	calculateInverseCalibratedSensorOutput(OutputDistributionIndex variant, double Pa, double Vdd);
+
+/**
+ *	@brief  Returns the specialized inverse kernel for a single SDP8x6 variant.
+ *
+ *	@param  variant				: The sensor variant / configuration.
+ *	@return InverseCalibrationFunction	: The inverse kernel of the variant, or `NULL` if the variant is invalid.
+ */
+InverseCalibrationFunction	getInverseCalibrationFunction(OutputDistributionIndex variant);
+
+/**
+ *	@brief  Returns the specialized inverse batch kernel of a calibration kernel implementation for
+ *		a single SDP8x6 variant. The inverse kernels have no branches, so both scalar
+ *		implementations use the same kernel.
+ *
+ *	@param  implementation				: The calibration kernel implementation.
+ *	@param  variant					: The sensor variant / configuration.
+ *	@return InverseCalibrationBatchFunction		: The inverse batch kernel, or `NULL` if the variant is invalid
+ *							  or the implementation is not available on this platform.
+ */
+InverseCalibrationBatchFunction	getInverseCalibrationBatchFunction(CalibrationKernelImplementation implementation, OutputDistributionIndex variant);
+
+/**
+ *	@brief  Calculates the Aout at which a single SDP8x6 variant outputs each of a batch of
+ *		pressures, for the matching supply voltages, using the calibration kernel
+ *		implementation selected at runtime (see `getCalibrationKernelImplementation()`).
+ *
+ *	@param  variant			: The sensor variant / configuration.
+ *	@param  Pa			: Array of `numberOfSamples` differential pressures (in Pascal).
+ *	@param  Vdd			: Array of `numberOfSamples` supply voltage values (in Volts).
+ *	@param  Aout			: Array of `numberOfSamples` values, where the function writes the Aout values (in Volts).
+ *	@param  numberOfSamples		: The number of samples in each of the arrays.
+ *	@return				: `kCommonConstantReturnTypeSuccess` if successful,
+ *					   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	calculateInverseCalibratedSensorOutputBatch(
+					OutputDistributionIndex	variant,
+					const double *		Pa,
+					const double *		Vdd,
+					double *		Aout,
+					size_t			numberOfSamples);
+
+/**
+ *	@brief  Checks the inverse calibration of all variants: the vectorized inverse kernels
+ *		supported by the CPU against the scalar inverse (in ULP), and the round trips
+ *		Aout -> Pa -> Aout and Pa -> Aout -> Pa through the scalar reference against
+ *		`kInverseCalibrationMaximumAoutRoundTripError` and
+ *		`kInverseCalibrationMaximumPaRoundTripError`.
+ *
+ *	@return			: `kCommonConstantReturnTypeSuccess` if all checks pass,
+ *				   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runInverseCalibrationSelfTest(void);
+
+/**
+ *	@brief  Times the inverse batch kernels of all calibration kernel implementations supported
+ *		by the running CPU, for all variants, and prints the time per sample in nanoseconds.
+ *
+ *	@param  numberOfSamples	: The number of (Pa, Vdd) pairs to invert per measurement.
+ */
+void	runInverseCalibrationBenchmark(size_t numberOfSamples);
@@ -0,0 +1,252 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <math.h>
+
+/*
+ *	Scalar reference implementations of the calibration routines taken from
+ *	SDP8xx Analog Datasheet, 2024-07-03. These are shared by all calibration
+ *	kernels (e.g., as the tail loops of the vectorized kernels) so that every
+ *	implementation agrees with a single reference.
+ */
+
+/**
+ *	@brief  Implementation of the sign function for distributional values.
+ *
+ *	@param  arg	: Sign function argument.
+ *	@return double	: The result of the sign function.
+ */
+static inline double
+sign(double arg)
+{
+	if (arg == 0.0)
+	{
+		return 0.0;
+	}
+
+	return arg / fabs(arg);
+}
+
+/**
+ *	@brief  Calibration routine for the linear configurations.
+ *
+ *	@param  Aout	: Ratiometric analog voltage value (in Volts).
+ *	@param  Vdd	: Supply voltage (in Volts).
+ *	@param  k1	: First calibration constant (gain).
+ *	@param  k2	: Second calibration constant (offset).
+ *	@return double	: The calibrated differential pressure (in Pascal).
+ */
+static inline double
+calculateLinearConfigurationOutput(double Aout, double Vdd, double k1, double k2)
+{
+	return k1 * Aout / Vdd - k2;
+}
+
+/**
+ *	@brief  Calibration routine for the square root configurations.
+ *
+ *	@param  Aout	: Ratiometric analog voltage value (in Volts).
+ *	@param  Vdd	: Supply voltage (in Volts).
+ *	@param  k1	: Ratio at which the output changes sign.
+ *	@param  k2	: Ratio scaling constant.
+ *	@param  k3	: Offset of the scaled ratio.
+ *	@param  k4	: Output scaling constant.
+ *	@return double	: The calibrated differential pressure (in Pascal).
+ */
+static inline double
+calculateSquareRootConfigurationOutput(double Aout, double Vdd, double k1, double k2, double k3, double k4)
+{
+	return sign((Aout / Vdd) - k1) * pow((Aout / (Vdd * k2)) - k3, 2) * k4;
+}
+
+/**
+ *	@brief  Branch-free calibration routine for the square root configurations. Computes the
+ *		same result as `calculateSquareRootConfigurationOutput()`, but replaces the compare
+ *		and division of `sign()` with `copysign()`, and `pow(x, 2)` with a multiply, which
+ *		is the correctly-rounded square that `pow()` also returns. At the sign change
+ *		(`Aout / Vdd == k1`), the magnitude is multiplied by zero, as in the reference.
+ *
+ *		Unlike `calculateSquareRootConfigurationOutput()`, this is only meant for plain
+ *		(sample) values, not distributional values.
+ *
+ *	@param  Aout	: Ratiometric analog voltage value (in Volts).
+ *	@param  Vdd	: Supply voltage (in Volts).
+ *	@param  k1	: Ratio at which the output changes sign.
+ *	@param  k2	: Ratio scaling constant.
+ *	@param  k3	: Offset of the scaled ratio.
+ *	@param  k4	: Output scaling constant.
+ *	@return double	: The calibrated differential pressure (in Pascal).
+ */
+static inline double
+calculateSquareRootConfigurationOutputBranchFree(double Aout, double Vdd, double k1, double k2, double k3, double k4)
+{
+	double	ratio = Aout / Vdd;
+	double	scaled = (Aout / (Vdd * k2)) - k3;
+
+	return copysign(scaled * scaled, ratio - k1) * (double)(ratio != k1) * k4;
+}
+
+/**
+ *	@brief  Calibration routine for the linear configurations, given the ratio `Aout / Vdd`.
+ *		Used when evaluating several variants for the same pair, so that the ratio is
+ *		computed only once. Rounds differently from `calculateLinearConfigurationOutput()`.
+ *
+ *	@param  ratio	: The ratio `Aout / Vdd`.
+ *	@param  k1	: First calibration constant (gain).
+ *	@param  k2	: Second calibration constant (offset).
+ *	@return double	: The calibrated differential pressure (in Pascal).
+ */
+static inline double
+calculateLinearConfigurationOutputFromRatio(double ratio, double k1, double k2)
+{
+	return k1 * ratio - k2;
+}
+
+/**
+ *	@brief  Branch-free calibration routine for the square root configurations, given the ratio
+ *		`Aout / Vdd`. Used when evaluating several variants for the same pair, so that the
+ *		ratio is computed only once. Rounds differently from `calculateSquareRootConfigurationOutput()`.
+ *
+ *	@param  ratio	: The ratio `Aout / Vdd`.
+ *	@param  k1	: Ratio at which the output changes sign.
+ *	@param  k2	: Ratio scaling constant.
+ *	@param  k3	: Offset of the scaled ratio.
+ *	@param  k4	: Output scaling constant.
+ *	@return double	: The calibrated differential pressure (in Pascal).
+ */
+static inline double
+calculateSquareRootConfigurationOutputFromRatio(double ratio, double k1, double k2, double k3, double k4)
+{
+	double	scaled = (ratio / k2) - k3;
+
+	return copysign(scaled * scaled, ratio - k1) * (double)(ratio != k1) * k4;
+}
+
+/**
+ *	@brief  Single-precision version of `calculateLinearConfigurationOutput()`.
+ *
+ *	@param  Aout	: Ratiometric analog voltage value (in Volts).
+ *	@param  Vdd	: Supply voltage (in Volts).
+ *	@param  k1	: First calibration constant (gain).
+ *	@param  k2	: Second calibration constant (offset).
+ *	@return float	: The calibrated differential pressure (in Pascal).
+ */
+static inline float
+calculateLinearConfigurationOutputFloat(float Aout, float Vdd, float k1, float k2)
+{
+	return k1 * Aout / Vdd - k2;
+}
+
+/**
+ *	@brief  Single-precision version of `calculateSquareRootConfigurationOutputBranchFree()`.
+ *
+ *	@param  Aout	: Ratiometric analog voltage value (in Volts).
+ *	@param  Vdd	: Supply voltage (in Volts).
+ *	@param  k1	: Ratio at which the output changes sign.
+ *	@param  k2	: Ratio scaling constant.
+ *	@param  k3	: Offset of the scaled ratio.
+ *	@param  k4	: Output scaling constant.
+ *	@return float	: The calibrated differential pressure (in Pascal).
+ */
+static inline float
+calculateSquareRootConfigurationOutputFloat(float Aout, float Vdd, float k1, float k2, float k3, float k4)
+{
+	float	ratio = Aout / Vdd;
+	float	scaled = (Aout / (Vdd * k2)) - k3;
+
+	return copysignf(scaled * scaled, ratio - k1) * (float)(ratio != k1) * k4;
+}
+
+/**
+ *	@brief  Single-precision version of `calculateLinearConfigurationOutputFromRatio()`.
+ *
+ *	@param  ratio	: The ratio `Aout / Vdd`.
+ *	@param  k1	: First calibration constant (gain).
+ *	@param  k2	: Second calibration constant (offset).
+ *	@return float	: The calibrated differential pressure (in Pascal).
+ */
+static inline float
+calculateLinearConfigurationOutputFromRatioFloat(float ratio, float k1, float k2)
+{
+	return k1 * ratio - k2;
+}
+
+/**
+ *	@brief  Single-precision version of `calculateSquareRootConfigurationOutputFromRatio()`.
+ *
+ *	@param  ratio	: The ratio `Aout / Vdd`.
+ *	@param  k1	: Ratio at which the output changes sign.
+ *	@param  k2	: Ratio scaling constant.
+ *	@param  k3	: Offset of the scaled ratio.
+ *	@param  k4	: Output scaling constant.
+ *	@return float	: The calibrated differential pressure (in Pascal).
+ */
+static inline float
+calculateSquareRootConfigurationOutputFromRatioFloat(float ratio, float k1, float k2, float k3, float k4)
+{
+	float	scaled = (ratio / k2) - k3;
+
+	return copysignf(scaled * scaled, ratio - k1) * (float)(ratio != k1) * k4;
+}
+
+/**
+ *	@brief  Inverse of the calibration routine for the linear configurations: the Aout
+ *		at which a linear configuration outputs `Pa` for the supply voltage `Vdd`.
+ *
+ *	@param  Pa	: The differential pressure (in Pascal).
+ *	@param  Vdd	: Supply voltage (in Volts).
+ *	@param  k1	: First calibration constant (gain).
+ *	@param  k2	: Second calibration constant (offset).
+ *	@return double	: The ratiometric analog voltage value (in Volts).
+ */
+static inline double
+calculateLinearConfigurationInverseOutput(double Pa, double Vdd, double k1, double k2)
+{
+	return ((Pa + k2) / k1) * Vdd;
+}
+
+/**
+ *	@brief  Inverse of the calibration routine for the square root configurations: the Aout
+ *		at which a square root configuration outputs `Pa` for the supply voltage `Vdd`.
+ *
+ *		The output is `sign(ratio - k1) * scaled^2 * k4`, with `scaled = ratio / k2 - k3`.
+ *		For the SDP8x6 constants, `k1 == k2 * k3`, so the sign of the output is the sign
+ *		of `scaled`, and the output increases monotonically with the ratio. The inverse
+ *		therefore splits on the sign of `Pa`: `scaled = sign(Pa) * sqrt(|Pa| / k4)`,
+ *		and `ratio = (scaled + k3) * k2`. `Pa == 0` gives the sign change at `k1`.
+ *
+ *	@param  Pa	: The differential pressure (in Pascal).
+ *	@param  Vdd	: Supply voltage (in Volts).
+ *	@param  k2	: Ratio scaling constant.
+ *	@param  k3	: Offset of the scaled ratio.
+ *	@param  k4	: Output scaling constant.
+ *	@return double	: The ratiometric analog voltage value (in Volts).
+ */
+static inline double
+calculateSquareRootConfigurationInverseOutput(double Pa, double Vdd, double k2, double k3, double k4)
+{
+	double	scaled = copysign(sqrt(fabs(Pa) / k4), Pa);
+
+	return ((scaled + k3) * k2) * Vdd;
+}
@@ -0,0 +1,289 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <time.h>
+#include "calibration.h"
+#include "calibration-lookup-table.h"
+
+/**
+ *	@brief  Looks up the output for a ratio `Aout / Vdd` in the table of a variant and
+ *		interpolates linearly. The index is clamped to the table, so ratios outside
+ *		[0, 1] are extrapolated from the first or last interval, and a NaN ratio
+ *		gives a NaN output.
+ *
+ *	@param  entries			: The table of the variant.
+ *	@param  numberOfIntervals	: The number of intervals of the table.
+ *	@param  ratio			: The ratio `Aout / Vdd`.
+ *	@return double			: The calibrated differential pressure (in Pascal).
+ */
+static inline double
+lookUpCalibratedSensorOutput(const double *  entries, size_t numberOfIntervals, double ratio)
+{
+	double	position = ratio * (double)numberOfIntervals;
+	double	lastIntervalPosition = (double)(numberOfIntervals - 1);
+	double	clampedPosition = (position > 0.0) ? position : 0.0;
+	size_t	index;
+	double	fraction;
+
+	/*
+	 *	Clamp with comparisons rather than `fmin()` / `fmax()`, which compile
+	 *	to library calls unless the compiler may ignore NaNs.
+	 */
+	clampedPosition = (clampedPosition < lastIntervalPosition) ? clampedPosition : lastIntervalPosition;
+	index = (size_t)clampedPosition;
+	fraction = position - (double)index;
+
+	return entries[2 * index] + fraction * entries[2 * index + 1];
+}
+
+CommonConstantReturnType
+buildCalibrationLookupTable(
+	CalibrationLookupTable *	lookupTable,
+	size_t				numberOfIntervals,
+	OutputDistributionIndex		variantLowerBound,
+	OutputDistributionIndex		variantUpperBound)
+{
+	if ((numberOfIntervals == 0) || (numberOfIntervals > kCalibrationLookupTableMaximumNumberOfIntervals))
+	{
+		fprintf(
+			stderr,
+			"Error: The number of lookup table intervals must be between 1 and %d. Provided %zu.\n",
+			kCalibrationLookupTableMaximumNumberOfIntervals,
+			numberOfIntervals);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	*lookupTable = (CalibrationLookupTable){ .numberOfIntervals = numberOfIntervals };
+
+	for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+	{
+		CalibrationFunction	calibrationFunction = getCalibrationFunction(variant);
+		double *		entries = (double *) checkedMalloc(2 * numberOfIntervals * sizeof(double), __FILE__, __LINE__);
+		double			startOfInterval = calibrationFunction(0.0, 1.0);
+
+		/*
+		 *	With `Vdd` equal to 1, the reference calculates the exact grid ratio.
+		 */
+		for (size_t i = 0; i < numberOfIntervals; i++)
+		{
+			double	endOfInterval = calibrationFunction((double)(i + 1) / (double)numberOfIntervals, 1.0);
+
+			entries[2 * i] = startOfInterval;
+			entries[2 * i + 1] = endOfInterval - startOfInterval;
+			startOfInterval = endOfInterval;
+		}
+
+		lookupTable->entries[variant] = entries;
+	}
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+void
+freeCalibrationLookupTable(CalibrationLookupTable *  lookupTable)
+{
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		free(lookupTable->entries[variant]);
+		lookupTable->entries[variant] = NULL;
+	}
+
+	return;
+}
+
+size_t
+getCalibrationLookupTableSizeInBytes(const CalibrationLookupTable *  lookupTable)
+{
+	return 2 * lookupTable->numberOfIntervals * sizeof(double);
+}
+
+CommonConstantReturnType
+calculateCalibratedSensorOutputBatchLookupTable(
+	const CalibrationLookupTable *	lookupTable,
+	OutputDistributionIndex		variant,
+	const double *			Aout,
+	const double *			Vdd,
+	double *			Pa,
+	size_t				numberOfSamples)
+{
+	const double *	entries;
+	size_t		numberOfIntervals = lookupTable->numberOfIntervals;
+
+	if ((variant >= kOutputDistributionIndexCalibratedSensorOutputMax) || (lookupTable->entries[variant] == NULL))
+	{
+		fprintf(stderr, "Error: No lookup table for output %d.\n", variant);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	entries = lookupTable->entries[variant];
+
+	for (size_t i = 0; i < numberOfSamples; i++)
+	{
+		Pa[i] = lookUpCalibratedSensorOutput(entries, numberOfIntervals, Aout[i] / Vdd[i]);
+	}
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+double
+calculateCalibrationLookupTableMaximumAbsoluteError(const CalibrationLookupTable *  lookupTable, OutputDistributionIndex variant)
+{
+	CalibrationFunction	calibrationFunction = getCalibrationFunction(variant);
+	double			maximumAbsoluteError = 0.0;
+
+	for (size_t i = 0; i < kCalibrationLookupTableErrorCheckNumberOfRatios; i++)
+	{
+		double	ratio = (double)i / (double)(kCalibrationLookupTableErrorCheckNumberOfRatios - 1);
+		double	Pa = lookUpCalibratedSensorOutput(lookupTable->entries[variant], lookupTable->numberOfIntervals, ratio);
+
+		maximumAbsoluteError = fmax(maximumAbsoluteError, fabs(Pa - calibrationFunction(ratio, 1.0)));
+	}
+
+	return maximumAbsoluteError;
+}
+
+void
+printCalibrationLookupTableReport(
+	FILE *				stream,
+	const CalibrationLookupTable *	lookupTable,
+	OutputDistributionIndex		variantLowerBound,
+	OutputDistributionIndex		variantUpperBound,
+	const char **			outputVariableDescriptions)
+{
+	fprintf(
+		stream,
+		"\nLookup table calibration (%zu intervals over Aout/Vdd in [0, 1], %.1lf KiB per output):\n",
+		lookupTable->numberOfIntervals,
+		getCalibrationLookupTableSizeInBytes(lookupTable) / 1024.0);
+
+	for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+	{
+		fprintf(
+			stream,
+			"\t%s: maximum absolute difference to the analytic formula %.3e Pa.\n",
+			outputVariableDescriptions[variant],
+			calculateCalibrationLookupTableMaximumAbsoluteError(lookupTable, variant));
+	}
+
+	return;
+}
+
+CommonConstantReturnType
+runCalibrationLookupTableSelfTest(void)
+{
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+	CalibrationLookupTable		lookupTable;
+
+	buildCalibrationLookupTable(
+		&lookupTable,
+		kCalibrationLookupTableDefaultNumberOfIntervals,
+		0,
+		kOutputDistributionIndexCalibratedSensorOutputMax);
+
+	printf(
+		"Lookup table calibration self-test (%d intervals, maximum allowed difference to scalar reference: %.1e Pa):\n",
+		kCalibrationLookupTableDefaultNumberOfIntervals,
+		kCalibrationLookupTableMaximumAbsoluteError);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		double	maximumAbsoluteError = calculateCalibrationLookupTableMaximumAbsoluteError(&lookupTable, variant);
+		bool	passed = (maximumAbsoluteError <= kCalibrationLookupTableMaximumAbsoluteError);
+
+		printf(
+			"\t%-18s: outputDistributions[%d]: maximum absolute difference %.3e Pa: %s\n",
+			"lookup-table",
+			variant,
+			maximumAbsoluteError,
+			passed ? "PASS" : "FAIL");
+
+		if (!passed)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+	}
+
+	freeCalibrationLookupTable(&lookupTable);
+
+	return result;
+}
+
+void
+runCalibrationLookupTableBenchmark(size_t numberOfSamples)
+{
+	double *		Aout = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *		Vdd = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *		Pa = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	CalibrationLookupTable	lookupTable;
+
+	setCalibrationKernelBenchmarkInputs(Aout, Vdd, numberOfSamples);
+	buildCalibrationLookupTable(
+		&lookupTable,
+		kCalibrationLookupTableDefaultNumberOfIntervals,
+		0,
+		kOutputDistributionIndexCalibratedSensorOutputMax);
+
+	printf(
+		"Lookup table calibration benchmark (%zu samples, %d intervals, best of %d runs):\n",
+		numberOfSamples,
+		kCalibrationLookupTableDefaultNumberOfIntervals,
+		kCalibrationKernelBenchmarkNumberOfRuns);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		double	bestSeconds = INFINITY;
+
+		for (int run = 0; run < kCalibrationKernelBenchmarkNumberOfRuns; run++)
+		{
+			clock_t	start = clock();
+
+			calculateCalibratedSensorOutputBatchLookupTable(&lookupTable, variant, Aout, Vdd, Pa, numberOfSamples);
+
+			double	seconds = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+
+			if (seconds < bestSeconds)
+			{
+				bestSeconds = seconds;
+			}
+		}
+
+		printf(
+			"\t%-18s: outputDistributions[%d]: %.3lf ns/sample\n",
+			"lookup-table",
+			variant,
+			bestSeconds * 1e9 / numberOfSamples);
+	}
+
+	freeCalibrationLookupTable(&lookupTable);
+	free(Aout);
+	free(Vdd);
+	free(Pa);
+
+	return;
+}
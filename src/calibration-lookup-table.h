@@ -0,0 +1,147 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include "common.h"
+#include "utilities-config.h"
+
+/*
+ *	Lookup tables of the calibrated output of each SDP8x6 variant over a grid of
+ *	`numberOfIntervals + 1` evenly spaced ratios `Aout / Vdd` in [0, 1]. All
+ *	variants depend on the inputs only through that ratio, so a lookup with
+ *	linear interpolation replaces the `pow()` (and the branches) of the square
+ *	root configurations. The linear configurations are linear in the ratio, so
+ *	their tables only add rounding error. For the square root configurations,
+ *	the interpolation error falls with the square of the number of intervals.
+ *
+ *	For each interval, `entries[variant]` stores the output at the start of the
+ *	interval followed by the difference to the output at its end, so that a
+ *	lookup reads a single pair of adjacent values. Entries of variants that
+ *	have no table are `NULL`.
+ */
+typedef struct
+{
+	size_t		numberOfIntervals;
+	double *	entries[kOutputDistributionIndexCalibratedSensorOutputMax];
+} CalibrationLookupTable;
+
+/**
+ *	@brief  Builds the lookup tables of a range of variants from the scalar reference.
+ *
+ *	@param  lookupTable		: Pointer to the lookup table struct to fill in. Free with `freeCalibrationLookupTable()`.
+ *	@param  numberOfIntervals	: The number of intervals of the ratio grid, at most `kCalibrationLookupTableMaximumNumberOfIntervals`.
+ *	@param  variantLowerBound	: The first variant to build a table for.
+ *	@param  variantUpperBound	: One past the last variant to build a table for.
+ *	@return				: `kCommonConstantReturnTypeSuccess` if successful,
+ *					   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	buildCalibrationLookupTable(
+					CalibrationLookupTable *	lookupTable,
+					size_t				numberOfIntervals,
+					OutputDistributionIndex		variantLowerBound,
+					OutputDistributionIndex		variantUpperBound);
+
+/**
+ *	@brief  Frees the tables of a lookup table struct built by `buildCalibrationLookupTable()`.
+ *
+ *	@param  lookupTable	: Pointer to the lookup table struct.
+ */
+void	freeCalibrationLookupTable(CalibrationLookupTable *  lookupTable);
+
+/**
+ *	@brief  Returns the memory footprint of the table of a single variant.
+ *
+ *	@param  lookupTable	: Pointer to the lookup table struct.
+ *	@return size_t		: The size of the table of a variant, in bytes.
+ */
+size_t	getCalibrationLookupTableSizeInBytes(const CalibrationLookupTable *  lookupTable);
+
+/**
+ *	@brief  Calculates the calibrated sensor output of a single SDP8x6 variant for a batch of
+ *		(Aout, Vdd) pairs via its lookup table. Ratios outside [0, 1] are extrapolated
+ *		linearly from the first or last interval.
+ *
+ *	@param  lookupTable		: Pointer to the lookup table struct.
+ *	@param  variant			: The sensor variant / configuration to calibrate for.
+ *	@param  Aout			: Array of `numberOfSamples` ratiometric analog voltage values (in Volts).
+ *	@param  Vdd			: Array of `numberOfSamples` supply voltage values (in Volts).
+ *	@param  Pa			: Array of `numberOfSamples` values, where the function writes the calibrated outputs (in Pascal).
+ *	@param  numberOfSamples		: The number of samples in each of the arrays.
+ *	@return				: `kCommonConstantReturnTypeSuccess` if successful,
+ *					   else `kCommonConstantReturnTypeError` if the variant has no table.
+ */
+CommonConstantReturnType	calculateCalibratedSensorOutputBatchLookupTable(
+					const CalibrationLookupTable *	lookupTable,
+					OutputDistributionIndex		variant,
+					const double *			Aout,
+					const double *			Vdd,
+					double *			Pa,
+					size_t				numberOfSamples);
+
+/**
+ *	@brief  Calculates the maximum absolute difference between the lookup table of a variant and
+ *		the scalar reference, over `kCalibrationLookupTableErrorCheckNumberOfRatios` evenly
+ *		spaced ratios in [0, 1].
+ *
+ *	@param  lookupTable	: Pointer to the lookup table struct.
+ *	@param  variant		: The sensor variant / configuration, which must have a table.
+ *	@return double		: The maximum absolute difference (in Pascal).
+ */
+double	calculateCalibrationLookupTableMaximumAbsoluteError(const CalibrationLookupTable *  lookupTable, OutputDistributionIndex variant);
+
+/**
+ *	@brief  Prints the memory footprint and the maximum absolute error of the tables of a range
+ *		of variants.
+ *
+ *	@param  stream				: The stream to print to.
+ *	@param  lookupTable			: Pointer to the lookup table struct.
+ *	@param  variantLowerBound		: The first variant to report on.
+ *	@param  variantUpperBound		: One past the last variant to report on.
+ *	@param  outputVariableDescriptions	: An array of strings containing the descriptions of the outputs.
+ */
+void	printCalibrationLookupTableReport(
+		FILE *				stream,
+		const CalibrationLookupTable *	lookupTable,
+		OutputDistributionIndex		variantLowerBound,
+		OutputDistributionIndex		variantUpperBound,
+		const char **			outputVariableDescriptions);
+
+/**
+ *	@brief  Checks the lookup tables of all variants, with `kCalibrationLookupTableDefaultNumberOfIntervals`
+ *		intervals, against `kCalibrationLookupTableMaximumAbsoluteError`.
+ *
+ *	@return			: `kCommonConstantReturnTypeSuccess` if all variants are within the
+ *				   bound, else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runCalibrationLookupTableSelfTest(void);
+
+/**
+ *	@brief  Prints the time per sample of the lookup tables of all variants, with
+ *		`kCalibrationLookupTableDefaultNumberOfIntervals` intervals, on the same inputs
+ *		as `runCalibrationKernelBenchmark()`.
+ *
+ *	@param  numberOfSamples	: The number of samples to calibrate per run.
+ */
+void	runCalibrationLookupTableBenchmark(size_t numberOfSamples);
@@ -0,0 +1,661 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "calibration-simd.h"
+#include "calibration-kernels.h"
+
+/*
+ *	The vectorized kernels are only built for x86 targets with a GCC-compatible
+ *	compiler. Each kernel is compiled for its own instruction set via the `target`
+ *	function attribute, so the rest of the application does not need to be built
+ *	with `-mavx2` / `-mavx512f`, and the kernel to use is chosen at runtime.
+ *
+ *	The vectorized kernels perform exactly the same sequence of IEEE-754 operations
+ *	as the scalar reference in `calibration-kernels.h`:
+ *		-	`pow(x, 2)` is computed as `x * x`, which is the correctly-rounded
+ *			square that `pow()` also returns.
+ *		-	`sign(r - k1) * y` is computed by selecting `y`, `-y`, or `0`, which
+ *			is exact.
+ *	The results are therefore expected to be bit-identical (0 ULP) to the scalar
+ *	reference, which `calculateMaximumUlpDistanceToScalarReference()` checks.
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define kCalibrationSIMDIsX86	1
+#include <immintrin.h>
+#else
+#define kCalibrationSIMDIsX86	0
+#endif
+
+#if kCalibrationSIMDIsX86
+
+__attribute__((target("sse2")))
+static inline void
+calculateLinearConfigurationOutputBatchSSE2(double k1, double k2, const double *  Aout, const double *  Vdd, double *  Pa, size_t numberOfSamples)
+{
+	const __m128d	vK1 = _mm_set1_pd(k1);
+	const __m128d	vK2 = _mm_set1_pd(k2);
+	size_t		i = 0;
+
+	for (; i + 2 <= numberOfSamples; i += 2)
+	{
+		__m128d	vAout = _mm_loadu_pd(&Aout[i]);
+		__m128d	vVdd = _mm_loadu_pd(&Vdd[i]);
+
+		_mm_storeu_pd(&Pa[i], _mm_sub_pd(_mm_div_pd(_mm_mul_pd(vK1, vAout), vVdd), vK2));
+	}
+
+	for (; i < numberOfSamples; i++)
+	{
+		Pa[i] = calculateLinearConfigurationOutput(Aout[i], Vdd[i], k1, k2);
+	}
+
+	return;
+}
+
+__attribute__((target("sse2")))
+static inline void
+calculateSquareRootConfigurationOutputBatchSSE2(
+	double		k1,
+	double		k2,
+	double		k3,
+	double		k4,
+	const double *	Aout,
+	const double *	Vdd,
+	double *	Pa,
+	size_t		numberOfSamples)
+{
+	const __m128d	vK1 = _mm_set1_pd(k1);
+	const __m128d	vK2 = _mm_set1_pd(k2);
+	const __m128d	vK3 = _mm_set1_pd(k3);
+	const __m128d	vK4 = _mm_set1_pd(k4);
+	const __m128d	vSignBit = _mm_set1_pd(-0.0);
+	size_t		i = 0;
+
+	for (; i + 2 <= numberOfSamples; i += 2)
+	{
+		__m128d	vAout = _mm_loadu_pd(&Aout[i]);
+		__m128d	vVdd = _mm_loadu_pd(&Vdd[i]);
+		__m128d	vRatio = _mm_div_pd(vAout, vVdd);
+		__m128d	vScaled = _mm_sub_pd(_mm_div_pd(vAout, _mm_mul_pd(vVdd, vK2)), vK3);
+		__m128d	vMagnitude = _mm_mul_pd(_mm_mul_pd(vScaled, vScaled), vK4);
+		__m128d	vIsPositive = _mm_cmpgt_pd(vRatio, vK1);
+		__m128d	vIsNegative = _mm_cmplt_pd(vRatio, vK1);
+		__m128d	vIsUnordered = _mm_cmpunord_pd(vRatio, vK1);
+		__m128d	vResult;
+
+		vResult = _mm_or_pd(
+				_mm_and_pd(vIsPositive, vMagnitude),
+				_mm_and_pd(vIsNegative, _mm_xor_pd(vMagnitude, vSignBit)));
+		vResult = _mm_or_pd(vResult, _mm_and_pd(vIsUnordered, vRatio));
+
+		_mm_storeu_pd(&Pa[i], vResult);
+	}
+
+	for (; i < numberOfSamples; i++)
+	{
+		Pa[i] = calculateSquareRootConfigurationOutput(Aout[i], Vdd[i], k1, k2, k3, k4);
+	}
+
+	return;
+}
+
+__attribute__((target("avx2")))
+static inline void
+calculateLinearConfigurationOutputBatchAVX2(double k1, double k2, const double *  Aout, const double *  Vdd, double *  Pa, size_t numberOfSamples)
+{
+	const __m256d	vK1 = _mm256_set1_pd(k1);
+	const __m256d	vK2 = _mm256_set1_pd(k2);
+	size_t		i = 0;
+
+	for (; i + 4 <= numberOfSamples; i += 4)
+	{
+		__m256d	vAout = _mm256_loadu_pd(&Aout[i]);
+		__m256d	vVdd = _mm256_loadu_pd(&Vdd[i]);
+
+		_mm256_storeu_pd(&Pa[i], _mm256_sub_pd(_mm256_div_pd(_mm256_mul_pd(vK1, vAout), vVdd), vK2));
+	}
+
+	for (; i < numberOfSamples; i++)
+	{
+		Pa[i] = calculateLinearConfigurationOutput(Aout[i], Vdd[i], k1, k2);
+	}
+
+	return;
+}
+
+__attribute__((target("avx2")))
+static inline void
+calculateSquareRootConfigurationOutputBatchAVX2(
+	double		k1,
+	double		k2,
+	double		k3,
+	double		k4,
+	const double *	Aout,
+	const double *	Vdd,
+	double *	Pa,
+	size_t		numberOfSamples)
+{
+	const __m256d	vK1 = _mm256_set1_pd(k1);
+	const __m256d	vK2 = _mm256_set1_pd(k2);
+	const __m256d	vK3 = _mm256_set1_pd(k3);
+	const __m256d	vK4 = _mm256_set1_pd(k4);
+	const __m256d	vSignBit = _mm256_set1_pd(-0.0);
+	size_t		i = 0;
+
+	for (; i + 4 <= numberOfSamples; i += 4)
+	{
+		__m256d	vAout = _mm256_loadu_pd(&Aout[i]);
+		__m256d	vVdd = _mm256_loadu_pd(&Vdd[i]);
+		__m256d	vRatio = _mm256_div_pd(vAout, vVdd);
+		__m256d	vScaled = _mm256_sub_pd(_mm256_div_pd(vAout, _mm256_mul_pd(vVdd, vK2)), vK3);
+		__m256d	vMagnitude = _mm256_mul_pd(_mm256_mul_pd(vScaled, vScaled), vK4);
+		__m256d	vIsPositive = _mm256_cmp_pd(vRatio, vK1, _CMP_GT_OQ);
+		__m256d	vIsNegative = _mm256_cmp_pd(vRatio, vK1, _CMP_LT_OQ);
+		__m256d	vIsUnordered = _mm256_cmp_pd(vRatio, vK1, _CMP_UNORD_Q);
+		__m256d	vResult;
+
+		vResult = _mm256_or_pd(
+				_mm256_and_pd(vIsPositive, vMagnitude),
+				_mm256_and_pd(vIsNegative, _mm256_xor_pd(vMagnitude, vSignBit)));
+		vResult = _mm256_or_pd(vResult, _mm256_and_pd(vIsUnordered, vRatio));
+
+		_mm256_storeu_pd(&Pa[i], vResult);
+	}
+
+	for (; i < numberOfSamples; i++)
+	{
+		Pa[i] = calculateSquareRootConfigurationOutput(Aout[i], Vdd[i], k1, k2, k3, k4);
+	}
+
+	return;
+}
+
+__attribute__((target("avx512f")))
+static inline void
+calculateLinearConfigurationOutputBatchAVX512(double k1, double k2, const double *  Aout, const double *  Vdd, double *  Pa, size_t numberOfSamples)
+{
+	const __m512d	vK1 = _mm512_set1_pd(k1);
+	const __m512d	vK2 = _mm512_set1_pd(k2);
+	size_t		i = 0;
+
+	for (; i + 8 <= numberOfSamples; i += 8)
+	{
+		__m512d	vAout = _mm512_loadu_pd(&Aout[i]);
+		__m512d	vVdd = _mm512_loadu_pd(&Vdd[i]);
+
+		_mm512_storeu_pd(&Pa[i], _mm512_sub_pd(_mm512_div_pd(_mm512_mul_pd(vK1, vAout), vVdd), vK2));
+	}
+
+	for (; i < numberOfSamples; i++)
+	{
+		Pa[i] = calculateLinearConfigurationOutput(Aout[i], Vdd[i], k1, k2);
+	}
+
+	return;
+}
+
+__attribute__((target("avx512f")))
+static inline void
+calculateSquareRootConfigurationOutputBatchAVX512(
+	double		k1,
+	double		k2,
+	double		k3,
+	double		k4,
+	const double *	Aout,
+	const double *	Vdd,
+	double *	Pa,
+	size_t		numberOfSamples)
+{
+	const __m512d	vK1 = _mm512_set1_pd(k1);
+	const __m512d	vK2 = _mm512_set1_pd(k2);
+	const __m512d	vK3 = _mm512_set1_pd(k3);
+	const __m512d	vK4 = _mm512_set1_pd(k4);
+	const __m512i	vSignBit = _mm512_set1_epi64((long long) 0x8000000000000000ULL);
+	size_t		i = 0;
+
+	for (; i + 8 <= numberOfSamples; i += 8)
+	{
+		__m512d		vAout = _mm512_loadu_pd(&Aout[i]);
+		__m512d		vVdd = _mm512_loadu_pd(&Vdd[i]);
+		__m512d		vRatio = _mm512_div_pd(vAout, vVdd);
+		__m512d		vScaled = _mm512_sub_pd(_mm512_div_pd(vAout, _mm512_mul_pd(vVdd, vK2)), vK3);
+		__m512d		vMagnitude = _mm512_mul_pd(_mm512_mul_pd(vScaled, vScaled), vK4);
+		__m512d		vNegatedMagnitude = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(vMagnitude), vSignBit));
+		__mmask8	isPositive = _mm512_cmp_pd_mask(vRatio, vK1, _CMP_GT_OQ);
+		__mmask8	isNegative = _mm512_cmp_pd_mask(vRatio, vK1, _CMP_LT_OQ);
+		__mmask8	isUnordered = _mm512_cmp_pd_mask(vRatio, vK1, _CMP_UNORD_Q);
+		__m512d		vResult = _mm512_setzero_pd();
+
+		vResult = _mm512_mask_mov_pd(vResult, isPositive, vMagnitude);
+		vResult = _mm512_mask_mov_pd(vResult, isNegative, vNegatedMagnitude);
+		vResult = _mm512_mask_mov_pd(vResult, isUnordered, vRatio);
+
+		_mm512_storeu_pd(&Pa[i], vResult);
+	}
+
+	for (; i < numberOfSamples; i++)
+	{
+		Pa[i] = calculateSquareRootConfigurationOutput(Aout[i], Vdd[i], k1, k2, k3, k4);
+	}
+
+	return;
+}
+
+/*
+ *	Vectorized inverse calibration kernels. As for the forward kernels, they
+ *	perform the same sequence of IEEE-754 operations as the scalar inverse
+ *	routines in `calibration-kernels.h` (`fabs()` and `copysign()` are bit
+ *	operations, and `sqrt()` is correctly rounded), so their results are
+ *	expected to be bit-identical.
+ */
+__attribute__((target("sse2")))
+static inline void
+calculateLinearConfigurationInverseOutputBatchSSE2(double k1, double k2, const double *  Pa, const double *  Vdd, double *  Aout, size_t numberOfSamples)
+{
+	const __m128d	vK1 = _mm_set1_pd(k1);
+	const __m128d	vK2 = _mm_set1_pd(k2);
+	size_t		i = 0;
+
+	for (; i + 2 <= numberOfSamples; i += 2)
+	{
+		__m128d	vPa = _mm_loadu_pd(&Pa[i]);
+		__m128d	vVdd = _mm_loadu_pd(&Vdd[i]);
+
+		_mm_storeu_pd(&Aout[i], _mm_mul_pd(_mm_div_pd(_mm_add_pd(vPa, vK2), vK1), vVdd));
+	}
+
+	for (; i < numberOfSamples; i++)
+	{
+		Aout[i] = calculateLinearConfigurationInverseOutput(Pa[i], Vdd[i], k1, k2);
+	}
+
+	return;
+}
+
+__attribute__((target("sse2")))
+static inline void
+calculateSquareRootConfigurationInverseOutputBatchSSE2(
+	double		k2,
+	double		k3,
+	double		k4,
+	const double *	Pa,
+	const double *	Vdd,
+	double *	Aout,
+	size_t		numberOfSamples)
+{
+	const __m128d	vK2 = _mm_set1_pd(k2);
+	const __m128d	vK3 = _mm_set1_pd(k3);
+	const __m128d	vK4 = _mm_set1_pd(k4);
+	const __m128d	vSignBit = _mm_set1_pd(-0.0);
+	size_t		i = 0;
+
+	for (; i + 2 <= numberOfSamples; i += 2)
+	{
+		__m128d	vPa = _mm_loadu_pd(&Pa[i]);
+		__m128d	vVdd = _mm_loadu_pd(&Vdd[i]);
+		__m128d	vMagnitude = _mm_sqrt_pd(_mm_div_pd(_mm_andnot_pd(vSignBit, vPa), vK4));
+		__m128d	vScaled = _mm_or_pd(vMagnitude, _mm_and_pd(vSignBit, vPa));
+
+		_mm_storeu_pd(&Aout[i], _mm_mul_pd(_mm_mul_pd(_mm_add_pd(vScaled, vK3), vK2), vVdd));
+	}
+
+	for (; i < numberOfSamples; i++)
+	{
+		Aout[i] = calculateSquareRootConfigurationInverseOutput(Pa[i], Vdd[i], k2, k3, k4);
+	}
+
+	return;
+}
+
+__attribute__((target("avx2")))
+static inline void
+calculateLinearConfigurationInverseOutputBatchAVX2(double k1, double k2, const double *  Pa, const double *  Vdd, double *  Aout, size_t numberOfSamples)
+{
+	const __m256d	vK1 = _mm256_set1_pd(k1);
+	const __m256d	vK2 = _mm256_set1_pd(k2);
+	size_t		i = 0;
+
+	for (; i + 4 <= numberOfSamples; i += 4)
+	{
+		__m256d	vPa = _mm256_loadu_pd(&Pa[i]);
+		__m256d	vVdd = _mm256_loadu_pd(&Vdd[i]);
+
+		_mm256_storeu_pd(&Aout[i], _mm256_mul_pd(_mm256_div_pd(_mm256_add_pd(vPa, vK2), vK1), vVdd));
+	}
+
+	for (; i < numberOfSamples; i++)
+	{
+		Aout[i] = calculateLinearConfigurationInverseOutput(Pa[i], Vdd[i], k1, k2);
+	}
+
+	return;
+}
+
+__attribute__((target("avx2")))
+static inline void
+calculateSquareRootConfigurationInverseOutputBatchAVX2(
+	double		k2,
+	double		k3,
+	double		k4,
+	const double *	Pa,
+	const double *	Vdd,
+	double *	Aout,
+	size_t		numberOfSamples)
+{
+	const __m256d	vK2 = _mm256_set1_pd(k2);
+	const __m256d	vK3 = _mm256_set1_pd(k3);
+	const __m256d	vK4 = _mm256_set1_pd(k4);
+	const __m256d	vSignBit = _mm256_set1_pd(-0.0);
+	size_t		i = 0;
+
+	for (; i + 4 <= numberOfSamples; i += 4)
+	{
+		__m256d	vPa = _mm256_loadu_pd(&Pa[i]);
+		__m256d	vVdd = _mm256_loadu_pd(&Vdd[i]);
+		__m256d	vMagnitude = _mm256_sqrt_pd(_mm256_div_pd(_mm256_andnot_pd(vSignBit, vPa), vK4));
+		__m256d	vScaled = _mm256_or_pd(vMagnitude, _mm256_and_pd(vSignBit, vPa));
+
+		_mm256_storeu_pd(&Aout[i], _mm256_mul_pd(_mm256_mul_pd(_mm256_add_pd(vScaled, vK3), vK2), vVdd));
+	}
+
+	for (; i < numberOfSamples; i++)
+	{
+		Aout[i] = calculateSquareRootConfigurationInverseOutput(Pa[i], Vdd[i], k2, k3, k4);
+	}
+
+	return;
+}
+
+__attribute__((target("avx512f")))
+static inline void
+calculateLinearConfigurationInverseOutputBatchAVX512(double k1, double k2, const double *  Pa, const double *  Vdd, double *  Aout, size_t numberOfSamples)
+{
+	const __m512d	vK1 = _mm512_set1_pd(k1);
+	const __m512d	vK2 = _mm512_set1_pd(k2);
+	size_t		i = 0;
+
+	for (; i + 8 <= numberOfSamples; i += 8)
+	{
+		__m512d	vPa = _mm512_loadu_pd(&Pa[i]);
+		__m512d	vVdd = _mm512_loadu_pd(&Vdd[i]);
+
+		_mm512_storeu_pd(&Aout[i], _mm512_mul_pd(_mm512_div_pd(_mm512_add_pd(vPa, vK2), vK1), vVdd));
+	}
+
+	for (; i < numberOfSamples; i++)
+	{
+		Aout[i] = calculateLinearConfigurationInverseOutput(Pa[i], Vdd[i], k1, k2);
+	}
+
+	return;
+}
+
+__attribute__((target("avx512f")))
+static inline void
+calculateSquareRootConfigurationInverseOutputBatchAVX512(
+	double		k2,
+	double		k3,
+	double		k4,
+	const double *	Pa,
+	const double *	Vdd,
+	double *	Aout,
+	size_t		numberOfSamples)
+{
+	const __m512d	vK2 = _mm512_set1_pd(k2);
+	const __m512d	vK3 = _mm512_set1_pd(k3);
+	const __m512d	vK4 = _mm512_set1_pd(k4);
+	const __m512i	vSignBit = _mm512_set1_epi64((long long) 0x8000000000000000ULL);
+	size_t		i = 0;
+
+	for (; i + 8 <= numberOfSamples; i += 8)
+	{
+		__m512d	vPa = _mm512_loadu_pd(&Pa[i]);
+		__m512d	vVdd = _mm512_loadu_pd(&Vdd[i]);
+		__m512i	vPaBits = _mm512_castpd_si512(vPa);
+		__m512d	vMagnitude = _mm512_sqrt_pd(_mm512_div_pd(_mm512_castsi512_pd(_mm512_andnot_si512(vSignBit, vPaBits)), vK4));
+		__m512d	vScaled = _mm512_castsi512_pd(
+					_mm512_or_si512(
+						_mm512_castpd_si512(vMagnitude),
+						_mm512_and_si512(vSignBit, vPaBits)));
+
+		_mm512_storeu_pd(&Aout[i], _mm512_mul_pd(_mm512_mul_pd(_mm512_add_pd(vScaled, vK3), vK2), vVdd));
+	}
+
+	for (; i < numberOfSamples; i++)
+	{
+		Aout[i] = calculateSquareRootConfigurationInverseOutput(Pa[i], Vdd[i], k2, k3, k4);
+	}
+
+	return;
+}
+
+/*
+ *	Generate the specialized batch kernels of a variant for one instruction set,
+ *	with the calibration constants of the variant folded in at compile time.
+ */
+#define DEFINE_LINEAR_CONFIGURATION_BATCH_KERNEL(variantName, isa, targetName, k1, k2)			\
+	__attribute__((target(targetName)))								\
+	static void											\
+	calculate##variantName##OutputBatch##isa(const double *  Aout, const double *  Vdd, double *  Pa, size_t numberOfSamples)	\
+	{												\
+		calculateLinearConfigurationOutputBatch##isa((k1), (k2), Aout, Vdd, Pa, numberOfSamples);\
+	}
+
+#define DEFINE_SQUARE_ROOT_CONFIGURATION_BATCH_KERNEL(variantName, isa, targetName, k1, k2, k3, k4)		\
+	__attribute__((target(targetName)))								\
+	static void											\
+	calculate##variantName##OutputBatch##isa(const double *  Aout, const double *  Vdd, double *  Pa, size_t numberOfSamples)	\
+	{												\
+		calculateSquareRootConfigurationOutputBatch##isa((k1), (k2), (k3), (k4), Aout, Vdd, Pa, numberOfSamples);\
+	}
+
+#define DEFINE_LINEAR_CONFIGURATION_INVERSE_BATCH_KERNEL(variantName, isa, targetName, k1, k2)		\
+	__attribute__((target(targetName)))								\
+	static void											\
+	calculate##variantName##InverseOutputBatch##isa(const double *  Pa, const double *  Vdd, double *  Aout, size_t numberOfSamples)	\
+	{												\
+		calculateLinearConfigurationInverseOutputBatch##isa((k1), (k2), Pa, Vdd, Aout, numberOfSamples);\
+	}
+
+#define DEFINE_SQUARE_ROOT_CONFIGURATION_INVERSE_BATCH_KERNEL(variantName, isa, targetName, k2, k3, k4)	\
+	__attribute__((target(targetName)))								\
+	static void											\
+	calculate##variantName##InverseOutputBatch##isa(const double *  Pa, const double *  Vdd, double *  Aout, size_t numberOfSamples)	\
+	{												\
+		calculateSquareRootConfigurationInverseOutputBatch##isa((k2), (k3), (k4), Pa, Vdd, Aout, numberOfSamples);\
+	}
+
+#define DEFINE_BATCH_KERNELS(isa, targetName)								\
+	DEFINE_LINEAR_CONFIGURATION_BATCH_KERNEL(							\
+		SDP8x6Linear500Pa,									\
+		isa,											\
+		targetName,										\
+		kSensorCalibrationConstantSDP8x6Linear500Pa1,						\
+		kSensorCalibrationConstantSDP8x6Linear500Pa2)						\
+	DEFINE_LINEAR_CONFIGURATION_BATCH_KERNEL(							\
+		SDP8x6Linear125Pa,									\
+		isa,											\
+		targetName,										\
+		kSensorCalibrationConstantSDP8x6Linear125Pa1,						\
+		kSensorCalibrationConstantSDP8x6Linear125Pa2)						\
+	DEFINE_SQUARE_ROOT_CONFIGURATION_BATCH_KERNEL(							\
+		SDP8x6Sqrt500Pa,									\
+		isa,											\
+		targetName,										\
+		kSensorCalibrationConstantSDP8x6Sqrt500Pa1,						\
+		kSensorCalibrationConstantSDP8x6Sqrt500Pa2,						\
+		kSensorCalibrationConstantSDP8x6Sqrt500Pa3,						\
+		kSensorCalibrationConstantSDP8x6Sqrt500Pa4)						\
+	DEFINE_SQUARE_ROOT_CONFIGURATION_BATCH_KERNEL(							\
+		SDP8x6Sqrt125Pa,									\
+		isa,											\
+		targetName,										\
+		kSensorCalibrationConstantSDP8x6Sqrt125Pa1,						\
+		kSensorCalibrationConstantSDP8x6Sqrt125Pa2,						\
+		kSensorCalibrationConstantSDP8x6Sqrt125Pa3,						\
+		kSensorCalibrationConstantSDP8x6Sqrt125Pa4)						\
+	DEFINE_LINEAR_CONFIGURATION_INVERSE_BATCH_KERNEL(						\
+		SDP8x6Linear500Pa,									\
+		isa,											\
+		targetName,										\
+		kSensorCalibrationConstantSDP8x6Linear500Pa1,						\
+		kSensorCalibrationConstantSDP8x6Linear500Pa2)						\
+	DEFINE_LINEAR_CONFIGURATION_INVERSE_BATCH_KERNEL(						\
+		SDP8x6Linear125Pa,									\
+		isa,											\
+		targetName,										\
+		kSensorCalibrationConstantSDP8x6Linear125Pa1,						\
+		kSensorCalibrationConstantSDP8x6Linear125Pa2)						\
+	DEFINE_SQUARE_ROOT_CONFIGURATION_INVERSE_BATCH_KERNEL(						\
+		SDP8x6Sqrt500Pa,									\
+		isa,											\
+		targetName,										\
+		kSensorCalibrationConstantSDP8x6Sqrt500Pa2,						\
+		kSensorCalibrationConstantSDP8x6Sqrt500Pa3,						\
+		kSensorCalibrationConstantSDP8x6Sqrt500Pa4)						\
+	DEFINE_SQUARE_ROOT_CONFIGURATION_INVERSE_BATCH_KERNEL(						\
+		SDP8x6Sqrt125Pa,									\
+		isa,											\
+		targetName,										\
+		kSensorCalibrationConstantSDP8x6Sqrt125Pa2,						\
+		kSensorCalibrationConstantSDP8x6Sqrt125Pa3,						\
+		kSensorCalibrationConstantSDP8x6Sqrt125Pa4)
+
+DEFINE_BATCH_KERNELS(SSE2, "sse2")
+DEFINE_BATCH_KERNELS(AVX2, "avx2")
+DEFINE_BATCH_KERNELS(AVX512, "avx512f")
+
+/*
+ *	Dispatch table of the specialized batch kernels, indexed by the vectorized
+ *	`CalibrationKernelImplementation` (starting from `kCalibrationKernelImplementationSSE2`)
+ *	and by `OutputDistributionIndex`.
+ */
+static const CalibrationBatchFunction	vectorizedCalibrationBatchFunctions[kCalibrationKernelImplementationMax - kCalibrationKernelImplementationSSE2][kOutputDistributionIndexCalibratedSensorOutputMax] =
+					{
+						{
+							calculateSDP8x6Linear500PaOutputBatchSSE2,
+							calculateSDP8x6Linear125PaOutputBatchSSE2,
+							calculateSDP8x6Sqrt500PaOutputBatchSSE2,
+							calculateSDP8x6Sqrt125PaOutputBatchSSE2,
+						},
+						{
+							calculateSDP8x6Linear500PaOutputBatchAVX2,
+							calculateSDP8x6Linear125PaOutputBatchAVX2,
+							calculateSDP8x6Sqrt500PaOutputBatchAVX2,
+							calculateSDP8x6Sqrt125PaOutputBatchAVX2,
+						},
+						{
+							calculateSDP8x6Linear500PaOutputBatchAVX512,
+							calculateSDP8x6Linear125PaOutputBatchAVX512,
+							calculateSDP8x6Sqrt500PaOutputBatchAVX512,
+							calculateSDP8x6Sqrt125PaOutputBatchAVX512,
+						},
+					};
+
+/*
+ *	Dispatch table of the specialized inverse batch kernels, indexed like
+ *	`vectorizedCalibrationBatchFunctions`.
+ */
+static const InverseCalibrationBatchFunction	vectorizedInverseCalibrationBatchFunctions[kCalibrationKernelImplementationMax - kCalibrationKernelImplementationSSE2][kOutputDistributionIndexCalibratedSensorOutputMax] =
+						{
+							{
+								calculateSDP8x6Linear500PaInverseOutputBatchSSE2,
+								calculateSDP8x6Linear125PaInverseOutputBatchSSE2,
+								calculateSDP8x6Sqrt500PaInverseOutputBatchSSE2,
+								calculateSDP8x6Sqrt125PaInverseOutputBatchSSE2,
+							},
+							{
+								calculateSDP8x6Linear500PaInverseOutputBatchAVX2,
+								calculateSDP8x6Linear125PaInverseOutputBatchAVX2,
+								calculateSDP8x6Sqrt500PaInverseOutputBatchAVX2,
+								calculateSDP8x6Sqrt125PaInverseOutputBatchAVX2,
+							},
+							{
+								calculateSDP8x6Linear500PaInverseOutputBatchAVX512,
+								calculateSDP8x6Linear125PaInverseOutputBatchAVX512,
+								calculateSDP8x6Sqrt500PaInverseOutputBatchAVX512,
+								calculateSDP8x6Sqrt125PaInverseOutputBatchAVX512,
+							},
+						};
+
+#endif /* kCalibrationSIMDIsX86 */
+
+bool
+isCalibrationKernelImplementationSupported(CalibrationKernelImplementation implementation)
+{
+	switch (implementation)
+	{
+		case kCalibrationKernelImplementationScalar:
+		case kCalibrationKernelImplementationScalarBranchFree:
+			return true;
+#if kCalibrationSIMDIsX86
+		case kCalibrationKernelImplementationSSE2:
+			return __builtin_cpu_supports("sse2");
+
+		case kCalibrationKernelImplementationAVX2:
+			return __builtin_cpu_supports("avx2");
+
+		case kCalibrationKernelImplementationAVX512:
+			return __builtin_cpu_supports("avx512f");
+#endif
+		default:
+			return false;
+	}
+}
+
+CalibrationBatchFunction
+getVectorizedCalibrationBatchFunction(CalibrationKernelImplementation implementation, OutputDistributionIndex variant)
+{
+#if kCalibrationSIMDIsX86
+	if ((implementation >= kCalibrationKernelImplementationSSE2) &&
+		(implementation < kCalibrationKernelImplementationMax) &&
+		(variant < kOutputDistributionIndexCalibratedSensorOutputMax))
+	{
+		return vectorizedCalibrationBatchFunctions[implementation - kCalibrationKernelImplementationSSE2][variant];
+	}
+#else
+	(void) implementation;
+	(void) variant;
+#endif
+
+	return NULL;
+}
+
+InverseCalibrationBatchFunction
+getVectorizedInverseCalibrationBatchFunction(CalibrationKernelImplementation implementation, OutputDistributionIndex variant)
+{
+#if kCalibrationSIMDIsX86
+	if ((implementation >= kCalibrationKernelImplementationSSE2) &&
+		(implementation < kCalibrationKernelImplementationMax) &&
+		(variant < kOutputDistributionIndexCalibratedSensorOutputMax))
+	{
+		return vectorizedInverseCalibrationBatchFunctions[implementation - kCalibrationKernelImplementationSSE2][variant];
+	}
+#else
+	(void) implementation;
+	(void) variant;
+#endif
+
+	return NULL;
+}
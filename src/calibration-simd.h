@@ -0,0 +1,60 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "calibration.h"
+#include "calibration-inverse.h"
+
+/**
+ *	@brief  Checks whether the running CPU supports a calibration kernel implementation.
+ *		The scalar implementation is always supported.
+ *
+ *	@param  implementation	: The calibration kernel implementation to check.
+ *	@return bool		: `true` if the implementation can be used on this CPU, else `false`.
+ */
+bool	isCalibrationKernelImplementationSupported(CalibrationKernelImplementation implementation);
+
+/**
+ *	@brief  Returns the specialized batch kernel of a vectorized calibration kernel implementation
+ *		for a single SDP8x6 variant. The kernels calibrate the tail of a batch (which does
+ *		not fill a whole vector) with the scalar reference.
+ *
+ *	@param  implementation			: The vectorized calibration kernel implementation.
+ *	@param  variant				: The sensor variant / configuration to calibrate for.
+ *	@return CalibrationBatchFunction	: The batch kernel, or `NULL` if the implementation is not
+ *						  vectorized or not available on this platform.
+ */
+CalibrationBatchFunction	getVectorizedCalibrationBatchFunction(CalibrationKernelImplementation implementation, OutputDistributionIndex variant);
+
+/**
+ *	@brief  Returns the specialized inverse batch kernel of a vectorized calibration kernel
+ *		implementation for a single SDP8x6 variant.
+ *
+ *	@param  implementation				: The vectorized calibration kernel implementation.
+ *	@param  variant					: The sensor variant / configuration.
+ *	@return InverseCalibrationBatchFunction		: The inverse batch kernel, or `NULL` if the implementation is
+ *							  not vectorized or not available on this platform.
+ */
+InverseCalibrationBatchFunction	getVectorizedInverseCalibrationBatchFunction(CalibrationKernelImplementation implementation, OutputDistributionIndex variant);
@@ -0,0 +1,741 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+#include "calibration.h"
+#include "calibration-kernels.h"
+#include "calibration-simd.h"
+
+/*
+ *	The calibration kernel implementation used by `calculateCalibratedSensorOutputBatch()`.
+ *	`kCalibrationKernelImplementationMax` means that it has not been selected yet.
+ */
+static CalibrationKernelImplementation	selectedCalibrationKernelImplementation = kCalibrationKernelImplementationMax;
+
+/*
+ *	Generate the specialized scalar kernels of a variant. The calibration
+ *	constants are passed as compile-time constants to the `static inline`
+ *	routines of `calibration-kernels.h`, so the compiler folds them into
+ *	each kernel. Apart from the folding, the kernels perform the same
+ *	operations as the reference routines, so their results are identical.
+ */
+#define DEFINE_LINEAR_CONFIGURATION_KERNELS(variantName, k1, k2)						\
+	static double												\
+	calculate##variantName##Output(double Aout, double Vdd)							\
+	{													\
+		return calculateLinearConfigurationOutput(Aout, Vdd, (k1), (k2));				\
+	}													\
+														\
+	static void												\
+	calculate##variantName##OutputBatch(const double *  Aout, const double *  Vdd, double *  Pa, size_t numberOfSamples)	\
+	{													\
+		for (size_t i = 0; i < numberOfSamples; i++)							\
+		{												\
+			Pa[i] = calculateLinearConfigurationOutput(Aout[i], Vdd[i], (k1), (k2));		\
+		}												\
+	}													\
+														\
+	static void												\
+	calculate##variantName##OutputBatchFloat(const float *  Aout, const float *  Vdd, float *  Pa, size_t numberOfSamples)	\
+	{													\
+		for (size_t i = 0; i < numberOfSamples; i++)							\
+		{												\
+			Pa[i] = calculateLinearConfigurationOutputFloat(Aout[i], Vdd[i], (float)(k1), (float)(k2));	\
+		}												\
+	}
+
+#define DEFINE_SQUARE_ROOT_CONFIGURATION_KERNELS(variantName, k1, k2, k3, k4)					\
+	static double												\
+	calculate##variantName##Output(double Aout, double Vdd)							\
+	{													\
+		return calculateSquareRootConfigurationOutput(Aout, Vdd, (k1), (k2), (k3), (k4));		\
+	}													\
+														\
+	static void												\
+	calculate##variantName##OutputBatch(const double *  Aout, const double *  Vdd, double *  Pa, size_t numberOfSamples)	\
+	{													\
+		for (size_t i = 0; i < numberOfSamples; i++)							\
+		{												\
+			Pa[i] = calculateSquareRootConfigurationOutput(Aout[i], Vdd[i], (k1), (k2), (k3), (k4));	\
+		}												\
+	}													\
+														\
+	static void												\
+	calculate##variantName##OutputBatchBranchFree(const double *  Aout, const double *  Vdd, double *  Pa, size_t numberOfSamples)	\
+	{													\
+		for (size_t i = 0; i < numberOfSamples; i++)							\
+		{												\
+			Pa[i] = calculateSquareRootConfigurationOutputBranchFree(Aout[i], Vdd[i], (k1), (k2), (k3), (k4));	\
+		}												\
+	}													\
+														\
+	static void												\
+	calculate##variantName##OutputBatchFloat(const float *  Aout, const float *  Vdd, float *  Pa, size_t numberOfSamples)	\
+	{													\
+		for (size_t i = 0; i < numberOfSamples; i++)							\
+		{												\
+			Pa[i] = calculateSquareRootConfigurationOutputFloat(					\
+					Aout[i],								\
+					Vdd[i],									\
+					(float)(k1),								\
+					(float)(k2),								\
+					(float)(k3),								\
+					(float)(k4));								\
+		}												\
+	}
+
+DEFINE_LINEAR_CONFIGURATION_KERNELS(
+	SDP8x6Linear500Pa,
+	kSensorCalibrationConstantSDP8x6Linear500Pa1,
+	kSensorCalibrationConstantSDP8x6Linear500Pa2)
+
+DEFINE_LINEAR_CONFIGURATION_KERNELS(
+	SDP8x6Linear125Pa,
+	kSensorCalibrationConstantSDP8x6Linear125Pa1,
+	kSensorCalibrationConstantSDP8x6Linear125Pa2)
+
+DEFINE_SQUARE_ROOT_CONFIGURATION_KERNELS(
+	SDP8x6Sqrt500Pa,
+	kSensorCalibrationConstantSDP8x6Sqrt500Pa1,
+	kSensorCalibrationConstantSDP8x6Sqrt500Pa2,
+	kSensorCalibrationConstantSDP8x6Sqrt500Pa3,
+	kSensorCalibrationConstantSDP8x6Sqrt500Pa4)
+
+DEFINE_SQUARE_ROOT_CONFIGURATION_KERNELS(
+	SDP8x6Sqrt125Pa,
+	kSensorCalibrationConstantSDP8x6Sqrt125Pa1,
+	kSensorCalibrationConstantSDP8x6Sqrt125Pa2,
+	kSensorCalibrationConstantSDP8x6Sqrt125Pa3,
+	kSensorCalibrationConstantSDP8x6Sqrt125Pa4)
+
+/*
+ *	Dispatch tables of the specialized scalar kernels, indexed by `OutputDistributionIndex`.
+ *	The linear configurations have no branches, so their branch-free kernels are the
+ *	reference kernels.
+ */
+static const CalibrationFunction	calibrationFunctions[kOutputDistributionIndexCalibratedSensorOutputMax] =
+					{
+						calculateSDP8x6Linear500PaOutput,
+						calculateSDP8x6Linear125PaOutput,
+						calculateSDP8x6Sqrt500PaOutput,
+						calculateSDP8x6Sqrt125PaOutput,
+					};
+
+static const CalibrationBatchFunction	scalarCalibrationBatchFunctions[kOutputDistributionIndexCalibratedSensorOutputMax] =
+					{
+						calculateSDP8x6Linear500PaOutputBatch,
+						calculateSDP8x6Linear125PaOutputBatch,
+						calculateSDP8x6Sqrt500PaOutputBatch,
+						calculateSDP8x6Sqrt125PaOutputBatch,
+					};
+
+static const CalibrationBatchFunction	scalarBranchFreeCalibrationBatchFunctions[kOutputDistributionIndexCalibratedSensorOutputMax] =
+					{
+						calculateSDP8x6Linear500PaOutputBatch,
+						calculateSDP8x6Linear125PaOutputBatch,
+						calculateSDP8x6Sqrt500PaOutputBatchBranchFree,
+						calculateSDP8x6Sqrt125PaOutputBatchBranchFree,
+					};
+
+static const CalibrationBatchFunctionFloat	calibrationBatchFunctionsFloat[kOutputDistributionIndexCalibratedSensorOutputMax] =
+						{
+							calculateSDP8x6Linear500PaOutputBatchFloat,
+							calculateSDP8x6Linear125PaOutputBatchFloat,
+							calculateSDP8x6Sqrt500PaOutputBatchFloat,
+							calculateSDP8x6Sqrt125PaOutputBatchFloat,
+						};
+
+
+CalibrationFunction
+getCalibrationFunction(OutputDistributionIndex variant)
+{
+	if (variant >= kOutputDistributionIndexCalibratedSensorOutputMax)
+	{
+		return NULL;
+	}
+
+	return calibrationFunctions[variant];
+}
+
+CalibrationBatchFunction
+getCalibrationBatchFunction(CalibrationKernelImplementation implementation, OutputDistributionIndex variant)
+{
+	if (variant >= kOutputDistributionIndexCalibratedSensorOutputMax)
+	{
+		return NULL;
+	}
+
+	switch (implementation)
+	{
+		case kCalibrationKernelImplementationScalar:
+			return scalarCalibrationBatchFunctions[variant];
+
+		case kCalibrationKernelImplementationScalarBranchFree:
+			return scalarBranchFreeCalibrationBatchFunctions[variant];
+
+		default:
+			return getVectorizedCalibrationBatchFunction(implementation, variant);
+	}
+}
+
+CalibrationBatchFunctionFloat
+getCalibrationBatchFunctionFloat(OutputDistributionIndex variant)
+{
+	if (variant >= kOutputDistributionIndexCalibratedSensorOutputMax)
+	{
+		return NULL;
+	}
+
+	return calibrationBatchFunctionsFloat[variant];
+}
+
+double
+calculateCalibratedSensorOutput(OutputDistributionIndex variant, double Aout, double Vdd)
+{
+	CalibrationFunction	calibrationFunction = getCalibrationFunction(variant);
+
+	if (calibrationFunction == NULL)
+	{
+		return NAN;
+	}
+
+	return calibrationFunction(Aout, Vdd);
+}
+
+const char *
+getCalibrationKernelImplementationName(CalibrationKernelImplementation implementation)
+{
+	static const char *	names[kCalibrationKernelImplementationMax] =
+				{
+					"scalar",
+					"scalar-branch-free",
+					"sse2",
+					"avx2",
+					"avx512",
+				};
+
+	if (implementation >= kCalibrationKernelImplementationMax)
+	{
+		return "unknown";
+	}
+
+	return names[implementation];
+}
+
+CommonConstantReturnType
+parseCalibrationKernelImplementationName(const char *  name, CalibrationKernelImplementation *  implementation)
+{
+	for (CalibrationKernelImplementation i = 0; i < kCalibrationKernelImplementationMax; i++)
+	{
+		if (strcmp(name, getCalibrationKernelImplementationName(i)) == 0)
+		{
+			*implementation = i;
+
+			return kCommonConstantReturnTypeSuccess;
+		}
+	}
+
+	return kCommonConstantReturnTypeError;
+}
+
+CalibrationKernelImplementation
+getCalibrationKernelImplementation(void)
+{
+	if (selectedCalibrationKernelImplementation == kCalibrationKernelImplementationMax)
+	{
+		/*
+		 *	Pick the widest implementation the CPU supports. The scalar
+		 *	implementations are always supported.
+		 */
+		CalibrationKernelImplementation	implementation = kCalibrationKernelImplementationMax;
+
+		do
+		{
+			implementation--;
+		} while (!isCalibrationKernelImplementationSupported(implementation));
+
+		selectedCalibrationKernelImplementation = implementation;
+	}
+
+	return selectedCalibrationKernelImplementation;
+}
+
+CommonConstantReturnType
+setCalibrationKernelImplementation(CalibrationKernelImplementation implementation)
+{
+	if (!isCalibrationKernelImplementationSupported(implementation))
+	{
+		fprintf(
+			stderr,
+			"Error: Calibration kernel implementation \"%s\" is not supported on this CPU.\n",
+			getCalibrationKernelImplementationName(implementation));
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	selectedCalibrationKernelImplementation = implementation;
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+CommonConstantReturnType
+calculateCalibratedSensorOutputBatch(
+	OutputDistributionIndex	variant,
+	const double *		Aout,
+	const double *		Vdd,
+	double *		Pa,
+	size_t			numberOfSamples)
+{
+	return calculateCalibratedSensorOutputBatchWithImplementation(
+			getCalibrationKernelImplementation(),
+			variant,
+			Aout,
+			Vdd,
+			Pa,
+			numberOfSamples);
+}
+
+CommonConstantReturnType
+calculateCalibratedSensorOutputBatchWithImplementation(
+	CalibrationKernelImplementation	implementation,
+	OutputDistributionIndex		variant,
+	const double *			Aout,
+	const double *			Vdd,
+	double *			Pa,
+	size_t				numberOfSamples)
+{
+	if ((Aout == NULL) || (Vdd == NULL) || (Pa == NULL))
+	{
+		fprintf(stderr, "Error: Batch calibration arrays must not be NULL.\n");
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	CalibrationBatchFunction	calibrationBatchFunction = getCalibrationBatchFunction(implementation, variant);
+
+	if (calibrationBatchFunction == NULL)
+	{
+		fprintf(
+			stderr,
+			"Error: Invalid sensor variant or calibration kernel for batch calibration: Provided variant %d (max: %d), kernel \"%s\".\n",
+			variant,
+			kOutputDistributionIndexCalibratedSensorOutputMax - 1,
+			getCalibrationKernelImplementationName(implementation));
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	calibrationBatchFunction(Aout, Vdd, Pa, numberOfSamples);
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+void
+calculateCalibratedSensorOutputBatchAllVariants(
+	const double *		Aout,
+	const double *		Vdd,
+	double * const *	Pa,
+	size_t			numberOfSamples)
+{
+	double *	PaLinear500Pa = Pa[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear500Pa];
+	double *	PaLinear125Pa = Pa[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear125Pa];
+	double *	PaSqrt500Pa = Pa[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt500Pa];
+	double *	PaSqrt125Pa = Pa[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt125Pa];
+
+	for (size_t i = 0; i < numberOfSamples; i++)
+	{
+		double	ratio = Aout[i] / Vdd[i];
+
+		PaLinear500Pa[i] = calculateLinearConfigurationOutputFromRatio(
+					ratio,
+					kSensorCalibrationConstantSDP8x6Linear500Pa1,
+					kSensorCalibrationConstantSDP8x6Linear500Pa2);
+		PaLinear125Pa[i] = calculateLinearConfigurationOutputFromRatio(
+					ratio,
+					kSensorCalibrationConstantSDP8x6Linear125Pa1,
+					kSensorCalibrationConstantSDP8x6Linear125Pa2);
+		PaSqrt500Pa[i] = calculateSquareRootConfigurationOutputFromRatio(
+					ratio,
+					kSensorCalibrationConstantSDP8x6Sqrt500Pa1,
+					kSensorCalibrationConstantSDP8x6Sqrt500Pa2,
+					kSensorCalibrationConstantSDP8x6Sqrt500Pa3,
+					kSensorCalibrationConstantSDP8x6Sqrt500Pa4);
+		PaSqrt125Pa[i] = calculateSquareRootConfigurationOutputFromRatio(
+					ratio,
+					kSensorCalibrationConstantSDP8x6Sqrt125Pa1,
+					kSensorCalibrationConstantSDP8x6Sqrt125Pa2,
+					kSensorCalibrationConstantSDP8x6Sqrt125Pa3,
+					kSensorCalibrationConstantSDP8x6Sqrt125Pa4);
+	}
+
+	return;
+}
+
+void
+calculateCalibratedSensorOutputBatchAllVariantsFloat(
+	const float *		Aout,
+	const float *		Vdd,
+	float * const *		Pa,
+	size_t			numberOfSamples)
+{
+	float *	PaLinear500Pa = Pa[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear500Pa];
+	float *	PaLinear125Pa = Pa[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear125Pa];
+	float *	PaSqrt500Pa = Pa[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt500Pa];
+	float *	PaSqrt125Pa = Pa[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt125Pa];
+
+	for (size_t i = 0; i < numberOfSamples; i++)
+	{
+		float	ratio = Aout[i] / Vdd[i];
+
+		PaLinear500Pa[i] = calculateLinearConfigurationOutputFromRatioFloat(
+					ratio,
+					(float) kSensorCalibrationConstantSDP8x6Linear500Pa1,
+					(float) kSensorCalibrationConstantSDP8x6Linear500Pa2);
+		PaLinear125Pa[i] = calculateLinearConfigurationOutputFromRatioFloat(
+					ratio,
+					(float) kSensorCalibrationConstantSDP8x6Linear125Pa1,
+					(float) kSensorCalibrationConstantSDP8x6Linear125Pa2);
+		PaSqrt500Pa[i] = calculateSquareRootConfigurationOutputFromRatioFloat(
+					ratio,
+					(float) kSensorCalibrationConstantSDP8x6Sqrt500Pa1,
+					(float) kSensorCalibrationConstantSDP8x6Sqrt500Pa2,
+					(float) kSensorCalibrationConstantSDP8x6Sqrt500Pa3,
+					(float) kSensorCalibrationConstantSDP8x6Sqrt500Pa4);
+		PaSqrt125Pa[i] = calculateSquareRootConfigurationOutputFromRatioFloat(
+					ratio,
+					(float) kSensorCalibrationConstantSDP8x6Sqrt125Pa1,
+					(float) kSensorCalibrationConstantSDP8x6Sqrt125Pa2,
+					(float) kSensorCalibrationConstantSDP8x6Sqrt125Pa3,
+					(float) kSensorCalibrationConstantSDP8x6Sqrt125Pa4);
+	}
+
+	return;
+}
+
+/**
+ *	@brief  Maps a double to an integer such that adjacent doubles map to adjacent integers,
+ *		so that the ULP distance of two doubles is the difference of their mapped values.
+ *
+ *	@param  value	: The value to map.
+ *	@return int64_t	: The mapped value.
+ */
+static int64_t
+mapDoubleToOrderedInteger(double value)
+{
+	int64_t	bits;
+
+	memcpy(&bits, &value, sizeof(bits));
+
+	return (bits < 0) ? (INT64_MIN - bits) : bits;
+}
+
+uint64_t
+calculateUlpDistance(double a, double b)
+{
+	int64_t	orderedA = mapDoubleToOrderedInteger(a);
+	int64_t	orderedB = mapDoubleToOrderedInteger(b);
+
+	return (orderedA > orderedB) ? ((uint64_t)orderedA - (uint64_t)orderedB) : ((uint64_t)orderedB - (uint64_t)orderedA);
+}
+
+/**
+ *	@brief  Fills the inputs of the calibration kernel self-test: sweeps the ratio Aout/Vdd over
+ *		[0, 1] (which includes the sign change of the square root configurations at exactly
+ *		0.5) for supply voltages across the default input range, and adds the two neighbours
+ *		of the sign change for each supply voltage. The sample count is deliberately not a
+ *		multiple of the vector width, so that the scalar tail loops are exercised too.
+ *
+ *	@param  Aout	: Array of `kCalibrationKernelSelfTestNumberOfSamples` values, where the function writes the Aout values.
+ *	@param  Vdd	: Array of `kCalibrationKernelSelfTestNumberOfSamples` values, where the function writes the Vdd values.
+ */
+static void
+setSelfTestInputs(double *  Aout, double *  Vdd)
+{
+	for (size_t v = 0; v < kCalibrationKernelSelfTestNumberOfSupplyVoltages; v++)
+	{
+		double	vddFraction = (double)v / (kCalibrationKernelSelfTestNumberOfSupplyVoltages - 1);
+		double	vddValue = kDefaultInputDistributionVddUniformDistLow +
+					vddFraction * (kDefaultInputDistributionVddUniformDistHigh - kDefaultInputDistributionVddUniformDistLow);
+		double	signChangeAout = kSensorCalibrationConstantSDP8x6Sqrt500Pa1 * vddValue;
+		size_t	rowStart = v * (kCalibrationKernelSelfTestNumberOfRatios + 2);
+
+		for (size_t r = 0; r < kCalibrationKernelSelfTestNumberOfRatios; r++)
+		{
+			Vdd[rowStart + r] = vddValue;
+			Aout[rowStart + r] = ((double)r / (kCalibrationKernelSelfTestNumberOfRatios - 1)) * vddValue;
+		}
+
+		Vdd[rowStart + kCalibrationKernelSelfTestNumberOfRatios] = vddValue;
+		Aout[rowStart + kCalibrationKernelSelfTestNumberOfRatios] = nextafter(signChangeAout, 0.0);
+		Vdd[rowStart + kCalibrationKernelSelfTestNumberOfRatios + 1] = vddValue;
+		Aout[rowStart + kCalibrationKernelSelfTestNumberOfRatios + 1] = nextafter(signChangeAout, INFINITY);
+	}
+
+	return;
+}
+
+uint64_t
+calculateMaximumUlpDistanceToScalarReference(CalibrationKernelImplementation implementation, OutputDistributionIndex variant)
+{
+	double *	Aout;
+	double *	Vdd;
+	double *	PaReference;
+	double *	Pa;
+	uint64_t	maximumUlpDistance = 0;
+
+	if (!isCalibrationKernelImplementationSupported(implementation))
+	{
+		return UINT64_MAX;
+	}
+
+	Aout = (double *) checkedMalloc(kCalibrationKernelSelfTestNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	Vdd = (double *) checkedMalloc(kCalibrationKernelSelfTestNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	PaReference = (double *) checkedMalloc(kCalibrationKernelSelfTestNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	Pa = (double *) checkedMalloc(kCalibrationKernelSelfTestNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+
+	setSelfTestInputs(Aout, Vdd);
+
+	calculateCalibratedSensorOutputBatchWithImplementation(
+		kCalibrationKernelImplementationScalar,
+		variant,
+		Aout,
+		Vdd,
+		PaReference,
+		kCalibrationKernelSelfTestNumberOfSamples);
+	calculateCalibratedSensorOutputBatchWithImplementation(
+		implementation,
+		variant,
+		Aout,
+		Vdd,
+		Pa,
+		kCalibrationKernelSelfTestNumberOfSamples);
+
+	for (size_t i = 0; i < kCalibrationKernelSelfTestNumberOfSamples; i++)
+	{
+		uint64_t	ulpDistance = calculateUlpDistance(Pa[i], PaReference[i]);
+
+		if (ulpDistance > maximumUlpDistance)
+		{
+			maximumUlpDistance = ulpDistance;
+		}
+	}
+
+	free(Aout);
+	free(Vdd);
+	free(PaReference);
+	free(Pa);
+
+	return maximumUlpDistance;
+}
+
+/**
+ *	@brief  Checks the fused all-variants batch kernel against the scalar reference and prints the
+ *		maximum absolute difference for each variant. The fused kernel reuses `Aout / Vdd`
+ *		across the variants, so its rounding differs slightly from the reference, and the
+ *		check uses an absolute bound (`kCalibrationFusedKernelMaximumAbsoluteError`) rather
+ *		than a ULP bound, which is not meaningful near the zero crossings of the outputs.
+ *
+ *	@return			: `kCommonConstantReturnTypeSuccess` if all variants are within the
+ *				   bound, else `kCommonConstantReturnTypeError`.
+ */
+static CommonConstantReturnType
+checkAllVariantsKernelAgainstScalarReference(void)
+{
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+	double *			Aout = (double *) checkedMalloc(kCalibrationKernelSelfTestNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *			Vdd = (double *) checkedMalloc(kCalibrationKernelSelfTestNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *			PaReference = (double *) checkedMalloc(kCalibrationKernelSelfTestNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *			Pa[kOutputDistributionIndexCalibratedSensorOutputMax];
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		Pa[variant] = (double *) checkedMalloc(kCalibrationKernelSelfTestNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	}
+
+	setSelfTestInputs(Aout, Vdd);
+	calculateCalibratedSensorOutputBatchAllVariants(Aout, Vdd, Pa, kCalibrationKernelSelfTestNumberOfSamples);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		double	maximumAbsoluteError = 0.0;
+		bool	passed;
+
+		calculateCalibratedSensorOutputBatchWithImplementation(
+			kCalibrationKernelImplementationScalar,
+			variant,
+			Aout,
+			Vdd,
+			PaReference,
+			kCalibrationKernelSelfTestNumberOfSamples);
+
+		for (size_t i = 0; i < kCalibrationKernelSelfTestNumberOfSamples; i++)
+		{
+			maximumAbsoluteError = fmax(maximumAbsoluteError, fabs(Pa[variant][i] - PaReference[i]));
+		}
+
+		passed = (maximumAbsoluteError <= kCalibrationFusedKernelMaximumAbsoluteError);
+		printf(
+			"\t%-18s: outputDistributions[%d]: maximum absolute difference %.3e Pa (bound: %.1e Pa): %s\n",
+			"all-variants",
+			variant,
+			maximumAbsoluteError,
+			kCalibrationFusedKernelMaximumAbsoluteError,
+			passed ? "PASS" : "FAIL");
+
+		if (!passed)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+
+		free(Pa[variant]);
+	}
+
+	free(Aout);
+	free(Vdd);
+	free(PaReference);
+
+	return result;
+}
+
+CommonConstantReturnType
+runCalibrationKernelSelfTest(void)
+{
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	printf("Calibration kernel self-test (maximum allowed distance to scalar reference: %d ULP):\n", kCalibrationKernelMaximumUlpDistance);
+
+	for (CalibrationKernelImplementation implementation = 0; implementation < kCalibrationKernelImplementationMax; implementation++)
+	{
+		if (!isCalibrationKernelImplementationSupported(implementation))
+		{
+			printf("\t%-18s: not supported on this CPU\n", getCalibrationKernelImplementationName(implementation));
+
+			continue;
+		}
+
+		for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+		{
+			uint64_t	maximumUlpDistance = calculateMaximumUlpDistanceToScalarReference(implementation, variant);
+			bool		passed = (maximumUlpDistance <= kCalibrationKernelMaximumUlpDistance);
+
+			printf(
+				"\t%-18s: outputDistributions[%d]: maximum distance %" PRIu64 " ULP: %s\n",
+				getCalibrationKernelImplementationName(implementation),
+				variant,
+				maximumUlpDistance,
+				passed ? "PASS" : "FAIL");
+
+			if (!passed)
+			{
+				result = kCommonConstantReturnTypeError;
+			}
+		}
+	}
+
+	if (checkAllVariantsKernelAgainstScalarReference() != kCommonConstantReturnTypeSuccess)
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	return result;
+}
+
+void
+setCalibrationKernelBenchmarkInputs(double *  Aout, double *  Vdd, size_t numberOfSamples)
+{
+	/*
+	 *	Spread the inputs over the default input ranges, so that the
+	 *	square root configurations see both signs of the output.
+	 */
+	for (size_t i = 0; i < numberOfSamples; i++)
+	{
+		double	fraction = (double)((i * 7919) % numberOfSamples) / numberOfSamples;
+
+		Aout[i] = kDefaultInputDistributionAoutUniformDistLow +
+				fraction * (kDefaultInputDistributionAoutUniformDistHigh - kDefaultInputDistributionAoutUniformDistLow);
+		Vdd[i] = kDefaultInputDistributionVddUniformDistLow +
+				(1.0 - fraction) * (kDefaultInputDistributionVddUniformDistHigh - kDefaultInputDistributionVddUniformDistLow);
+	}
+
+	return;
+}
+
+void
+runCalibrationKernelBenchmark(size_t numberOfSamples)
+{
+	double *	Aout = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *	Vdd = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *	Pa = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+
+	setCalibrationKernelBenchmarkInputs(Aout, Vdd, numberOfSamples);
+
+	printf("Calibration kernel benchmark (%zu samples, best of %d runs):\n", numberOfSamples, kCalibrationKernelBenchmarkNumberOfRuns);
+
+	for (CalibrationKernelImplementation implementation = 0; implementation < kCalibrationKernelImplementationMax; implementation++)
+	{
+		if (!isCalibrationKernelImplementationSupported(implementation))
+		{
+			printf("\t%-18s: not supported on this CPU\n", getCalibrationKernelImplementationName(implementation));
+
+			continue;
+		}
+
+		for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+		{
+			double	bestSeconds = INFINITY;
+
+			for (int run = 0; run < kCalibrationKernelBenchmarkNumberOfRuns; run++)
+			{
+				clock_t	start = clock();
+
+				calculateCalibratedSensorOutputBatchWithImplementation(implementation, variant, Aout, Vdd, Pa, numberOfSamples);
+
+				double	seconds = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+
+				if (seconds < bestSeconds)
+				{
+					bestSeconds = seconds;
+				}
+			}
+
+			printf(
+				"\t%-18s: outputDistributions[%d]: %.3lf ns/sample\n",
+				getCalibrationKernelImplementationName(implementation),
+				variant,
+				bestSeconds * 1e9 / numberOfSamples);
+		}
+	}
+
+	free(Aout);
+	free(Vdd);
+	free(Pa);
+
+	return;
+}
@@ -0,0 +1,264 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "common.h"
+#include "utilities-config.h"
+
+/*
+ *	Implementations of the batch calibration kernels:
+ *		kCalibrationKernelImplementationScalar			: Portable scalar reference implementation.
+ *		kCalibrationKernelImplementationScalarBranchFree	: Portable scalar implementation that replaces `sign()` and
+ *									  `pow(x, 2)` of the square root configurations with
+ *									  `copysign()` and a multiply.
+ *		kCalibrationKernelImplementationSSE2			: x86 SSE2 implementation (2 doubles per vector).
+ *		kCalibrationKernelImplementationAVX2			: x86 AVX2 implementation (4 doubles per vector).
+ *		kCalibrationKernelImplementationAVX512			: x86 AVX-512F implementation (8 doubles per vector).
+ */
+typedef enum
+{
+	kCalibrationKernelImplementationScalar			= 0,
+	kCalibrationKernelImplementationScalarBranchFree	= 1,
+	kCalibrationKernelImplementationSSE2			= 2,
+	kCalibrationKernelImplementationAVX2			= 3,
+	kCalibrationKernelImplementationAVX512			= 4,
+	kCalibrationKernelImplementationMax,
+} CalibrationKernelImplementation;
+
+/*
+ *	Per-variant calibration kernels, with the calibration constants of the
+ *	variant folded in at compile time:
+ *		CalibrationFunction		: Calibrates a single (Aout, Vdd) pair.
+ *		CalibrationBatchFunction	: Calibrates a batch of (Aout, Vdd) pairs stored as a structure of arrays.
+ */
+typedef double	(*CalibrationFunction)(double Aout, double Vdd);
+typedef void	(*CalibrationBatchFunction)(const double *  Aout, const double *  Vdd, double *  Pa, size_t numberOfSamples);
+
+/*
+ *	Single-precision (float32) version of `CalibrationBatchFunction`.
+ */
+typedef void	(*CalibrationBatchFunctionFloat)(const float *  Aout, const float *  Vdd, float *  Pa, size_t numberOfSamples);
+
+/**
+ *	@brief  Calculates the calibrated sensor output of a single SDP8x6 variant for a
+ *		single (Aout, Vdd) pair, using the calibration routines taken from
+ *		SDP8xx Analog Datasheet, 2024-07-03.
+ *
+ *	@param  variant		: The sensor variant / configuration to calibrate for.
+ *	@param  Aout		: Ratiometric analog voltage value (in Volts).
+ *	@param  Vdd		: Supply voltage (in Volts).
+ *	@return double		: The calibrated differential pressure (in Pascal).
+ */
+double	calculateCalibratedSensorOutput(OutputDistributionIndex variant, double Aout, double Vdd);
+
+/**
+ *	@brief  Returns the specialized kernel for a single SDP8x6 variant. Look this up once, outside
+ *		of any loop over samples, so that the loop itself does not branch on the variant.
+ *
+ *	@param  variant			: The sensor variant / configuration to calibrate for.
+ *	@return CalibrationFunction	: The kernel of the variant, or `NULL` if the variant is invalid.
+ */
+CalibrationFunction	getCalibrationFunction(OutputDistributionIndex variant);
+
+/**
+ *	@brief  Returns the specialized batch kernel of a calibration kernel implementation for a single
+ *		SDP8x6 variant.
+ *
+ *	@param  implementation			: The calibration kernel implementation.
+ *	@param  variant				: The sensor variant / configuration to calibrate for.
+ *	@return CalibrationBatchFunction	: The batch kernel, or `NULL` if the variant is invalid or
+ *						  the implementation is not available on this platform.
+ */
+CalibrationBatchFunction	getCalibrationBatchFunction(CalibrationKernelImplementation implementation, OutputDistributionIndex variant);
+
+/**
+ *	@brief  Returns the specialized single-precision (float32) batch kernel for a single SDP8x6 variant.
+ *		The square root configurations use the branch-free formulation. The kernels are plain
+ *		loops that the compiler vectorizes, with twice as many lanes per vector as the
+ *		double-precision kernels.
+ *
+ *	@param  variant				: The sensor variant / configuration to calibrate for.
+ *	@return CalibrationBatchFunctionFloat	: The batch kernel, or `NULL` if the variant is invalid.
+ */
+CalibrationBatchFunctionFloat	getCalibrationBatchFunctionFloat(OutputDistributionIndex variant);
+
+/**
+ *	@brief  Returns the name of a calibration kernel implementation (e.g., "avx2").
+ *
+ *	@param  implementation	: The calibration kernel implementation.
+ *	@return const char *	: The name of the implementation.
+ */
+const char *	getCalibrationKernelImplementationName(CalibrationKernelImplementation implementation);
+
+/**
+ *	@brief  Parses the name of a calibration kernel implementation.
+ *
+ *	@param  name		: The name of the implementation, as returned by `getCalibrationKernelImplementationName()`.
+ *	@param  implementation	: Pointer to where the function writes the parsed implementation.
+ *	@return			: `kCommonConstantReturnTypeSuccess` if successful,
+ *				   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	parseCalibrationKernelImplementationName(const char *  name, CalibrationKernelImplementation *  implementation);
+
+/**
+ *	@brief  Returns the calibration kernel implementation used by `calculateCalibratedSensorOutputBatch()`.
+ *		Unless set via `setCalibrationKernelImplementation()`, this is the widest
+ *		implementation that the running CPU supports, as detected via CPUID on first use.
+ *
+ *	@return CalibrationKernelImplementation	: The calibration kernel implementation in use.
+ */
+CalibrationKernelImplementation	getCalibrationKernelImplementation(void);
+
+/**
+ *	@brief  Overrides the calibration kernel implementation used by `calculateCalibratedSensorOutputBatch()`.
+ *
+ *	@param  implementation	: The calibration kernel implementation to use.
+ *	@return			: `kCommonConstantReturnTypeSuccess` if successful,
+ *				   else `kCommonConstantReturnTypeError` if the running CPU does not support it.
+ */
+CommonConstantReturnType	setCalibrationKernelImplementation(CalibrationKernelImplementation implementation);
+
+/**
+ *	@brief  Calculates the calibrated sensor output of a single SDP8x6 variant for a batch
+ *		of (Aout, Vdd) pairs stored as a structure of arrays. Can be used without going
+ *		through `main()` and `CommandLineArguments`.
+ *
+ *	@param  variant			: The sensor variant / configuration to calibrate for.
+ *	@param  Aout			: Array of `numberOfSamples` ratiometric analog voltage values (in Volts).
+ *	@param  Vdd			: Array of `numberOfSamples` supply voltage values (in Volts).
+ *	@param  Pa			: Array of `numberOfSamples` values, where the function writes the calibrated outputs (in Pascal).
+ *	@param  numberOfSamples		: The number of samples in each of the arrays.
+ *	@return				: `kCommonConstantReturnTypeSuccess` if successful,
+ *					   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	calculateCalibratedSensorOutputBatch(
+					OutputDistributionIndex	variant,
+					const double *		Aout,
+					const double *		Vdd,
+					double *		Pa,
+					size_t			numberOfSamples);
+
+/**
+ *	@brief  Calculates the calibrated sensor outputs of all SDP8x6 variants for a batch of
+ *		(Aout, Vdd) pairs stored as a structure of arrays. Computes the ratio `Aout / Vdd`
+ *		once per pair and evaluates all variants from it, so the results can differ from
+ *		`calculateCalibratedSensorOutputBatch()` in the last bits
+ *		(see `kCalibrationFusedKernelMaximumAbsoluteError`).
+ *
+ *	@param  Aout			: Array of `numberOfSamples` ratiometric analog voltage values (in Volts).
+ *	@param  Vdd			: Array of `numberOfSamples` supply voltage values (in Volts).
+ *	@param  Pa			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` arrays of `numberOfSamples`
+ *					  values, indexed by `OutputDistributionIndex`, where the function writes the calibrated outputs.
+ *	@param  numberOfSamples		: The number of samples in each of the arrays.
+ */
+void	calculateCalibratedSensorOutputBatchAllVariants(
+		const double *		Aout,
+		const double *		Vdd,
+		double * const *	Pa,
+		size_t			numberOfSamples);
+
+/**
+ *	@brief  Single-precision (float32) version of `calculateCalibratedSensorOutputBatchAllVariants()`.
+ *
+ *	@param  Aout			: Array of `numberOfSamples` ratiometric analog voltage values (in Volts).
+ *	@param  Vdd			: Array of `numberOfSamples` supply voltage values (in Volts).
+ *	@param  Pa			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` arrays of `numberOfSamples`
+ *					  values, indexed by `OutputDistributionIndex`, where the function writes the calibrated outputs.
+ *	@param  numberOfSamples		: The number of samples in each of the arrays.
+ */
+void	calculateCalibratedSensorOutputBatchAllVariantsFloat(
+		const float *		Aout,
+		const float *		Vdd,
+		float * const *		Pa,
+		size_t			numberOfSamples);
+
+/**
+ *	@brief  Same as `calculateCalibratedSensorOutputBatch()`, but using the given calibration
+ *		kernel implementation instead of the one selected at runtime.
+ *
+ *	@param  implementation		: The calibration kernel implementation to use.
+ *	@param  variant			: The sensor variant / configuration to calibrate for.
+ *	@param  Aout			: Array of `numberOfSamples` ratiometric analog voltage values (in Volts).
+ *	@param  Vdd			: Array of `numberOfSamples` supply voltage values (in Volts).
+ *	@param  Pa			: Array of `numberOfSamples` values, where the function writes the calibrated outputs (in Pascal).
+ *	@param  numberOfSamples		: The number of samples in each of the arrays.
+ *	@return				: `kCommonConstantReturnTypeSuccess` if successful,
+ *					   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	calculateCalibratedSensorOutputBatchWithImplementation(
+					CalibrationKernelImplementation	implementation,
+					OutputDistributionIndex		variant,
+					const double *			Aout,
+					const double *			Vdd,
+					double *			Pa,
+					size_t				numberOfSamples);
+
+/**
+ *	@brief  Calculates the distance of two doubles in units in the last place (ULP), i.e., the
+ *		number of representable doubles between them. `+0.0` and `-0.0` are zero ULP apart.
+ *
+ *	@param  a		: The first value.
+ *	@param  b		: The second value.
+ *	@return uint64_t	: The ULP distance.
+ */
+uint64_t	calculateUlpDistance(double a, double b);
+
+/**
+ *	@brief  Calculates the maximum distance, in units in the last place (ULP), between the outputs
+ *		of a calibration kernel implementation and the scalar reference implementation, over a
+ *		grid of (Aout, Vdd) pairs covering the valid ratio range [0, 1] of a variant.
+ *
+ *	@param  implementation	: The calibration kernel implementation to check.
+ *	@param  variant		: The sensor variant / configuration to check.
+ *	@return uint64_t	: The maximum ULP distance. `UINT64_MAX` if the implementation is not supported.
+ */
+uint64_t	calculateMaximumUlpDistanceToScalarReference(CalibrationKernelImplementation implementation, OutputDistributionIndex variant);
+
+/**
+ *	@brief  Checks all calibration kernel implementations supported by the running CPU against the
+ *		scalar reference implementation, for all variants, and prints the results.
+ *
+ *	@return			: `kCommonConstantReturnTypeSuccess` if all implementations are within
+ *				   `kCalibrationKernelMaximumUlpDistance` of the reference, else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runCalibrationKernelSelfTest(void);
+
+/**
+ *	@brief  Sets the inputs used by the calibration kernel benchmarks: (Aout, Vdd) pairs spread
+ *		over the default input ranges.
+ *
+ *	@param  Aout		: Array of `numberOfSamples` values, where the function writes the Aout inputs.
+ *	@param  Vdd		: Array of `numberOfSamples` values, where the function writes the Vdd inputs.
+ *	@param  numberOfSamples	: The number of samples in each of the arrays.
+ */
+void	setCalibrationKernelBenchmarkInputs(double *  Aout, double *  Vdd, size_t numberOfSamples);
+
+/**
+ *	@brief  Times all calibration kernel implementations supported by the running CPU, for all
+ *		variants, and prints the time per sample in nanoseconds.
+ *
+ *	@param  numberOfSamples	: The number of (Aout, Vdd) pairs to calibrate per measurement.
+ */
+void	runCalibrationKernelBenchmark(size_t numberOfSamples);
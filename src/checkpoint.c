@@ -0,0 +1,424 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include "checkpoint.h"
+#include "montecarlo.h"
+#include "shard.h"
+
+/*
+ *	Progress of a checkpointed run, written after its partial state. The
+ *	index of the next iteration also sets the interval, and therefore the
+ *	random number generator streams, that the run continues with.
+ */
+typedef struct
+{
+	uint64_t	numberOfThreads;
+	uint64_t	checkpointInterval;
+	uint64_t	nextSample;
+} CheckpointProgress;
+
+
+/**
+ *	@brief  Writes a checkpoint to a temporary file, and renames it to the checkpoint file.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  streamingStatistics		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` statistics.
+ *	@param  quantileSketches		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` quantile sketches.
+ *	@param  histograms			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` histograms, or `NULL`.
+ *	@param  nextSample			: The index of the next iteration.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+static CommonConstantReturnType
+writeCheckpointFile(
+	CommandLineArguments *		arguments,
+	const StreamingStatistics *	streamingStatistics,
+	const QuantileSketch *		quantileSketches,
+	const Histogram *		histograms,
+	size_t				nextSample)
+{
+	char			temporaryFilePath[kCommonConstantMaxCharsPerFilepath + sizeof(kCheckpointTemporaryFilePathSuffix)];
+	CheckpointProgress	progress =
+				{
+					.numberOfThreads	= arguments->numberOfThreads,
+					.checkpointInterval	= arguments->checkpointInterval,
+					.nextSample		= nextSample,
+				};
+	bool			isWritten;
+	FILE *			file;
+
+	snprintf(temporaryFilePath, sizeof(temporaryFilePath), "%s%s", arguments->checkpointFilePath, kCheckpointTemporaryFilePathSuffix);
+	file = fopen(temporaryFilePath, "wb");
+
+	if (file == NULL)
+	{
+		fprintf(stderr, "Error: Could not open \"%s\" for writing.\n", temporaryFilePath);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	isWritten = (writeShardPartialState(file, arguments, streamingStatistics, quantileSketches, histograms) == kCommonConstantReturnTypeSuccess) &&
+			(fwrite(&progress, sizeof(progress), 1, file) == 1);
+
+	if ((fclose(file) != 0) || !isWritten || (rename(temporaryFilePath, arguments->checkpointFilePath) != 0))
+	{
+		fprintf(stderr, "Error: Could not write the checkpoint \"%s\".\n", arguments->checkpointFilePath);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+/**
+ *	@brief  Reads the checkpoint file of the same run, if it exists.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  streamingStatistics		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` statistics, where the
+ *						  function reads the statistics of the checkpoint.
+ *	@param  quantileSketches		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` quantile sketches, where
+ *						  the function reads the sketches of the checkpoint.
+ *	@param  histograms			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` initialized histograms,
+ *						  where the function reads the counts of the checkpoint, or `NULL`.
+ *	@param  sampleStart			: The index of the first iteration of the run.
+ *	@param  sampleEnd			: One past the index of the last iteration of the run.
+ *	@param  nextSample			: Pointer to where the function writes the index of the next iteration, if the
+ *						  checkpoint file exists.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful, or if the checkpoint file does
+ *						  not exist, else `kCommonConstantReturnTypeError`.
+ */
+static CommonConstantReturnType
+readCheckpointFile(
+	CommandLineArguments *		arguments,
+	StreamingStatistics *		streamingStatistics,
+	QuantileSketch *		quantileSketches,
+	Histogram *			histograms,
+	size_t				sampleStart,
+	size_t				sampleEnd,
+	size_t *			nextSample)
+{
+	CheckpointProgress	progress;
+	bool			isRead;
+	FILE *			file = fopen(arguments->checkpointFilePath, "rb");
+
+	if (file == NULL)
+	{
+		fprintf(stderr, "Warning: No checkpoint \"%s\" to resume from. Starting from the first iteration.\n", arguments->checkpointFilePath);
+
+		return kCommonConstantReturnTypeSuccess;
+	}
+
+	/*
+	 *	The results depend on the number of threads and the interval, as
+	 *	well as on the settings of the run that the partial state checks.
+	 */
+	isRead = (readShardPartialState(file, arguments, streamingStatistics, quantileSketches, histograms) == kCommonConstantReturnTypeSuccess) &&
+			(fread(&progress, sizeof(progress), 1, file) == 1) &&
+			(progress.numberOfThreads == arguments->numberOfThreads) &&
+			(progress.checkpointInterval == arguments->checkpointInterval) &&
+			(progress.nextSample >= sampleStart) &&
+			(progress.nextSample <= sampleEnd) &&
+			(((progress.nextSample - sampleStart) % progress.checkpointInterval == 0) || (progress.nextSample == sampleEnd));
+	fclose(file);
+
+	if (!isRead)
+	{
+		fprintf(
+			stderr,
+			"Error: \"%s\" is not a checkpoint of this run. Resuming requires the arguments of the run, including the number of threads and the interval.\n",
+			arguments->checkpointFilePath);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	*nextSample = progress.nextSample;
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+/**
+ *	@brief  Runs at most a number of the checkpointed intervals of `runCheckpointedMonteCarloIterations()`,
+ *		e.g., to stop a run after an interval, as if it had been stopped there.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  lookupTable			: Pointer to the lookup tables of the selected variants, or `NULL`.
+ *	@param  streamingStatistics		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` statistics, which the
+ *						  function initializes and folds the output samples into.
+ *	@param  quantileSketches		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` quantile sketches, which the
+ *						  function initializes and adds the output samples to.
+ *	@param  histograms			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` initialized histograms,
+ *						  where the function counts the output samples, or `NULL`.
+ *	@param  maximumNumberOfIntervals	: The maximum number of intervals to run, after those of the checkpoint.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+static CommonConstantReturnType
+runCheckpointedMonteCarloIntervals(
+	CommandLineArguments *		arguments,
+	const CalibrationLookupTable *	lookupTable,
+	StreamingStatistics *		streamingStatistics,
+	QuantileSketch *		quantileSketches,
+	Histogram *			histograms,
+	size_t				maximumNumberOfIntervals)
+{
+	MonteCarloOutputSamples	monteCarloOutputSamples = {0};
+	size_t			sampleStart;
+	size_t			sampleEnd;
+	size_t			nextSample;
+	size_t			numberOfIntervals = 0;
+
+	getShardIterationRange(arguments, &sampleStart, &sampleEnd);
+	nextSample = sampleStart;
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		initializeStreamingStatistics(&streamingStatistics[variant]);
+		initializeQuantileSketch(&quantileSketches[variant]);
+	}
+
+	if (arguments->isResumeEnabled &&
+		(readCheckpointFile(
+			arguments,
+			streamingStatistics,
+			quantileSketches,
+			histograms,
+			sampleStart,
+			sampleEnd,
+			&nextSample) != kCommonConstantReturnTypeSuccess))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	/*
+	 *	Each interval draws from its own streams of the seed, which only
+	 *	depend on its index, so that a resumed run draws the same samples as
+	 *	an uninterrupted one, and folds them into the same statistics.
+	 */
+	while ((nextSample < sampleEnd) && (numberOfIntervals < maximumNumberOfIntervals))
+	{
+		uint64_t	interval = (nextSample - sampleStart) / arguments->checkpointInterval;
+		size_t		intervalEnd = (sampleEnd - nextSample > arguments->checkpointInterval) ?
+							nextSample + arguments->checkpointInterval :
+							sampleEnd;
+
+		if (runNativeMonteCarloIterationRange(
+			arguments,
+			lookupTable,
+			&monteCarloOutputSamples,
+			streamingStatistics,
+			quantileSketches,
+			histograms,
+			nextSample,
+			intervalEnd,
+			(interval * arguments->numberOfShards + arguments->shardIndex) * kMonteCarloMaximumNumberOfThreads) != kCommonConstantReturnTypeSuccess)
+		{
+			return kCommonConstantReturnTypeError;
+		}
+
+		nextSample = intervalEnd;
+		numberOfIntervals++;
+
+		if (writeCheckpointFile(
+			arguments,
+			streamingStatistics,
+			quantileSketches,
+			histograms,
+			nextSample) != kCommonConstantReturnTypeSuccess)
+		{
+			return kCommonConstantReturnTypeError;
+		}
+	}
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+CommonConstantReturnType
+runCheckpointedMonteCarloIterations(
+	CommandLineArguments *		arguments,
+	const CalibrationLookupTable *	lookupTable,
+	StreamingStatistics *		streamingStatistics,
+	QuantileSketch *		quantileSketches,
+	Histogram *			histograms)
+{
+	return runCheckpointedMonteCarloIntervals(arguments, lookupTable, streamingStatistics, quantileSketches, histograms, SIZE_MAX);
+}
+
+CommonConstantReturnType
+runCheckpointSelfTest(void)
+{
+	const size_t			numberOfIntervals = kCheckpointSelfTestNumberOfIntervalsBeforeStop;
+	QuantileSketch *		quantileSketches = (QuantileSketch *) checkedMalloc(
+								2 * kOutputDistributionIndexCalibratedSensorOutputMax * sizeof(QuantileSketch),
+								__FILE__,
+								__LINE__);
+	QuantileSketch *		referenceQuantileSketches = &quantileSketches[kOutputDistributionIndexCalibratedSensorOutputMax];
+	StreamingStatistics		streamingStatistics[kOutputDistributionIndexCalibratedSensorOutputMax];
+	StreamingStatistics		referenceStreamingStatistics[kOutputDistributionIndexCalibratedSensorOutputMax];
+	Histogram			histograms[kOutputDistributionIndexCalibratedSensorOutputMax];
+	Histogram			referenceHistograms[kOutputDistributionIndexCalibratedSensorOutputMax];
+	CommandLineArguments		arguments = {0};
+	const char *			mismatchDescriptions[] = { "iterations", "seed", "threads", "interval" };
+	const size_t			numberOfMismatches = sizeof(mismatchDescriptions) / sizeof(mismatchDescriptions[0]);
+	CommandLineArguments		mismatchedArguments[sizeof(mismatchDescriptions) / sizeof(mismatchDescriptions[0])];
+	bool				isStopped;
+	bool				isResumePassed;
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	printf(
+		"Checkpoint self-test (%zu xoshiro256** iterations on %d threads, in intervals of %d, stopped after interval %zu):\n",
+		(size_t) kCheckpointSelfTestNumberOfSamples,
+		kCheckpointSelfTestNumberOfThreads,
+		kCheckpointSelfTestInterval,
+		numberOfIntervals);
+
+	arguments.common.outputSelect = kOutputDistributionIndexCalibratedSensorOutputMax;
+	arguments.common.numberOfMonteCarloIterations = kCheckpointSelfTestNumberOfSamples;
+	arguments.numberOfThreads = kCheckpointSelfTestNumberOfThreads;
+	arguments.seed = kDefaultMonteCarloSeed;
+	arguments.randomNumberGeneratorType = kRandomNumberGeneratorTypeXoshiro256;
+	arguments.samplingStrategy = kSamplingStrategyIndependent;
+	arguments.isStreamingStatisticsEnabled = true;
+	arguments.isQuantileSketchEnabled = true;
+	arguments.isHistogramEnabled = true;
+	arguments.histogramNumberOfBins = kCheckpointSelfTestNumberOfBins;
+	arguments.shardIndex = 0;
+	arguments.numberOfShards = 1;
+	arguments.isCheckpointEnabled = true;
+	arguments.checkpointInterval = kCheckpointSelfTestInterval;
+	snprintf(arguments.checkpointFilePath, kCommonConstantMaxCharsPerFilepath, "%s", kCheckpointSelfTestFilePath);
+
+	/*
+	 *	The uninterrupted run, then a run stopped after an interval, whose
+	 *	state in memory is lost, and its resumption from the checkpoint.
+	 */
+	initializeOutputHistograms(&arguments, referenceHistograms);
+	initializeOutputHistograms(&arguments, histograms);
+
+	if ((runCheckpointedMonteCarloIterations(
+			&arguments,
+			NULL,
+			referenceStreamingStatistics,
+			referenceQuantileSketches,
+			referenceHistograms) != kCommonConstantReturnTypeSuccess) ||
+		(runCheckpointedMonteCarloIntervals(
+			&arguments,
+			NULL,
+			streamingStatistics,
+			quantileSketches,
+			histograms,
+			numberOfIntervals) != kCommonConstantReturnTypeSuccess))
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	isStopped = (streamingStatistics[0].numberOfSamples == numberOfIntervals * kCheckpointSelfTestInterval);
+	printf("\tStopped after %" PRIu64 " iterations: %s\n", streamingStatistics[0].numberOfSamples, isStopped ? "PASS" : "FAIL");
+
+	if (!isStopped)
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		freeHistogram(&histograms[variant]);
+	}
+
+	initializeOutputHistograms(&arguments, histograms);
+	arguments.isResumeEnabled = true;
+	isResumePassed = (result == kCommonConstantReturnTypeSuccess) &&
+				(runCheckpointedMonteCarloIterations(&arguments, NULL, streamingStatistics, quantileSketches, histograms) == kCommonConstantReturnTypeSuccess);
+
+	for (OutputDistributionIndex variant = 0; isResumePassed && (variant < kOutputDistributionIndexCalibratedSensorOutputMax); variant++)
+	{
+		isResumePassed = isSameShardOutputState(
+					&streamingStatistics[variant],
+					&referenceStreamingStatistics[variant],
+					&quantileSketches[variant],
+					&referenceQuantileSketches[variant],
+					&histograms[variant],
+					&referenceHistograms[variant]);
+	}
+
+	printf("\tResumed statistics, quantile sketches, and histograms bitwise the same as uninterrupted: %s\n", isResumePassed ? "PASS" : "FAIL");
+
+	if (!isResumePassed)
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	/*
+	 *	Resuming with other arguments than those of the checkpoint must fail.
+	 *	Each prints its error.
+	 */
+	for (size_t i = 0; i < numberOfMismatches; i++)
+	{
+		mismatchedArguments[i] = arguments;
+	}
+
+	mismatchedArguments[0].common.numberOfMonteCarloIterations++;
+	mismatchedArguments[1].seed++;
+	mismatchedArguments[2].numberOfThreads++;
+	mismatchedArguments[3].checkpointInterval++;
+
+	for (size_t i = 0; i < numberOfMismatches; i++)
+	{
+		bool	isRejected;
+
+		for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+		{
+			freeHistogram(&histograms[variant]);
+		}
+
+		initializeOutputHistograms(&mismatchedArguments[i], histograms);
+		isRejected = (runCheckpointedMonteCarloIterations(
+					&mismatchedArguments[i],
+					NULL,
+					streamingStatistics,
+					quantileSketches,
+					histograms) != kCommonConstantReturnTypeSuccess);
+		printf("\tResume with other %s rejected: %s\n", mismatchDescriptions[i], isRejected ? "PASS" : "FAIL");
+
+		if (!isRejected)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+	}
+
+	remove(kCheckpointSelfTestFilePath);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		freeHistogram(&histograms[variant]);
+		freeHistogram(&referenceHistograms[variant]);
+	}
+
+	free(quantileSketches);
+
+	return result;
+}
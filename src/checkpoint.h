@@ -0,0 +1,66 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "utilities.h"
+#include "calibration-lookup-table.h"
+#include "streaming-statistics.h"
+#include "quantile-sketch.h"
+#include "histogram.h"
+
+/**
+ *	@brief  Runs the native Monte Carlo iterations of the run (or of its shard, with the -d option) in
+ *		intervals of `arguments->checkpointInterval` iterations, and after each interval writes the
+ *		statistics, quantile sketches, and histograms so far, and the index of the next iteration,
+ *		to the checkpoint file. With `arguments->isResumeEnabled`, first reads them back from the
+ *		checkpoint file, if it exists, and continues from there. The results of a resumed run are
+ *		bit-identical to those of an uninterrupted run with the same arguments.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  lookupTable			: Pointer to the lookup tables of the selected variants, or `NULL`.
+ *	@param  streamingStatistics		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` statistics, which the
+ *						  function initializes and folds the output samples into.
+ *	@param  quantileSketches		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` quantile sketches, which the
+ *						  function initializes and adds the output samples to.
+ *	@param  histograms			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` initialized histograms,
+ *						  where the function counts the output samples, or `NULL`.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runCheckpointedMonteCarloIterations(
+					CommandLineArguments *		arguments,
+					const CalibrationLookupTable *	lookupTable,
+					StreamingStatistics *		streamingStatistics,
+					QuantileSketch *		quantileSketches,
+					Histogram *			histograms);
+
+/**
+ *	@brief  Checks that a xoshiro256** run stopped after an interval and resumed from its checkpoint
+ *		gives bitwise the statistics, quantile sketches, and histograms of the uninterrupted run,
+ *		and that resuming with other iterations, seed, threads, or interval fails. Writes the
+ *		checkpoint to the working directory, and removes it.
+ *
+ *	@return		: `kCommonConstantReturnTypeSuccess` if all checks pass,
+ *			   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runCheckpointSelfTest(void);
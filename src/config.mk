@@ -1,4 +1,26 @@
 SOURCES =\
 	main.c\
 	common.c\
-	utilities.c
+	utilities.c\
+	calibration.c\
+	calibration-simd.c\
+	calibration-fixed-point.c\
+	calibration-lookup-table.c\
+	calibration-inverse.c\
+	calibration-cached-reciprocal.c\
+	montecarlo.c\
+	random-number-generator.c\
+	streaming-statistics.c\
+	quasi-monte-carlo.c\
+	sampling-strategy.c\
+	adaptive-stopping.c\
+	quantile-sketch.c\
+	histogram.c\
+	shard.c\
+	checkpoint.c\
+	importance-sampling.c\
+	analytic-distribution.c\
+	grid-propagation.c\
+	particle-distribution.c\
+	wasserstein-distance.c\
+	adc.c
@@ -0,0 +1,781 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include "grid-propagation.h"
+#include "calibration.h"
+#include "random-number-generator.h"
+#include "analytic-distribution.h"
+
+/**
+ *	@brief  Compares two doubles, for `qsort()`.
+ *
+ *	@param  a	: Pointer to the first double.
+ *	@param  b	: Pointer to the second double.
+ *	@return int	: Negative, zero, or positive if the first is smaller than, equal to, or greater than the second.
+ */
+static int
+compareDoubles(const void *  a, const void *  b)
+{
+	double	x = *(const double *)a;
+	double	y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ *	@brief  Returns the quantile of the standard Gaussian distribution, by bisection of its CDF.
+ *
+ *	@param  probability	: The probability of the quantile, in (0, 1).
+ *	@return double		: The quantile.
+ */
+static double
+getStandardGaussianQuantile(double probability)
+{
+	double	low = -kGridPropagationNormalQuantileBound;
+	double	high = kGridPropagationNormalQuantileBound;
+
+	for (int i = 0; i < kGridPropagationNumberOfBisections; i++)
+	{
+		double	middle = 0.5 * (low + high);
+
+		if ((middle == low) || (middle == high))
+		{
+			break;
+		}
+
+		/*
+		 *	Compare in the nearer tail, where the CDF keeps its relative accuracy.
+		 */
+		if ((middle < 0.0) ? (0.5 * erfc(-middle / M_SQRT2) < probability) : (0.5 * erfc(middle / M_SQRT2) > 1.0 - probability))
+		{
+			low = middle;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return 0.5 * (low + high);
+}
+
+/**
+ *	@brief  Returns the mean and standard deviation of a Gaussian input: those of the uniform input over its range.
+ *
+ *	@param  input			: Pointer to the input distribution.
+ *	@param  standardDeviation	: Pointer to where the function writes the standard deviation.
+ *	@return double			: The mean.
+ */
+static double
+getGaussianInputParameters(const GridInputDistribution *  input, double *  standardDeviation)
+{
+	*standardDeviation = (input->high - input->low) / sqrt(12.0);
+
+	return 0.5 * (input->low + input->high);
+}
+
+const char *
+getGridInputDistributionName(GridInputDistributionType type)
+{
+	static const char *	names[kGridInputDistributionMax] =
+				{
+					"uniform",
+					"gaussian",
+					"triangular",
+					"empirical",
+				};
+
+	if (type >= kGridInputDistributionMax)
+	{
+		return "unknown";
+	}
+
+	return names[type];
+}
+
+CommonConstantReturnType
+parseGridInputDistributionName(const char *  name, GridInputDistributionType *  type)
+{
+	for (GridInputDistributionType i = 0; i < kGridInputDistributionMax; i++)
+	{
+		if (strcmp(name, getGridInputDistributionName(i)) == 0)
+		{
+			*type = i;
+
+			return kCommonConstantReturnTypeSuccess;
+		}
+	}
+
+	return kCommonConstantReturnTypeError;
+}
+
+CommonConstantReturnType
+initializeGridInputDistributions(GridInputDistributionType type, const char *  filePath, GridInputDistribution *  inputs)
+{
+	char				line[kGridPropagationMaxCharsPerLine];
+	size_t				capacity = kMonteCarloSampleBlockSize;
+	size_t				lineNumber = 0;
+	FILE *				file;
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	inputs[kInputDistributionIndexAout] = (GridInputDistribution)
+		{
+			.type			= type,
+			.low			= kDefaultInputDistributionAoutUniformDistLow,
+			.high			= kDefaultInputDistributionAoutUniformDistHigh,
+			.samples		= NULL,
+			.numberOfSamples	= 0,
+		};
+	inputs[kInputDistributionIndexVdd] = (GridInputDistribution)
+		{
+			.type			= type,
+			.low			= kDefaultInputDistributionVddUniformDistLow,
+			.high			= kDefaultInputDistributionVddUniformDistHigh,
+			.samples		= NULL,
+			.numberOfSamples	= 0,
+		};
+
+	if (type != kGridInputDistributionEmpirical)
+	{
+		return kCommonConstantReturnTypeSuccess;
+	}
+
+	file = fopen(filePath, "r");
+
+	if (file == NULL)
+	{
+		fprintf(stderr, "Error: Could not open input distribution file \"%s\".\n", filePath);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	for (InputDistributionIndex i = 0; i < kInputDistributionIndexMax; i++)
+	{
+		inputs[i].samples = (double *) checkedMalloc(capacity * sizeof(double), __FILE__, __LINE__);
+	}
+
+	while (fgets(line, sizeof(line), file) != NULL)
+	{
+		double	Aout;
+		double	Vdd;
+		char	trailing;
+
+		lineNumber++;
+
+		if ((line[0] == '#') || (strspn(line, " \t\r\n") == strlen(line)))
+		{
+			continue;
+		}
+
+		if ((sscanf(line, "%lf ,%lf %c", &Aout, &Vdd, &trailing) != 2) || !isfinite(Aout) || !isfinite(Vdd) || !(Vdd > 0.0))
+		{
+			fprintf(stderr, "Error: Line %zu of \"%s\" is not a valid pair of samples `Aout,Vdd` with 0 < Vdd.\n", lineNumber, filePath);
+			result = kCommonConstantReturnTypeError;
+
+			break;
+		}
+
+		if (inputs[kInputDistributionIndexAout].numberOfSamples == capacity)
+		{
+			capacity *= 2;
+
+			for (InputDistributionIndex i = 0; i < kInputDistributionIndexMax; i++)
+			{
+				double *	samples = (double *) realloc(inputs[i].samples, capacity * sizeof(double));
+
+				if (samples == NULL)
+				{
+					fprintf(stderr, "Error: Could not allocate memory for the samples of \"%s\".\n", filePath);
+					fclose(file);
+					freeGridInputDistributions(inputs);
+
+					return kCommonConstantReturnTypeError;
+				}
+
+				inputs[i].samples = samples;
+			}
+		}
+
+		inputs[kInputDistributionIndexAout].samples[inputs[kInputDistributionIndexAout].numberOfSamples++] = Aout;
+		inputs[kInputDistributionIndexVdd].samples[inputs[kInputDistributionIndexVdd].numberOfSamples++] = Vdd;
+	}
+
+	fclose(file);
+
+	if ((result == kCommonConstantReturnTypeSuccess) && (inputs[kInputDistributionIndexAout].numberOfSamples == 0))
+	{
+		fprintf(stderr, "Error: The input distribution file \"%s\" has no samples.\n", filePath);
+		result = kCommonConstantReturnTypeError;
+	}
+
+	if (result != kCommonConstantReturnTypeSuccess)
+	{
+		freeGridInputDistributions(inputs);
+
+		return result;
+	}
+
+	for (InputDistributionIndex i = 0; i < kInputDistributionIndexMax; i++)
+	{
+		qsort(inputs[i].samples, inputs[i].numberOfSamples, sizeof(double), compareDoubles);
+		inputs[i].low = inputs[i].samples[0];
+		inputs[i].high = inputs[i].samples[inputs[i].numberOfSamples - 1];
+	}
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+void
+freeGridInputDistributions(GridInputDistribution *  inputs)
+{
+	for (InputDistributionIndex i = 0; i < kInputDistributionIndexMax; i++)
+	{
+		free(inputs[i].samples);
+		inputs[i].samples = NULL;
+		inputs[i].numberOfSamples = 0;
+	}
+
+	return;
+}
+
+double
+getGridInputQuantile(const GridInputDistribution *  input, double probability)
+{
+	double	width = input->high - input->low;
+
+	switch (input->type)
+	{
+		case kGridInputDistributionUniform:
+			return input->low + probability * width;
+
+		case kGridInputDistributionGaussian:
+		{
+			double	standardDeviation;
+			double	mean = getGaussianInputParameters(input, &standardDeviation);
+
+			return mean + standardDeviation * getStandardGaussianQuantile(probability);
+		}
+
+		case kGridInputDistributionTriangular:
+			return (probability < 0.5) ?
+				input->low + width * sqrt(0.5 * probability) :
+				input->high - width * sqrt(0.5 * (1.0 - probability));
+
+		default:
+		{
+			/*
+			 *	The quantile of the empirical distribution, which gives each
+			 *	sample the same probability.
+			 */
+			size_t	index = (size_t)(probability * (double)input->numberOfSamples);
+
+			return input->samples[(index < input->numberOfSamples) ? index : input->numberOfSamples - 1];
+		}
+	}
+}
+
+/**
+ *	@brief  Transforms pairs of independent uniform values in [0, 1) into pairs of input samples.
+ *		Gaussian inputs use the Box-Muller transform of each pair, and the others the quantiles.
+ *
+ *	@param  inputs		: Array of `kInputDistributionIndexMax` distributions.
+ *	@param  uniform0	: Array of `numberOfSamples` uniform values.
+ *	@param  uniform1	: Array of `numberOfSamples` uniform values.
+ *	@param  Aout		: Array of `numberOfSamples` values, where the function writes the Aout samples.
+ *	@param  Vdd		: Array of `numberOfSamples` values, where the function writes the Vdd samples.
+ *	@param  numberOfSamples	: The number of pairs.
+ */
+static void
+transformUniformPairs(
+	const GridInputDistribution *	inputs,
+	const double *			uniform0,
+	const double *			uniform1,
+	double *			Aout,
+	double *			Vdd,
+	size_t				numberOfSamples)
+{
+	if (inputs[kInputDistributionIndexAout].type == kGridInputDistributionGaussian)
+	{
+		double	AoutStandardDeviation;
+		double	VddStandardDeviation;
+		double	AoutMean = getGaussianInputParameters(&inputs[kInputDistributionIndexAout], &AoutStandardDeviation);
+		double	VddMean = getGaussianInputParameters(&inputs[kInputDistributionIndexVdd], &VddStandardDeviation);
+
+		for (size_t i = 0; i < numberOfSamples; i++)
+		{
+			double	radius = sqrt(-2.0 * log1p(-uniform0[i]));
+			double	angle = 2.0 * M_PI * uniform1[i];
+
+			Aout[i] = AoutMean + AoutStandardDeviation * radius * cos(angle);
+			Vdd[i] = VddMean + VddStandardDeviation * radius * sin(angle);
+		}
+
+		return;
+	}
+
+	for (size_t i = 0; i < numberOfSamples; i++)
+	{
+		Aout[i] = getGridInputQuantile(&inputs[kInputDistributionIndexAout], uniform0[i]);
+		Vdd[i] = getGridInputQuantile(&inputs[kInputDistributionIndexVdd], uniform1[i]);
+	}
+
+	return;
+}
+
+/**
+ *	@brief  Gets the nodes of an input: its quantiles at the midpoints in probability of `gridSize`
+ *		intervals of equal probability.
+ *
+ *	@param  input		: Pointer to the input distribution.
+ *	@param  gridSize	: The number of nodes.
+ *	@param  nodes		: Array of `gridSize` values, where the function writes the nodes, in increasing order.
+ */
+static void
+getGridNodes(const GridInputDistribution *  input, size_t gridSize, double *  nodes)
+{
+	for (size_t i = 0; i < gridSize; i++)
+	{
+		nodes[i] = getGridInputQuantile(input, ((double)i + 0.5) / (double)gridSize);
+	}
+
+	return;
+}
+
+/**
+ *	@brief  Gets the range of the outputs of a grid. The outputs are monotone in each input, so the
+ *		extremes are at the corners of the grid.
+ *
+ *	@param  inputs		: Array of `kInputDistributionIndexMax` distributions.
+ *	@param  gridSize	: The number of nodes per input.
+ *	@param  variant		: The sensor variant / configuration.
+ *	@param  low		: Pointer to where the function writes the smallest output.
+ *	@param  high		: Pointer to where the function writes a value just above the largest output.
+ */
+static void
+getGridOutputRange(const GridInputDistribution *  inputs, size_t gridSize, OutputDistributionIndex variant, double *  low, double *  high)
+{
+	CalibrationFunction	calibrationFunction = getCalibrationFunction(variant);
+	double			AoutNodes[2] =
+				{
+					getGridInputQuantile(&inputs[kInputDistributionIndexAout], 0.5 / (double)gridSize),
+					getGridInputQuantile(&inputs[kInputDistributionIndexAout], 1.0 - 0.5 / (double)gridSize),
+				};
+	double			VddNodes[2] =
+				{
+					getGridInputQuantile(&inputs[kInputDistributionIndexVdd], 0.5 / (double)gridSize),
+					getGridInputQuantile(&inputs[kInputDistributionIndexVdd], 1.0 - 0.5 / (double)gridSize),
+				};
+
+	*low = INFINITY;
+	*high = -INFINITY;
+
+	for (int i = 0; i < 2; i++)
+	{
+		for (int j = 0; j < 2; j++)
+		{
+			double	Pa = calibrationFunction(AoutNodes[i], VddNodes[j]);
+
+			*low = fmin(*low, Pa);
+			*high = fmax(*high, Pa);
+		}
+	}
+
+	*high = (*high > *low) ? nextafter(*high, INFINITY) : *low + 1.0;
+
+	return;
+}
+
+void
+propagateGrid(
+	const GridInputDistribution *	inputs,
+	size_t				gridSize,
+	OutputDistributionIndex		variant,
+	StreamingStatistics *		statistics,
+	Histogram *			histogram)
+{
+	CalibrationBatchFunction	calibrationBatchFunction = getCalibrationBatchFunction(getCalibrationKernelImplementation(), variant);
+	double *			AoutNodes = (double *) checkedMalloc(gridSize * sizeof(double), __FILE__, __LINE__);
+	double *			VddNodes = (double *) checkedMalloc(gridSize * sizeof(double), __FILE__, __LINE__);
+	double *			Aout = (double *) checkedMalloc(gridSize * sizeof(double), __FILE__, __LINE__);
+	double *			Pa = (double *) checkedMalloc(gridSize * sizeof(double), __FILE__, __LINE__);
+
+	getGridNodes(&inputs[kInputDistributionIndexAout], gridSize, AoutNodes);
+	getGridNodes(&inputs[kInputDistributionIndexVdd], gridSize, VddNodes);
+
+	/*
+	 *	One row of the grid per batch: a node of Aout with all nodes of Vdd.
+	 */
+	for (size_t i = 0; i < gridSize; i++)
+	{
+		for (size_t j = 0; j < gridSize; j++)
+		{
+			Aout[j] = AoutNodes[i];
+		}
+
+		calibrationBatchFunction(Aout, VddNodes, Pa, gridSize);
+		addDoubleSamplesToStreamingStatistics(statistics, Pa, gridSize);
+
+		if (histogram != NULL)
+		{
+			addDoubleSamplesToHistogram(histogram, Pa, gridSize);
+		}
+	}
+
+	free(AoutNodes);
+	free(VddNodes);
+	free(Aout);
+	free(Pa);
+
+	return;
+}
+
+/**
+ *	@brief  Returns the mean and variance of the outputs of a grid, whose pairs of nodes are the
+ *		whole population of equal weight rather than samples of it.
+ *
+ *	@param  statistics		: Pointer to the statistics of the outputs of the grid.
+ *	@return MeanAndVariance		: The mean and variance.
+ */
+static MeanAndVariance
+getGridMeanAndVariance(const StreamingStatistics *  statistics)
+{
+	MeanAndVariance	meanAndVariance = getStreamingStatisticsMeanAndVariance(statistics);
+
+	if (statistics->numberOfSamples > 1)
+	{
+		meanAndVariance.variance *= (double)(statistics->numberOfSamples - 1) / (double)statistics->numberOfSamples;
+	}
+
+	return meanAndVariance;
+}
+
+/**
+ *	@brief  Returns a quantile of the samples of a histogram, interpolated linearly within its bin.
+ *
+ *	@param  histogram	: Pointer to the histogram.
+ *	@param  probability	: The probability of the quantile, in [0, 1].
+ *	@return double		: The quantile.
+ */
+static double
+getHistogramQuantile(const Histogram *  histogram, double probability)
+{
+	uint64_t	total = histogram->underflowCount + histogram->overflowCount;
+	double		binWidth = (histogram->high - histogram->low) / (double)histogram->numberOfBins;
+	double		target;
+	double		cumulative = (double)histogram->underflowCount;
+
+	for (size_t i = 0; i < histogram->numberOfBins; i++)
+	{
+		total += histogram->counts[i];
+	}
+
+	target = probability * (double)total;
+
+	if (target <= cumulative)
+	{
+		return histogram->low;
+	}
+
+	for (size_t i = 0; i < histogram->numberOfBins; i++)
+	{
+		if ((histogram->counts[i] > 0) && (cumulative + (double)histogram->counts[i] >= target))
+		{
+			return histogram->low + binWidth * ((double)i + (target - cumulative) / (double)histogram->counts[i]);
+		}
+
+		cumulative += (double)histogram->counts[i];
+	}
+
+	return histogram->high;
+}
+
+/**
+ *	@brief  Returns the largest difference between the CDFs of the samples of two histograms with
+ *		the same bins, over the edges of the bins.
+ *
+ *	@param  histogram	: Pointer to the first histogram.
+ *	@param  other		: Pointer to the second histogram.
+ *	@return double		: The largest difference.
+ */
+static double
+getMaximumHistogramCdfDifference(const Histogram *  histogram, const Histogram *  other)
+{
+	double		totals[2] = { (double)(histogram->underflowCount + histogram->overflowCount), (double)(other->underflowCount + other->overflowCount) };
+	double		cumulatives[2] = { (double)histogram->underflowCount, (double)other->underflowCount };
+	double		maximumDifference;
+
+	for (size_t i = 0; i < histogram->numberOfBins; i++)
+	{
+		totals[0] += (double)histogram->counts[i];
+		totals[1] += (double)other->counts[i];
+	}
+
+	maximumDifference = fabs(cumulatives[0] / totals[0] - cumulatives[1] / totals[1]);
+
+	for (size_t i = 0; i < histogram->numberOfBins; i++)
+	{
+		cumulatives[0] += (double)histogram->counts[i];
+		cumulatives[1] += (double)other->counts[i];
+		maximumDifference = fmax(maximumDifference, fabs(cumulatives[0] / totals[0] - cumulatives[1] / totals[1]));
+	}
+
+	return maximumDifference;
+}
+
+void
+runGridPropagation(
+	const GridInputDistribution *	inputs,
+	size_t				gridSize,
+	OutputDistributionIndex		outputSelectLowerBound,
+	OutputDistributionIndex		outputSelectUpperBound,
+	const char **			outputVariableDescriptions)
+{
+	const double	probabilities[kQuantileSketchNumberOfQuantiles] = kQuantileSketchProbabilities;
+
+	printf(
+		"Grid propagation (%s inputs, %zu x %zu grid, %d bins):\n",
+		getGridInputDistributionName(inputs[kInputDistributionIndexAout].type),
+		gridSize,
+		gridSize,
+		kGridPropagationNumberOfBins);
+
+	for (OutputDistributionIndex variant = outputSelectLowerBound; variant < outputSelectUpperBound; variant++)
+	{
+		StreamingStatistics	statistics;
+		Histogram		histogram;
+		MeanAndVariance		meanAndVariance;
+		double			low;
+		double			high;
+		clock_t			start = clock();
+		double			seconds;
+
+		getGridOutputRange(inputs, gridSize, variant, &low, &high);
+		initializeStreamingStatistics(&statistics);
+		initializeHistogram(&histogram, low, high, kGridPropagationNumberOfBins);
+		propagateGrid(inputs, gridSize, variant, &statistics, &histogram);
+		seconds = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+		meanAndVariance = getGridMeanAndVariance(&statistics);
+
+		printf(
+			"\t%s: mean %.6lf Pa, standard deviation %.6lf Pa,",
+			outputVariableDescriptions[variant],
+			meanAndVariance.mean,
+			sqrt(meanAndVariance.variance));
+
+		for (size_t i = 0; i < kQuantileSketchNumberOfQuantiles; i++)
+		{
+			printf("%s p%g %.6lf Pa", (i == 0) ? "" : ",", probabilities[i] * 100.0, getHistogramQuantile(&histogram, probabilities[i]));
+		}
+
+		printf(", range [%.6lf, %.6lf] Pa, %.3lf ms\n", statistics.minimum, statistics.maximum, seconds * 1e3);
+		freeHistogram(&histogram);
+	}
+
+	return;
+}
+
+void
+runGridPropagationConvergenceReport(
+	const GridInputDistribution *	inputs,
+	size_t				maximumGridSize,
+	size_t				numberOfReferenceSamples,
+	uint64_t			seed,
+	OutputDistributionIndex		outputSelectLowerBound,
+	OutputDistributionIndex		outputSelectUpperBound,
+	const char **			outputVariableDescriptions)
+{
+	StreamingStatistics	referenceStatistics[kOutputDistributionIndexCalibratedSensorOutputMax];
+	Histogram		referenceHistograms[kOutputDistributionIndexCalibratedSensorOutputMax];
+	double			uniform0[kMonteCarloSampleBlockSize];
+	double			uniform1[kMonteCarloSampleBlockSize];
+	double			Aout[kMonteCarloSampleBlockSize];
+	double			Vdd[kMonteCarloSampleBlockSize];
+	double			Pa[kMonteCarloSampleBlockSize];
+	clock_t			start = clock();
+	double			referenceSeconds;
+
+	/*
+	 *	The histograms of the reference and of all grids share the bins over
+	 *	the range of the largest grid, which contains the nodes of all smaller
+	 *	grids, and the reference samples outside it fall in the underflow and
+	 *	overflow bins.
+	 */
+	for (OutputDistributionIndex variant = outputSelectLowerBound; variant < outputSelectUpperBound; variant++)
+	{
+		double	low;
+		double	high;
+
+		getGridOutputRange(inputs, maximumGridSize, variant, &low, &high);
+		initializeStreamingStatistics(&referenceStatistics[variant]);
+		initializeHistogram(&referenceHistograms[variant], low, high, kGridPropagationNumberOfBins);
+	}
+
+	for (size_t blockStart = 0; blockStart < numberOfReferenceSamples; blockStart += kMonteCarloSampleBlockSize)
+	{
+		size_t	blockSize = (numberOfReferenceSamples - blockStart < kMonteCarloSampleBlockSize) ? (numberOfReferenceSamples - blockStart) : kMonteCarloSampleBlockSize;
+
+		drawUniformDoublePairsPhilox(seed, blockStart, 0.0, 1.0, 0.0, 1.0, uniform0, uniform1, blockSize);
+		transformUniformPairs(inputs, uniform0, uniform1, Aout, Vdd, blockSize);
+
+		for (OutputDistributionIndex variant = outputSelectLowerBound; variant < outputSelectUpperBound; variant++)
+		{
+			getCalibrationBatchFunction(getCalibrationKernelImplementation(), variant)(Aout, Vdd, Pa, blockSize);
+			addDoubleSamplesToStreamingStatistics(&referenceStatistics[variant], Pa, blockSize);
+			addDoubleSamplesToHistogram(&referenceHistograms[variant], Pa, blockSize);
+		}
+	}
+
+	referenceSeconds = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+
+	printf(
+		"Grid propagation convergence (%s inputs; errors relative to Monte Carlo with %zu Philox samples, %.3lf ms per output, which has its own standard errors; CDF error over %d bins):\n",
+		getGridInputDistributionName(inputs[kInputDistributionIndexAout].type),
+		numberOfReferenceSamples,
+		referenceSeconds * 1e3 / (double)(outputSelectUpperBound - outputSelectLowerBound),
+		kGridPropagationNumberOfBins);
+
+	for (OutputDistributionIndex variant = outputSelectLowerBound; variant < outputSelectUpperBound; variant++)
+	{
+		MeanAndVariance	reference = getStreamingStatisticsMeanAndVariance(&referenceStatistics[variant]);
+
+		printf(
+			"\t%s: Monte Carlo mean %.6lf Pa (standard error %.3e Pa), standard deviation %.6lf Pa:\n",
+			outputVariableDescriptions[variant],
+			reference.mean,
+			sqrt(reference.variance / (double)numberOfReferenceSamples),
+			sqrt(reference.variance));
+
+		for (size_t gridSize = kGridPropagationConvergenceMinimumGridSize; ; gridSize *= 2)
+		{
+			StreamingStatistics	statistics;
+			Histogram		histogram;
+			MeanAndVariance		meanAndVariance;
+			double			seconds;
+
+			if (gridSize > maximumGridSize)
+			{
+				gridSize = maximumGridSize;
+			}
+
+			start = clock();
+			initializeStreamingStatistics(&statistics);
+			initializeHistogram(&histogram, referenceHistograms[variant].low, referenceHistograms[variant].high, kGridPropagationNumberOfBins);
+			propagateGrid(inputs, gridSize, variant, &statistics, &histogram);
+			seconds = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+			meanAndVariance = getGridMeanAndVariance(&statistics);
+
+			printf(
+				"\t\t%6zu x %-6zu grid (%10.3lf ms): mean error %.3e Pa, standard deviation error %.3e Pa, CDF error %.3e\n",
+				gridSize,
+				gridSize,
+				seconds * 1e3,
+				fabs(meanAndVariance.mean - reference.mean),
+				fabs(sqrt(meanAndVariance.variance) - sqrt(reference.variance)),
+				getMaximumHistogramCdfDifference(&histogram, &referenceHistograms[variant]));
+			freeHistogram(&histogram);
+
+			if (gridSize == maximumGridSize)
+			{
+				break;
+			}
+		}
+
+		freeHistogram(&referenceHistograms[variant]);
+	}
+
+	return;
+}
+
+CommonConstantReturnType
+runGridPropagationSelfTest(void)
+{
+	const double			probabilities[] = { 1e-12, 1e-6, 0.01, 0.3, 0.5, 0.7, 0.99, 1.0 - 1e-6 };
+	GridInputDistribution		inputs[kInputDistributionIndexMax];
+	double				maximumProbabilityError = 0.0;
+	bool				passed;
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	printf("Grid propagation self-test (%d x %d uniform grid):\n", kGridPropagationSelfTestGridSize, kGridPropagationSelfTestGridSize);
+
+	for (size_t i = 0; i < sizeof(probabilities) / sizeof(probabilities[0]); i++)
+	{
+		double	quantile = getStandardGaussianQuantile(probabilities[i]);
+		double	probability = (quantile < 0.0) ? 0.5 * erfc(-quantile / M_SQRT2) : 1.0 - 0.5 * erfc(quantile / M_SQRT2);
+
+		maximumProbabilityError = fmax(maximumProbabilityError, fabs(probability - probabilities[i]) / fmin(probabilities[i], 1.0 - probabilities[i]));
+	}
+
+	passed = (maximumProbabilityError <= kGridPropagationSelfTestMaximumProbabilityError);
+	printf("\tGaussian quantiles: maximum relative error in probability %.3e: %s\n", maximumProbabilityError, passed ? "PASS" : "FAIL");
+
+	if (!passed)
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	initializeGridInputDistributions(kGridInputDistributionUniform, NULL, inputs);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		AnalyticOutputDistribution	distribution;
+		MeanAndVariance			exact;
+		MeanAndVariance			grid;
+		StreamingStatistics		statistics;
+
+		initializeAnalyticOutputDistribution(
+			&distribution,
+			variant,
+			inputs[kInputDistributionIndexAout].low,
+			inputs[kInputDistributionIndexAout].high,
+			inputs[kInputDistributionIndexVdd].low,
+			inputs[kInputDistributionIndexVdd].high);
+		exact = getAnalyticOutputMeanAndVariance(&distribution);
+		initializeStreamingStatistics(&statistics);
+		propagateGrid(inputs, kGridPropagationSelfTestGridSize, variant, &statistics, NULL);
+		grid = getGridMeanAndVariance(&statistics);
+		passed = (fabs(grid.mean - exact.mean) <= kGridPropagationSelfTestMaximumRelativeError * fabs(exact.mean)) &&
+				(fabs(grid.variance - exact.variance) <= kGridPropagationSelfTestMaximumRelativeError * exact.variance);
+		printf(
+			"\tVariant %u: mean %.9lf Pa (exact %.9lf Pa), variance %.9lf Pa^2 (exact %.9lf Pa^2): %s\n",
+			variant,
+			grid.mean,
+			exact.mean,
+			grid.variance,
+			exact.variance,
+			passed ? "PASS" : "FAIL");
+
+		if (!passed)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+	}
+
+	return result;
+}
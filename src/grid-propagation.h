@@ -0,0 +1,169 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "common.h"
+#include "utilities-config.h"
+#include "streaming-statistics.h"
+#include "histogram.h"
+
+/*
+ *	Distributions of the inputs of the grid propagation mode. The uniform
+ *	inputs are those of `utilities-config.h`; the others keep their scale:
+ *		kGridInputDistributionUniform		: Uniform in [low, high).
+ *		kGridInputDistributionGaussian		: Gaussian with the mean and variance of the uniform input.
+ *		kGridInputDistributionTriangular	: Triangular over [low, high], with the mode at the middle.
+ *		kGridInputDistributionEmpirical		: The sorted samples of a column of a file of `Aout,Vdd` pairs.
+ */
+typedef enum
+{
+	kGridInputDistributionUniform		= 0,
+	kGridInputDistributionGaussian		= 1,
+	kGridInputDistributionTriangular	= 2,
+	kGridInputDistributionEmpirical		= 3,
+	kGridInputDistributionMax,
+} GridInputDistributionType;
+
+typedef struct
+{
+	GridInputDistributionType	type;
+	double				low;
+	double				high;
+	double *			samples;
+	size_t				numberOfSamples;
+} GridInputDistribution;
+
+/**
+ *	@brief  Returns the name of an input distribution, as accepted by `parseGridInputDistributionName()`.
+ *
+ *	@param  type		: The input distribution.
+ *	@return const char *	: The name, or "unknown".
+ */
+const char *	getGridInputDistributionName(GridInputDistributionType type);
+
+/**
+ *	@brief  Parses the name of an input distribution.
+ *
+ *	@param  name	: The name.
+ *	@param  type	: Pointer to where the function writes the input distribution.
+ *	@return		: `kCommonConstantReturnTypeSuccess` if successful,
+ *			   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	parseGridInputDistributionName(const char *  name, GridInputDistributionType *  type);
+
+/**
+ *	@brief  Sets up the distributions of both inputs. For empirical inputs, reads the `Aout,Vdd`
+ *		pairs of a file, one per line, and sorts the samples of each input.
+ *
+ *	@param  type		: The input distribution.
+ *	@param  filePath	: The path of the file of samples of empirical inputs, else unused.
+ *	@param  inputs		: Array of `kInputDistributionIndexMax` distributions, indexed by `InputDistributionIndex`.
+ *	@return			: `kCommonConstantReturnTypeSuccess` if successful,
+ *				   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	initializeGridInputDistributions(GridInputDistributionType type, const char *  filePath, GridInputDistribution *  inputs);
+
+/**
+ *	@brief  Frees the samples of empirical input distributions.
+ *
+ *	@param  inputs	: Array of `kInputDistributionIndexMax` distributions.
+ */
+void	freeGridInputDistributions(GridInputDistribution *  inputs);
+
+/**
+ *	@brief  Returns a quantile of an input distribution.
+ *
+ *	@param  input		: Pointer to the input distribution.
+ *	@param  probability	: The probability of the quantile, in (0, 1).
+ *	@return double		: The quantile.
+ */
+double	getGridInputQuantile(const GridInputDistribution *  input, double probability);
+
+/**
+ *	@brief  Propagates a grid of `gridSize` nodes per input through the calibration of a variant:
+ *		calibrates all `gridSize` squared pairs of nodes, of equal weight, and adds the outputs
+ *		to running statistics and, if not `NULL`, a histogram.
+ *
+ *	@param  inputs		: Array of `kInputDistributionIndexMax` distributions.
+ *	@param  gridSize	: The number of nodes per input.
+ *	@param  variant		: The sensor variant / configuration.
+ *	@param  statistics	: Pointer to initialized statistics, to add the outputs to.
+ *	@param  histogram	: Pointer to an initialized histogram, to add the outputs to, or `NULL`.
+ */
+void	propagateGrid(
+		const GridInputDistribution *	inputs,
+		size_t				gridSize,
+		OutputDistributionIndex		variant,
+		StreamingStatistics *		statistics,
+		Histogram *			histogram);
+
+/**
+ *	@brief  Prints, for each selected output, the mean, standard deviation, and quantiles of the
+ *		output of a grid, binned into `kGridPropagationNumberOfBins` bins over its range, and the
+ *		time it takes.
+ *
+ *	@param  inputs				: Array of `kInputDistributionIndexMax` distributions.
+ *	@param  gridSize			: The number of nodes per input.
+ *	@param  outputSelectLowerBound		: The first selected output.
+ *	@param  outputSelectUpperBound		: One past the last selected output.
+ *	@param  outputVariableDescriptions	: The descriptions of the outputs, indexed by `OutputDistributionIndex`.
+ */
+void	runGridPropagation(
+		const GridInputDistribution *	inputs,
+		size_t				gridSize,
+		OutputDistributionIndex		outputSelectLowerBound,
+		OutputDistributionIndex		outputSelectUpperBound,
+		const char **			outputVariableDescriptions);
+
+/**
+ *	@brief  Prints, for each selected output, the errors of the mean, standard deviation, and CDF
+ *		of grids from `kGridPropagationConvergenceMinimumGridSize` nodes per input, doubling
+ *		up to `maximumGridSize`, relative to Monte Carlo with Philox inputs, and their times.
+ *
+ *	@param  inputs				: Array of `kInputDistributionIndexMax` distributions.
+ *	@param  maximumGridSize			: The largest number of nodes per input.
+ *	@param  numberOfReferenceSamples	: The number of samples of the Monte Carlo reference.
+ *	@param  seed				: The seed of the Philox generator of the reference.
+ *	@param  outputSelectLowerBound		: The first selected output.
+ *	@param  outputSelectUpperBound		: One past the last selected output.
+ *	@param  outputVariableDescriptions	: The descriptions of the outputs, indexed by `OutputDistributionIndex`.
+ */
+void	runGridPropagationConvergenceReport(
+		const GridInputDistribution *	inputs,
+		size_t				maximumGridSize,
+		size_t				numberOfReferenceSamples,
+		uint64_t			seed,
+		OutputDistributionIndex		outputSelectLowerBound,
+		OutputDistributionIndex		outputSelectUpperBound,
+		const char **			outputVariableDescriptions);
+
+/**
+ *	@brief  Checks the Gaussian quantiles against the Gaussian CDF, and the mean and variance of
+ *		uniform grids of each variant against the exact distribution.
+ *
+ *	@return	: `kCommonConstantReturnTypeSuccess` if all are within `kGridPropagationSelfTestMaximumProbabilityError`
+ *		  and `kGridPropagationSelfTestMaximumRelativeError`, else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runGridPropagationSelfTest(void);
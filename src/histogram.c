@@ -0,0 +1,416 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include "histogram.h"
+#include "montecarlo.h"
+
+/**
+ *	@brief  Returns the lower edge of a bin of a histogram, as written to the histogram files.
+ *		The edge of bin `numberOfBins` is `high`.
+ *
+ *	@param  histogram	: Pointer to the histogram.
+ *	@param  bin		: The bin, at most `numberOfBins`.
+ *	@return double		: The lower edge of the bin.
+ */
+static inline double
+getHistogramBinEdge(const Histogram *  histogram, size_t bin)
+{
+	double	binWidth = (histogram->high - histogram->low) / histogram->numberOfBins;
+
+	return (bin == histogram->numberOfBins) ? histogram->high : (histogram->low + bin * binWidth);
+}
+
+/*
+ *	Generates the function that adds a block of samples of a floating-point
+ *	type to a histogram. The bin from the scaled offset of a sample can be
+ *	off by one next to an edge, due to rounding, so it is corrected against
+ *	the edges of `getHistogramBinEdge()`, and a sample on an edge is counted
+ *	in the bin above it, like in the files.
+ */
+#define DEFINE_ADD_SAMPLES_TO_HISTOGRAM(functionName, sampleType)					\
+	void												\
+	functionName(Histogram *  histogram, const sampleType *  samples, size_t numberOfSamples)	\
+	{												\
+		double	binsPerUnit = histogram->numberOfBins / (histogram->high - histogram->low);	\
+		double	lastBin = (double)(histogram->numberOfBins - 1);				\
+														\
+		for (size_t i = 0; i < numberOfSamples; i++)						\
+		{											\
+			double	sample = samples[i];							\
+			size_t	bin;									\
+														\
+			/*										\
+			 *	NaN samples count as underflow.						\
+			 */										\
+			if (!(sample >= histogram->low))						\
+			{										\
+				histogram->underflowCount++;						\
+				continue;								\
+			}										\
+														\
+			if (sample >= histogram->high)							\
+			{										\
+				histogram->overflowCount++;						\
+				continue;								\
+			}										\
+														\
+			bin = (size_t) fmin((sample - histogram->low) * binsPerUnit, lastBin);		\
+														\
+			if (sample < getHistogramBinEdge(histogram, bin))				\
+			{										\
+				bin--;									\
+			}										\
+			else if (sample >= getHistogramBinEdge(histogram, bin + 1))			\
+			{										\
+				bin++;									\
+			}										\
+														\
+			histogram->counts[bin]++;							\
+		}											\
+														\
+		return;											\
+	}
+
+DEFINE_ADD_SAMPLES_TO_HISTOGRAM(addDoubleSamplesToHistogram, double)
+DEFINE_ADD_SAMPLES_TO_HISTOGRAM(addFloatSamplesToHistogram, float)
+
+
+void
+initializeHistogram(Histogram *  histogram, double low, double high, size_t numberOfBins)
+{
+	*histogram = (Histogram)
+			{
+				.low		= low,
+				.high		= high,
+				.numberOfBins	= numberOfBins,
+				.underflowCount	= 0,
+				.overflowCount	= 0,
+				.counts		= (uint64_t *) checkedMalloc(numberOfBins * sizeof(uint64_t), __FILE__, __LINE__),
+			};
+
+	memset(histogram->counts, 0, numberOfBins * sizeof(uint64_t));
+
+	return;
+}
+
+void
+freeHistogram(Histogram *  histogram)
+{
+	free(histogram->counts);
+	histogram->counts = NULL;
+
+	return;
+}
+
+void
+mergeHistogram(Histogram *  histogram, const Histogram *  other)
+{
+	for (size_t bin = 0; bin < histogram->numberOfBins; bin++)
+	{
+		histogram->counts[bin] += other->counts[bin];
+	}
+
+	histogram->underflowCount += other->underflowCount;
+	histogram->overflowCount += other->overflowCount;
+
+	return;
+}
+
+/**
+ *	@brief  Writes a histogram as the CSV rows of its bins, from the underflow to the overflow bin.
+ *
+ *	@param  file		: The file to write to.
+ *	@param  histogram	: Pointer to the histogram.
+ *	@param  output		: The index of the output of the histogram.
+ */
+static void
+writeHistogramCSVRows(FILE *  file, const Histogram *  histogram, OutputDistributionIndex output)
+{
+	fprintf(file, "%u,-inf,%.10g,%" PRIu64 "\n", output, histogram->low, histogram->underflowCount);
+
+	for (size_t bin = 0; bin < histogram->numberOfBins; bin++)
+	{
+		fprintf(
+			file,
+			"%u,%.10g,%.10g,%" PRIu64 "\n",
+			output,
+			getHistogramBinEdge(histogram, bin),
+			getHistogramBinEdge(histogram, bin + 1),
+			histogram->counts[bin]);
+	}
+
+	fprintf(file, "%u,%.10g,inf,%" PRIu64 "\n", output, histogram->high, histogram->overflowCount);
+
+	return;
+}
+
+/**
+ *	@brief  Writes a histogram as a JSON object.
+ *
+ *	@param  file				: The file to write to.
+ *	@param  histogram			: Pointer to the histogram.
+ *	@param  output				: The index of the output of the histogram.
+ *	@param  outputVariableDescription	: The description of the output.
+ */
+static void
+writeHistogramJSONObject(FILE *  file, const Histogram *  histogram, OutputDistributionIndex output, const char *  outputVariableDescription)
+{
+	fprintf(
+		file,
+		"{\"output\": %u, \"description\": \"%s\", \"low\": %.17g, \"high\": %.17g, \"numberOfBins\": %zu, "
+		"\"underflow\": %" PRIu64 ", \"overflow\": %" PRIu64 ", \"counts\": [",
+		output,
+		outputVariableDescription,
+		histogram->low,
+		histogram->high,
+		histogram->numberOfBins,
+		histogram->underflowCount,
+		histogram->overflowCount);
+
+	for (size_t bin = 0; bin < histogram->numberOfBins; bin++)
+	{
+		fprintf(file, "%s%" PRIu64, (bin == 0) ? "" : ", ", histogram->counts[bin]);
+	}
+
+	fprintf(file, "]}");
+
+	return;
+}
+
+CommonConstantReturnType
+writeHistogramsToFile(
+	const char *		filePath,
+	const Histogram *	histograms,
+	OutputDistributionIndex	outputSelectLowerBound,
+	OutputDistributionIndex	outputSelectUpperBound,
+	const char **		outputVariableDescriptions)
+{
+	size_t	filePathLength = strlen(filePath);
+	size_t	extensionLength = strlen(kHistogramJSONFileExtension);
+	bool	isJSON = (filePathLength >= extensionLength) && (strcmp(&filePath[filePathLength - extensionLength], kHistogramJSONFileExtension) == 0);
+	FILE *	file = fopen(filePath, "w");
+
+	if (file == NULL)
+	{
+		fprintf(stderr, "Error: Could not open \"%s\" for writing.\n", filePath);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	if (isJSON)
+	{
+		fprintf(file, "{\"histograms\": [");
+
+		for (OutputDistributionIndex output = outputSelectLowerBound; output < outputSelectUpperBound; output++)
+		{
+			fprintf(file, "%s", (output == outputSelectLowerBound) ? "" : ", ");
+			writeHistogramJSONObject(file, &histograms[output], output, outputVariableDescriptions[output]);
+		}
+
+		fprintf(file, "]}\n");
+	}
+	else
+	{
+		fprintf(file, "output,bin_low,bin_high,count\n");
+
+		for (OutputDistributionIndex output = outputSelectLowerBound; output < outputSelectUpperBound; output++)
+		{
+			writeHistogramCSVRows(file, &histograms[output], output);
+		}
+	}
+
+	fclose(file);
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+/**
+ *	@brief  Checks the counts of a histogram against expected counts, and prints the outcome.
+ *
+ *	@param  histogram		: Pointer to the histogram to check.
+ *	@param  expected		: Pointer to the histogram of the expected counts, with the same bins.
+ *	@param  description		: The description of the case.
+ *	@return bool			: Whether the counts match.
+ */
+static bool
+checkHistogramCounts(const Histogram *  histogram, const Histogram *  expected, const char *  description)
+{
+	bool	passed = (histogram->underflowCount == expected->underflowCount) && (histogram->overflowCount == expected->overflowCount);
+
+	for (size_t bin = 0; bin < histogram->numberOfBins; bin++)
+	{
+		passed = passed && (histogram->counts[bin] == expected->counts[bin]);
+	}
+
+	printf(
+		"\t%s: underflow %" PRIu64 ", overflow %" PRIu64 ": %s\n",
+		description,
+		histogram->underflowCount,
+		histogram->overflowCount,
+		passed ? "PASS" : "FAIL");
+
+	return passed;
+}
+
+CommonConstantReturnType
+runHistogramSelfTest(void)
+{
+	const size_t			numberOfBins = kHistogramSelfTestNumberOfBins;
+	const double			outOfRangeSamples[] = { NAN, -INFINITY, -3.0, -2.0 - 0x1p-50, 6.0, 6.0 + 0x1p-50, 7.0, INFINITY };
+	const float			outOfRangeSamplesFloat[] = { NAN, -INFINITY, -3.0f, -2.0f - 0x1p-20f, 6.0f, 6.0f + 0x1p-20f, 7.0f, INFINITY };
+	const size_t			numberOfOutOfRangeSamples = sizeof(outOfRangeSamples) / sizeof(outOfRangeSamples[0]);
+	double				edgeSamples[2 * (kHistogramSelfTestNumberOfBins + 1)];
+	Histogram			histogram;
+	Histogram			expected;
+	Histogram			singleThreadHistograms[kOutputDistributionIndexCalibratedSensorOutputMax];
+	Histogram			histograms[kOutputDistributionIndexCalibratedSensorOutputMax];
+	StreamingStatistics		streamingStatistics[kOutputDistributionIndexCalibratedSensorOutputMax];
+	CommandLineArguments		arguments = {0};
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	printf(
+		"Histogram self-test (%zu bins, %zu outputs counted by %d threads):\n",
+		numberOfBins,
+		(size_t) kHistogramSelfTestNumberOfSamples,
+		kHistogramSelfTestNumberOfThreads);
+
+	/*
+	 *	Each edge of bins whose width is not a power of two, and the sample
+	 *	just below it: the edge is counted in the bin above it, `high` in the
+	 *	overflow bin, and the sample just below `low` in the underflow bin.
+	 */
+	initializeHistogram(&histogram, kDefaultInputDistributionAoutUniformDistLow, kDefaultInputDistributionAoutUniformDistHigh, numberOfBins);
+	initializeHistogram(&expected, kDefaultInputDistributionAoutUniformDistLow, kDefaultInputDistributionAoutUniformDistHigh, numberOfBins);
+
+	for (size_t bin = 0; bin <= numberOfBins; bin++)
+	{
+		edgeSamples[2 * bin] = getHistogramBinEdge(&histogram, bin);
+		edgeSamples[2 * bin + 1] = nextafter(edgeSamples[2 * bin], -INFINITY);
+
+		if (bin < numberOfBins)
+		{
+			expected.counts[bin] = 2;
+		}
+	}
+
+	expected.underflowCount = 1;
+	expected.overflowCount = 1;
+	addDoubleSamplesToHistogram(&histogram, edgeSamples, 2 * (numberOfBins + 1));
+
+	if (!checkHistogramCounts(&histogram, &expected, "Bin edges and high"))
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	freeHistogram(&histogram);
+	freeHistogram(&expected);
+
+	/*
+	 *	NaN, below `low`, and at or above `high`, in double and single
+	 *	precision.
+	 */
+	initializeHistogram(&histogram, -2.0, 6.0, numberOfBins);
+	initializeHistogram(&expected, -2.0, 6.0, numberOfBins);
+	expected.underflowCount = 4;
+	expected.overflowCount = 4;
+	addDoubleSamplesToHistogram(&histogram, outOfRangeSamples, numberOfOutOfRangeSamples);
+
+	if (!checkHistogramCounts(&histogram, &expected, "NaN, underflow, and overflow"))
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	freeHistogram(&histogram);
+	initializeHistogram(&histogram, -2.0, 6.0, numberOfBins);
+	addFloatSamplesToHistogram(&histogram, outOfRangeSamplesFloat, numberOfOutOfRangeSamples);
+
+	if (!checkHistogramCounts(&histogram, &expected, "NaN, underflow, and overflow (single precision)"))
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	freeHistogram(&histogram);
+	freeHistogram(&expected);
+
+	/*
+	 *	The Philox outputs do not depend on the number of threads, so the
+	 *	merged histograms of the threads must match those of one thread.
+	 */
+	arguments.common.outputSelect = kOutputDistributionIndexCalibratedSensorOutputMax;
+	arguments.common.numberOfMonteCarloIterations = kHistogramSelfTestNumberOfSamples;
+	arguments.seed = kDefaultMonteCarloSeed;
+	arguments.randomNumberGeneratorType = kRandomNumberGeneratorTypePhilox;
+	arguments.samplingStrategy = kSamplingStrategyIndependent;
+	arguments.histogramNumberOfBins = numberOfBins;
+
+	for (size_t run = 0; run < 2; run++)
+	{
+		Histogram *	runHistograms = (run == 0) ? singleThreadHistograms : histograms;
+
+		arguments.numberOfThreads = (run == 0) ? 1 : kHistogramSelfTestNumberOfThreads;
+		initializeOutputHistograms(&arguments, runHistograms);
+
+		for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+		{
+			initializeStreamingStatistics(&streamingStatistics[variant]);
+		}
+
+		if (runNativeMonteCarloIterationRange(
+			&arguments,
+			NULL,
+			NULL,
+			streamingStatistics,
+			NULL,
+			runHistograms,
+			0,
+			kHistogramSelfTestNumberOfSamples,
+			0) != kCommonConstantReturnTypeSuccess)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+	}
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		char	description[64];
+
+		snprintf(description, sizeof(description), "Variant %u, merged from threads", variant);
+
+		if (!checkHistogramCounts(&histograms[variant], &singleThreadHistograms[variant], description))
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+
+		freeHistogram(&singleThreadHistograms[variant]);
+		freeHistogram(&histograms[variant]);
+	}
+
+	return result;
+}
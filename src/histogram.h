@@ -0,0 +1,117 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "common.h"
+#include "utilities-config.h"
+
+/*
+ *	Histogram of a stream of samples over `numberOfBins` bins of equal width
+ *	in [`low`, `high`), with the samples below and above the range counted in
+ *	`underflowCount` and `overflowCount`.
+ */
+typedef struct
+{
+	double		low;
+	double		high;
+	size_t		numberOfBins;
+	uint64_t	underflowCount;
+	uint64_t	overflowCount;
+	uint64_t *	counts;
+} Histogram;
+
+/**
+ *	@brief  Initializes a histogram with no samples, and allocates its bins.
+ *
+ *	@param  histogram	: Pointer to the histogram to initialize.
+ *	@param  low		: The lower end of the range of the bins.
+ *	@param  high		: The upper end of the range of the bins, greater than `low`.
+ *	@param  numberOfBins	: The number of bins.
+ */
+void	initializeHistogram(Histogram *  histogram, double low, double high, size_t numberOfBins);
+
+/**
+ *	@brief  Frees the bins of a histogram.
+ *
+ *	@param  histogram	: Pointer to the histogram.
+ */
+void	freeHistogram(Histogram *  histogram);
+
+/**
+ *	@brief  Adds a block of samples to a histogram.
+ *
+ *	@param  histogram	: Pointer to the histogram to add the samples to.
+ *	@param  samples		: The samples.
+ *	@param  numberOfSamples	: The number of samples.
+ */
+void	addDoubleSamplesToHistogram(Histogram *  histogram, const double *  samples, size_t numberOfSamples);
+
+/**
+ *	@brief  Adds a block of single-precision samples to a histogram.
+ *
+ *	@param  histogram	: Pointer to the histogram to add the samples to.
+ *	@param  samples		: The samples.
+ *	@param  numberOfSamples	: The number of samples.
+ */
+void	addFloatSamplesToHistogram(Histogram *  histogram, const float *  samples, size_t numberOfSamples);
+
+/**
+ *	@brief  Adds the counts of another histogram with the same bins to a histogram.
+ *
+ *	@param  histogram	: Pointer to the histogram to merge into.
+ *	@param  other		: Pointer to the histogram to merge.
+ */
+void	mergeHistogram(Histogram *  histogram, const Histogram *  other);
+
+/**
+ *	@brief  Writes histograms to a file, as JSON if the path ends with `kHistogramJSONFileExtension`,
+ *		else as CSV with one `output,bin_low,bin_high,count` row per bin, including the underflow
+ *		and overflow bins, whose open ends are `-inf` and `inf`.
+ *
+ *	@param  filePath			: The path of the file to write.
+ *	@param  histograms			: Array of histograms, indexed by `OutputDistributionIndex`.
+ *	@param  outputSelectLowerBound		: The first output whose histogram to write.
+ *	@param  outputSelectUpperBound		: One past the last output whose histogram to write.
+ *	@param  outputVariableDescriptions	: An array of strings containing the descriptions of the outputs.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	writeHistogramsToFile(
+					const char *		filePath,
+					const Histogram *	histograms,
+					OutputDistributionIndex	outputSelectLowerBound,
+					OutputDistributionIndex	outputSelectUpperBound,
+					const char **		outputVariableDescriptions);
+
+/**
+ *	@brief  Checks the counts of histograms of samples on and next to the bin edges, of NaN,
+ *		underflow, and overflow samples, and that the merged histograms of several threads
+ *		match those of one thread.
+ *
+ *	@return		: `kCommonConstantReturnTypeSuccess` if all checks pass,
+ *			   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runHistogramSelfTest(void);
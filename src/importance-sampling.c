@@ -0,0 +1,342 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "importance-sampling.h"
+#include "calibration.h"
+#include "calibration-inverse.h"
+#include "random-number-generator.h"
+
+/**
+ *	@brief  Returns the margin by which the output of a pair of inputs is in a tail: its difference to
+ *		the threshold, with the sign of the tail, so that the inputs of the tail have a non-negative margin.
+ *
+ *	@param  calibrationFunction	: The kernel of the variant.
+ *	@param  threshold		: The threshold, in Pascal.
+ *	@param  tailSign		: `1.0` for the upper tail, `-1.0` for the lower tail.
+ *	@param  Aout			: Ratiometric analog voltage value (in Volts).
+ *	@param  Vdd			: Supply voltage (in Volts).
+ *	@return double			: The margin, in Pascal.
+ */
+static double
+getTailMargin(CalibrationFunction calibrationFunction, double threshold, double tailSign, double Aout, double Vdd)
+{
+	return tailSign * (calibrationFunction(Aout, Vdd) - threshold);
+}
+
+/**
+ *	@brief  Finds, by bisection, where the margin of a tail changes sign along one input, with the
+ *		other input fixed.
+ *
+ *	@param  calibrationFunction	: The kernel of the variant.
+ *	@param  threshold		: The threshold, in Pascal.
+ *	@param  tailSign		: `1.0` for the upper tail, `-1.0` for the lower tail.
+ *	@param  isAoutVaried		: `true` to vary Aout with Vdd fixed to `otherInput`, `false` for the converse.
+ *	@param  otherInput		: The value of the fixed input.
+ *	@param  outside			: A value of the varied input with a negative margin.
+ *	@param  inside			: A value of the varied input with a non-negative margin.
+ *	@return double			: The last value of the varied input with a negative margin, so that all
+ *					  values with a non-negative margin are between it and `inside`.
+ */
+static double
+bisectTailBoundary(
+	CalibrationFunction	calibrationFunction,
+	double			threshold,
+	double			tailSign,
+	bool			isAoutVaried,
+	double			otherInput,
+	double			outside,
+	double			inside)
+{
+	for (int i = 0; i < kImportanceSamplingNumberOfBisections; i++)
+	{
+		double	middle = 0.5 * (outside + inside);
+
+		if ((middle == outside) || (middle == inside))
+		{
+			break;
+		}
+
+		if ((isAoutVaried ?
+			getTailMargin(calibrationFunction, threshold, tailSign, middle, otherInput) :
+			getTailMargin(calibrationFunction, threshold, tailSign, otherInput, middle)) >= 0.0)
+		{
+			inside = middle;
+		}
+		else
+		{
+			outside = middle;
+		}
+	}
+
+	return outside;
+}
+
+void
+estimateTailProbability(
+	OutputDistributionIndex		variant,
+	double				threshold,
+	bool				isUpperTail,
+	uint64_t			seed,
+	uint64_t			firstIndex,
+	size_t				numberOfSamples,
+	TailProbabilityEstimate *	estimate)
+{
+	CalibrationFunction		calibrationFunction = getCalibrationFunction(variant);
+	CalibrationBatchFunction	calibrationBatchFunction = getCalibrationBatchFunction(getCalibrationKernelImplementation(), variant);
+	double				tailSign = isUpperTail ? 1.0 : -1.0;
+	double				AoutLow = kDefaultInputDistributionAoutUniformDistLow;
+	double				AoutHigh = kDefaultInputDistributionAoutUniformDistHigh;
+	double				VddLow = kDefaultInputDistributionVddUniformDistLow;
+	double				VddHigh = kDefaultInputDistributionVddUniformDistHigh;
+	double				AoutMiddle = 0.5 * (AoutLow + AoutHigh);
+	double				VddMiddle = 0.5 * (VddLow + VddHigh);
+	bool				isMarginIncreasingInAout = getTailMargin(calibrationFunction, threshold, tailSign, AoutHigh, VddMiddle) >=
+									getTailMargin(calibrationFunction, threshold, tailSign, AoutLow, VddMiddle);
+	bool				isMarginIncreasingInVdd = getTailMargin(calibrationFunction, threshold, tailSign, AoutMiddle, VddHigh) >=
+									getTailMargin(calibrationFunction, threshold, tailSign, AoutMiddle, VddLow);
+	double				AoutInside = isMarginIncreasingInAout ? AoutHigh : AoutLow;
+	double				AoutOutside = isMarginIncreasingInAout ? AoutLow : AoutHigh;
+	double				VddInside = isMarginIncreasingInVdd ? VddHigh : VddLow;
+	double				VddOutside = isMarginIncreasingInVdd ? VddLow : VddHigh;
+	double				Aout[kMonteCarloSampleBlockSize];
+	double				Vdd[kMonteCarloSampleBlockSize];
+	double				Pa[kMonteCarloSampleBlockSize];
+	uint64_t			numberOfSamplesInTail = 0;
+	double				fractionInTail;
+
+	*estimate = (TailProbabilityEstimate)
+		{
+			.threshold		= threshold,
+			.probability		= 0.0,
+			.standardError		= 0.0,
+			.proposalProbability	= 0.0,
+		};
+
+	/*
+	 *	The output is monotone in each input, so if the corner of the inputs
+	 *	with the largest margin is not in the tail, no inputs are.
+	 */
+	if ((numberOfSamples == 0) || (getTailMargin(calibrationFunction, threshold, tailSign, AoutInside, VddInside) < 0.0))
+	{
+		return;
+	}
+
+	/*
+	 *	Any inputs of the tail are also in the tail with either input moved
+	 *	to that corner, so they are within the box between the corner and
+	 *	the boundaries of the tail along the two edges through the corner.
+	 */
+	if (getTailMargin(calibrationFunction, threshold, tailSign, AoutOutside, VddInside) < 0.0)
+	{
+		AoutOutside = bisectTailBoundary(calibrationFunction, threshold, tailSign, true, VddInside, AoutOutside, AoutInside);
+	}
+
+	if (getTailMargin(calibrationFunction, threshold, tailSign, AoutInside, VddOutside) < 0.0)
+	{
+		VddOutside = bisectTailBoundary(calibrationFunction, threshold, tailSign, false, AoutInside, VddOutside, VddInside);
+	}
+
+	estimate->proposalProbability = (fabs(AoutInside - AoutOutside) * fabs(VddInside - VddOutside)) / ((AoutHigh - AoutLow) * (VddHigh - VddLow));
+
+	for (size_t blockStart = 0; blockStart < numberOfSamples; blockStart += kMonteCarloSampleBlockSize)
+	{
+		size_t	blockSize = (numberOfSamples - blockStart < kMonteCarloSampleBlockSize) ? (numberOfSamples - blockStart) : kMonteCarloSampleBlockSize;
+
+		drawUniformDoublePairsPhilox(
+			seed,
+			firstIndex + blockStart,
+			fmin(AoutInside, AoutOutside),
+			fmax(AoutInside, AoutOutside),
+			fmin(VddInside, VddOutside),
+			fmax(VddInside, VddOutside),
+			Aout,
+			Vdd,
+			blockSize);
+		calibrationBatchFunction(Aout, Vdd, Pa, blockSize);
+
+		for (size_t i = 0; i < blockSize; i++)
+		{
+			numberOfSamplesInTail += isUpperTail ? (Pa[i] > threshold) : (Pa[i] <= threshold);
+		}
+	}
+
+	/*
+	 *	Each sample has the weight of the probability of the box, so the
+	 *	estimate is that probability times the fraction of the samples in the
+	 *	tail, and its standard error follows from the sample variance of the
+	 *	weighted indicator of the tail.
+	 */
+	fractionInTail = (double) numberOfSamplesInTail / (double) numberOfSamples;
+	estimate->probability = estimate->proposalProbability * fractionInTail;
+
+	if (numberOfSamples > 1)
+	{
+		estimate->standardError = estimate->proposalProbability * sqrt(fractionInTail * (1.0 - fractionInTail) / (double)(numberOfSamples - 1));
+	}
+
+	return;
+}
+
+void
+printImportanceSamplingReport(
+	CommandLineArguments *	arguments,
+	const double *		outputMeans,
+	const char **		outputVariableDescriptions)
+{
+	OutputDistributionIndex	outputSelectLowerBound;
+	OutputDistributionIndex	outputSelectUpperBound;
+	uint64_t		firstIndex = 0;
+
+	getSelectedOutputBounds(arguments, &outputSelectLowerBound, &outputSelectUpperBound);
+	printf("\nTail probabilities (importance sampling, %d samples per probability):\n", kImportanceSamplingNumberOfSamples);
+
+	for (OutputDistributionIndex variant = outputSelectLowerBound; variant < outputSelectUpperBound; variant++)
+	{
+		printf("\t%s (mean %.2lf Pa):\n", outputVariableDescriptions[variant], outputMeans[variant]);
+
+		for (size_t i = 0; i < arguments->numberOfTailDeviations; i++)
+		{
+			/*
+			 *	As in `printCalibratedValueAndProbabilities()`, the lower
+			 *	tail is at most the mean scaled by (1 - deviation), and the
+			 *	upper tail is above the mean scaled by (1 + deviation).
+			 */
+			for (int tail = 0; tail < 2; tail++)
+			{
+				bool				isUpperTail = (tail == 1);
+				double				deviation = arguments->tailDeviations[i];
+				TailProbabilityEstimate		estimate;
+
+				estimateTailProbability(
+					variant,
+					outputMeans[variant] * (isUpperTail ? (1.0 + deviation) : (1.0 - deviation)),
+					isUpperTail,
+					arguments->seed,
+					firstIndex,
+					kImportanceSamplingNumberOfSamples,
+					&estimate);
+				firstIndex += kImportanceSamplingNumberOfSamples;
+
+				printf(
+					"\t\tProbability that the output is %g%% or more %s than the mean (%s %.2lf Pa): %.6e, standard error %.3e",
+					deviation * 100.0,
+					isUpperTail ? "greater" : "smaller",
+					isUpperTail ? "above" : "at most",
+					estimate.threshold,
+					estimate.probability,
+					estimate.standardError);
+
+				if (estimate.proposalProbability == 0.0)
+				{
+					printf(" (no inputs reach the threshold)\n");
+				}
+				else if (estimate.standardError > 0.0)
+				{
+					printf(
+						", as plain Monte Carlo with %.3g samples\n",
+						estimate.probability * (1.0 - estimate.probability) / (estimate.standardError * estimate.standardError));
+				}
+				else
+				{
+					printf("\n");
+				}
+			}
+		}
+	}
+
+	return;
+}
+
+CommonConstantReturnType
+runImportanceSamplingSelfTest(void)
+{
+	const size_t			numberOfIntegrationPoints = kImportanceSamplingSelfTestNumberOfIntegrationPoints;
+	double				AoutLow = kDefaultInputDistributionAoutUniformDistLow;
+	double				AoutHigh = kDefaultInputDistributionAoutUniformDistHigh;
+	double				VddLow = kDefaultInputDistributionVddUniformDistLow;
+	double				VddHigh = kDefaultInputDistributionVddUniformDistHigh;
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	printf("Importance sampling self-test (%d samples per probability):\n", kImportanceSamplingNumberOfSamples);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		CalibrationFunction		calibrationFunction = getCalibrationFunction(variant);
+		InverseCalibrationFunction	inverseCalibrationFunction = getInverseCalibrationFunction(variant);
+		bool				isIncreasingInAout = calibrationFunction(AoutHigh, VddLow) > calibrationFunction(AoutLow, VddLow);
+		bool				isIncreasingInVdd = calibrationFunction(AoutLow, VddHigh) > calibrationFunction(AoutLow, VddLow);
+		double				maximumOutput = calibrationFunction(
+									isIncreasingInAout ? AoutHigh : AoutLow,
+									isIncreasingInVdd ? VddHigh : VddLow);
+		double				minimumOutput = calibrationFunction(
+									isIncreasingInAout ? AoutLow : AoutHigh,
+									isIncreasingInVdd ? VddLow : VddHigh);
+
+		for (int tail = 0; tail < 2; tail++)
+		{
+			bool				isUpperTail = (tail == 1);
+			double				threshold = isUpperTail ?
+								maximumOutput - kImportanceSamplingSelfTestTailFraction * (maximumOutput - minimumOutput) :
+								minimumOutput + kImportanceSamplingSelfTestTailFraction * (maximumOutput - minimumOutput);
+			double				exactProbability = 0.0;
+			TailProbabilityEstimate		estimate;
+			bool				passed;
+
+			/*
+			 *	For each Vdd, the tail is the range of Aout on the side of
+			 *	the Aout of the threshold where the output is in the tail.
+			 */
+			for (size_t i = 0; i < numberOfIntegrationPoints; i++)
+			{
+				double	Vdd = VddLow + (VddHigh - VddLow) * ((double) i + 0.5) / (double) numberOfIntegrationPoints;
+				double	AoutAtThreshold = fmin(fmax(inverseCalibrationFunction(threshold, Vdd), AoutLow), AoutHigh);
+
+				exactProbability += ((isUpperTail == isIncreasingInAout) ? (AoutHigh - AoutAtThreshold) : (AoutAtThreshold - AoutLow)) /
+							((AoutHigh - AoutLow) * (double) numberOfIntegrationPoints);
+			}
+
+			estimateTailProbability(variant, threshold, isUpperTail, kDefaultMonteCarloSeed, 0, kImportanceSamplingNumberOfSamples, &estimate);
+			passed = (fabs(estimate.probability - exactProbability) <= kImportanceSamplingSelfTestMaximumStandardErrors * estimate.standardError) &&
+					(estimate.standardError <= kImportanceSamplingSelfTestMaximumRelativeStandardError * exactProbability);
+			printf(
+				"\tVariant %u, %s tail: probability %.6e (exact %.6e), standard error %.3e: %s\n",
+				variant,
+				isUpperTail ? "upper" : "lower",
+				estimate.probability,
+				exactProbability,
+				estimate.standardError,
+				passed ? "PASS" : "FAIL");
+
+			if (!passed)
+			{
+				result = kCommonConstantReturnTypeError;
+			}
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,94 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "utilities.h"
+
+/*
+ *	Importance sampling estimate of the probability that an output exceeds a
+ *	threshold: the estimate, its standard error, and the probability of the
+ *	box of inputs that the proposal draws from (the inverse of the weight of
+ *	each sample). A proposal probability of zero means that no input exceeds
+ *	the threshold, so the probability is exactly zero.
+ */
+typedef struct
+{
+	double	threshold;
+	double	probability;
+	double	standardError;
+	double	proposalProbability;
+} TailProbabilityEstimate;
+
+/**
+ *	@brief  Estimates the probability that an output is above (or at most) a threshold, for the uniform
+ *		inputs of `utilities-config.h`, with importance sampling: draws the inputs uniformly from
+ *		the smallest box of inputs that contains all inputs that exceed the threshold, and weights
+ *		each sample with the ratio of the probability of the box to that of all inputs. Assumes,
+ *		like the outputs of all variants, that the output is monotone in each input, which makes
+ *		the estimate unbiased.
+ *
+ *	@param  variant			: The output variant.
+ *	@param  threshold		: The threshold, in Pascal.
+ *	@param  isUpperTail		: `true` for the probability of outputs above the threshold, `false` for at most the threshold.
+ *	@param  seed			: The seed of the Philox generator that draws the inputs.
+ *	@param  firstIndex		: The Philox index of the first input pair.
+ *	@param  numberOfSamples		: The number of input pairs.
+ *	@param  estimate		: Pointer to where the function writes the estimate.
+ */
+void	estimateTailProbability(
+		OutputDistributionIndex		variant,
+		double				threshold,
+		bool				isUpperTail,
+		uint64_t			seed,
+		uint64_t			firstIndex,
+		size_t				numberOfSamples,
+		TailProbabilityEstimate *	estimate);
+
+/**
+ *	@brief  Prints, for each selected output, the importance sampling estimates of the probabilities
+ *		that it is `arguments->tailDeviations` or more smaller or greater than its mean, like
+ *		the queries of `printCalibratedValueAndProbabilities()`, with their standard errors and
+ *		the number of plain Monte Carlo samples with the same standard error.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  outputMeans			: The means of the outputs of the run, indexed by `OutputDistributionIndex`.
+ *	@param  outputVariableDescriptions	: The descriptions of the outputs, indexed by `OutputDistributionIndex`.
+ */
+void	printImportanceSamplingReport(
+		CommandLineArguments *	arguments,
+		const double *		outputMeans,
+		const char **		outputVariableDescriptions);
+
+/**
+ *	@brief  Checks the importance sampling estimates of an upper and a lower tail probability of each
+ *		variant against the exact probabilities, integrated over Vdd with the inverse calibration.
+ *
+ *	@return	: `kCommonConstantReturnTypeSuccess` if all estimates are within
+ *		  `kImportanceSamplingSelfTestMaximumStandardErrors` standard errors of the exact
+ *		  probabilities, with a relative standard error of at most
+ *		  `kImportanceSamplingSelfTestMaximumRelativeStandardError`, else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runImportanceSamplingSelfTest(void);
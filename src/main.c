@@ -30,25 +30,28 @@
 #include <float.h>
 #include <uxhw.h>
 #include "utilities.h"
+#include "calibration.h"
+#include "montecarlo.h"
+#include "calibration-fixed-point.h"
+#include "calibration-lookup-table.h"
+#include "calibration-inverse.h"
+#include "calibration-cached-reciprocal.h"
+#include "streaming-statistics.h"
+#include "quasi-monte-carlo.h"
+#include "sampling-strategy.h"
+#include "adaptive-stopping.h"
+#include "quantile-sketch.h"
+#include "histogram.h"
+#include "shard.h"
+#include "checkpoint.h"
+#include "importance-sampling.h"
+#include "analytic-distribution.h"
+#include "grid-propagation.h"
+#include "particle-distribution.h"
+#include "wasserstein-distance.h"
+#include "adc.h"
 
 
-/**
- *	@brief  Implementation of the sign function for distributional values.
- *
- *	@param  arg	: Sign function argument.
- *	@return double	: The result of the sign function.
- */
-static double
-sign(double arg)
-{
-	if (arg == 0.0)
-	{
-		return 0.0;
-	}
-
-	return arg / fabs(arg);
-}
-
 /**
  *	@brief  Sets the Input Distributions via calls to UxHw API functions.
  *
@@ -72,59 +75,99 @@ setInputDistributionsViaUxHwCall(double *  inputDistributions)
  *	@brief  Sensor calibration routines for different modes taken from
  *		SDP8xx Analog Datasheet, 2024-07-03.
  *
- *	@param  arguments		: Pointer to command-line arguments struct.
+ *	@param  calibrationFunctions	: The specialized kernels of the variants, indexed by `OutputDistributionIndex`.
+ *	@param  variantLowerBound	: The first variant to calculate.
+ *	@param  variantUpperBound	: One past the last variant to calculate.
  *	@param  inputDistributions	: The array of input distributions used in the calculation.
  * 	@param  outputDistributions	: An array of of output distributions.
- * 						Writes the result to `outputDistributions[outputSelectValue]`.
+ * 						Writes the result of each calculated variant to `outputDistributions[variant]`.
  *
- *	@return	double			: Returns the distributional value calculated.
+ *	@return	double			: Returns the distributional value calculated last.
  */
 static double
-calculateSensorOutput(CommandLineArguments *  arguments, double *  inputDistributions, double *  outputDistributions)
+calculateSensorOutput(
+	const CalibrationFunction *	calibrationFunctions,
+	OutputDistributionIndex		variantLowerBound,
+	OutputDistributionIndex		variantUpperBound,
+	double *			inputDistributions,
+	double *			outputDistributions)
 {
 	double	Vdd = inputDistributions[kInputDistributionIndexVdd];
 	double	Aout = inputDistributions[kInputDistributionIndexAout];
-	double	calibratedValue;
+	double	calibratedValue = 0.0;
 
-	bool	calculateAllOutputs = (arguments->common.outputSelect == kOutputDistributionIndexCalibratedSensorOutputMax);
-
-	if (calculateAllOutputs ||
-		(arguments->common.outputSelect == kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear500Pa))
+	for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
 	{
-		calibratedValue = kSensorCalibrationConstantSDP8x6Linear500Pa1 * Aout / Vdd - kSensorCalibrationConstantSDP8x6Linear500Pa2;
-		outputDistributions[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear500Pa] = calibratedValue;
+		calibratedValue = calibrationFunctions[variant](Aout, Vdd);
+		outputDistributions[variant] = calibratedValue;
 	}
 
-	if (calculateAllOutputs ||
-		(arguments->common.outputSelect == kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear125Pa))
-	{
-		calibratedValue = kSensorCalibrationConstantSDP8x6Linear125Pa1 * Aout / Vdd - kSensorCalibrationConstantSDP8x6Linear125Pa2;
-		outputDistributions[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear125Pa] = calibratedValue;
-	}
+	return	calibratedValue;
+}
 
-	if (calculateAllOutputs ||
-		(arguments->common.outputSelect == kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt500Pa))
-	{
-		calibratedValue = 	sign((Aout / Vdd) - kSensorCalibrationConstantSDP8x6Sqrt500Pa1) *
-					pow((Aout / (Vdd * kSensorCalibrationConstantSDP8x6Sqrt500Pa2)) -
-					kSensorCalibrationConstantSDP8x6Sqrt500Pa3, 2) *
-					kSensorCalibrationConstantSDP8x6Sqrt500Pa4;
-		outputDistributions[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt500Pa] = calibratedValue;
-	}
+/**
+ *	@brief  Sets the Input Distributions as particle distributions of the uniform inputs.
+ *
+ *	@param  inputDistributions	: An array of particle distributions, which the function sets up.
+ *	@param  numberOfParticles	: The number of particles of each input.
+ */
+static void
+setInputDistributionsViaParticles(ParticleDistribution *  inputDistributions, size_t numberOfParticles)
+{
+	initializeUniformParticleDistribution(
+		&inputDistributions[kInputDistributionIndexAout],
+		kDefaultInputDistributionAoutUniformDistLow,
+		kDefaultInputDistributionAoutUniformDistHigh,
+		numberOfParticles);
+
+	initializeUniformParticleDistribution(
+		&inputDistributions[kInputDistributionIndexVdd],
+		kDefaultInputDistributionVddUniformDistLow,
+		kDefaultInputDistributionVddUniformDistHigh,
+		numberOfParticles);
+
+	return;
+}
+
+/**
+ *	@brief  Particle version of `calculateSensorOutput()`: calculates the full distribution of
+ *		each output in one pass over particle distributions of the inputs. The distribution
+ *		of the ratio `Aout / Vdd`, the only operation between the independent inputs, is
+ *		calculated once for all variants.
+ *
+ *	@param  variantLowerBound	: The first variant to calculate.
+ *	@param  variantUpperBound	: One past the last variant to calculate.
+ *	@param  inputDistributions	: The particle distributions of the inputs.
+ *	@param  numberOfParticles	: The number of particles of each output.
+ *	@param  outputDistributions	: An array of particle distributions.
+ *					  Writes the result of each calculated variant to `outputDistributions[variant]`.
+ */
+static void
+calculateSensorOutputParticles(
+	OutputDistributionIndex		variantLowerBound,
+	OutputDistributionIndex		variantUpperBound,
+	const ParticleDistribution *	inputDistributions,
+	size_t				numberOfParticles,
+	ParticleDistribution *		outputDistributions)
+{
+	ParticleDistribution	ratio;
+
+	combineParticleDistributions(
+		kParticleOperationDivide,
+		&inputDistributions[kInputDistributionIndexAout],
+		&inputDistributions[kInputDistributionIndexVdd],
+		numberOfParticles,
+		&ratio);
 
-	if (calculateAllOutputs ||
-		(arguments->common.outputSelect == kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt125Pa))
+	for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
 	{
-		calibratedValue = 	sign((Aout / Vdd) - kSensorCalibrationConstantSDP8x6Sqrt125Pa1) *
-					pow((Aout / (Vdd * kSensorCalibrationConstantSDP8x6Sqrt125Pa2)) -
-					kSensorCalibrationConstantSDP8x6Sqrt125Pa3, 2) *
-					kSensorCalibrationConstantSDP8x6Sqrt125Pa4;
-		outputDistributions[kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt125Pa] = calibratedValue;
+		calculateCalibratedSensorOutputParticlesFromRatio(variant, &ratio, &outputDistributions[variant]);
 	}
 
-	return	calibratedValue;
-}
+	freeParticleDistribution(&ratio);
 
+	return;
+}
 
 int
 main(int argc, char *  argv[])
@@ -132,10 +175,10 @@ main(int argc, char *  argv[])
 	CommandLineArguments	arguments = {0};
 
 	double			calibratedSensorOutput;
-	double *		monteCarloOutputSamples = NULL;
+	MonteCarloOutputSamples	monteCarloOutputSamples = {0};
 	clock_t			start;
 	clock_t			end;
-	double			cpuTimeUsedSeconds;
+	double			cpuTimeUsedSeconds = 0.0;
 	double			inputDistributions[kInputDistributionIndexMax];
 	double			outputDistributions[kOutputDistributionIndexCalibratedSensorOutputMax];
 	const char *		outputVariableNames[kOutputDistributionIndexCalibratedSensorOutputMax] =
@@ -146,6 +189,17 @@ main(int argc, char *  argv[])
 					"Calibrated Sensor Output SDP8x6 Square 125Pa",
 				};
 	MeanAndVariance		meanAndVariance;
+	CalibrationFunction	calibrationFunctions[kOutputDistributionIndexCalibratedSensorOutputMax];
+	OutputDistributionIndex	variantLowerBound;
+	OutputDistributionIndex	variantUpperBound;
+	CalibrationLookupTable	lookupTable = {0};
+	StreamingStatistics	streamingStatistics[kOutputDistributionIndexCalibratedSensorOutputMax];
+	AdaptiveStoppingResult	adaptiveStoppingResult;
+	QuantileSketch *	quantileSketches = NULL;
+	Histogram		histograms[kOutputDistributionIndexCalibratedSensorOutputMax] = {0};
+	CommonConstantReturnType	monteCarloResult;
+	WassersteinReference	wassersteinReference = {0};
+	char			partialStateFilePath[kCommonConstantMaxCharsPerFilepath];
 
 	/*
 	 *	Get command line arguments.
@@ -155,14 +209,296 @@ main(int argc, char *  argv[])
 		return kCommonConstantReturnTypeError;
 	}
 
-	if (arguments.common.isMonteCarloMode)
+	if (arguments.isCalibrationKernelSelected)
+	{
+		if (setCalibrationKernelImplementation(arguments.calibrationKernelImplementation) != kCommonConstantReturnTypeSuccess)
+		{
+			return kCommonConstantReturnTypeError;
+		}
+	}
+
+	if (arguments.isCalibrationKernelSelfTestEnabled)
+	{
+		CommonConstantReturnType	selfTestResult = runCalibrationKernelSelfTest();
+
+		if (runFixedPointCalibrationSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runCalibrationLookupTableSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runInverseCalibrationSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runCachedReciprocalCalibrationSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runRandomNumberGeneratorSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runQuasiRandomSequenceSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runSamplingStrategySelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runStreamingStatisticsSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runAdaptiveStoppingSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runQuantileSketchSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runHistogramSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runShardSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runCheckpointSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runImportanceSamplingSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runAnalyticDistributionSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runGridPropagationSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runParticleDistributionSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		if (runWassersteinDistanceSelfTest() != kCommonConstantReturnTypeSuccess)
+		{
+			selfTestResult = kCommonConstantReturnTypeError;
+		}
+
+		return selfTestResult;
+	}
+
+	if (arguments.isCalibrationKernelBenchmarkEnabled)
+	{
+		size_t	numberOfBenchmarkSamples = arguments.common.isMonteCarloMode ?
+							arguments.common.numberOfMonteCarloIterations :
+							kCalibrationKernelBenchmarkDefaultNumberOfSamples;
+
+		runCalibrationKernelBenchmark(numberOfBenchmarkSamples);
+		runCalibrationLookupTableBenchmark(numberOfBenchmarkSamples);
+		runInverseCalibrationBenchmark(numberOfBenchmarkSamples);
+		runCachedReciprocalCalibrationBenchmark(numberOfBenchmarkSamples);
+		runRandomNumberGeneratorBenchmark(numberOfBenchmarkSamples);
+
+		return kCommonConstantReturnTypeSuccess;
+	}
+
+	if (arguments.isQuasiMonteCarloConvergenceReportEnabled)
+	{
+		runQuasiMonteCarloConvergenceReport(outputVariableNames);
+
+		return kCommonConstantReturnTypeSuccess;
+	}
+
+	if (arguments.isGridPropagationEnabled)
+	{
+		GridInputDistribution	gridInputs[kInputDistributionIndexMax];
+
+		if (initializeGridInputDistributions(arguments.gridInputDistributionType, arguments.gridInputFilePath, gridInputs) != kCommonConstantReturnTypeSuccess)
+		{
+			return kCommonConstantReturnTypeError;
+		}
+
+		getSelectedOutputBounds(&arguments, &variantLowerBound, &variantUpperBound);
+		runGridPropagation(gridInputs, arguments.gridSize, variantLowerBound, variantUpperBound, outputVariableNames);
+
+		if (arguments.isGridConvergenceReportEnabled)
+		{
+			printf("\n");
+			runGridPropagationConvergenceReport(
+				gridInputs,
+				arguments.gridSize,
+				arguments.common.isMonteCarloMode ? arguments.common.numberOfMonteCarloIterations : kGridPropagationReferenceNumberOfSamples,
+				arguments.seed,
+				variantLowerBound,
+				variantUpperBound,
+				outputVariableNames);
+		}
+
+		freeGridInputDistributions(gridInputs);
+
+		return kCommonConstantReturnTypeSuccess;
+	}
+
+	if (arguments.isParticlePropagationEnabled)
+	{
+		ParticleDistribution	particleInputs[kInputDistributionIndexMax];
+		ParticleDistribution	particleOutputs[kOutputDistributionIndexCalibratedSensorOutputMax];
+
+		getSelectedOutputBounds(&arguments, &variantLowerBound, &variantUpperBound);
+		setInputDistributionsViaParticles(particleInputs, arguments.numberOfParticles);
+		start = clock();
+		calculateSensorOutputParticles(variantLowerBound, variantUpperBound, particleInputs, arguments.numberOfParticles, particleOutputs);
+		end = clock();
+		printParticleDistributionReport(
+			particleOutputs,
+			((double)(end - start)) / CLOCKS_PER_SEC,
+			variantLowerBound,
+			variantUpperBound,
+			outputVariableNames);
+
+		for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+		{
+			freeParticleDistribution(&particleOutputs[variant]);
+		}
+
+		freeParticleDistribution(&particleInputs[kInputDistributionIndexAout]);
+		freeParticleDistribution(&particleInputs[kInputDistributionIndexVdd]);
+
+		return kCommonConstantReturnTypeSuccess;
+	}
+
+	/*
+	 *	Load the reference of the Wasserstein distance before timing.
+	 */
+	if (arguments.isWassersteinReferenceSelected &&
+		(loadWassersteinReference(arguments.wassersteinReferenceFilePath, &wassersteinReference) != kCommonConstantReturnTypeSuccess))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	/*
+	 *	The quantile sketches take constant memory, whether or not the
+	 *	output samples are stored.
+	 */
+	if (arguments.isQuantileSketchEnabled)
 	{
-		monteCarloOutputSamples = (double *) checkedMalloc(
-							arguments.common.numberOfMonteCarloIterations * sizeof(double),
+		quantileSketches = (QuantileSketch *) checkedMalloc(
+							kOutputDistributionIndexCalibratedSensorOutputMax * sizeof(QuantileSketch),
 							__FILE__,
 							__LINE__);
 	}
 
+	/*
+	 *	Merging the partial-state files of shards sets the selected output,
+	 *	so load them before getting the bounds of the selected variants.
+	 */
+	if (arguments.isMergeEnabled &&
+		(mergeShardPartialStateFiles(&arguments, streamingStatistics, quantileSketches, histograms) != kCommonConstantReturnTypeSuccess))
+	{
+		for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+		{
+			freeHistogram(&histograms[variant]);
+		}
+
+		free(quantileSketches);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	getSelectedOutputBounds(&arguments, &variantLowerBound, &variantUpperBound);
+
+	/*
+	 *	Build the lookup tables at startup, before timing.
+	 */
+	if (arguments.isLookupTableEnabled)
+	{
+		if (buildCalibrationLookupTable(
+			&lookupTable,
+			arguments.lookupTableNumberOfIntervals,
+			variantLowerBound,
+			variantUpperBound) != kCommonConstantReturnTypeSuccess)
+		{
+			return kCommonConstantReturnTypeError;
+		}
+	}
+
+	/*
+	 *	The ADC code input mode calibrates plain (non-distributional) raw ADC codes.
+	 *	Its outputs may go to the standard output, so the lookup table report goes
+	 *	to the standard error.
+	 */
+	if (arguments.isAdcCodeInputEnabled)
+	{
+		CommonConstantReturnType	adcCodeCalibrationResult = runAdcCodeCalibration(
+										&arguments,
+										arguments.isLookupTableEnabled ? &lookupTable : NULL,
+										outputVariableNames);
+
+		if (arguments.isLookupTableEnabled)
+		{
+			printCalibrationLookupTableReport(stderr, &lookupTable, variantLowerBound, variantUpperBound, outputVariableNames);
+			freeCalibrationLookupTable(&lookupTable);
+		}
+
+		return adcCodeCalibrationResult;
+	}
+
+	/*
+	 *	In the streaming statistics mode, the output samples are not stored.
+	 */
+	if (arguments.common.isMonteCarloMode && !arguments.isStreamingStatisticsEnabled)
+	{
+		for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+		{
+			if (arguments.isSinglePrecisionEnabled)
+			{
+				monteCarloOutputSamples.asFloat[variant] = (float *) checkedMalloc(
+										arguments.common.numberOfMonteCarloIterations * sizeof(float),
+										__FILE__,
+										__LINE__);
+			}
+			else
+			{
+				monteCarloOutputSamples.asDouble[variant] = (double *) checkedMalloc(
+										arguments.common.numberOfMonteCarloIterations * sizeof(double),
+										__FILE__,
+										__LINE__);
+			}
+		}
+	}
+
+	if (arguments.isHistogramEnabled && !arguments.isMergeEnabled)
+	{
+		initializeOutputHistograms(&arguments, histograms);
+	}
+
 	/*
 	 *	Start timing.
 	 */
@@ -171,23 +507,111 @@ main(int argc, char *  argv[])
 		start = clock();
 	}
 
-	for (size_t i = 0; i < arguments.common.numberOfMonteCarloIterations; i++)
+	if (arguments.common.isMonteCarloMode)
 	{
 		/*
-		 *	Set input distribution values, inside the main computation
-		 *	loop, so that it can also generate samples in the native
-		 *	Monte Carlo Execution Mode.
+		 *	In the native Monte Carlo Execution Mode, the inputs are plain
+		 *	samples, so we calibrate them in blocks with the (vectorized)
+		 *	batch calibration kernels. For this application, the calibrated
+		 *	sensor output is the item we track. With a target half-width,
+		 *	run them in batches until it is met, and from then on treat the
+		 *	samples used as the number of iterations.
 		 */
-		setInputDistributionsViaUxHwCall(inputDistributions);
+		if (arguments.isMergeEnabled)
+		{
+			/*
+			 *	The merged statistics of the shards are already loaded.
+			 */
+			monteCarloResult = kCommonConstantReturnTypeSuccess;
+		}
+		else if (arguments.isCheckpointEnabled)
+		{
+			monteCarloResult = runCheckpointedMonteCarloIterations(
+						&arguments,
+						arguments.isLookupTableEnabled ? &lookupTable : NULL,
+						streamingStatistics,
+						quantileSketches,
+						arguments.isHistogramEnabled ? histograms : NULL);
+		}
+		else if (arguments.isShardSelected)
+		{
+			monteCarloResult = runShardMonteCarloIterations(
+						&arguments,
+						arguments.isLookupTableEnabled ? &lookupTable : NULL,
+						streamingStatistics,
+						quantileSketches,
+						arguments.isHistogramEnabled ? histograms : NULL);
+		}
+		else if (arguments.isAdaptiveStoppingEnabled)
+		{
+			monteCarloResult = runAdaptiveMonteCarloIterations(
+						&arguments,
+						arguments.isLookupTableEnabled ? &lookupTable : NULL,
+						&monteCarloOutputSamples,
+						arguments.isStreamingStatisticsEnabled ? streamingStatistics : NULL,
+						quantileSketches,
+						arguments.isHistogramEnabled ? histograms : NULL,
+						&adaptiveStoppingResult);
+			arguments.common.numberOfMonteCarloIterations = adaptiveStoppingResult.numberOfSamples;
+		}
+		else
+		{
+			monteCarloResult = runNativeMonteCarloIterations(
+						&arguments,
+						arguments.isLookupTableEnabled ? &lookupTable : NULL,
+						&monteCarloOutputSamples,
+						arguments.isStreamingStatisticsEnabled ? streamingStatistics : NULL,
+						quantileSketches,
+						arguments.isHistogramEnabled ? histograms : NULL);
+		}
+
+		if (monteCarloResult != kCommonConstantReturnTypeSuccess)
+		{
+			for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+			{
+				free(monteCarloOutputSamples.asDouble[variant]);
+				free(monteCarloOutputSamples.asFloat[variant]);
+			}
 
-		calibratedSensorOutput = calculateSensorOutput(&arguments, inputDistributions, outputDistributions);
+			for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+			{
+				freeHistogram(&histograms[variant]);
+			}
+
+			free(quantileSketches);
+			freeCalibrationLookupTable(&lookupTable);
+			freeWassersteinReference(&wassersteinReference);
 
+			return kCommonConstantReturnTypeError;
+		}
+	}
+	else
+	{
 		/*
-		 *	For this application, `calibratedSensorOutput` is the item we track.
+		 *	Select the kernels of the variants once, outside the main
+		 *	computation loop, so that the loop does not branch on the
+		 *	selected output.
 		 */
-		if (arguments.common.isMonteCarloMode)
+		for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+		{
+			calibrationFunctions[variant] = getCalibrationFunction(variant);
+		}
+
+		for (size_t i = 0; i < arguments.common.numberOfMonteCarloIterations; i++)
 		{
-			monteCarloOutputSamples[i] = calibratedSensorOutput;
+			/*
+			 *	Set input distribution values, inside the main computation
+			 *	loop, so that it can also generate samples in the native
+			 *	Monte Carlo Execution Mode.
+			 */
+			setInputDistributionsViaUxHwCall(inputDistributions);
+
+			calibratedSensorOutput = calculateSensorOutput(
+							calibrationFunctions,
+							variantLowerBound,
+							variantUpperBound,
+							inputDistributions,
+							outputDistributions);
 		}
 	}
 
@@ -197,10 +621,28 @@ main(int argc, char *  argv[])
 	 */
 	if (arguments.common.isMonteCarloMode)
 	{
-		meanAndVariance = calculateMeanAndVarianceOfDoubleSamples(
-					monteCarloOutputSamples,
-					arguments.common.numberOfMonteCarloIterations);
-		calibratedSensorOutput = meanAndVariance.mean;
+		for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+		{
+			if (arguments.isStreamingStatisticsEnabled)
+			{
+				meanAndVariance = getStreamingStatisticsMeanAndVariance(&streamingStatistics[variant]);
+			}
+			else if (arguments.isSinglePrecisionEnabled)
+			{
+				meanAndVariance = calculateMeanAndVarianceOfFloatSamples(
+							monteCarloOutputSamples.asFloat[variant],
+							arguments.common.numberOfMonteCarloIterations);
+			}
+			else
+			{
+				meanAndVariance = calculateMeanAndVarianceOfDoubleSamples(
+							monteCarloOutputSamples.asDouble[variant],
+							arguments.common.numberOfMonteCarloIterations);
+			}
+
+			outputDistributions[variant] = meanAndVariance.mean;
+			calibratedSensorOutput = meanAndVariance.mean;
+		}
 	}
 
 	/*
@@ -212,7 +654,36 @@ main(int argc, char *  argv[])
 		cpuTimeUsedSeconds = ((double)(end - start)) / CLOCKS_PER_SEC;
 	}
 
-	if (arguments.common.isBenchmarkingMode)
+	if (arguments.common.isBenchmarkingMode && arguments.isWassersteinReferenceSelected)
+	{
+		/*
+		 *	With a reference, we print instead:
+		 *		(1) the 1-Wasserstein distance of the output samples to the reference
+		 *		(2) time in microseconds, of the run without the distance
+		 *		(3) the number of samples
+		 *	The distance sorts a copy of the samples of the single selected output.
+		 */
+		double *	samples = (double *) checkedMalloc(
+						arguments.common.numberOfMonteCarloIterations * sizeof(double),
+						__FILE__,
+						__LINE__);
+
+		for (size_t i = 0; i < arguments.common.numberOfMonteCarloIterations; i++)
+		{
+			samples[i] = arguments.isSinglePrecisionEnabled ?
+					(double)monteCarloOutputSamples.asFloat[variantLowerBound][i] :
+					monteCarloOutputSamples.asDouble[variantLowerBound][i];
+		}
+
+		printf(
+			"%le %" PRIu64 " %zu\n",
+			calculateWassersteinDistance(&wassersteinReference, samples, arguments.common.numberOfMonteCarloIterations),
+			(uint64_t)(cpuTimeUsedSeconds*1000000),
+			arguments.common.numberOfMonteCarloIterations);
+		free(samples);
+		freeWassersteinReference(&wassersteinReference);
+	}
+	else if (arguments.common.isBenchmarkingMode)
 	{
 		/*
 		 *	In benchmarking mode, we print:
@@ -246,11 +717,94 @@ main(int argc, char *  argv[])
 		{
 			printJSONFormattedOutput(
 				&arguments,
-				monteCarloOutputSamples,
+				&monteCarloOutputSamples,
 				outputDistributions,
+				quantileSketches,
 				outputVariableNames);
 		}
 
+		/*
+		 *	In single precision mode, report the difference to double precision.
+		 */
+		if (arguments.isSinglePrecisionEnabled && !arguments.common.isOutputJSONMode)
+		{
+			printSinglePrecisionAccuracyReport(&arguments, outputVariableNames);
+		}
+
+		/*
+		 *	In the streaming statistics mode, report the statistics of the
+		 *	outputs instead of storing their samples.
+		 */
+		if (arguments.isStreamingStatisticsEnabled && !arguments.common.isOutputJSONMode)
+		{
+			printf("\nStreaming statistics:\n");
+
+			for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+			{
+				printStreamingStatistics(stdout, &streamingStatistics[variant], outputVariableNames[variant]);
+			}
+		}
+
+		/*
+		 *	With quantile sketches, report the quantiles of the outputs.
+		 */
+		if (arguments.isQuantileSketchEnabled && !arguments.common.isOutputJSONMode)
+		{
+			printf("\nQuantiles (streaming sketch):\n");
+
+			for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+			{
+				printQuantileSketchQuantiles(stdout, &quantileSketches[variant], outputVariableNames[variant]);
+			}
+		}
+
+		/*
+		 *	With a variance-reduction sampling strategy, report its gain over
+		 *	independent sampling.
+		 */
+		if ((arguments.samplingStrategy != kSamplingStrategyIndependent) && !arguments.common.isOutputJSONMode)
+		{
+			printSamplingStrategyReport(&arguments, outputVariableNames);
+		}
+
+		/*
+		 *	With adaptive stopping, report the number of samples it used.
+		 */
+		if (arguments.isAdaptiveStoppingEnabled && !arguments.common.isOutputJSONMode)
+		{
+			printAdaptiveStoppingReport(&arguments, &adaptiveStoppingResult, outputVariableNames);
+		}
+
+		/*
+		 *	With importance sampling, report the tail probabilities of the
+		 *	outputs around the means of the run.
+		 */
+		if (arguments.isImportanceSamplingEnabled && !arguments.common.isOutputJSONMode)
+		{
+			printImportanceSamplingReport(&arguments, outputDistributions, outputVariableNames);
+		}
+
+		/*
+		 *	With the exact distribution, report it, and the errors of the Monte
+		 *	Carlo estimates against it.
+		 */
+		if (arguments.isAnalyticDistributionEnabled && !arguments.common.isOutputJSONMode)
+		{
+			printAnalyticDistributionReport(
+				&arguments,
+				arguments.common.isMonteCarloMode ? outputDistributions : NULL,
+				arguments.isQuantileSketchEnabled ? quantileSketches : NULL,
+				outputVariableNames);
+		}
+
+		/*
+		 *	When calibrating via lookup tables, report their footprint and error.
+		 */
+		if (arguments.isLookupTableEnabled && !arguments.common.isOutputJSONMode)
+		{
+			printCalibrationLookupTableReport(stdout, &lookupTable, variantLowerBound, variantUpperBound, outputVariableNames);
+		}
+
 		/*
 		 *	Print timing result.
 		 */
@@ -273,18 +827,102 @@ main(int argc, char *  argv[])
 				return kCommonConstantReturnTypeError;
 			}
 		}
+
+		/*
+		 *	Write the histograms of the outputs.
+		 */
+		if (arguments.isHistogramEnabled &&
+			(writeHistogramsToFile(
+				arguments.histogramFilePath,
+				histograms,
+				variantLowerBound,
+				variantUpperBound,
+				outputVariableNames) != kCommonConstantReturnTypeSuccess))
+		{
+			return kCommonConstantReturnTypeError;
+		}
+	}
+
+	/*
+	 *	Write the partial state of a shard, to merge with the other shards.
+	 */
+	if (arguments.isShardSelected)
+	{
+		if (writeShardPartialStateFile(
+			&arguments,
+			streamingStatistics,
+			quantileSketches,
+			histograms,
+			partialStateFilePath) != kCommonConstantReturnTypeSuccess)
+		{
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (!arguments.common.isOutputJSONMode && !arguments.common.isBenchmarkingMode)
+		{
+			printf("\nWrote the partial state of shard %zu of %zu to %s\n", arguments.shardIndex, arguments.numberOfShards, partialStateFilePath);
+		}
 	}
 
 	/*
 	 *	Save Monte carlo outputs in an output file.
 	 *	Free dynamically-allocated memory.
 	 */
-	if (arguments.common.isMonteCarloMode)
+	if (arguments.common.isMonteCarloMode && !arguments.isStreamingStatisticsEnabled)
 	{
-		saveMonteCarloDoubleDataToDataDotOutFile(monteCarloOutputSamples, (uint64_t)(cpuTimeUsedSeconds*1000000), arguments.common.numberOfMonteCarloIterations);
-		
-		free(monteCarloOutputSamples);
+		for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+		{
+			char	outputFilePath[kCommonConstantMaxCharsPerFilepath];
+
+			/*
+			 *	When all outputs are calculated, save the samples of each
+			 *	output in its own file.
+			 */
+			if (arguments.common.outputSelect == kOutputDistributionIndexCalibratedSensorOutputMax)
+			{
+				snprintf(outputFilePath, sizeof(outputFilePath), kMonteCarloAllOutputsDataFilePathFormat, variant);
+			}
+			else
+			{
+				snprintf(outputFilePath, sizeof(outputFilePath), "data.out");
+			}
+
+			if (arguments.isSinglePrecisionEnabled)
+			{
+				saveMonteCarloFloatDataToFile(
+					outputFilePath,
+					monteCarloOutputSamples.asFloat[variant],
+					(uint64_t)(cpuTimeUsedSeconds*1000000),
+					arguments.common.numberOfMonteCarloIterations);
+			}
+			else if (arguments.common.outputSelect == kOutputDistributionIndexCalibratedSensorOutputMax)
+			{
+				saveMonteCarloDoubleDataToFile(
+					outputFilePath,
+					monteCarloOutputSamples.asDouble[variant],
+					(uint64_t)(cpuTimeUsedSeconds*1000000),
+					arguments.common.numberOfMonteCarloIterations);
+			}
+			else
+			{
+				saveMonteCarloDoubleDataToDataDotOutFile(
+					monteCarloOutputSamples.asDouble[variant],
+					(uint64_t)(cpuTimeUsedSeconds*1000000),
+					arguments.common.numberOfMonteCarloIterations);
+			}
+
+			free(monteCarloOutputSamples.asDouble[variant]);
+			free(monteCarloOutputSamples.asFloat[variant]);
+		}
 	}
 
+	for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+	{
+		freeHistogram(&histograms[variant]);
+	}
+
+	free(quantileSketches);
+	freeCalibrationLookupTable(&lookupTable);
+
 	return 0;
 }
@@ -0,0 +1,904 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <uxhw.h>
+#include "montecarlo.h"
+#include "calibration.h"
+#include "random-number-generator.h"
+#include "streaming-statistics.h"
+#include "quantile-sketch.h"
+#include "histogram.h"
+#include "quasi-monte-carlo.h"
+#include "sampling-strategy.h"
+
+/*
+ *	The native Monte Carlo mode runs its slices of iterations in POSIX threads
+ *	where available, and else one after the other in the calling thread.
+ */
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#if defined(_POSIX_THREADS) && (_POSIX_THREADS > 0)
+#include <pthread.h>
+#define kMonteCarloThreadsAreSupported	1
+#else
+#define kMonteCarloThreadsAreSupported	0
+#endif
+
+/*
+ *	A contiguous range of Monte Carlo iterations, which one thread draws and
+ *	calibrates. With xoshiro256**, the range has its own stream of the seed.
+ *	With Philox and the quasi-random sequences, the inputs of each iteration
+ *	only depend on the seed and the index of the iteration. In the streaming
+ *	statistics mode, the range folds its output samples into its own
+ *	statistics, indexed by `OutputDistributionIndex`, instead of storing them.
+ */
+typedef struct
+{
+	CommandLineArguments *		arguments;
+	const CalibrationLookupTable *	lookupTable;
+	MonteCarloOutputSamples *	monteCarloOutputSamples;
+	RandomNumberGenerator		randomNumberGenerator;
+	const QuasiRandomSequence *	quasiRandomSequence;
+	StreamingStatistics *		streamingStatistics;
+	QuantileSketch *		quantileSketches;
+	Histogram *			histograms;
+	size_t				sampleStart;
+	size_t				sampleEnd;
+	CommonConstantReturnType	result;
+} MonteCarloSampleRange;
+
+/**
+ *	@brief  Draws a block of input samples via calls to UxHw API functions. Draws Aout and then
+ *		Vdd for each sample, in the same order as `setInputDistributionsViaUxHwCall()`.
+ *
+ *	@param  AoutSamples	: Array where the function writes the Aout samples.
+ *	@param  VddSamples	: Array where the function writes the Vdd samples.
+ *	@param  blockSize	: The number of samples to draw.
+ */
+static void
+drawInputSamplesViaUxHwCall(double *  AoutSamples, double *  VddSamples, size_t blockSize)
+{
+	for (size_t i = 0; i < blockSize; i++)
+	{
+		AoutSamples[i] = UxHwDoubleUniformDist(
+					kDefaultInputDistributionAoutUniformDistLow,
+					kDefaultInputDistributionAoutUniformDistHigh);
+		VddSamples[i] = UxHwDoubleUniformDist(
+					kDefaultInputDistributionVddUniformDistLow,
+					kDefaultInputDistributionVddUniformDistHigh);
+	}
+
+	return;
+}
+
+/**
+ *	@brief  Converts a block of double-precision samples to single precision.
+ *
+ *	@param  source		: The double-precision samples.
+ *	@param  destination	: Array where the function writes the single-precision samples.
+ *	@param  blockSize	: The number of samples to convert.
+ */
+static void
+convertBlockToFloat(const double *  source, float *  destination, size_t blockSize)
+{
+	for (size_t i = 0; i < blockSize; i++)
+	{
+		destination[i] = (float)source[i];
+	}
+
+	return;
+}
+
+/**
+ *	@brief  Draws a block of input samples from a seeded generator, in the same order as
+ *		`drawInputSamplesViaUxHwCall()`.
+ *
+ *	@param  randomNumberGenerator	: Pointer to the generator to draw from.
+ *	@param  AoutSamples		: Array where the function writes the Aout samples.
+ *	@param  VddSamples		: Array where the function writes the Vdd samples.
+ *	@param  blockSize		: The number of samples to draw.
+ */
+static void
+drawInputSamplesViaRandomNumberGenerator(
+	RandomNumberGenerator *	randomNumberGenerator,
+	double *		AoutSamples,
+	double *		VddSamples,
+	size_t			blockSize)
+{
+	for (size_t i = 0; i < blockSize; i++)
+	{
+		AoutSamples[i] = drawUniformDoubleInRange(
+					randomNumberGenerator,
+					kDefaultInputDistributionAoutUniformDistLow,
+					kDefaultInputDistributionAoutUniformDistHigh);
+		VddSamples[i] = drawUniformDoubleInRange(
+					randomNumberGenerator,
+					kDefaultInputDistributionVddUniformDistLow,
+					kDefaultInputDistributionVddUniformDistHigh);
+	}
+
+	return;
+}
+
+/**
+ *	@brief  Draws and calibrates the Monte Carlo samples of a range of iterations, in blocks.
+ *		Writes the result to `range->result`, so that it can run as a thread.
+ *
+ *	@param  range	: Pointer to the range to calculate.
+ */
+static void
+calculateMonteCarloSampleRange(MonteCarloSampleRange *  range)
+{
+	double				AoutSamples[kMonteCarloSampleBlockSize];
+	double				VddSamples[kMonteCarloSampleBlockSize];
+	float				AoutSamplesFloat[kMonteCarloSampleBlockSize];
+	float				VddSamplesFloat[kMonteCarloSampleBlockSize];
+	double				blockOutputSamplesDouble[kOutputDistributionIndexCalibratedSensorOutputMax][kMonteCarloSampleBlockSize];
+	float				blockOutputSamplesFloat[kOutputDistributionIndexCalibratedSensorOutputMax][kMonteCarloSampleBlockSize];
+	MonteCarloOutputSamples		blockOutputSamples;
+	CommandLineArguments *		arguments = range->arguments;
+	const CalibrationLookupTable *	lookupTable = range->lookupTable;
+	MonteCarloOutputSamples *	monteCarloOutputSamples = range->monteCarloOutputSamples;
+	bool				isStreaming = (range->streamingStatistics != NULL);
+	bool				calculateAllOutputs = (arguments->common.outputSelect == kOutputDistributionIndexCalibratedSensorOutputMax);
+	bool				isSinglePrecision = arguments->isSinglePrecisionEnabled;
+	CalibrationBatchFunction	calibrationBatchFunction = NULL;
+	CalibrationBatchFunctionFloat	calibrationBatchFunctionFloat = NULL;
+	OutputDistributionIndex		variantLowerBound;
+	OutputDistributionIndex		variantUpperBound;
+
+	range->result = kCommonConstantReturnTypeSuccess;
+	getSelectedOutputBounds(arguments, &variantLowerBound, &variantUpperBound);
+
+	/*
+	 *	In the streaming statistics mode, each block is calibrated into
+	 *	buffers of a single block, and folded into the statistics.
+	 */
+	if (isStreaming)
+	{
+		for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+		{
+			blockOutputSamples.asDouble[variant] = blockOutputSamplesDouble[variant];
+			blockOutputSamples.asFloat[variant] = blockOutputSamplesFloat[variant];
+		}
+
+		monteCarloOutputSamples = &blockOutputSamples;
+	}
+
+	/*
+	 *	Select the batch kernel once, outside the main computation loop.
+	 */
+	if (!calculateAllOutputs && (lookupTable == NULL))
+	{
+		if (isSinglePrecision)
+		{
+			calibrationBatchFunctionFloat = getCalibrationBatchFunctionFloat(arguments->common.outputSelect);
+		}
+		else
+		{
+			calibrationBatchFunction = getCalibrationBatchFunction(getCalibrationKernelImplementation(), arguments->common.outputSelect);
+		}
+
+		if ((calibrationBatchFunction == NULL) && (calibrationBatchFunctionFloat == NULL))
+		{
+			fprintf(stderr, "Error: No batch calibration kernel for output %zu.\n", (size_t) arguments->common.outputSelect);
+			range->result = kCommonConstantReturnTypeError;
+
+			return;
+		}
+	}
+
+	for (size_t blockStart = range->sampleStart; blockStart < range->sampleEnd; blockStart += kMonteCarloSampleBlockSize)
+	{
+		size_t	blockSize = range->sampleEnd - blockStart;
+		size_t	outputOffset = isStreaming ? 0 : blockStart;
+
+		if (blockSize > kMonteCarloSampleBlockSize)
+		{
+			blockSize = kMonteCarloSampleBlockSize;
+		}
+
+		switch (arguments->randomNumberGeneratorType)
+		{
+			case kRandomNumberGeneratorTypeXoshiro256:
+				drawInputSamplesViaRandomNumberGenerator(&range->randomNumberGenerator, AoutSamples, VddSamples, blockSize);
+				break;
+
+			case kRandomNumberGeneratorTypePhilox:
+				drawInputPairsWithSamplingStrategy(
+					arguments->samplingStrategy,
+					arguments->seed,
+					arguments->common.numberOfMonteCarloIterations,
+					blockStart,
+					kDefaultInputDistributionAoutUniformDistLow,
+					kDefaultInputDistributionAoutUniformDistHigh,
+					kDefaultInputDistributionVddUniformDistLow,
+					kDefaultInputDistributionVddUniformDistHigh,
+					AoutSamples,
+					VddSamples,
+					blockSize);
+				break;
+
+			case kRandomNumberGeneratorTypeSobol:
+			case kRandomNumberGeneratorTypeSobolScrambled:
+			case kRandomNumberGeneratorTypeHalton:
+			case kRandomNumberGeneratorTypeHaltonScrambled:
+				drawQuasiRandomPairs(
+					range->quasiRandomSequence,
+					blockStart,
+					kDefaultInputDistributionAoutUniformDistLow,
+					kDefaultInputDistributionAoutUniformDistHigh,
+					kDefaultInputDistributionVddUniformDistLow,
+					kDefaultInputDistributionVddUniformDistHigh,
+					AoutSamples,
+					VddSamples,
+					blockSize);
+				break;
+
+			default:
+				drawInputSamplesViaUxHwCall(AoutSamples, VddSamples, blockSize);
+				break;
+		}
+
+		if (isSinglePrecision)
+		{
+			convertBlockToFloat(AoutSamples, AoutSamplesFloat, blockSize);
+			convertBlockToFloat(VddSamples, VddSamplesFloat, blockSize);
+		}
+
+		if (lookupTable != NULL)
+		{
+			for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+			{
+				if (calculateCalibratedSensorOutputBatchLookupTable(
+					lookupTable,
+					variant,
+					AoutSamples,
+					VddSamples,
+					&monteCarloOutputSamples->asDouble[variant][outputOffset],
+					blockSize) != kCommonConstantReturnTypeSuccess)
+				{
+					range->result = kCommonConstantReturnTypeError;
+
+					return;
+				}
+			}
+		}
+		else if (calculateAllOutputs)
+		{
+			if (isSinglePrecision)
+			{
+				float *	variantOutputSamples[kOutputDistributionIndexCalibratedSensorOutputMax];
+
+				for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+				{
+					variantOutputSamples[variant] = &monteCarloOutputSamples->asFloat[variant][outputOffset];
+				}
+
+				calculateCalibratedSensorOutputBatchAllVariantsFloat(AoutSamplesFloat, VddSamplesFloat, variantOutputSamples, blockSize);
+			}
+			else
+			{
+				double *	variantOutputSamples[kOutputDistributionIndexCalibratedSensorOutputMax];
+
+				for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+				{
+					variantOutputSamples[variant] = &monteCarloOutputSamples->asDouble[variant][outputOffset];
+				}
+
+				calculateCalibratedSensorOutputBatchAllVariants(AoutSamples, VddSamples, variantOutputSamples, blockSize);
+			}
+		}
+		else if (isSinglePrecision)
+		{
+			calibrationBatchFunctionFloat(
+				AoutSamplesFloat,
+				VddSamplesFloat,
+				&monteCarloOutputSamples->asFloat[arguments->common.outputSelect][outputOffset],
+				blockSize);
+		}
+		else
+		{
+			calibrationBatchFunction(
+				AoutSamples,
+				VddSamples,
+				&monteCarloOutputSamples->asDouble[arguments->common.outputSelect][outputOffset],
+				blockSize);
+		}
+
+		if (isStreaming)
+		{
+			for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+			{
+				if (isSinglePrecision)
+				{
+					addFloatSamplesToStreamingStatistics(&range->streamingStatistics[variant], monteCarloOutputSamples->asFloat[variant], blockSize);
+				}
+				else
+				{
+					addDoubleSamplesToStreamingStatistics(&range->streamingStatistics[variant], monteCarloOutputSamples->asDouble[variant], blockSize);
+				}
+			}
+		}
+
+		if (range->quantileSketches != NULL)
+		{
+			for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+			{
+				if (isSinglePrecision)
+				{
+					addFloatSamplesToQuantileSketch(&range->quantileSketches[variant], &monteCarloOutputSamples->asFloat[variant][outputOffset], blockSize);
+				}
+				else
+				{
+					addDoubleSamplesToQuantileSketch(&range->quantileSketches[variant], &monteCarloOutputSamples->asDouble[variant][outputOffset], blockSize);
+				}
+			}
+		}
+
+		if (range->histograms != NULL)
+		{
+			for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+			{
+				if (isSinglePrecision)
+				{
+					addFloatSamplesToHistogram(&range->histograms[variant], &monteCarloOutputSamples->asFloat[variant][outputOffset], blockSize);
+				}
+				else
+				{
+					addDoubleSamplesToHistogram(&range->histograms[variant], &monteCarloOutputSamples->asDouble[variant][outputOffset], blockSize);
+				}
+			}
+		}
+	}
+
+	return;
+}
+
+#if kMonteCarloThreadsAreSupported
+/**
+ *	@brief  Thread entry point of `calculateMonteCarloSampleRange()`.
+ *
+ *	@param  range	: Pointer to the `MonteCarloSampleRange` to calculate.
+ *	@return void *	: `NULL`. The result is in the range struct.
+ */
+static void *
+calculateMonteCarloSampleRangeThread(void *  range)
+{
+	calculateMonteCarloSampleRange((MonteCarloSampleRange *) range);
+
+	return NULL;
+}
+#endif /* kMonteCarloThreadsAreSupported */
+
+CommonConstantReturnType
+runNativeMonteCarloIterationRange(
+	CommandLineArguments *		arguments,
+	const CalibrationLookupTable *	lookupTable,
+	MonteCarloOutputSamples *	monteCarloOutputSamples,
+	StreamingStatistics *		streamingStatistics,
+	QuantileSketch *		quantileSketches,
+	Histogram *			histograms,
+	size_t				sampleStart,
+	size_t				sampleEnd,
+	uint64_t			firstStreamIndex)
+{
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+	size_t				numberOfIterations = sampleEnd - sampleStart;
+	size_t				numberOfThreads = arguments->numberOfThreads;
+	MonteCarloSampleRange *		ranges;
+	StreamingStatistics *		rangeStreamingStatistics = NULL;
+	QuantileSketch *		rangeQuantileSketches = NULL;
+	Histogram *			rangeHistograms = NULL;
+	OutputDistributionIndex		variantLowerBound;
+	OutputDistributionIndex		variantUpperBound;
+	QuasiRandomSequence		quasiRandomSequence;
+	bool *				isThreadRunning;
+#if kMonteCarloThreadsAreSupported
+	pthread_t *			threads;
+#endif /* kMonteCarloThreadsAreSupported */
+
+	/*
+	 *	Without a seeded generator, draw all samples via the UxHw API calls,
+	 *	in the calling thread.
+	 */
+	if (arguments->randomNumberGeneratorType == kRandomNumberGeneratorTypeUxHw)
+	{
+		MonteCarloSampleRange	range =
+					{
+						.arguments			= arguments,
+						.lookupTable			= lookupTable,
+						.monteCarloOutputSamples	= monteCarloOutputSamples,
+						.streamingStatistics		= streamingStatistics,
+						.quantileSketches		= quantileSketches,
+						.histograms			= histograms,
+						.sampleStart			= sampleStart,
+						.sampleEnd			= sampleEnd,
+					};
+
+		calculateMonteCarloSampleRange(&range);
+
+		return range.result;
+	}
+
+	/*
+	 *	The quasi-random sequences are shared by all threads, which draw
+	 *	their slices of the points of the sequence.
+	 */
+	if (isQuasiRandomNumberGeneratorType(arguments->randomNumberGeneratorType) &&
+		(initializeQuasiRandomSequence(&quasiRandomSequence, arguments->randomNumberGeneratorType, arguments->seed) != kCommonConstantReturnTypeSuccess))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	getSelectedOutputBounds(arguments, &variantLowerBound, &variantUpperBound);
+
+	ranges = (MonteCarloSampleRange *) checkedMalloc(numberOfThreads * sizeof(MonteCarloSampleRange), __FILE__, __LINE__);
+	isThreadRunning = (bool *) checkedMalloc(numberOfThreads * sizeof(bool), __FILE__, __LINE__);
+
+	if (streamingStatistics != NULL)
+	{
+		rangeStreamingStatistics = (StreamingStatistics *) checkedMalloc(
+							numberOfThreads * kOutputDistributionIndexCalibratedSensorOutputMax * sizeof(StreamingStatistics),
+							__FILE__,
+							__LINE__);
+	}
+
+	if (quantileSketches != NULL)
+	{
+		rangeQuantileSketches = (QuantileSketch *) checkedMalloc(
+						numberOfThreads * kOutputDistributionIndexCalibratedSensorOutputMax * sizeof(QuantileSketch),
+						__FILE__,
+						__LINE__);
+	}
+
+	if (histograms != NULL)
+	{
+		rangeHistograms = (Histogram *) checkedMalloc(
+					numberOfThreads * kOutputDistributionIndexCalibratedSensorOutputMax * sizeof(Histogram),
+					__FILE__,
+					__LINE__);
+	}
+#if kMonteCarloThreadsAreSupported
+	threads = (pthread_t *) checkedMalloc(numberOfThreads * sizeof(pthread_t), __FILE__, __LINE__);
+#endif /* kMonteCarloThreadsAreSupported */
+
+	/*
+	 *	Each thread draws its own contiguous slice of the iterations from its
+	 *	own stream of the seed, and writes to its own slice of the output
+	 *	samples. The samples therefore depend only on the seed and the number
+	 *	of threads (and with Philox and the quasi-random sequences, only on the
+	 *	seed), not on the scheduling of the threads.
+	 */
+	for (size_t thread = 0; thread < numberOfThreads; thread++)
+	{
+		ranges[thread] = (MonteCarloSampleRange)
+				{
+					.arguments			= arguments,
+					.lookupTable			= lookupTable,
+					.monteCarloOutputSamples	= monteCarloOutputSamples,
+					.quasiRandomSequence		= &quasiRandomSequence,
+					.streamingStatistics		= NULL,
+					.quantileSketches		= NULL,
+					.histograms			= NULL,
+					.sampleStart			= sampleStart + numberOfIterations * thread / numberOfThreads,
+					.sampleEnd			= sampleStart + numberOfIterations * (thread + 1) / numberOfThreads,
+				};
+		isThreadRunning[thread] = false;
+
+		if (arguments->randomNumberGeneratorType == kRandomNumberGeneratorTypeXoshiro256)
+		{
+			seedRandomNumberGenerator(&ranges[thread].randomNumberGenerator, arguments->seed, firstStreamIndex + thread);
+		}
+
+		if (streamingStatistics != NULL)
+		{
+			ranges[thread].streamingStatistics = &rangeStreamingStatistics[thread * kOutputDistributionIndexCalibratedSensorOutputMax];
+
+			for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+			{
+				initializeStreamingStatistics(&ranges[thread].streamingStatistics[variant]);
+			}
+		}
+
+		if (quantileSketches != NULL)
+		{
+			ranges[thread].quantileSketches = &rangeQuantileSketches[thread * kOutputDistributionIndexCalibratedSensorOutputMax];
+
+			for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+			{
+				initializeQuantileSketch(&ranges[thread].quantileSketches[variant]);
+			}
+		}
+
+		/*
+		 *	Each thread counts into its own histograms, with the bins of the
+		 *	histograms of the selected variants, so that it needs no locks.
+		 */
+		if (histograms != NULL)
+		{
+			ranges[thread].histograms = &rangeHistograms[thread * kOutputDistributionIndexCalibratedSensorOutputMax];
+
+			for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+			{
+				initializeHistogram(
+					&ranges[thread].histograms[variant],
+					histograms[variant].low,
+					histograms[variant].high,
+					histograms[variant].numberOfBins);
+			}
+		}
+
+#if kMonteCarloThreadsAreSupported
+		if (numberOfThreads > 1)
+		{
+			isThreadRunning[thread] = (pthread_create(&threads[thread], NULL, calculateMonteCarloSampleRangeThread, &ranges[thread]) == 0);
+		}
+#endif /* kMonteCarloThreadsAreSupported */
+	}
+
+	/*
+	 *	Calculate the slices of threads that could not be started in the
+	 *	calling thread. This gives the same samples.
+	 */
+	for (size_t thread = 0; thread < numberOfThreads; thread++)
+	{
+		if (isThreadRunning[thread])
+		{
+#if kMonteCarloThreadsAreSupported
+			pthread_join(threads[thread], NULL);
+#endif /* kMonteCarloThreadsAreSupported */
+		}
+		else
+		{
+			if (numberOfThreads > 1)
+			{
+				fprintf(stderr, "Warning: Could not start thread %zu. Calculating its samples serially.\n", thread);
+			}
+
+			calculateMonteCarloSampleRange(&ranges[thread]);
+		}
+
+		if (ranges[thread].result != kCommonConstantReturnTypeSuccess)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+
+		/*
+		 *	Merge the statistics and quantile sketches of the threads in
+		 *	the order of their slices, so that they do not depend on the
+		 *	scheduling either.
+		 */
+		if (streamingStatistics != NULL)
+		{
+			for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+			{
+				mergeStreamingStatistics(&streamingStatistics[variant], &ranges[thread].streamingStatistics[variant]);
+			}
+		}
+
+		if (quantileSketches != NULL)
+		{
+			for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+			{
+				mergeQuantileSketch(&quantileSketches[variant], &ranges[thread].quantileSketches[variant]);
+			}
+		}
+
+		if (histograms != NULL)
+		{
+			for (OutputDistributionIndex variant = variantLowerBound; variant < variantUpperBound; variant++)
+			{
+				mergeHistogram(&histograms[variant], &ranges[thread].histograms[variant]);
+				freeHistogram(&ranges[thread].histograms[variant]);
+			}
+		}
+	}
+
+	free(ranges);
+	free(rangeStreamingStatistics);
+	free(rangeQuantileSketches);
+	free(rangeHistograms);
+	free(isThreadRunning);
+#if kMonteCarloThreadsAreSupported
+	free(threads);
+#endif /* kMonteCarloThreadsAreSupported */
+
+	return result;
+}
+
+CommonConstantReturnType
+runNativeMonteCarloIterations(
+	CommandLineArguments *		arguments,
+	const CalibrationLookupTable *	lookupTable,
+	MonteCarloOutputSamples *	monteCarloOutputSamples,
+	StreamingStatistics *		streamingStatistics,
+	QuantileSketch *		quantileSketches,
+	Histogram *			histograms)
+{
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		if (streamingStatistics != NULL)
+		{
+			initializeStreamingStatistics(&streamingStatistics[variant]);
+		}
+
+		if (quantileSketches != NULL)
+		{
+			initializeQuantileSketch(&quantileSketches[variant]);
+		}
+	}
+
+	return runNativeMonteCarloIterationRange(
+			arguments,
+			lookupTable,
+			monteCarloOutputSamples,
+			streamingStatistics,
+			quantileSketches,
+			histograms,
+			0,
+			arguments->common.numberOfMonteCarloIterations,
+			0);
+}
+
+void
+printSinglePrecisionAccuracyReport(CommandLineArguments *  arguments, const char **  outputVariableDescriptions)
+{
+	double *		Aout = (double *) checkedMalloc(kSinglePrecisionAccuracyCheckNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *		Vdd = (double *) checkedMalloc(kSinglePrecisionAccuracyCheckNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *		Pa = (double *) checkedMalloc(kSinglePrecisionAccuracyCheckNumberOfSamples * sizeof(double), __FILE__, __LINE__);
+	float *			AoutFloat = (float *) checkedMalloc(kSinglePrecisionAccuracyCheckNumberOfSamples * sizeof(float), __FILE__, __LINE__);
+	float *			VddFloat = (float *) checkedMalloc(kSinglePrecisionAccuracyCheckNumberOfSamples * sizeof(float), __FILE__, __LINE__);
+	float *			PaFloat = (float *) checkedMalloc(kSinglePrecisionAccuracyCheckNumberOfSamples * sizeof(float), __FILE__, __LINE__);
+	OutputDistributionIndex	outputSelectLowerBound;
+	OutputDistributionIndex	outputSelectUpperBound;
+
+	getSelectedOutputBounds(arguments, &outputSelectLowerBound, &outputSelectUpperBound);
+	drawInputSamplesViaUxHwCall(Aout, Vdd, kSinglePrecisionAccuracyCheckNumberOfSamples);
+	convertBlockToFloat(Aout, AoutFloat, kSinglePrecisionAccuracyCheckNumberOfSamples);
+	convertBlockToFloat(Vdd, VddFloat, kSinglePrecisionAccuracyCheckNumberOfSamples);
+
+	printf("\nSingle precision versus double precision calibration (%d input samples):\n", kSinglePrecisionAccuracyCheckNumberOfSamples);
+
+	for (OutputDistributionIndex variant = outputSelectLowerBound; variant < outputSelectUpperBound; variant++)
+	{
+		double	maximumAbsoluteDifference = 0.0;
+		double	maximumAbsoluteOutput = 0.0;
+		double	sumOfDifferences = 0.0;
+
+		calculateCalibratedSensorOutputBatchWithImplementation(
+			kCalibrationKernelImplementationScalar,
+			variant,
+			Aout,
+			Vdd,
+			Pa,
+			kSinglePrecisionAccuracyCheckNumberOfSamples);
+		getCalibrationBatchFunctionFloat(variant)(AoutFloat, VddFloat, PaFloat, kSinglePrecisionAccuracyCheckNumberOfSamples);
+
+		for (size_t i = 0; i < kSinglePrecisionAccuracyCheckNumberOfSamples; i++)
+		{
+			double	difference = (double)PaFloat[i] - Pa[i];
+
+			maximumAbsoluteDifference = fmax(maximumAbsoluteDifference, fabs(difference));
+			maximumAbsoluteOutput = fmax(maximumAbsoluteOutput, fabs(Pa[i]));
+			sumOfDifferences += difference;
+		}
+
+		printf(
+			"\t%s: maximum absolute difference %.3e Pa (%.3e of the largest output), mean difference %.3e Pa\n",
+			outputVariableDescriptions[variant],
+			maximumAbsoluteDifference,
+			(maximumAbsoluteOutput > 0.0) ? (maximumAbsoluteDifference / maximumAbsoluteOutput) : 0.0,
+			sumOfDifferences / kSinglePrecisionAccuracyCheckNumberOfSamples);
+	}
+
+	free(Aout);
+	free(Vdd);
+	free(Pa);
+	free(AoutFloat);
+	free(VddFloat);
+	free(PaFloat);
+
+	return;
+}
+
+/**
+ *	@brief  Calculates the statistics of all outputs from input samples drawn with a sampling strategy.
+ *
+ *	@param  strategy		: The sampling strategy.
+ *	@param  seed			: The seed of the strategy.
+ *	@param  numberOfSamples		: The number of input samples.
+ *	@param  statistics		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` statistics, indexed by
+ *					  `OutputDistributionIndex`, where the function writes the statistics.
+ */
+static void
+calculateOutputStatisticsWithSamplingStrategy(SamplingStrategy strategy, uint64_t seed, size_t numberOfSamples, StreamingStatistics *  statistics)
+{
+	double			AoutSamples[kMonteCarloSampleBlockSize];
+	double			VddSamples[kMonteCarloSampleBlockSize];
+	double			outputSamples[kOutputDistributionIndexCalibratedSensorOutputMax][kMonteCarloSampleBlockSize];
+	double *		blockOutputSamples[kOutputDistributionIndexCalibratedSensorOutputMax];
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		blockOutputSamples[variant] = outputSamples[variant];
+		initializeStreamingStatistics(&statistics[variant]);
+	}
+
+	for (size_t blockStart = 0; blockStart < numberOfSamples; blockStart += kMonteCarloSampleBlockSize)
+	{
+		size_t	blockSize = numberOfSamples - blockStart;
+
+		if (blockSize > kMonteCarloSampleBlockSize)
+		{
+			blockSize = kMonteCarloSampleBlockSize;
+		}
+
+		drawInputPairsWithSamplingStrategy(
+			strategy,
+			seed,
+			numberOfSamples,
+			blockStart,
+			kDefaultInputDistributionAoutUniformDistLow,
+			kDefaultInputDistributionAoutUniformDistHigh,
+			kDefaultInputDistributionVddUniformDistLow,
+			kDefaultInputDistributionVddUniformDistHigh,
+			AoutSamples,
+			VddSamples,
+			blockSize);
+		calculateCalibratedSensorOutputBatchAllVariants(AoutSamples, VddSamples, blockOutputSamples, blockSize);
+
+		for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+		{
+			addDoubleSamplesToStreamingStatistics(&statistics[variant], outputSamples[variant], blockSize);
+		}
+	}
+
+	return;
+}
+
+void
+printSamplingStrategyReport(CommandLineArguments *  arguments, const char **  outputVariableDescriptions)
+{
+	StreamingStatistics	meanEstimates[2][kOutputDistributionIndexCalibratedSensorOutputMax];
+	SamplingStrategy	strategies[2] = {kSamplingStrategyIndependent, arguments->samplingStrategy};
+	size_t			numberOfSamples = arguments->common.numberOfMonteCarloIterations;
+	OutputDistributionIndex	outputSelectLowerBound;
+	OutputDistributionIndex	outputSelectUpperBound;
+
+	getSelectedOutputBounds(arguments, &outputSelectLowerBound, &outputSelectUpperBound);
+
+	if (numberOfSamples > kSamplingStrategyReportMaximumNumberOfSamples)
+	{
+		numberOfSamples = kSamplingStrategyReportMaximumNumberOfSamples;
+	}
+
+	/*
+	 *	The variance of the mean of each strategy is estimated from the
+	 *	spread of the means of independent replicates (different seeds).
+	 */
+	for (int strategy = 0; strategy < 2; strategy++)
+	{
+		for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+		{
+			initializeStreamingStatistics(&meanEstimates[strategy][variant]);
+		}
+
+		for (uint64_t replicate = 0; replicate < kSamplingStrategyReportNumberOfReplicates; replicate++)
+		{
+			StreamingStatistics	statistics[kOutputDistributionIndexCalibratedSensorOutputMax];
+
+			calculateOutputStatisticsWithSamplingStrategy(strategies[strategy], arguments->seed + replicate, numberOfSamples, statistics);
+
+			for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+			{
+				addDoubleSamplesToStreamingStatistics(&meanEstimates[strategy][variant], &statistics[variant].mean, 1);
+			}
+		}
+	}
+
+	printf(
+		"\nVariance reduction of %s sampling (%d replicates of %zu samples, versus iid sampling):\n",
+		getSamplingStrategyName(arguments->samplingStrategy),
+		kSamplingStrategyReportNumberOfReplicates,
+		numberOfSamples);
+
+	for (OutputDistributionIndex variant = outputSelectLowerBound; variant < outputSelectUpperBound; variant++)
+	{
+		double	independentVariance = getStreamingStatisticsMeanAndVariance(&meanEstimates[0][variant]).variance;
+		double	strategyVariance = getStreamingStatisticsMeanAndVariance(&meanEstimates[1][variant]).variance;
+		double	varianceReductionFactor = (strategyVariance > 0.0) ? (independentVariance / strategyVariance) : INFINITY;
+
+		/*
+		 *	With iid and antithetic sampling, the variance of the mean is
+		 *	inversely proportional to the number of samples, so the factor
+		 *	carries over to the samples of the run. With stratified and Latin
+		 *	hypercube sampling, the factor grows with the number of samples,
+		 *	so it is a lower bound for runs of more samples than the replicates.
+		 */
+		printf(
+			"\t%s: standard error of the mean %.3e Pa (iid: %.3e Pa), variance reduction factor %.3g, effective sample size %.4g of %zu samples\n",
+			outputVariableDescriptions[variant],
+			sqrt(strategyVariance),
+			sqrt(independentVariance),
+			varianceReductionFactor,
+			varianceReductionFactor * (double)arguments->common.numberOfMonteCarloIterations,
+			arguments->common.numberOfMonteCarloIterations);
+	}
+
+	return;
+}
+
+void
+initializeOutputHistograms(CommandLineArguments *  arguments, Histogram *  histograms)
+{
+	StreamingStatistics	pilotStatistics[kOutputDistributionIndexCalibratedSensorOutputMax];
+	OutputDistributionIndex	outputSelectLowerBound;
+	OutputDistributionIndex	outputSelectUpperBound;
+
+	getSelectedOutputBounds(arguments, &outputSelectLowerBound, &outputSelectUpperBound);
+
+	/*
+	 *	The pilot batch draws independent Philox inputs, whatever the input
+	 *	generator of the run, so that it does not change the samples of the
+	 *	run, and so that it covers the input rectangle even when the strata
+	 *	of the run are laid out in the order of the iterations.
+	 */
+	if (!arguments->isHistogramRangeSelected)
+	{
+		calculateOutputStatisticsWithSamplingStrategy(kSamplingStrategyIndependent, arguments->seed, kHistogramPilotNumberOfSamples, pilotStatistics);
+	}
+
+	for (OutputDistributionIndex variant = outputSelectLowerBound; variant < outputSelectUpperBound; variant++)
+	{
+		double	low = arguments->histogramLow;
+		double	high = arguments->histogramHigh;
+
+		if (!arguments->isHistogramRangeSelected)
+		{
+			double	margin = kHistogramAutoRangeMargin * (pilotStatistics[variant].maximum - pilotStatistics[variant].minimum);
+
+			low = pilotStatistics[variant].minimum - margin;
+			high = pilotStatistics[variant].maximum + margin;
+
+			/*
+			 *	Keep the range non-empty for a constant output.
+			 */
+			if (!(low < high))
+			{
+				low -= 0.5;
+				high += 0.5;
+			}
+		}
+
+		initializeHistogram(&histograms[variant], low, high, arguments->histogramNumberOfBins);
+	}
+
+	return;
+}
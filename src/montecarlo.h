@@ -0,0 +1,136 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "utilities.h"
+#include "calibration-lookup-table.h"
+#include "streaming-statistics.h"
+#include "quantile-sketch.h"
+#include "histogram.h"
+
+/**
+ *	@brief  Runs the native Monte Carlo iterations: draws blocks of (Aout, Vdd) input samples
+ *		via calls to UxHw API functions and calibrates each block with the batch calibration
+ *		kernels. When all outputs are selected, each input sample is drawn once and all
+ *		variants are evaluated from it, so the variants share the same random numbers.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  lookupTable			: Pointer to the lookup tables of the selected variants, to calibrate via the tables
+ *						  instead of the batch calibration kernels, or `NULL`.
+ *	@param  monteCarloOutputSamples		: Pointer to the arrays where the function writes the output samples of each selected
+ *						  variant, in single precision if `arguments->isSinglePrecisionEnabled`. Entries of
+ *						  variants that are not selected are not used. Not used if `streamingStatistics`
+ *						  is not `NULL`.
+ *	@param  streamingStatistics		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` statistics, where the
+ *						  function folds the output samples of each selected variant into, instead of storing
+ *						  them, or `NULL`.
+ *	@param  quantileSketches		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` quantile sketches, where
+ *						  the function adds the output samples of each selected variant to, or `NULL`. Each
+ *						  thread sketches its own slice, and the sketches are merged in the order of the slices.
+ *	@param  histograms			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` histograms, whose entries of
+ *						  the selected variants are initialized, where the function counts the output samples
+ *						  of each selected variant, or `NULL`. Each thread counts its own slice in histograms
+ *						  with the same bins, which are merged at the end.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runNativeMonteCarloIterations(
+					CommandLineArguments *		arguments,
+					const CalibrationLookupTable *	lookupTable,
+					MonteCarloOutputSamples *	monteCarloOutputSamples,
+					StreamingStatistics *		streamingStatistics,
+					QuantileSketch *		quantileSketches,
+					Histogram *			histograms);
+
+/**
+ *	@brief  Runs a range of the native Monte Carlo iterations, as `runNativeMonteCarloIterations()` runs
+ *		all of them, e.g., to run the iterations in batches. The output samples are written at the
+ *		indices of their iterations, and the statistics, sketches, and histograms of the range are
+ *		merged into `streamingStatistics`, `quantileSketches`, and `histograms`.
+ *		With the xoshiro256** generator, the threads draw from the streams of the seed from
+ *		`firstStreamIndex` on, so consecutive ranges must use distinct stream indices. With the other
+ *		generators, the samples of an iteration only depend on its index.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  lookupTable			: Pointer to the lookup tables of the selected variants, or `NULL`.
+ *	@param  monteCarloOutputSamples		: Pointer to the arrays where the function writes the output samples, as in
+ *						  `runNativeMonteCarloIterations()`.
+ *	@param  streamingStatistics		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` statistics, where the
+ *						  function folds the output samples of each selected variant into, or `NULL`.
+ *	@param  quantileSketches		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` quantile sketches, where
+ *						  the function adds the output samples of each selected variant to, or `NULL`.
+ *	@param  histograms			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` histograms, where the
+ *						  function counts the output samples of each selected variant, or `NULL`.
+ *	@param  sampleStart			: The index of the first iteration of the range.
+ *	@param  sampleEnd			: One past the index of the last iteration of the range.
+ *	@param  firstStreamIndex		: The index of the xoshiro256** stream of the first thread. The other
+ *						  generators do not seed the streams, and ignore it.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runNativeMonteCarloIterationRange(
+					CommandLineArguments *		arguments,
+					const CalibrationLookupTable *	lookupTable,
+					MonteCarloOutputSamples *	monteCarloOutputSamples,
+					StreamingStatistics *		streamingStatistics,
+					QuantileSketch *		quantileSketches,
+					Histogram *			histograms,
+					size_t				sampleStart,
+					size_t				sampleEnd,
+					uint64_t			firstStreamIndex);
+
+/**
+ *	@brief  Compares the single-precision calibration kernels against the double-precision scalar
+ *		reference on fresh input samples, and prints, for each selected variant, the maximum
+ *		absolute difference, that difference relative to the largest output, and the mean
+ *		difference.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  outputVariableDescriptions	: An array of strings containing the descriptions of the outputs.
+ */
+void	printSinglePrecisionAccuracyReport(CommandLineArguments *  arguments, const char **  outputVariableDescriptions);
+
+/**
+ *	@brief  Estimates the variance of the mean of each selected output with the selected sampling
+ *		strategy and with independent sampling, from the means of
+ *		`kSamplingStrategyReportNumberOfReplicates` runs with different seeds of the number of
+ *		iterations of the run (up to `kSamplingStrategyReportMaximumNumberOfSamples`), and prints
+ *		the variance reduction factor of the strategy and the effective sample size of the run,
+ *		i.e., the number of independent samples that give the same variance of the mean.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  outputVariableDescriptions	: An array of strings containing the descriptions of the outputs.
+ */
+void	printSamplingStrategyReport(CommandLineArguments *  arguments, const char **  outputVariableDescriptions);
+
+/**
+ *	@brief  Initializes the histograms of the selected outputs, with the number of bins and range of
+ *		the command-line arguments. Without a range, the range of each output is the range of
+ *		the outputs of a pilot batch of `kHistogramPilotNumberOfSamples` independent Philox inputs,
+ *		widened by `kHistogramAutoRangeMargin` of its width at both ends.
+ *
+ *	@param  arguments	: Pointer to command-line arguments struct.
+ *	@param  histograms	: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` histograms, indexed by
+ *				  `OutputDistributionIndex`, whose entries of the selected outputs the function initializes.
+ */
+void	initializeOutputHistograms(CommandLineArguments *  arguments, Histogram *  histograms);
@@ -0,0 +1,704 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "particle-distribution.h"
+#include "calibration-kernels.h"
+#include "analytic-distribution.h"
+#include "quantile-sketch.h"
+
+typedef struct
+{
+	double	value;
+	double	weight;
+} Particle;
+
+/*
+ *	Identifier of the next particle set. Zero is reserved for constants.
+ */
+static uint64_t	nextParticleSetIdentifier = 1;
+
+/**
+ *	@brief  Compares two particles by value, for `qsort()`.
+ *
+ *	@param  a	: Pointer to the first particle.
+ *	@param  b	: Pointer to the second particle.
+ *	@return int	: Negative, zero, or positive if the first is smaller than, equal to, or greater than the second.
+ */
+static int
+compareParticles(const void *  a, const void *  b)
+{
+	double	x = ((const Particle *)a)->value;
+	double	y = ((const Particle *)b)->value;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ *	@brief  Allocates the particles of a distribution.
+ *
+ *	@param  distribution		: Pointer to the distribution.
+ *	@param  numberOfParticles	: The number of particles.
+ *	@param  particleSetIdentifier	: The particle set of the distribution.
+ */
+static void
+allocateParticleDistribution(ParticleDistribution *  distribution, size_t numberOfParticles, uint64_t particleSetIdentifier)
+{
+	distribution->numberOfParticles = numberOfParticles;
+	distribution->values = (double *) checkedMalloc(numberOfParticles * sizeof(double), __FILE__, __LINE__);
+	distribution->weights = (double *) checkedMalloc(numberOfParticles * sizeof(double), __FILE__, __LINE__);
+	distribution->particleSetIdentifier = particleSetIdentifier;
+
+	return;
+}
+
+/**
+ *	@brief  Returns the result of a binary operation on two values.
+ *
+ *	@param  operation	: The operation.
+ *	@param  left		: The left operand.
+ *	@param  right		: The right operand.
+ *	@return double		: The result, or NaN for an invalid operation.
+ */
+static double
+applyParticleOperation(ParticleOperation operation, double left, double right)
+{
+	switch (operation)
+	{
+		case kParticleOperationAdd:
+			return left + right;
+
+		case kParticleOperationSubtract:
+			return left - right;
+
+		case kParticleOperationMultiply:
+			return left * right;
+
+		case kParticleOperationDivide:
+			return left / right;
+
+		case kParticleOperationPower:
+			return pow(left, right);
+
+		default:
+			return NAN;
+	}
+}
+
+/**
+ *	@brief  Sorts weighted particles and resamples them to the particles of a distribution: splits
+ *		the sorted particles into intervals of equal weight, splitting the particles that
+ *		straddle the boundaries, and sets one particle per interval at its mean, which keeps
+ *		the mean of the particles.
+ *
+ *	@param  particles		: The weighted particles, which the function sorts.
+ *	@param  numberOfInputParticles	: The number of weighted particles.
+ *	@param  distribution		: Pointer to the distribution, with its particles allocated, where
+ *					  the function writes its values and weights.
+ */
+static void
+resampleParticles(Particle *  particles, size_t numberOfInputParticles, ParticleDistribution *  distribution)
+{
+	size_t	numberOfParticles = distribution->numberOfParticles;
+	double	totalWeight = 0.0;
+	double	intervalWeight;
+	double	weight = 0.0;
+	double	moment = 0.0;
+	size_t	interval = 0;
+
+	qsort(particles, numberOfInputParticles, sizeof(Particle), compareParticles);
+
+	for (size_t i = 0; i < numberOfInputParticles; i++)
+	{
+		totalWeight += particles[i].weight;
+	}
+
+	intervalWeight = totalWeight / (double)numberOfParticles;
+
+	for (size_t i = 0; i < numberOfInputParticles; i++)
+	{
+		double	remainingWeight = particles[i].weight;
+
+		/*
+		 *	The last interval takes the remaining weight, whatever the
+		 *	rounding of the weights of the intervals before it.
+		 */
+		while ((interval + 1 < numberOfParticles) && (weight + remainingWeight >= intervalWeight))
+		{
+			double	part = intervalWeight - weight;
+
+			distribution->values[interval] = (moment + part * particles[i].value) / intervalWeight;
+			distribution->weights[interval] = intervalWeight;
+			interval++;
+			remainingWeight -= part;
+			weight = 0.0;
+			moment = 0.0;
+		}
+
+		weight += remainingWeight;
+		moment += remainingWeight * particles[i].value;
+	}
+
+	distribution->values[interval] = (weight > 0.0) ? (moment / weight) : particles[numberOfInputParticles - 1].value;
+	distribution->weights[interval] = weight;
+
+	return;
+}
+
+/**
+ *	@brief  Returns the particles of a distribution, sorted by value.
+ *
+ *	@param  distribution	: Pointer to the distribution.
+ *	@return Particle *	: The sorted particles, which the caller frees.
+ */
+static Particle *
+getSortedParticles(const ParticleDistribution *  distribution)
+{
+	Particle *	particles = (Particle *) checkedMalloc(distribution->numberOfParticles * sizeof(Particle), __FILE__, __LINE__);
+
+	for (size_t i = 0; i < distribution->numberOfParticles; i++)
+	{
+		particles[i] = (Particle) { .value = distribution->values[i], .weight = distribution->weights[i] };
+	}
+
+	qsort(particles, distribution->numberOfParticles, sizeof(Particle), compareParticles);
+
+	return particles;
+}
+
+/**
+ *	@brief  Returns a quantile of sorted particles: the smallest value at which their cumulative
+ *		weight reaches the probability.
+ *
+ *	@param  particles		: The particles, sorted by value, with weights that sum to one.
+ *	@param  numberOfParticles	: The number of particles.
+ *	@param  probability		: The probability of the quantile, in (0, 1).
+ *	@return double			: The quantile.
+ */
+static double
+getSortedParticlesQuantile(const Particle *  particles, size_t numberOfParticles, double probability)
+{
+	double	cumulativeWeight = 0.0;
+
+	for (size_t i = 0; i < numberOfParticles; i++)
+	{
+		cumulativeWeight += particles[i].weight;
+
+		if (cumulativeWeight >= probability)
+		{
+			return particles[i].value;
+		}
+	}
+
+	return particles[numberOfParticles - 1].value;
+}
+
+/**
+ *	@brief  Returns the largest difference between the CDF of sorted particles and the exact CDF
+ *		of an output, on both sides of each particle.
+ *
+ *	@param  particles		: The particles, sorted by value, with weights that sum to one.
+ *	@param  numberOfParticles	: The number of particles.
+ *	@param  distribution		: Pointer to the exact distribution of the output.
+ *	@return double			: The largest difference.
+ */
+static double
+getMaximumCdfDifference(const Particle *  particles, size_t numberOfParticles, const AnalyticOutputDistribution *  distribution)
+{
+	double	cumulativeWeight = 0.0;
+	double	maximumDifference = 0.0;
+
+	for (size_t i = 0; i < numberOfParticles; i++)
+	{
+		double	cdf = getAnalyticOutputCdf(distribution, particles[i].value);
+
+		maximumDifference = fmax(maximumDifference, fabs(cumulativeWeight - cdf));
+		cumulativeWeight += particles[i].weight;
+		maximumDifference = fmax(maximumDifference, fabs(cumulativeWeight - cdf));
+	}
+
+	return maximumDifference;
+}
+
+void
+initializeUniformParticleDistribution(ParticleDistribution *  distribution, double low, double high, size_t numberOfParticles)
+{
+	allocateParticleDistribution(distribution, numberOfParticles, nextParticleSetIdentifier++);
+
+	for (size_t i = 0; i < numberOfParticles; i++)
+	{
+		distribution->values[i] = low + (high - low) * (((double)i + 0.5) / (double)numberOfParticles);
+		distribution->weights[i] = 1.0 / (double)numberOfParticles;
+	}
+
+	return;
+}
+
+void
+initializeConstantParticleDistribution(ParticleDistribution *  distribution, double value)
+{
+	allocateParticleDistribution(distribution, 1, 0);
+	distribution->values[0] = value;
+	distribution->weights[0] = 1.0;
+
+	return;
+}
+
+void
+freeParticleDistribution(ParticleDistribution *  distribution)
+{
+	free(distribution->values);
+	free(distribution->weights);
+	distribution->values = NULL;
+	distribution->weights = NULL;
+	distribution->numberOfParticles = 0;
+
+	return;
+}
+
+void
+combineParticleDistributions(
+	ParticleOperation		operation,
+	const ParticleDistribution *	left,
+	const ParticleDistribution *	right,
+	size_t				numberOfParticles,
+	ParticleDistribution *		result)
+{
+	size_t		numberOfPairs;
+	Particle *	pairs;
+
+	if ((left->particleSetIdentifier != 0) && (left->particleSetIdentifier == right->particleSetIdentifier))
+	{
+		allocateParticleDistribution(result, left->numberOfParticles, left->particleSetIdentifier);
+
+		for (size_t i = 0; i < left->numberOfParticles; i++)
+		{
+			result->values[i] = applyParticleOperation(operation, left->values[i], right->values[i]);
+			result->weights[i] = left->weights[i];
+		}
+
+		return;
+	}
+
+	if ((left->numberOfParticles == 1) || (right->numberOfParticles == 1))
+	{
+		const ParticleDistribution *	particles = (left->numberOfParticles == 1) ? right : left;
+
+		allocateParticleDistribution(result, particles->numberOfParticles, particles->particleSetIdentifier);
+
+		for (size_t i = 0; i < particles->numberOfParticles; i++)
+		{
+			size_t	leftIndex = (left->numberOfParticles == 1) ? 0 : i;
+			size_t	rightIndex = (right->numberOfParticles == 1) ? 0 : i;
+
+			result->values[i] = applyParticleOperation(operation, left->values[leftIndex], right->values[rightIndex]);
+			result->weights[i] = left->weights[leftIndex] * right->weights[rightIndex];
+		}
+
+		return;
+	}
+
+	numberOfPairs = left->numberOfParticles * right->numberOfParticles;
+	pairs = (Particle *) checkedMalloc(numberOfPairs * sizeof(Particle), __FILE__, __LINE__);
+
+	for (size_t i = 0; i < left->numberOfParticles; i++)
+	{
+		for (size_t j = 0; j < right->numberOfParticles; j++)
+		{
+			pairs[i * right->numberOfParticles + j] = (Particle)
+								{
+									.value	= applyParticleOperation(operation, left->values[i], right->values[j]),
+									.weight	= left->weights[i] * right->weights[j],
+								};
+		}
+	}
+
+	allocateParticleDistribution(result, (numberOfPairs < numberOfParticles) ? numberOfPairs : numberOfParticles, nextParticleSetIdentifier++);
+	resampleParticles(pairs, numberOfPairs, result);
+	free(pairs);
+
+	return;
+}
+
+void
+combineParticleDistributionWithConstant(
+	ParticleOperation		operation,
+	const ParticleDistribution *	left,
+	double				right,
+	ParticleDistribution *		result)
+{
+	double			weight = 1.0;
+	ParticleDistribution	constant =
+				{
+					.numberOfParticles	= 1,
+					.values			= &right,
+					.weights		= &weight,
+					.particleSetIdentifier	= 0,
+				};
+
+	combineParticleDistributions(operation, left, &constant, left->numberOfParticles, result);
+
+	return;
+}
+
+void
+applyParticleFunction(ParticleFunction function, const ParticleDistribution *  argument, ParticleDistribution *  result)
+{
+	allocateParticleDistribution(result, argument->numberOfParticles, argument->particleSetIdentifier);
+
+	for (size_t i = 0; i < argument->numberOfParticles; i++)
+	{
+		switch (function)
+		{
+			case kParticleFunctionFabs:
+				result->values[i] = fabs(argument->values[i]);
+				break;
+
+			case kParticleFunctionSign:
+				result->values[i] = sign(argument->values[i]);
+				break;
+
+			default:
+				result->values[i] = NAN;
+				break;
+		}
+
+		result->weights[i] = argument->weights[i];
+	}
+
+	return;
+}
+
+MeanAndVariance
+getParticleDistributionMeanAndVariance(const ParticleDistribution *  distribution)
+{
+	double	totalWeight = 0.0;
+	double	moment = 0.0;
+	double	centralMoment = 0.0;
+	double	mean;
+
+	for (size_t i = 0; i < distribution->numberOfParticles; i++)
+	{
+		totalWeight += distribution->weights[i];
+		moment += distribution->weights[i] * distribution->values[i];
+	}
+
+	mean = moment / totalWeight;
+
+	for (size_t i = 0; i < distribution->numberOfParticles; i++)
+	{
+		double	deviation = distribution->values[i] - mean;
+
+		centralMoment += distribution->weights[i] * deviation * deviation;
+	}
+
+	return (MeanAndVariance) { .mean = mean, .variance = centralMoment / totalWeight };
+}
+
+/**
+ *	@brief  Particle version of `calculateLinearConfigurationOutputFromRatio()`.
+ *
+ *	@param  ratio	: Pointer to the distribution of the ratio `Aout / Vdd`.
+ *	@param  k1	: First calibration constant (gain).
+ *	@param  k2	: Second calibration constant (offset).
+ *	@param  Pa	: Pointer to the distribution where the function writes the output.
+ */
+static void
+calculateLinearConfigurationOutputParticles(const ParticleDistribution *  ratio, double k1, double k2, ParticleDistribution *  Pa)
+{
+	ParticleDistribution	scaled;
+
+	combineParticleDistributionWithConstant(kParticleOperationMultiply, ratio, k1, &scaled);
+	combineParticleDistributionWithConstant(kParticleOperationSubtract, &scaled, k2, Pa);
+	freeParticleDistribution(&scaled);
+
+	return;
+}
+
+/**
+ *	@brief  Particle version of `calculateSquareRootConfigurationOutput()`, given the ratio `Aout / Vdd`.
+ *
+ *	@param  ratio	: Pointer to the distribution of the ratio `Aout / Vdd`.
+ *	@param  k1	: Ratio at which the output changes sign.
+ *	@param  k2	: Ratio scaling constant.
+ *	@param  k3	: Offset of the scaled ratio.
+ *	@param  k4	: Output scaling constant.
+ *	@param  Pa	: Pointer to the distribution where the function writes the output.
+ */
+static void
+calculateSquareRootConfigurationOutputParticles(
+	const ParticleDistribution *	ratio,
+	double				k1,
+	double				k2,
+	double				k3,
+	double				k4,
+	ParticleDistribution *		Pa)
+{
+	ParticleDistribution	divided;
+	ParticleDistribution	scaled;
+	ParticleDistribution	squared;
+	ParticleDistribution	shifted;
+	ParticleDistribution	signs;
+	ParticleDistribution	signedSquared;
+
+	combineParticleDistributionWithConstant(kParticleOperationDivide, ratio, k2, &divided);
+	combineParticleDistributionWithConstant(kParticleOperationSubtract, &divided, k3, &scaled);
+	combineParticleDistributionWithConstant(kParticleOperationPower, &scaled, 2.0, &squared);
+	combineParticleDistributionWithConstant(kParticleOperationSubtract, ratio, k1, &shifted);
+	applyParticleFunction(kParticleFunctionSign, &shifted, &signs);
+	combineParticleDistributions(kParticleOperationMultiply, &signs, &squared, squared.numberOfParticles, &signedSquared);
+	combineParticleDistributionWithConstant(kParticleOperationMultiply, &signedSquared, k4, Pa);
+
+	freeParticleDistribution(&divided);
+	freeParticleDistribution(&scaled);
+	freeParticleDistribution(&squared);
+	freeParticleDistribution(&shifted);
+	freeParticleDistribution(&signs);
+	freeParticleDistribution(&signedSquared);
+
+	return;
+}
+
+void
+calculateCalibratedSensorOutputParticlesFromRatio(
+	OutputDistributionIndex		variant,
+	const ParticleDistribution *	ratio,
+	ParticleDistribution *		Pa)
+{
+	switch (variant)
+	{
+		case kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear500Pa:
+			calculateLinearConfigurationOutputParticles(
+				ratio,
+				kSensorCalibrationConstantSDP8x6Linear500Pa1,
+				kSensorCalibrationConstantSDP8x6Linear500Pa2,
+				Pa);
+			break;
+
+		case kOutputDistributionIndexCalibratedSensorOutputSDP8x6Linear125Pa:
+			calculateLinearConfigurationOutputParticles(
+				ratio,
+				kSensorCalibrationConstantSDP8x6Linear125Pa1,
+				kSensorCalibrationConstantSDP8x6Linear125Pa2,
+				Pa);
+			break;
+
+		case kOutputDistributionIndexCalibratedSensorOutputSDP8x6Sqrt500Pa:
+			calculateSquareRootConfigurationOutputParticles(
+				ratio,
+				kSensorCalibrationConstantSDP8x6Sqrt500Pa1,
+				kSensorCalibrationConstantSDP8x6Sqrt500Pa2,
+				kSensorCalibrationConstantSDP8x6Sqrt500Pa3,
+				kSensorCalibrationConstantSDP8x6Sqrt500Pa4,
+				Pa);
+			break;
+
+		default:
+			calculateSquareRootConfigurationOutputParticles(
+				ratio,
+				kSensorCalibrationConstantSDP8x6Sqrt125Pa1,
+				kSensorCalibrationConstantSDP8x6Sqrt125Pa2,
+				kSensorCalibrationConstantSDP8x6Sqrt125Pa3,
+				kSensorCalibrationConstantSDP8x6Sqrt125Pa4,
+				Pa);
+			break;
+	}
+
+	return;
+}
+
+void
+printParticleDistributionReport(
+	const ParticleDistribution *	outputDistributions,
+	double				seconds,
+	OutputDistributionIndex		outputSelectLowerBound,
+	OutputDistributionIndex		outputSelectUpperBound,
+	const char **			outputVariableDescriptions)
+{
+	const double	probabilities[kQuantileSketchNumberOfQuantiles] = kQuantileSketchProbabilities;
+
+	printf(
+		"Particle propagation (%zu particles per value, uniform inputs, %.3lf ms for all outputs; errors relative to the exact distribution):\n",
+		outputDistributions[outputSelectLowerBound].numberOfParticles,
+		seconds * 1e3);
+
+	for (OutputDistributionIndex variant = outputSelectLowerBound; variant < outputSelectUpperBound; variant++)
+	{
+		const ParticleDistribution *	distribution = &outputDistributions[variant];
+		Particle *			particles = getSortedParticles(distribution);
+		MeanAndVariance			meanAndVariance = getParticleDistributionMeanAndVariance(distribution);
+		AnalyticOutputDistribution	exact;
+
+		printf(
+			"\t%s: mean %.6lf Pa, standard deviation %.6lf Pa,",
+			outputVariableDescriptions[variant],
+			meanAndVariance.mean,
+			sqrt(meanAndVariance.variance));
+
+		for (size_t i = 0; i < kQuantileSketchNumberOfQuantiles; i++)
+		{
+			printf(
+				"%s p%g %.6lf Pa",
+				(i == 0) ? "" : ",",
+				probabilities[i] * 100.0,
+				getSortedParticlesQuantile(particles, distribution->numberOfParticles, probabilities[i]));
+		}
+
+		printf(", range [%.6lf, %.6lf] Pa\n", particles[0].value, particles[distribution->numberOfParticles - 1].value);
+
+		if (initializeAnalyticOutputDistribution(
+				&exact,
+				variant,
+				kDefaultInputDistributionAoutUniformDistLow,
+				kDefaultInputDistributionAoutUniformDistHigh,
+				kDefaultInputDistributionVddUniformDistLow,
+				kDefaultInputDistributionVddUniformDistHigh) == kCommonConstantReturnTypeSuccess)
+		{
+			MeanAndVariance	exactMeanAndVariance = getAnalyticOutputMeanAndVariance(&exact);
+
+			printf(
+				"\t\tmean error %.3e Pa, standard deviation error %.3e Pa, CDF error %.3e\n",
+				fabs(meanAndVariance.mean - exactMeanAndVariance.mean),
+				fabs(sqrt(meanAndVariance.variance) - sqrt(exactMeanAndVariance.variance)),
+				getMaximumCdfDifference(particles, distribution->numberOfParticles, &exact));
+		}
+
+		free(particles);
+	}
+
+	return;
+}
+
+CommonConstantReturnType
+runParticleDistributionSelfTest(void)
+{
+	ParticleDistribution		X;
+	ParticleDistribution		Y;
+	ParticleDistribution		ratio;
+	ParticleDistribution		difference;
+	ParticleDistribution		sum;
+	MeanAndVariance			sumMeanAndVariance;
+	double				maximumDifference = 0.0;
+	bool				passed;
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	printf("Particle distribution self-test (%d particles):\n", kParticleDistributionSelfTestNumberOfParticles);
+
+	/*
+	 *	X - X is zero for the particles of the same set, and X + Y of two
+	 *	independent uniforms in [0, 1] has mean 1 and variance 1/6.
+	 */
+	initializeUniformParticleDistribution(&X, 0.0, 1.0, kParticleDistributionSelfTestNumberOfParticles);
+	initializeUniformParticleDistribution(&Y, 0.0, 1.0, kParticleDistributionSelfTestNumberOfParticles);
+	combineParticleDistributions(kParticleOperationSubtract, &X, &X, kParticleDistributionSelfTestNumberOfParticles, &difference);
+	combineParticleDistributions(kParticleOperationAdd, &X, &Y, kParticleDistributionSelfTestNumberOfParticles, &sum);
+	sumMeanAndVariance = getParticleDistributionMeanAndVariance(&sum);
+
+	for (size_t i = 0; i < difference.numberOfParticles; i++)
+	{
+		maximumDifference = fmax(maximumDifference, fabs(difference.values[i]));
+	}
+
+	passed = (maximumDifference == 0.0) &&
+			(sum.numberOfParticles == kParticleDistributionSelfTestNumberOfParticles) &&
+			(fabs(sumMeanAndVariance.mean - 1.0) <= kParticleDistributionSelfTestMaximumRelativeError) &&
+			(fabs(sumMeanAndVariance.variance * 6.0 - 1.0) <= kParticleDistributionSelfTestMaximumRelativeError);
+	printf(
+		"\tX - X of the same particles: maximum %.3e; X + Y of independent U(0, 1): mean %.9lf, variance %.9lf: %s\n",
+		maximumDifference,
+		sumMeanAndVariance.mean,
+		sumMeanAndVariance.variance,
+		passed ? "PASS" : "FAIL");
+
+	if (!passed)
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	freeParticleDistribution(&difference);
+	freeParticleDistribution(&sum);
+	freeParticleDistribution(&X);
+	freeParticleDistribution(&Y);
+
+	initializeUniformParticleDistribution(&X, kDefaultInputDistributionAoutUniformDistLow, kDefaultInputDistributionAoutUniformDistHigh, kParticleDistributionSelfTestNumberOfParticles);
+	initializeUniformParticleDistribution(&Y, kDefaultInputDistributionVddUniformDistLow, kDefaultInputDistributionVddUniformDistHigh, kParticleDistributionSelfTestNumberOfParticles);
+	combineParticleDistributions(kParticleOperationDivide, &X, &Y, kParticleDistributionSelfTestNumberOfParticles, &ratio);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		AnalyticOutputDistribution	exact;
+		MeanAndVariance			exactMeanAndVariance;
+		MeanAndVariance			meanAndVariance;
+		ParticleDistribution		Pa;
+		Particle *			particles;
+		double				meanError;
+		double				standardDeviationError;
+		double				cdfError;
+
+		initializeAnalyticOutputDistribution(
+			&exact,
+			variant,
+			kDefaultInputDistributionAoutUniformDistLow,
+			kDefaultInputDistributionAoutUniformDistHigh,
+			kDefaultInputDistributionVddUniformDistLow,
+			kDefaultInputDistributionVddUniformDistHigh);
+		exactMeanAndVariance = getAnalyticOutputMeanAndVariance(&exact);
+
+		calculateCalibratedSensorOutputParticlesFromRatio(variant, &ratio, &Pa);
+		meanAndVariance = getParticleDistributionMeanAndVariance(&Pa);
+		particles = getSortedParticles(&Pa);
+		meanError = fabs(meanAndVariance.mean - exactMeanAndVariance.mean) / sqrt(exactMeanAndVariance.variance);
+		standardDeviationError = fabs(sqrt(meanAndVariance.variance / exactMeanAndVariance.variance) - 1.0);
+		cdfError = getMaximumCdfDifference(particles, Pa.numberOfParticles, &exact);
+
+		passed = (meanError <= kParticleDistributionSelfTestMaximumRelativeError) &&
+				(standardDeviationError <= kParticleDistributionSelfTestMaximumRelativeError) &&
+				(cdfError <= kParticleDistributionSelfTestMaximumCdfError);
+		printf(
+			"\tVariant %u: mean error %.3e standard deviations, relative standard deviation error %.3e, CDF error %.3e: %s\n",
+			variant,
+			meanError,
+			standardDeviationError,
+			cdfError,
+			passed ? "PASS" : "FAIL");
+
+		if (!passed)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+
+		free(particles);
+		freeParticleDistribution(&Pa);
+	}
+
+	freeParticleDistribution(&ratio);
+	freeParticleDistribution(&X);
+	freeParticleDistribution(&Y);
+
+	return result;
+}
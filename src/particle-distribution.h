@@ -0,0 +1,192 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "common.h"
+#include "utilities-config.h"
+
+/*
+ *	Distributional values of the particle mode, as mixtures of Dirac deltas:
+ *	`numberOfParticles` values with weights that sum to one. The values that
+ *	share a nonzero `particleSetIdentifier` are functions of the same particles,
+ *	index by index, so that operations between them are exact, like the sign and
+ *	the square of the ratio in the square root configurations. Operations between
+ *	values of different particle sets assume that they are independent, like the
+ *	Aout and Vdd inputs, and resample their pairs of particles to K particles.
+ *	Constants are single particles with the identifier zero.
+ */
+typedef struct
+{
+	size_t		numberOfParticles;
+	double *	values;
+	double *	weights;
+	uint64_t	particleSetIdentifier;
+} ParticleDistribution;
+
+/*
+ *	Binary operations on particle distributions.
+ */
+typedef enum
+{
+	kParticleOperationAdd		= 0,
+	kParticleOperationSubtract	= 1,
+	kParticleOperationMultiply	= 2,
+	kParticleOperationDivide	= 3,
+	kParticleOperationPower		= 4,
+	kParticleOperationMax,
+} ParticleOperation;
+
+/*
+ *	Functions of a single particle distribution.
+ */
+typedef enum
+{
+	kParticleFunctionFabs		= 0,
+	kParticleFunctionSign		= 1,
+	kParticleFunctionMax,
+} ParticleFunction;
+
+/**
+ *	@brief  Sets up a uniform distribution over [low, high] as `numberOfParticles` particles of
+ *		equal weight at its quantiles at the midpoints of intervals of equal probability,
+ *		with a new particle set identifier.
+ *
+ *	@param  distribution		: Pointer to the distribution to set up.
+ *	@param  low			: Lower bound.
+ *	@param  high			: Upper bound.
+ *	@param  numberOfParticles	: The number of particles.
+ */
+void	initializeUniformParticleDistribution(ParticleDistribution *  distribution, double low, double high, size_t numberOfParticles);
+
+/**
+ *	@brief  Sets up a constant as a single particle.
+ *
+ *	@param  distribution	: Pointer to the distribution to set up.
+ *	@param  value		: The constant.
+ */
+void	initializeConstantParticleDistribution(ParticleDistribution *  distribution, double value);
+
+/**
+ *	@brief  Frees the particles of a distribution.
+ *
+ *	@param  distribution	: Pointer to the distribution.
+ */
+void	freeParticleDistribution(ParticleDistribution *  distribution);
+
+/**
+ *	@brief  Applies a binary operation to two particle distributions. Operands of the same particle
+ *		set, or a single-particle operand, combine index by index and keep the particle set.
+ *		Otherwise, the operands are independent: their pairs of particles are combined with the
+ *		products of their weights and resampled to `numberOfParticles` particles of a new
+ *		particle set, one per interval of equal probability, at the mean of the interval.
+ *
+ *	@param  operation		: The operation.
+ *	@param  left			: Pointer to the left operand.
+ *	@param  right			: Pointer to the right operand.
+ *	@param  numberOfParticles	: The number of particles of the result of independent operands.
+ *	@param  result			: Pointer to the distribution where the function writes the result.
+ *					  Must not be one of the operands.
+ */
+void	combineParticleDistributions(
+		ParticleOperation		operation,
+		const ParticleDistribution *	left,
+		const ParticleDistribution *	right,
+		size_t				numberOfParticles,
+		ParticleDistribution *		result);
+
+/**
+ *	@brief  Applies a binary operation to a particle distribution and a constant right operand,
+ *		particle by particle, keeping the particle set.
+ *
+ *	@param  operation	: The operation.
+ *	@param  left		: Pointer to the left operand.
+ *	@param  right		: The constant right operand.
+ *	@param  result		: Pointer to the distribution where the function writes the result.
+ *				  Must not be the left operand.
+ */
+void	combineParticleDistributionWithConstant(
+		ParticleOperation		operation,
+		const ParticleDistribution *	left,
+		double				right,
+		ParticleDistribution *		result);
+
+/**
+ *	@brief  Applies a function to a particle distribution, particle by particle, keeping the particle set.
+ *
+ *	@param  function	: The function.
+ *	@param  argument	: Pointer to the argument.
+ *	@param  result		: Pointer to the distribution where the function writes the result.
+ *				  Must not be the argument.
+ */
+void	applyParticleFunction(ParticleFunction function, const ParticleDistribution *  argument, ParticleDistribution *  result);
+
+/**
+ *	@brief  Returns the mean and variance of a particle distribution.
+ *
+ *	@param  distribution		: Pointer to the distribution.
+ *	@return MeanAndVariance		: The mean and (population) variance.
+ */
+MeanAndVariance	getParticleDistributionMeanAndVariance(const ParticleDistribution *  distribution);
+
+/**
+ *	@brief  Calculates the distribution of the output of a variant from the particle distribution of
+ *		the ratio `Aout / Vdd`, with the formulas of `calibration-kernels.h` from the ratio, so that
+ *		the sign and the square of the square root configurations share its particles and the
+ *		output keeps its number of particles.
+ *
+ *	@param  variant	: The sensor variant / configuration.
+ *	@param  ratio	: Pointer to the distribution of the ratio `Aout / Vdd`.
+ *	@param  Pa	: Pointer to the distribution where the function writes the output.
+ */
+void	calculateCalibratedSensorOutputParticlesFromRatio(
+		OutputDistributionIndex		variant,
+		const ParticleDistribution *	ratio,
+		ParticleDistribution *		Pa);
+
+/**
+ *	@brief  Prints the mean, standard deviation, and quantiles of the output distributions of the
+ *		particle mode, and their errors relative to the exact distribution of the outputs for
+ *		the uniform inputs.
+ *
+ *	@param  outputDistributions		: The output distributions, indexed by `OutputDistributionIndex`.
+ *	@param  seconds				: The CPU time of the calculation of all outputs, in seconds.
+ *	@param  outputSelectLowerBound		: The first output to print.
+ *	@param  outputSelectUpperBound		: One past the last output to print.
+ *	@param  outputVariableDescriptions	: The names of the outputs.
+ */
+void	printParticleDistributionReport(
+		const ParticleDistribution *	outputDistributions,
+		double				seconds,
+		OutputDistributionIndex		outputSelectLowerBound,
+		OutputDistributionIndex		outputSelectUpperBound,
+		const char **			outputVariableDescriptions);
+
+/**
+ *	@brief  Checks the particle operations and the particle distributions of the outputs
+ *		against the exact distribution of the outputs.
+ *
+ *	@return		: `kCommonConstantReturnTypeSuccess` if all checks pass, else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runParticleDistributionSelfTest(void);
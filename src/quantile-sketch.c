@@ -0,0 +1,433 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "quantile-sketch.h"
+#include "calibration.h"
+#include "sampling-strategy.h"
+
+/**
+ *	@brief  Compares two centroids by their mean, for `qsort()`.
+ *
+ *	@param  a	: Pointer to the first centroid.
+ *	@param  b	: Pointer to the second centroid.
+ *	@return int	: Negative, zero, or positive, if the mean of the first centroid is less than, equal to, or greater than that of the second.
+ */
+static int
+compareCentroids(const void *  a, const void *  b)
+{
+	double	x = ((const QuantileSketchCentroid *) a)->mean;
+	double	y = ((const QuantileSketchCentroid *) b)->mean;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ *	@brief  Compares two doubles, for `qsort()`.
+ *
+ *	@param  a	: Pointer to the first double.
+ *	@param  b	: Pointer to the second double.
+ *	@return int	: Negative, zero, or positive, if the first double is less than, equal to, or greater than the second.
+ */
+static int
+compareDoubles(const void *  a, const void *  b)
+{
+	double	x = *(const double *) a;
+	double	y = *(const double *) b;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ *	@brief  The arcsine scale function of the t-digest, which maps a rank to the index of the
+ *		centroid that covers it. Each centroid spans at most one unit of it.
+ *
+ *	@param  q	: The normalized rank, in [0, 1].
+ *	@return double	: The scaled rank.
+ */
+static double
+scaleQuantileSketchRank(double q)
+{
+	/*
+	 *	asin(1) is pi / 2.
+	 */
+	return kQuantileSketchCompression / 4.0 * asin(2.0 * q - 1.0) / asin(1.0);
+}
+
+/**
+ *	@brief  Inverse of `scaleQuantileSketchRank()`.
+ *
+ *	@param  k	: The scaled rank, in [-compression / 4, compression / 4].
+ *	@return double	: The normalized rank.
+ */
+static double
+unscaleQuantileSketchRank(double k)
+{
+	return (sin(fmin(k * 4.0 / kQuantileSketchCompression, 1.0) * asin(1.0)) + 1.0) / 2.0;
+}
+
+/**
+ *	@brief  Merges the buffered samples of a sketch, and optionally the centroids of another sketch,
+ *		into its centroids: sorts all of them by their mean, and merges neighbours in one pass
+ *		for as long as the merged centroid spans at most one unit of the scale function.
+ *
+ *	@param  sketch			: Pointer to the sketch.
+ *	@param  extraCentroids		: Centroids to merge in, or `NULL`.
+ *	@param  numberOfExtraCentroids	: The number of centroids in `extraCentroids`.
+ */
+static void
+compressQuantileSketch(QuantileSketch *  sketch, const QuantileSketchCentroid *  extraCentroids, size_t numberOfExtraCentroids)
+{
+	QuantileSketchCentroid	centroids[2 * kQuantileSketchMaximumNumberOfCentroids + kQuantileSketchBufferSize];
+	size_t			numberOfCentroids = 0;
+	double			totalWeight = 0.0;
+	double			mergedWeight = 0.0;
+	double			weightLimit;
+	QuantileSketchCentroid	current;
+
+	memcpy(&centroids[numberOfCentroids], sketch->centroids, sketch->numberOfCentroids * sizeof(QuantileSketchCentroid));
+	numberOfCentroids += sketch->numberOfCentroids;
+
+	for (size_t i = 0; i < sketch->numberOfBufferedSamples; i++)
+	{
+		centroids[numberOfCentroids++] = (QuantileSketchCentroid){ .mean = sketch->bufferedSamples[i], .weight = 1.0 };
+	}
+
+	if (numberOfExtraCentroids > 0)
+	{
+		memcpy(&centroids[numberOfCentroids], extraCentroids, numberOfExtraCentroids * sizeof(QuantileSketchCentroid));
+		numberOfCentroids += numberOfExtraCentroids;
+	}
+
+	sketch->numberOfBufferedSamples = 0;
+	sketch->numberOfCentroids = 0;
+
+	if (numberOfCentroids == 0)
+	{
+		return;
+	}
+
+	qsort(centroids, numberOfCentroids, sizeof(QuantileSketchCentroid), compareCentroids);
+
+	for (size_t i = 0; i < numberOfCentroids; i++)
+	{
+		totalWeight += centroids[i].weight;
+	}
+
+	current = centroids[0];
+	weightLimit = totalWeight * unscaleQuantileSketchRank(scaleQuantileSketchRank(0.0) + 1.0);
+
+	for (size_t i = 1; i < numberOfCentroids; i++)
+	{
+		/*
+		 *	Each pair of neighbouring centroids spans more than one unit of
+		 *	the scale function, which bounds their number to about the
+		 *	compression. The last centroid absorbs any that would exceed it.
+		 */
+		if ((mergedWeight + current.weight + centroids[i].weight <= weightLimit) ||
+			(sketch->numberOfCentroids == kQuantileSketchMaximumNumberOfCentroids - 1))
+		{
+			current.weight += centroids[i].weight;
+			current.mean += (centroids[i].mean - current.mean) * centroids[i].weight / current.weight;
+		}
+		else
+		{
+			sketch->centroids[sketch->numberOfCentroids++] = current;
+			mergedWeight += current.weight;
+			weightLimit = totalWeight * unscaleQuantileSketchRank(scaleQuantileSketchRank(mergedWeight / totalWeight) + 1.0);
+			current = centroids[i];
+		}
+	}
+
+	sketch->centroids[sketch->numberOfCentroids++] = current;
+
+	return;
+}
+
+/*
+ *	Generates the function that adds a block of samples of a floating-point
+ *	type to a quantile sketch.
+ */
+#define DEFINE_ADD_SAMPLES_TO_QUANTILE_SKETCH(functionName, sampleType)					\
+	void												\
+	functionName(QuantileSketch *  sketch, const sampleType *  samples, size_t numberOfSamples)	\
+	{												\
+		for (size_t i = 0; i < numberOfSamples; i++)						\
+		{											\
+			double	sample = samples[i];							\
+														\
+			sketch->minimum = (sample < sketch->minimum) ? sample : sketch->minimum;	\
+			sketch->maximum = (sample > sketch->maximum) ? sample : sketch->maximum;	\
+			sketch->bufferedSamples[sketch->numberOfBufferedSamples++] = sample;		\
+														\
+			if (sketch->numberOfBufferedSamples == kQuantileSketchBufferSize)		\
+			{										\
+				compressQuantileSketch(sketch, NULL, 0);				\
+			}										\
+		}											\
+														\
+		sketch->numberOfSamples += numberOfSamples;						\
+														\
+		return;											\
+	}
+
+DEFINE_ADD_SAMPLES_TO_QUANTILE_SKETCH(addDoubleSamplesToQuantileSketch, double)
+DEFINE_ADD_SAMPLES_TO_QUANTILE_SKETCH(addFloatSamplesToQuantileSketch, float)
+
+
+void
+initializeQuantileSketch(QuantileSketch *  sketch)
+{
+	sketch->numberOfSamples = 0;
+	sketch->minimum = INFINITY;
+	sketch->maximum = -INFINITY;
+	sketch->numberOfCentroids = 0;
+	sketch->numberOfBufferedSamples = 0;
+
+	return;
+}
+
+void
+mergeQuantileSketch(QuantileSketch *  sketch, const QuantileSketch *  other)
+{
+	uint64_t	numberOfSamples = sketch->numberOfSamples + other->numberOfSamples;
+
+	if (other->numberOfSamples == 0)
+	{
+		return;
+	}
+
+	/*
+	 *	Add the buffered samples of the other sketch as samples, then merge
+	 *	in its centroids.
+	 */
+	addDoubleSamplesToQuantileSketch(sketch, other->bufferedSamples, other->numberOfBufferedSamples);
+	compressQuantileSketch(sketch, other->centroids, other->numberOfCentroids);
+	sketch->minimum = fmin(sketch->minimum, other->minimum);
+	sketch->maximum = fmax(sketch->maximum, other->maximum);
+	sketch->numberOfSamples = numberOfSamples;
+
+	return;
+}
+
+double
+getQuantileSketchQuantile(QuantileSketch *  sketch, double probability)
+{
+	const QuantileSketchCentroid *	centroids = sketch->centroids;
+	double				totalWeight = 0.0;
+	double				rank;
+	double				cumulativeWeight;
+	size_t				last;
+
+	if (sketch->numberOfSamples == 0)
+	{
+		return NAN;
+	}
+
+	if (sketch->numberOfBufferedSamples > 0)
+	{
+		compressQuantileSketch(sketch, NULL, 0);
+	}
+
+	for (size_t i = 0; i < sketch->numberOfCentroids; i++)
+	{
+		totalWeight += centroids[i].weight;
+	}
+
+	/*
+	 *	The weight of each centroid is centered on its mean. Below the
+	 *	center of the first centroid and above the center of the last one,
+	 *	interpolate towards the minimum and maximum.
+	 */
+	rank = probability * totalWeight;
+	last = sketch->numberOfCentroids - 1;
+
+	if (rank <= centroids[0].weight / 2.0)
+	{
+		return sketch->minimum + (centroids[0].mean - sketch->minimum) * rank / (centroids[0].weight / 2.0);
+	}
+
+	if (rank >= totalWeight - centroids[last].weight / 2.0)
+	{
+		return sketch->maximum - (sketch->maximum - centroids[last].mean) * (totalWeight - rank) / (centroids[last].weight / 2.0);
+	}
+
+	cumulativeWeight = centroids[0].weight / 2.0;
+
+	for (size_t i = 0; i < last; i++)
+	{
+		double	gap = (centroids[i].weight + centroids[i + 1].weight) / 2.0;
+
+		if (rank < cumulativeWeight + gap)
+		{
+			return centroids[i].mean + (centroids[i + 1].mean - centroids[i].mean) * (rank - cumulativeWeight) / gap;
+		}
+
+		cumulativeWeight += gap;
+	}
+
+	return centroids[last].mean;
+}
+
+void
+getQuantileSketchQuantiles(QuantileSketch *  sketch, double *  quantiles)
+{
+	const double	probabilities[kQuantileSketchNumberOfQuantiles] = kQuantileSketchProbabilities;
+
+	for (size_t i = 0; i < kQuantileSketchNumberOfQuantiles; i++)
+	{
+		quantiles[i] = getQuantileSketchQuantile(sketch, probabilities[i]);
+	}
+
+	return;
+}
+
+void
+printQuantileSketchQuantiles(FILE *  stream, QuantileSketch *  sketch, const char *  variableDescription)
+{
+	const double	probabilities[kQuantileSketchNumberOfQuantiles] = kQuantileSketchProbabilities;
+	double		quantiles[kQuantileSketchNumberOfQuantiles];
+
+	getQuantileSketchQuantiles(sketch, quantiles);
+	fprintf(stream, "\t%s:", variableDescription);
+
+	for (size_t i = 0; i < kQuantileSketchNumberOfQuantiles; i++)
+	{
+		fprintf(stream, "%s p%g %.6lf Pa", (i == 0) ? "" : ",", probabilities[i] * 100.0, quantiles[i]);
+	}
+
+	fprintf(stream, "\n");
+
+	return;
+}
+
+CommonConstantReturnType
+runQuantileSketchSelfTest(void)
+{
+	const size_t			numberOfSamples = kQuantileSketchSelfTestNumberOfSamples;
+	const size_t			numberOfSlices = 7;
+	const double			probabilities[kQuantileSketchNumberOfQuantiles] = kQuantileSketchProbabilities;
+	double *			Aout = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *			Vdd = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *			Pa = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	QuantileSketch *		sketches = (QuantileSketch *) checkedMalloc(numberOfSlices * sizeof(QuantileSketch), __FILE__, __LINE__);
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	printf("Quantile sketch self-test (%zu samples, merged from %zu sketches):\n", numberOfSamples, numberOfSlices);
+
+	drawInputPairsWithSamplingStrategy(
+		kSamplingStrategyIndependent,
+		kDefaultMonteCarloSeed,
+		numberOfSamples,
+		0,
+		kDefaultInputDistributionAoutUniformDistLow,
+		kDefaultInputDistributionAoutUniformDistHigh,
+		kDefaultInputDistributionVddUniformDistLow,
+		kDefaultInputDistributionVddUniformDistHigh,
+		Aout,
+		Vdd,
+		numberOfSamples);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		CalibrationFunction	calibrationFunction = getCalibrationFunction(variant);
+		double			maximumRankError = 0.0;
+		bool			passed;
+
+		for (size_t i = 0; i < numberOfSamples; i++)
+		{
+			Pa[i] = calibrationFunction(Aout[i], Vdd[i]);
+		}
+
+		/*
+		 *	Sketch slices of uneven lengths, and merge them in order.
+		 */
+		for (size_t slice = 0; slice < numberOfSlices; slice++)
+		{
+			size_t	sliceStart = numberOfSamples * slice * slice / (numberOfSlices * numberOfSlices);
+			size_t	sliceEnd = numberOfSamples * (slice + 1) * (slice + 1) / (numberOfSlices * numberOfSlices);
+
+			initializeQuantileSketch(&sketches[slice]);
+			addDoubleSamplesToQuantileSketch(&sketches[slice], &Pa[sliceStart], sliceEnd - sliceStart);
+
+			if (slice > 0)
+			{
+				mergeQuantileSketch(&sketches[0], &sketches[slice]);
+			}
+		}
+
+		qsort(Pa, numberOfSamples, sizeof(double), compareDoubles);
+
+		for (size_t i = 0; i < kQuantileSketchNumberOfQuantiles; i++)
+		{
+			double	estimate = getQuantileSketchQuantile(&sketches[0], probabilities[i]);
+			size_t	low = 0;
+			size_t	high = numberOfSamples;
+
+			/*
+			 *	The rank of the estimate is the number of samples at most
+			 *	equal to it.
+			 */
+			while (low < high)
+			{
+				size_t	middle = low + (high - low) / 2;
+
+				if (Pa[middle] <= estimate)
+				{
+					low = middle + 1;
+				}
+				else
+				{
+					high = middle;
+				}
+			}
+
+			maximumRankError = fmax(maximumRankError, fabs((double) low / numberOfSamples - probabilities[i]));
+		}
+
+		passed = (sketches[0].numberOfSamples == numberOfSamples) && (maximumRankError <= kQuantileSketchSelfTestMaximumRankError);
+		printf(
+			"\tVariant %u: %zu centroids, maximum rank error of the quantiles %.2e: %s\n",
+			variant,
+			sketches[0].numberOfCentroids,
+			maximumRankError,
+			passed ? "PASS" : "FAIL");
+
+		if (!passed)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+	}
+
+	free(Aout);
+	free(Vdd);
+	free(Pa);
+	free(sketches);
+
+	return result;
+}
@@ -0,0 +1,128 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "common.h"
+#include "utilities-config.h"
+
+/*
+ *	A centroid of a quantile sketch: the mean of the samples it summarizes,
+ *	and their number.
+ */
+typedef struct
+{
+	double	mean;
+	double	weight;
+} QuantileSketchCentroid;
+
+/*
+ *	Constant-memory, mergeable quantile sketch (merging t-digest) of a stream
+ *	of samples: centroids sorted by their mean, whose weight is bounded by the
+ *	arcsine scale function, and a buffer of samples not yet merged into them.
+ */
+typedef struct
+{
+	uint64_t		numberOfSamples;
+	double			minimum;
+	double			maximum;
+	size_t			numberOfCentroids;
+	size_t			numberOfBufferedSamples;
+	QuantileSketchCentroid	centroids[kQuantileSketchMaximumNumberOfCentroids];
+	double			bufferedSamples[kQuantileSketchBufferSize];
+} QuantileSketch;
+
+/**
+ *	@brief  Initializes a quantile sketch to summarize no samples.
+ *
+ *	@param  sketch	: Pointer to the sketch to initialize.
+ */
+void	initializeQuantileSketch(QuantileSketch *  sketch);
+
+/**
+ *	@brief  Adds a block of samples to a quantile sketch.
+ *
+ *	@param  sketch		: Pointer to the sketch to add the samples to.
+ *	@param  samples		: The samples.
+ *	@param  numberOfSamples	: The number of samples.
+ */
+void	addDoubleSamplesToQuantileSketch(QuantileSketch *  sketch, const double *  samples, size_t numberOfSamples);
+
+/**
+ *	@brief  Adds a block of single-precision samples to a quantile sketch.
+ *
+ *	@param  sketch		: Pointer to the sketch to add the samples to.
+ *	@param  samples		: The samples.
+ *	@param  numberOfSamples	: The number of samples.
+ */
+void	addFloatSamplesToQuantileSketch(QuantileSketch *  sketch, const float *  samples, size_t numberOfSamples);
+
+/**
+ *	@brief  Merges the samples summarized by another quantile sketch into a sketch.
+ *
+ *	@param  sketch	: Pointer to the sketch to merge into.
+ *	@param  other	: Pointer to the sketch to merge.
+ */
+void	mergeQuantileSketch(QuantileSketch *  sketch, const QuantileSketch *  other);
+
+/**
+ *	@brief  Estimates a quantile of the samples summarized by a quantile sketch, by interpolating
+ *		between the means of the centroids, and the minimum and maximum. Merges the buffered
+ *		samples into the centroids first.
+ *
+ *	@param  sketch		: Pointer to the sketch.
+ *	@param  probability	: The probability of the quantile, in [0, 1].
+ *	@return double		: The estimate of the quantile, or `NAN` if the sketch has no samples.
+ */
+double	getQuantileSketchQuantile(QuantileSketch *  sketch, double probability);
+
+/**
+ *	@brief  Estimates the quantiles of `kQuantileSketchProbabilities` of the samples summarized
+ *		by a quantile sketch.
+ *
+ *	@param  sketch		: Pointer to the sketch.
+ *	@param  quantiles	: Array of `kQuantileSketchNumberOfQuantiles` values, where the function writes the quantiles.
+ */
+void	getQuantileSketchQuantiles(QuantileSketch *  sketch, double *  quantiles);
+
+/**
+ *	@brief  Prints the quantiles of `kQuantileSketchProbabilities` of the samples summarized by a
+ *		quantile sketch, in a human-readable form.
+ *
+ *	@param  stream			: The stream to print to.
+ *	@param  sketch			: Pointer to the sketch.
+ *	@param  variableDescription	: A string describing the variable whose samples the sketch summarizes.
+ */
+void	printQuantileSketchQuantiles(FILE *  stream, QuantileSketch *  sketch, const char *  variableDescription);
+
+/**
+ *	@brief  Checks that the quantiles of a sketch, built from several sketches of slices of a stream
+ *		of calibrated outputs and merged, are within `kQuantileSketchSelfTestMaximumRankError`
+ *		in rank of the exact quantiles of the stream.
+ *
+ *	@return		: `kCommonConstantReturnTypeSuccess` if all checks pass,
+ *			   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runQuantileSketchSelfTest(void);
@@ -0,0 +1,651 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "quasi-monte-carlo.h"
+#include "calibration.h"
+#include "streaming-statistics.h"
+
+/**
+ *	@brief  Draws 32 random bits for the scrambling of a sequence.
+ *
+ *	@param  randomNumberGenerator	: Pointer to the generator to draw from.
+ *	@return uint32_t		: The drawn bits.
+ */
+static uint32_t
+drawScramblingBits(RandomNumberGenerator *  randomNumberGenerator)
+{
+	return (uint32_t)(drawUniformDouble(randomNumberGenerator) * 4294967296.0);
+}
+
+/**
+ *	@brief  Multiplies a 32-bit binary fraction by a lower-triangular matrix over GF(2), whose
+ *		row `j` gives the `j`-th most significant bit of the result.
+ *
+ *	@param  rows		: The `kSobolNumberOfBits` rows of the matrix, as bit masks.
+ *	@param  value		: The binary fraction to multiply.
+ *	@return uint32_t	: The product.
+ */
+static uint32_t
+multiplyByScramblingMatrix(const uint32_t *  rows, uint32_t value)
+{
+	uint32_t	result = 0;
+
+	for (int j = 0; j < kSobolNumberOfBits; j++)
+	{
+		result |= (uint32_t)(__builtin_parity(rows[j] & value)) << (kSobolNumberOfBits - 1 - j);
+	}
+
+	return result;
+}
+
+/**
+ *	@brief  Calculates the Sobol point of a Gray code index from the direction numbers.
+ *
+ *	@param  sequence	: Pointer to the sequence.
+ *	@param  grayCode	: The Gray code of the index of the point.
+ *	@param  point		: Array of `kQuasiMonteCarloNumberOfDimensions` values, where the function writes the
+ *				  point as 32-bit binary fractions, without the digital shift.
+ */
+static void
+calculateSobolPoint(const QuasiRandomSequence *  sequence, uint32_t grayCode, uint32_t *  point)
+{
+	for (int dimension = 0; dimension < kQuasiMonteCarloNumberOfDimensions; dimension++)
+	{
+		point[dimension] = 0;
+	}
+
+	for (int bit = 0; grayCode != 0; bit++, grayCode >>= 1)
+	{
+		if (grayCode & 1)
+		{
+			for (int dimension = 0; dimension < kQuasiMonteCarloNumberOfDimensions; dimension++)
+			{
+				point[dimension] ^= sequence->sobolDirectionNumbers[dimension][bit];
+			}
+		}
+	}
+
+	return;
+}
+
+/**
+ *	@brief  Calculates the radical inverse of an index, i.e., the digits of the index in the
+ *		given base, mirrored about the radix point.
+ *
+ *	@param  index	: The index.
+ *	@param  base	: The base.
+ *	@return double	: The radical inverse, in [0, 1).
+ */
+static inline double
+calculateRadicalInverse(uint64_t index, uint64_t base)
+{
+	double	inverseBase = 1.0 / (double)base;
+	double	digitWeight = inverseBase;
+	double	result = 0.0;
+
+	while (index != 0)
+	{
+		result += (double)(index % base) * digitWeight;
+		index /= base;
+		digitWeight *= inverseBase;
+	}
+
+	return result;
+}
+
+bool
+isQuasiRandomNumberGeneratorType(RandomNumberGeneratorType type)
+{
+	return (type == kRandomNumberGeneratorTypeSobol) ||
+		(type == kRandomNumberGeneratorTypeSobolScrambled) ||
+		(type == kRandomNumberGeneratorTypeHalton) ||
+		(type == kRandomNumberGeneratorTypeHaltonScrambled);
+}
+
+CommonConstantReturnType
+initializeQuasiRandomSequence(QuasiRandomSequence *  sequence, RandomNumberGeneratorType type, uint64_t seed)
+{
+	RandomNumberGenerator	randomNumberGenerator;
+	uint32_t		m = 1;
+
+	if (!isQuasiRandomNumberGeneratorType(type))
+	{
+		fprintf(stderr, "Error: %s is not a quasi-random sequence.\n", getRandomNumberGeneratorTypeName(type));
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	memset(sequence, 0, sizeof(*sequence));
+	sequence->type = type;
+
+	/*
+	 *	Direction numbers v_k = m_k / 2^k: in the first dimension, m_k = 1,
+	 *	and in the second dimension (primitive polynomial x + 1, m_1 = 1),
+	 *	m_k = 2 * m_(k-1) XOR m_(k-1).
+	 */
+	for (int bit = 0; bit < kSobolNumberOfBits; bit++)
+	{
+		if (bit > 0)
+		{
+			m = (m << 1) ^ m;
+		}
+
+		sequence->sobolDirectionNumbers[0][bit] = (uint32_t)1 << (kSobolNumberOfBits - 1 - bit);
+		sequence->sobolDirectionNumbers[1][bit] = m << (kSobolNumberOfBits - 1 - bit);
+	}
+
+	seedRandomNumberGenerator(&randomNumberGenerator, seed, 0);
+
+	if (type == kRandomNumberGeneratorTypeSobolScrambled)
+	{
+		/*
+		 *	The scrambling is linear over GF(2), so scrambling the direction
+		 *	numbers once scrambles all points.
+		 */
+		for (int dimension = 0; dimension < kQuasiMonteCarloNumberOfDimensions; dimension++)
+		{
+			uint32_t	rows[kSobolNumberOfBits];
+
+			for (int j = 0; j < kSobolNumberOfBits; j++)
+			{
+				uint32_t	diagonalBit = (uint32_t)1 << (kSobolNumberOfBits - 1 - j);
+
+				rows[j] = diagonalBit | (drawScramblingBits(&randomNumberGenerator) & ~(diagonalBit | (diagonalBit - 1)));
+			}
+
+			for (int bit = 0; bit < kSobolNumberOfBits; bit++)
+			{
+				sequence->sobolDirectionNumbers[dimension][bit] = multiplyByScramblingMatrix(rows, sequence->sobolDirectionNumbers[dimension][bit]);
+			}
+
+			sequence->sobolDigitalShift[dimension] = drawScramblingBits(&randomNumberGenerator);
+		}
+	}
+	else if (type == kRandomNumberGeneratorTypeHaltonScrambled)
+	{
+		for (int dimension = 0; dimension < kQuasiMonteCarloNumberOfDimensions; dimension++)
+		{
+			sequence->haltonShift[dimension] = drawUniformDouble(&randomNumberGenerator);
+		}
+	}
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+void
+drawQuasiRandomPairs(
+	const QuasiRandomSequence *	sequence,
+	uint64_t			firstIndex,
+	double				low0,
+	double				high0,
+	double				low1,
+	double				high1,
+	double *			values0,
+	double *			values1,
+	size_t				numberOfPoints)
+{
+	const double	fractionScale = 1.0 / (double)kSobolSequenceMaximumNumberOfPoints;
+	const double	range0 = high0 - low0;
+	const double	range1 = high1 - low1;
+
+	if ((sequence->type == kRandomNumberGeneratorTypeSobol) || (sequence->type == kRandomNumberGeneratorTypeSobolScrambled))
+	{
+		uint32_t	index = (uint32_t)firstIndex;
+		uint32_t	point[kQuasiMonteCarloNumberOfDimensions];
+
+		/*
+		 *	Calculate the first point from its Gray code, and each next
+		 *	point by flipping the direction number of the lowest set bit
+		 *	of its index. The sequence repeats after 2^32 points. Each
+		 *	point is placed at the center of its cell of width 2^-32, as
+		 *	the left edges would bias the estimates by about 2^-33.
+		 */
+		calculateSobolPoint(sequence, index ^ (index >> 1), point);
+
+		for (size_t i = 0; i < numberOfPoints; i++)
+		{
+			values0[i] = low0 + range0 * (((double)(point[0] ^ sequence->sobolDigitalShift[0]) + 0.5) * fractionScale);
+			values1[i] = low1 + range1 * (((double)(point[1] ^ sequence->sobolDigitalShift[1]) + 0.5) * fractionScale);
+
+			index++;
+
+			if (index == 0)
+			{
+				calculateSobolPoint(sequence, 0, point);
+			}
+			else
+			{
+				int	bit = __builtin_ctz(index);
+
+				point[0] ^= sequence->sobolDirectionNumbers[0][bit];
+				point[1] ^= sequence->sobolDirectionNumbers[1][bit];
+			}
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i < numberOfPoints; i++)
+		{
+			double	u0 = calculateRadicalInverse(firstIndex + i, 2) + sequence->haltonShift[0];
+			double	u1 = calculateRadicalInverse(firstIndex + i, 3) + sequence->haltonShift[1];
+
+			u0 = (u0 >= 1.0) ? (u0 - 1.0) : u0;
+			u1 = (u1 >= 1.0) ? (u1 - 1.0) : u1;
+			values0[i] = low0 + range0 * u0;
+			values1[i] = low1 + range1 * u1;
+		}
+	}
+
+	return;
+}
+
+/**
+ *	@brief  Checks that the first 2^m points of a Sobol sequence form a (0, m, 2)-net in base 2,
+ *		i.e., that each box [a / 2^i, (a + 1) / 2^i) x [b / 2^(m - i), (b + 1) / 2^(m - i))
+ *		contains exactly one point, for all i from 0 to m.
+ *
+ *	@param  sequence	: Pointer to the sequence to check.
+ *	@return bool		: `true` if the points form a net, else `false`.
+ */
+static bool
+isSobolSequenceNet(const QuasiRandomSequence *  sequence)
+{
+	const size_t	numberOfPoints = (size_t)1 << kSobolSelfTestLog2NumberOfPoints;
+	double *	values0 = (double *) checkedMalloc(numberOfPoints * sizeof(double), __FILE__, __LINE__);
+	double *	values1 = (double *) checkedMalloc(numberOfPoints * sizeof(double), __FILE__, __LINE__);
+	uint8_t *	boxCounts = (uint8_t *) checkedMalloc(numberOfPoints * sizeof(uint8_t), __FILE__, __LINE__);
+	bool		isNet = true;
+
+	drawQuasiRandomPairs(sequence, 0, 0.0, 1.0, 0.0, 1.0, values0, values1, numberOfPoints);
+
+	for (int log2NumberOfRows = 0; log2NumberOfRows <= kSobolSelfTestLog2NumberOfPoints; log2NumberOfRows++)
+	{
+		size_t	numberOfRows = (size_t)1 << log2NumberOfRows;
+		size_t	numberOfColumns = numberOfPoints / numberOfRows;
+
+		memset(boxCounts, 0, numberOfPoints * sizeof(uint8_t));
+
+		for (size_t i = 0; i < numberOfPoints; i++)
+		{
+			size_t	box = (size_t)(values0[i] * numberOfRows) * numberOfColumns + (size_t)(values1[i] * numberOfColumns);
+
+			boxCounts[box]++;
+		}
+
+		for (size_t box = 0; box < numberOfPoints; box++)
+		{
+			isNet = isNet && (boxCounts[box] == 1);
+		}
+	}
+
+	free(values0);
+	free(values1);
+	free(boxCounts);
+
+	return isNet;
+}
+
+CommonConstantReturnType
+runQuasiRandomSequenceSelfTest(void)
+{
+	/*
+	 *	The first points of the Sobol sequence in Gray code order, and of
+	 *	the Halton sequence.
+	 */
+	static const double			sobolPoints[][kQuasiMonteCarloNumberOfDimensions] =
+						{
+							{0.0, 0.0}, {0.5, 0.5}, {0.75, 0.25}, {0.25, 0.75},
+							{0.375, 0.375}, {0.875, 0.875}, {0.625, 0.125}, {0.125, 0.625},
+						};
+	static const double			haltonPoints[][kQuasiMonteCarloNumberOfDimensions] =
+						{
+							{0.0, 0.0}, {1.0 / 2, 1.0 / 3}, {1.0 / 4, 2.0 / 3}, {3.0 / 4, 1.0 / 9},
+							{1.0 / 8, 4.0 / 9}, {5.0 / 8, 7.0 / 9}, {3.0 / 8, 2.0 / 9}, {7.0 / 8, 5.0 / 9},
+						};
+	static const RandomNumberGeneratorType	sequenceTypes[] =
+						{
+							kRandomNumberGeneratorTypeSobol,
+							kRandomNumberGeneratorTypeSobolScrambled,
+							kRandomNumberGeneratorTypeHalton,
+							kRandomNumberGeneratorTypeHaltonScrambled,
+						};
+	const size_t				numberOfKnownPoints = sizeof(sobolPoints) / sizeof(sobolPoints[0]);
+	const double				knownPointTolerance = 1.0 / (double)kSobolSequenceMaximumNumberOfPoints;
+	CommonConstantReturnType		result = kCommonConstantReturnTypeSuccess;
+
+	printf("Quasi-random sequence self-test:\n");
+
+	for (size_t sequenceType = 0; sequenceType < sizeof(sequenceTypes) / sizeof(sequenceTypes[0]); sequenceType++)
+	{
+		/*
+		 *	Start just below the end of the Sobol sequence, to also cover
+		 *	its wrap-around.
+		 */
+		size_t				numberOfPoints = kMonteCarloSampleBlockSize + 5;
+		uint64_t			firstIndex = kSobolSequenceMaximumNumberOfPoints - 13;
+		double *			values0 = (double *) checkedMalloc(numberOfPoints * sizeof(double), __FILE__, __LINE__);
+		double *			values1 = (double *) checkedMalloc(numberOfPoints * sizeof(double), __FILE__, __LINE__);
+		RandomNumberGeneratorType	type = sequenceTypes[sequenceType];
+		QuasiRandomSequence		sequence;
+		bool				passed = true;
+
+		initializeQuasiRandomSequence(&sequence, type, kDefaultMonteCarloSeed);
+
+		if ((type == kRandomNumberGeneratorTypeSobol) || (type == kRandomNumberGeneratorTypeHalton))
+		{
+			const double (*knownPoints)[kQuasiMonteCarloNumberOfDimensions] = (type == kRandomNumberGeneratorTypeSobol) ? sobolPoints : haltonPoints;
+
+			drawQuasiRandomPairs(&sequence, 0, 0.0, 1.0, 0.0, 1.0, values0, values1, numberOfKnownPoints);
+
+			for (size_t i = 0; i < numberOfKnownPoints; i++)
+			{
+				passed = passed && (fabs(values0[i] - knownPoints[i][0]) <= knownPointTolerance) && (fabs(values1[i] - knownPoints[i][1]) <= knownPointTolerance);
+			}
+
+			printf("\t%-18s: known points: %s\n", getRandomNumberGeneratorTypeName(type), passed ? "PASS" : "FAIL");
+
+			if (!passed)
+			{
+				result = kCommonConstantReturnTypeError;
+			}
+		}
+
+		drawQuasiRandomPairs(&sequence, firstIndex, 0.0, 1.0, 0.0, 1.0, values0, values1, numberOfPoints);
+
+		passed = true;
+
+		for (size_t i = 0; i < numberOfPoints; i++)
+		{
+			double	value0;
+			double	value1;
+
+			drawQuasiRandomPairs(&sequence, firstIndex + i, 0.0, 1.0, 0.0, 1.0, &value0, &value1, 1);
+			passed = passed && (value0 == values0[i]) && (value1 == values1[i]) &&
+					(values0[i] >= 0.0) && (values0[i] < 1.0) && (values1[i] >= 0.0) && (values1[i] < 1.0);
+		}
+
+		printf("\t%-18s: ranges of points identical to single points: %s\n", getRandomNumberGeneratorTypeName(type), passed ? "PASS" : "FAIL");
+
+		if (!passed)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+
+		if ((type == kRandomNumberGeneratorTypeSobol) || (type == kRandomNumberGeneratorTypeSobolScrambled))
+		{
+			passed = isSobolSequenceNet(&sequence);
+			printf("\t%-18s: first 2^%d points form a (0, %d, 2)-net: %s\n",
+				getRandomNumberGeneratorTypeName(type),
+				kSobolSelfTestLog2NumberOfPoints,
+				kSobolSelfTestLog2NumberOfPoints,
+				passed ? "PASS" : "FAIL");
+
+			if (!passed)
+			{
+				result = kCommonConstantReturnTypeError;
+			}
+		}
+
+		free(values0);
+		free(values1);
+	}
+
+	return result;
+}
+
+/**
+ *	@brief  Estimates the mean and variance of all outputs from input samples drawn with Philox
+ *		or a quasi-random sequence.
+ *
+ *	@param  type			: `kRandomNumberGeneratorTypePhilox` or a scrambled quasi-random sequence.
+ *	@param  seed			: The seed of the generator or of the scrambling.
+ *	@param  numberOfSamples		: The number of input samples.
+ *	@param  estimates		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` estimates, indexed by
+ *					  `OutputDistributionIndex`, where the function writes the estimates.
+ */
+static void
+estimateOutputMeanAndVariance(RandomNumberGeneratorType type, uint64_t seed, size_t numberOfSamples, MeanAndVariance *  estimates)
+{
+	double			AoutSamples[kMonteCarloSampleBlockSize];
+	double			VddSamples[kMonteCarloSampleBlockSize];
+	double			outputSamples[kOutputDistributionIndexCalibratedSensorOutputMax][kMonteCarloSampleBlockSize];
+	double *		blockOutputSamples[kOutputDistributionIndexCalibratedSensorOutputMax];
+	StreamingStatistics	statistics[kOutputDistributionIndexCalibratedSensorOutputMax];
+	QuasiRandomSequence	sequence;
+
+	if (isQuasiRandomNumberGeneratorType(type))
+	{
+		initializeQuasiRandomSequence(&sequence, type, seed);
+	}
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		blockOutputSamples[variant] = outputSamples[variant];
+		initializeStreamingStatistics(&statistics[variant]);
+	}
+
+	for (size_t blockStart = 0; blockStart < numberOfSamples; blockStart += kMonteCarloSampleBlockSize)
+	{
+		size_t	blockSize = numberOfSamples - blockStart;
+
+		if (blockSize > kMonteCarloSampleBlockSize)
+		{
+			blockSize = kMonteCarloSampleBlockSize;
+		}
+
+		if (type == kRandomNumberGeneratorTypePhilox)
+		{
+			drawUniformDoublePairsPhilox(
+				seed,
+				blockStart,
+				kDefaultInputDistributionAoutUniformDistLow,
+				kDefaultInputDistributionAoutUniformDistHigh,
+				kDefaultInputDistributionVddUniformDistLow,
+				kDefaultInputDistributionVddUniformDistHigh,
+				AoutSamples,
+				VddSamples,
+				blockSize);
+		}
+		else
+		{
+			drawQuasiRandomPairs(
+				&sequence,
+				blockStart,
+				kDefaultInputDistributionAoutUniformDistLow,
+				kDefaultInputDistributionAoutUniformDistHigh,
+				kDefaultInputDistributionVddUniformDistLow,
+				kDefaultInputDistributionVddUniformDistHigh,
+				AoutSamples,
+				VddSamples,
+				blockSize);
+		}
+
+		calculateCalibratedSensorOutputBatchAllVariants(AoutSamples, VddSamples, blockOutputSamples, blockSize);
+
+		for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+		{
+			addDoubleSamplesToStreamingStatistics(&statistics[variant], outputSamples[variant], blockSize);
+		}
+	}
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		estimates[variant] = getStreamingStatisticsMeanAndVariance(&statistics[variant]);
+	}
+
+	return;
+}
+
+/**
+ *	@brief  Prints the errors of the methods of the convergence report for one number of samples,
+ *		followed, for all but the first (plain Monte Carlo) method, by how many times more
+ *		samples plain Monte Carlo needs for the same error. Errors below the rounding floor
+ *		are printed as "<" and the floor, with the ratio of an error at the floor as a lower
+ *		bound (">"), or no ratio ("-") if the plain Monte Carlo error is below the floor too.
+ *
+ *	@param  methods		: The sources of input samples of the methods.
+ *	@param  numberOfMethods	: The number of methods.
+ *	@param  errors		: Array of `numberOfMethods` errors, one per method.
+ *	@param  roundingFloor	: The rounding error of the estimates, below which errors are noise.
+ */
+static void
+printConvergenceErrors(const RandomNumberGeneratorType *  methods, size_t numberOfMethods, const double *  errors, double roundingFloor)
+{
+	for (size_t method = 0; method < numberOfMethods; method++)
+	{
+		if (errors[method] > roundingFloor)
+		{
+			printf(" %s %.3e", getRandomNumberGeneratorTypeName(methods[method]), errors[method]);
+		}
+		else
+		{
+			printf(" %s <%.3e", getRandomNumberGeneratorTypeName(methods[method]), roundingFloor);
+		}
+
+		if (method > 0)
+		{
+			if (errors[0] <= roundingFloor)
+			{
+				printf(" (-)");
+			}
+			else if (errors[method] <= roundingFloor)
+			{
+				printf(" (>%.3gx)", (errors[0] * errors[0]) / (roundingFloor * roundingFloor));
+			}
+			else
+			{
+				printf(" (%.3gx)", (errors[0] * errors[0]) / (errors[method] * errors[method]));
+			}
+		}
+	}
+
+	return;
+}
+
+void
+runQuasiMonteCarloConvergenceReport(const char **  outputVariableDescriptions)
+{
+	/*
+	 *	Plain Monte Carlo first, as the baseline of the sample ratios.
+	 */
+	static const RandomNumberGeneratorType	methods[] =
+						{
+							kRandomNumberGeneratorTypePhilox,
+							kRandomNumberGeneratorTypeSobolScrambled,
+							kRandomNumberGeneratorTypeHaltonScrambled,
+						};
+	enum
+	{
+		kNumberOfMethods	= sizeof(methods) / sizeof(methods[0]),
+		kNumberOfSampleSizes	= (kQuasiMonteCarloConvergenceMaximumLog2NumberOfSamples - kQuasiMonteCarloConvergenceMinimumLog2NumberOfSamples) /
+						kQuasiMonteCarloConvergenceLog2NumberOfSamplesStep + 1,
+	};
+	double					meanErrors[kOutputDistributionIndexCalibratedSensorOutputMax][kNumberOfSampleSizes][kNumberOfMethods];
+	double					varianceErrors[kOutputDistributionIndexCalibratedSensorOutputMax][kNumberOfSampleSizes][kNumberOfMethods];
+	double					meanFloors[kOutputDistributionIndexCalibratedSensorOutputMax][kNumberOfSampleSizes];
+	double					varianceFloors[kOutputDistributionIndexCalibratedSensorOutputMax][kNumberOfSampleSizes];
+
+	for (int sampleSize = 0; sampleSize < kNumberOfSampleSizes; sampleSize++)
+	{
+		size_t	numberOfSamples = (size_t)1 << (kQuasiMonteCarloConvergenceMinimumLog2NumberOfSamples + sampleSize * kQuasiMonteCarloConvergenceLog2NumberOfSamplesStep);
+
+		for (int method = 0; method < kNumberOfMethods; method++)
+		{
+			StreamingStatistics	meanEstimates[kOutputDistributionIndexCalibratedSensorOutputMax];
+			StreamingStatistics	varianceEstimates[kOutputDistributionIndexCalibratedSensorOutputMax];
+
+			for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+			{
+				initializeStreamingStatistics(&meanEstimates[variant]);
+				initializeStreamingStatistics(&varianceEstimates[variant]);
+			}
+
+			/*
+			 *	The spread of the estimates of independent replicates is
+			 *	the error of a single estimate, since all methods are unbiased.
+			 */
+			for (uint64_t replicate = 0; replicate < kQuasiMonteCarloConvergenceNumberOfReplicates; replicate++)
+			{
+				MeanAndVariance	estimates[kOutputDistributionIndexCalibratedSensorOutputMax];
+
+				estimateOutputMeanAndVariance(methods[method], kDefaultMonteCarloSeed + replicate, numberOfSamples, estimates);
+
+				for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+				{
+					addDoubleSamplesToStreamingStatistics(&meanEstimates[variant], &estimates[variant].mean, 1);
+					addDoubleSamplesToStreamingStatistics(&varianceEstimates[variant], &estimates[variant].variance, 1);
+				}
+			}
+
+			for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+			{
+				meanErrors[variant][sampleSize][method] = sqrt(getStreamingStatisticsMeanAndVariance(&meanEstimates[variant]).variance);
+				varianceErrors[variant][sampleSize][method] = sqrt(getStreamingStatisticsMeanAndVariance(&varianceEstimates[variant]).variance);
+			}
+
+			/*
+			 *	The estimates sum blocks of kMonteCarloSampleBlockSize samples,
+			 *	so their rounding error is up to about kMonteCarloSampleBlockSize
+			 *	units in the last place of the estimate. Errors below that floor
+			 *	are rounding noise, and their sample ratios meaningless.
+			 */
+			if (method == 0)
+			{
+				for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+				{
+					meanFloors[variant][sampleSize] = kMonteCarloSampleBlockSize * DBL_EPSILON * fabs(meanEstimates[variant].mean);
+					varianceFloors[variant][sampleSize] = kMonteCarloSampleBlockSize * DBL_EPSILON * fabs(varianceEstimates[variant].mean);
+				}
+			}
+		}
+	}
+
+	printf(
+		"Quasi-Monte Carlo convergence (error: standard deviation of the estimates over %d seeds; in parentheses: times more samples plain Monte Carlo needs for the same error; <: below the rounding floor):\n",
+		kQuasiMonteCarloConvergenceNumberOfReplicates);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		printf("\t%s:\n", outputVariableDescriptions[variant]);
+
+		for (int sampleSize = 0; sampleSize < kNumberOfSampleSizes; sampleSize++)
+		{
+			size_t	numberOfSamples = (size_t)1 << (kQuasiMonteCarloConvergenceMinimumLog2NumberOfSamples + sampleSize * kQuasiMonteCarloConvergenceLog2NumberOfSamplesStep);
+
+			printf("\t\t%7zu samples: mean error", numberOfSamples);
+			printConvergenceErrors(methods, kNumberOfMethods, meanErrors[variant][sampleSize], meanFloors[variant][sampleSize]);
+			printf("; variance error");
+			printConvergenceErrors(methods, kNumberOfMethods, varianceErrors[variant][sampleSize], varianceFloors[variant][sampleSize]);
+			printf("\n");
+		}
+	}
+
+	return;
+}
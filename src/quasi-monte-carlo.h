@@ -0,0 +1,124 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "common.h"
+#include "utilities-config.h"
+#include "random-number-generator.h"
+
+/*
+ *	Two-dimensional low-discrepancy sequence for the quasi-Monte Carlo (QMC)
+ *	mode, which replaces the pseudo-random (Aout, Vdd) input pairs:
+ *		Sobol	: The first two dimensions of the Sobol sequence (van der Corput in base 2, and
+ *			  the primitive polynomial x + 1), with 32-bit direction numbers, enumerated in
+ *			  Gray code order (Antonov and Saleev). Each aligned block of 2^m points is a
+ *			  (0, m, 2)-net in base 2, i.e., the same set of points as in natural order.
+ *			  The scrambled sequence applies a random lower-triangular linear scrambling and
+ *			  a random digital shift (Matousek), which keep the net property.
+ *		Halton	: Radical inverses of the index in bases 2 and 3. The scrambled sequence applies
+ *			  a random shift modulo 1 (Cranley and Patterson).
+ *
+ *	The point of index `i` only depends on `i` (and on the seed of the scrambling),
+ *	so, like with Philox, any range of points can be drawn independently of all others.
+ *	The randomizations make each point uniformly distributed, so that independent
+ *	scramblings give independent unbiased estimates, whose spread estimates the error.
+ */
+typedef struct
+{
+	RandomNumberGeneratorType	type;
+	uint32_t			sobolDirectionNumbers[kQuasiMonteCarloNumberOfDimensions][kSobolNumberOfBits];
+	uint32_t			sobolDigitalShift[kQuasiMonteCarloNumberOfDimensions];
+	double				haltonShift[kQuasiMonteCarloNumberOfDimensions];
+} QuasiRandomSequence;
+
+/**
+ *	@brief  Returns whether a source of input samples is a quasi-random (low-discrepancy) sequence.
+ *
+ *	@param  type	: The source of input samples.
+ *	@return bool	: `true` for the Sobol and Halton sequences, else `false`.
+ */
+bool	isQuasiRandomNumberGeneratorType(RandomNumberGeneratorType type);
+
+/**
+ *	@brief  Initializes a quasi-random sequence, and draws its scrambling from the seed if the
+ *		sequence is scrambled.
+ *
+ *	@param  sequence	: Pointer to the sequence to initialize.
+ *	@param  type		: One of the Sobol or Halton sources of input samples.
+ *	@param  seed		: The seed of the scrambling. Ignored for unscrambled sequences.
+ *	@return			: `kCommonConstantReturnTypeSuccess` if `type` is a quasi-random sequence,
+ *				   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	initializeQuasiRandomSequence(QuasiRandomSequence *  sequence, RandomNumberGeneratorType type, uint64_t seed);
+
+/**
+ *	@brief  Draws a range of points of a quasi-random sequence, scaled to [low0, high0) x [low1, high1).
+ *		The Sobol sequence has `kSobolSequenceMaximumNumberOfPoints` points.
+ *
+ *	@param  sequence	: Pointer to the sequence to draw from.
+ *	@param  firstIndex	: The index of the first point to draw.
+ *	@param  low0		: The lower bound of the range of the first coordinates.
+ *	@param  high0		: The upper bound of the range of the first coordinates.
+ *	@param  low1		: The lower bound of the range of the second coordinates.
+ *	@param  high1		: The upper bound of the range of the second coordinates.
+ *	@param  values0		: Array of `numberOfPoints` values, where the function writes the first coordinates.
+ *	@param  values1		: Array of `numberOfPoints` values, where the function writes the second coordinates.
+ *	@param  numberOfPoints	: The number of points to draw.
+ */
+void	drawQuasiRandomPairs(
+		const QuasiRandomSequence *	sequence,
+		uint64_t			firstIndex,
+		double				low0,
+		double				high0,
+		double				low1,
+		double				high1,
+		double *			values0,
+		double *			values1,
+		size_t				numberOfPoints);
+
+/**
+ *	@brief  Checks the Sobol and Halton sequences against known points, checks that drawing a range
+ *		of points at once gives the same points as drawing them one by one, and checks the
+ *		net property of the scrambled Sobol sequence.
+ *
+ *	@return		: `kCommonConstantReturnTypeSuccess` if all checks pass,
+ *			   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runQuasiRandomSequenceSelfTest(void);
+
+/**
+ *	@brief  Prints, for each output, the error of the estimates of the mean and of the variance of
+ *		plain Monte Carlo (Philox) and of the scrambled Sobol and Halton sequences, for increasing
+ *		numbers of samples. The error of each method is the standard deviation of its estimates
+ *		over `kQuasiMonteCarloConvergenceNumberOfReplicates` independent seeds. For each
+ *		sequence, the report also prints how many times more samples plain Monte Carlo needs
+ *		for the same error, `(errorMonteCarlo / errorSequence)^2`, since the error of plain
+ *		Monte Carlo decreases with the square root of the number of samples.
+ *
+ *	@param  outputVariableDescriptions	: The descriptions of the outputs, indexed by `OutputDistributionIndex`.
+ */
+void	runQuasiMonteCarloConvergenceReport(const char **  outputVariableDescriptions);
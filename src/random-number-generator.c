@@ -0,0 +1,669 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <uxhw.h>
+#include "random-number-generator.h"
+#include "utilities-config.h"
+
+/*
+ *	The AVX2 implementation of the Philox generator is only built for x86
+ *	targets with a GCC-compatible compiler, via the `target` function
+ *	attribute, as for the vectorized calibration kernels.
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define kRandomNumberGeneratorIsX86	1
+#include <immintrin.h>
+#else
+#define kRandomNumberGeneratorIsX86	0
+#endif
+
+/*
+ *	Philox4x32-10 constants (Salmon et al., "Parallel Random Numbers: As Easy
+ *	as 1, 2, 3", SC 2011): round multipliers and key increments (Weyl sequence).
+ */
+#define kPhiloxMultiplier0	(0xD2511F53U)
+#define kPhiloxMultiplier1	(0xCD9E8D57U)
+#define kPhiloxKeyIncrement0	(0x9E3779B9U)
+#define kPhiloxKeyIncrement1	(0xBB67AE85U)
+#define kPhiloxNumberOfRounds	(10)
+
+/*
+ *	Number of independent groups of 8 counters per iteration of the AVX2 implementation.
+ */
+#define kPhiloxAVX2NumberOfGroups	(2)
+
+/**
+ *	@brief  Rotates a 64-bit value left.
+ *
+ *	@param  value		: The value to rotate.
+ *	@param  bits		: The number of bits to rotate by, in (0, 64).
+ *	@return uint64_t	: The rotated value.
+ */
+static inline uint64_t
+rotateLeft(uint64_t value, int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+/**
+ *	@brief  SplitMix64 step, used to expand the seed into the state of the generator.
+ *
+ *	@param  state		: Pointer to the SplitMix64 state, which the function advances.
+ *	@return uint64_t	: The next output of SplitMix64.
+ */
+static uint64_t
+drawSplitMix64(uint64_t *  state)
+{
+	uint64_t	z = (*state += 0x9E3779B97F4A7C15ULL);
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+	return z ^ (z >> 31);
+}
+
+/**
+ *	@brief  Draws the next 64 random bits (xoshiro256**).
+ *
+ *	@param  randomNumberGenerator	: Pointer to the generator to draw from.
+ *	@return uint64_t		: The drawn bits.
+ */
+static inline uint64_t
+drawUint64(RandomNumberGenerator *  randomNumberGenerator)
+{
+	uint64_t *	s = randomNumberGenerator->state;
+	uint64_t	result = rotateLeft(s[1] * 5, 7) * 9;
+	uint64_t	t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotateLeft(s[3], 45);
+
+	return result;
+}
+
+void
+seedRandomNumberGenerator(RandomNumberGenerator *  randomNumberGenerator, uint64_t seed, uint64_t streamIndex)
+{
+	uint64_t	streamState = streamIndex;
+	uint64_t	splitMix64State;
+
+	/*
+	 *	The SplitMix64 output is a bijection of its state, so the streams of
+	 *	a seed start from distinct SplitMix64 states, in constant time for
+	 *	any stream index.
+	 */
+	splitMix64State = seed ^ drawSplitMix64(&streamState);
+
+	for (int i = 0; i < 4; i++)
+	{
+		randomNumberGenerator->state[i] = drawSplitMix64(&splitMix64State);
+	}
+
+	return;
+}
+
+double
+drawUniformDouble(RandomNumberGenerator *  randomNumberGenerator)
+{
+	return (double)(drawUint64(randomNumberGenerator) >> 11) * 0x1.0p-53;
+}
+
+double
+drawUniformDoubleInRange(RandomNumberGenerator *  randomNumberGenerator, double low, double high)
+{
+	return low + (high - low) * drawUniformDouble(randomNumberGenerator);
+}
+
+/**
+ *	@brief  Calculates the Philox4x32-10 output block of a counter.
+ *
+ *	@param  counter	: The 128-bit counter, as four 32-bit words.
+ *	@param  key	: The 64-bit key, as two 32-bit words.
+ *	@param  output	: Array of four 32-bit words, where the function writes the output block.
+ */
+static void
+calculatePhilox4x32(const uint32_t *  counter, const uint32_t *  key, uint32_t *  output)
+{
+	uint32_t	c0 = counter[0];
+	uint32_t	c1 = counter[1];
+	uint32_t	c2 = counter[2];
+	uint32_t	c3 = counter[3];
+	uint32_t	k0 = key[0];
+	uint32_t	k1 = key[1];
+
+	for (int round = 0; round < kPhiloxNumberOfRounds; round++)
+	{
+		uint64_t	product0 = (uint64_t)kPhiloxMultiplier0 * c0;
+		uint64_t	product1 = (uint64_t)kPhiloxMultiplier1 * c2;
+
+		c0 = (uint32_t)(product1 >> 32) ^ c1 ^ k0;
+		c1 = (uint32_t)product1;
+		c2 = (uint32_t)(product0 >> 32) ^ c3 ^ k1;
+		c3 = (uint32_t)product0;
+
+		k0 += kPhiloxKeyIncrement0;
+		k1 += kPhiloxKeyIncrement1;
+	}
+
+	output[0] = c0;
+	output[1] = c1;
+	output[2] = c2;
+	output[3] = c3;
+
+	return;
+}
+
+/**
+ *	@brief  Converts 64 random bits to a uniformly distributed double in [0, 1), by placing the
+ *		upper 52 bits in the mantissa of a double in [1, 2) and subtracting 1. Unlike a
+ *		conversion from an integer, this maps directly to SIMD instructions.
+ *
+ *	@param  low	: The lower 32 random bits.
+ *	@param  high	: The upper 32 random bits.
+ *	@return double	: The uniformly distributed double.
+ */
+static inline double
+convertBitsToUniformDouble(uint32_t low, uint32_t high)
+{
+	uint64_t	bits = (((((uint64_t)high) << 32) | low) >> 12) | 0x3FF0000000000000ULL;
+	double		value;
+
+	memcpy(&value, &bits, sizeof(value));
+
+	return value - 1.0;
+}
+
+/**
+ *	@brief  Portable implementation of `drawUniformDoublePairsPhilox()`.
+ */
+static void
+drawUniformDoublePairsPhiloxScalar(
+	uint64_t	seed,
+	uint64_t	firstIndex,
+	double		low0,
+	double		high0,
+	double		low1,
+	double		high1,
+	double *	values0,
+	double *	values1,
+	size_t		numberOfPairs)
+{
+	uint32_t	key[2] = {(uint32_t)seed, (uint32_t)(seed >> 32)};
+
+	for (size_t i = 0; i < numberOfPairs; i++)
+	{
+		uint64_t	index = firstIndex + i;
+		uint32_t	counter[4] = {(uint32_t)index, (uint32_t)(index >> 32), 0, 0};
+		uint32_t	output[4];
+
+		calculatePhilox4x32(counter, key, output);
+		values0[i] = low0 + (high0 - low0) * convertBitsToUniformDouble(output[0], output[1]);
+		values1[i] = low1 + (high1 - low1) * convertBitsToUniformDouble(output[2], output[3]);
+	}
+
+	return;
+}
+
+#if kRandomNumberGeneratorIsX86
+
+/**
+ *	@brief  Multiplies each 32-bit lane of a vector by a constant, into the upper and lower
+ *		32 bits of the 64-bit products.
+ *
+ *	@param  vValue		: The 32-bit lanes to multiply.
+ *	@param  vMultiplier	: The multiplier, in all lanes.
+ *	@param  vHigh		: Pointer to where the function writes the upper 32 bits of the products.
+ *	@param  vLow		: Pointer to where the function writes the lower 32 bits of the products.
+ */
+__attribute__((target("avx2")))
+static inline void
+multiplyHighLowAVX2(__m256i vValue, __m256i vMultiplier, __m256i *  vHigh, __m256i *  vLow)
+{
+	__m256i	vEvenProducts = _mm256_mul_epu32(vValue, vMultiplier);
+	__m256i	vOddProducts = _mm256_mul_epu32(_mm256_srli_epi64(vValue, 32), vMultiplier);
+
+	*vLow = _mm256_blend_epi32(vEvenProducts, _mm256_slli_epi64(vOddProducts, 32), 0xAA);
+	*vHigh = _mm256_blend_epi32(_mm256_srli_epi64(vEvenProducts, 32), vOddProducts, 0xAA);
+
+	return;
+}
+
+/**
+ *	@brief  Converts the 64-bit lanes of random bits of a vector to uniformly distributed doubles
+ *		in [low, high), as `convertBitsToUniformDouble()`.
+ *
+ *	@param  vBits		: The random bits.
+ *	@param  vLow		: The lower bound of the range, in all lanes.
+ *	@param  vRange		: The width of the range, in all lanes.
+ *	@return __m256d		: The uniformly distributed doubles.
+ */
+__attribute__((target("avx2")))
+static inline __m256d
+convertBitsToUniformDoubleAVX2(__m256i vBits, __m256d vLow, __m256d vRange)
+{
+	__m256d	vUniform = _mm256_sub_pd(
+				_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(vBits, 12), _mm256_set1_epi64x(0x3FF0000000000000LL))),
+				_mm256_set1_pd(1.0));
+
+	return _mm256_add_pd(vLow, _mm256_mul_pd(vRange, vUniform));
+}
+
+/**
+ *	@brief  AVX2 implementation of `drawUniformDoublePairsPhilox()`, which runs the rounds of 8
+ *		counters in the 32-bit lanes of four vectors, for several groups of 8 counters at once.
+ */
+__attribute__((target("avx2")))
+static void
+drawUniformDoublePairsPhiloxAVX2(
+	uint64_t	seed,
+	uint64_t	firstIndex,
+	double		low0,
+	double		high0,
+	double		low1,
+	double		high1,
+	double *	values0,
+	double *	values1,
+	size_t		numberOfPairs)
+{
+	const __m256i	vMultiplier0 = _mm256_set1_epi32((int)kPhiloxMultiplier0);
+	const __m256i	vMultiplier1 = _mm256_set1_epi32((int)kPhiloxMultiplier1);
+	const __m256i	vKeyIncrement0 = _mm256_set1_epi32((int)kPhiloxKeyIncrement0);
+	const __m256i	vKeyIncrement1 = _mm256_set1_epi32((int)kPhiloxKeyIncrement1);
+	const __m256i	vLaneOffsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	const __m256d	vLow0 = _mm256_set1_pd(low0);
+	const __m256d	vRange0 = _mm256_set1_pd(high0 - low0);
+	const __m256d	vLow1 = _mm256_set1_pd(low1);
+	const __m256d	vRange1 = _mm256_set1_pd(high1 - low1);
+	size_t		i = 0;
+
+	/*
+	 *	Each round depends on the previous one, so interleave the rounds of
+	 *	`kPhiloxAVX2NumberOfGroups` independent groups of 8 counters, to hide
+	 *	the latency of the multiplies.
+	 */
+	for (; i + 8 * kPhiloxAVX2NumberOfGroups <= numberOfPairs; i += 8 * kPhiloxAVX2NumberOfGroups)
+	{
+		__m256i	vC0[kPhiloxAVX2NumberOfGroups];
+		__m256i	vC1[kPhiloxAVX2NumberOfGroups];
+		__m256i	vC2[kPhiloxAVX2NumberOfGroups];
+		__m256i	vC3[kPhiloxAVX2NumberOfGroups];
+		__m256i	vK0 = _mm256_set1_epi32((int)(uint32_t)seed);
+		__m256i	vK1 = _mm256_set1_epi32((int)(uint32_t)(seed >> 32));
+
+		for (int group = 0; group < kPhiloxAVX2NumberOfGroups; group++)
+		{
+			uint64_t	index = firstIndex + i + 8 * group;
+
+			/*
+			 *	The upper word of the counter only differs between the lanes
+			 *	if the lower word wraps around within these 8 counters.
+			 */
+			if ((uint32_t)index <= UINT32_MAX - 7)
+			{
+				vC0[group] = _mm256_add_epi32(_mm256_set1_epi32((int)(uint32_t)index), vLaneOffsets);
+				vC1[group] = _mm256_set1_epi32((int)(uint32_t)(index >> 32));
+			}
+			else
+			{
+				uint32_t	lowWords[8];
+				uint32_t	highWords[8];
+
+				for (int lane = 0; lane < 8; lane++)
+				{
+					lowWords[lane] = (uint32_t)(index + lane);
+					highWords[lane] = (uint32_t)((index + lane) >> 32);
+				}
+
+				vC0[group] = _mm256_loadu_si256((const __m256i *) lowWords);
+				vC1[group] = _mm256_loadu_si256((const __m256i *) highWords);
+			}
+
+			vC2[group] = _mm256_setzero_si256();
+			vC3[group] = _mm256_setzero_si256();
+		}
+
+		for (int round = 0; round < kPhiloxNumberOfRounds; round++)
+		{
+			for (int group = 0; group < kPhiloxAVX2NumberOfGroups; group++)
+			{
+				__m256i	vHigh0;
+				__m256i	vLow0Product;
+				__m256i	vHigh1;
+				__m256i	vLow1Product;
+
+				multiplyHighLowAVX2(vC0[group], vMultiplier0, &vHigh0, &vLow0Product);
+				multiplyHighLowAVX2(vC2[group], vMultiplier1, &vHigh1, &vLow1Product);
+
+				vC0[group] = _mm256_xor_si256(_mm256_xor_si256(vHigh1, vC1[group]), vK0);
+				vC1[group] = vLow1Product;
+				vC2[group] = _mm256_xor_si256(_mm256_xor_si256(vHigh0, vC3[group]), vK1);
+				vC3[group] = vLow0Product;
+			}
+
+			vK0 = _mm256_add_epi32(vK0, vKeyIncrement0);
+			vK1 = _mm256_add_epi32(vK1, vKeyIncrement1);
+		}
+
+		for (int group = 0; group < kPhiloxAVX2NumberOfGroups; group++)
+		{
+			size_t	groupStart = i + 8 * group;
+
+			/*
+			 *	Interleave the words of each pair into 64-bit lanes. Within each
+			 *	128-bit half, the unpacks give the pairs {0, 1, 4, 5} and {2, 3, 6, 7}.
+			 */
+			__m256d	vValues0Even = convertBitsToUniformDoubleAVX2(_mm256_unpacklo_epi32(vC0[group], vC1[group]), vLow0, vRange0);
+			__m256d	vValues0Odd = convertBitsToUniformDoubleAVX2(_mm256_unpackhi_epi32(vC0[group], vC1[group]), vLow0, vRange0);
+			__m256d	vValues1Even = convertBitsToUniformDoubleAVX2(_mm256_unpacklo_epi32(vC2[group], vC3[group]), vLow1, vRange1);
+			__m256d	vValues1Odd = convertBitsToUniformDoubleAVX2(_mm256_unpackhi_epi32(vC2[group], vC3[group]), vLow1, vRange1);
+
+			_mm256_storeu_pd(&values0[groupStart], _mm256_permute2f128_pd(vValues0Even, vValues0Odd, 0x20));
+			_mm256_storeu_pd(&values0[groupStart + 4], _mm256_permute2f128_pd(vValues0Even, vValues0Odd, 0x31));
+			_mm256_storeu_pd(&values1[groupStart], _mm256_permute2f128_pd(vValues1Even, vValues1Odd, 0x20));
+			_mm256_storeu_pd(&values1[groupStart + 4], _mm256_permute2f128_pd(vValues1Even, vValues1Odd, 0x31));
+		}
+	}
+
+	drawUniformDoublePairsPhiloxScalar(
+		seed,
+		firstIndex + i,
+		low0,
+		high0,
+		low1,
+		high1,
+		&values0[i],
+		&values1[i],
+		numberOfPairs - i);
+
+	return;
+}
+
+#endif /* kRandomNumberGeneratorIsX86 */
+
+void
+drawUniformDoublePairsPhilox(
+	uint64_t	seed,
+	uint64_t	firstIndex,
+	double		low0,
+	double		high0,
+	double		low1,
+	double		high1,
+	double *	values0,
+	double *	values1,
+	size_t		numberOfPairs)
+{
+#if kRandomNumberGeneratorIsX86
+	if (__builtin_cpu_supports("avx2"))
+	{
+		drawUniformDoublePairsPhiloxAVX2(seed, firstIndex, low0, high0, low1, high1, values0, values1, numberOfPairs);
+
+		return;
+	}
+#endif /* kRandomNumberGeneratorIsX86 */
+
+	drawUniformDoublePairsPhiloxScalar(seed, firstIndex, low0, high0, low1, high1, values0, values1, numberOfPairs);
+
+	return;
+}
+
+const char *
+getRandomNumberGeneratorTypeName(RandomNumberGeneratorType type)
+{
+	static const char *	names[kRandomNumberGeneratorTypeMax] =
+				{
+					"uxhw",
+					"xoshiro256",
+					"philox",
+					"sobol",
+					"sobol-scrambled",
+					"halton",
+					"halton-scrambled",
+				};
+
+	if (type >= kRandomNumberGeneratorTypeMax)
+	{
+		return "unknown";
+	}
+
+	return names[type];
+}
+
+CommonConstantReturnType
+parseRandomNumberGeneratorTypeName(const char *  name, RandomNumberGeneratorType *  type)
+{
+	for (RandomNumberGeneratorType i = 0; i < kRandomNumberGeneratorTypeMax; i++)
+	{
+		if (strcmp(name, getRandomNumberGeneratorTypeName(i)) == 0)
+		{
+			*type = i;
+
+			return kCommonConstantReturnTypeSuccess;
+		}
+	}
+
+	return kCommonConstantReturnTypeError;
+}
+
+CommonConstantReturnType
+runRandomNumberGeneratorSelfTest(void)
+{
+	/*
+	 *	Known-answer vectors of Philox4x32-10 from the Random123 distribution
+	 *	(counter, key, output).
+	 */
+	static const uint32_t		knownAnswers[][10] =
+					{
+						{
+							0x00000000, 0x00000000, 0x00000000, 0x00000000,
+							0x00000000, 0x00000000,
+							0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8,
+						},
+						{
+							0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+							0xFFFFFFFF, 0xFFFFFFFF,
+							0x408F276D, 0x41C83B0E, 0xA20BC7C6, 0x6D5451FD,
+						},
+						{
+							0x243F6A88, 0x85A308D3, 0x13198A2E, 0x03707344,
+							0xA4093822, 0x299F31D0,
+							0xD16CFE09, 0x94FDCCEB, 0x5001E420, 0x24126EA1,
+						},
+					};
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+	bool				passed = true;
+
+	printf("Random number generator self-test:\n");
+
+	for (size_t vector = 0; vector < sizeof(knownAnswers) / sizeof(knownAnswers[0]); vector++)
+	{
+		uint32_t	output[4];
+
+		calculatePhilox4x32(&knownAnswers[vector][0], &knownAnswers[vector][4], output);
+		passed = passed && (memcmp(output, &knownAnswers[vector][6], sizeof(output)) == 0);
+	}
+
+	printf("\t%-18s: known-answer vectors: %s\n", "philox", passed ? "PASS" : "FAIL");
+
+	if (!passed)
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+#if kRandomNumberGeneratorIsX86
+	if (__builtin_cpu_supports("avx2"))
+	{
+		/*
+		 *	Start just below a wrap-around of the lower counter word, and
+		 *	draw a number of pairs that is not a multiple of 8, to also cover
+		 *	the carry into the upper word and the scalar tail.
+		 */
+		size_t		numberOfPairs = kMonteCarloSampleBlockSize + 5;
+		uint64_t	firstIndex = (1ULL << 32) - 13;
+		double *	values0 = (double *) checkedMalloc(numberOfPairs * sizeof(double), __FILE__, __LINE__);
+		double *	values1 = (double *) checkedMalloc(numberOfPairs * sizeof(double), __FILE__, __LINE__);
+		double *	referenceValues0 = (double *) checkedMalloc(numberOfPairs * sizeof(double), __FILE__, __LINE__);
+		double *	referenceValues1 = (double *) checkedMalloc(numberOfPairs * sizeof(double), __FILE__, __LINE__);
+
+		drawUniformDoublePairsPhiloxScalar(
+			kDefaultMonteCarloSeed,
+			firstIndex,
+			kDefaultInputDistributionAoutUniformDistLow,
+			kDefaultInputDistributionAoutUniformDistHigh,
+			kDefaultInputDistributionVddUniformDistLow,
+			kDefaultInputDistributionVddUniformDistHigh,
+			referenceValues0,
+			referenceValues1,
+			numberOfPairs);
+		drawUniformDoublePairsPhiloxAVX2(
+			kDefaultMonteCarloSeed,
+			firstIndex,
+			kDefaultInputDistributionAoutUniformDistLow,
+			kDefaultInputDistributionAoutUniformDistHigh,
+			kDefaultInputDistributionVddUniformDistLow,
+			kDefaultInputDistributionVddUniformDistHigh,
+			values0,
+			values1,
+			numberOfPairs);
+
+		passed = (memcmp(values0, referenceValues0, numberOfPairs * sizeof(double)) == 0) &&
+				(memcmp(values1, referenceValues1, numberOfPairs * sizeof(double)) == 0);
+		printf("\t%-18s: bit-identical to scalar implementation: %s\n", "philox-avx2", passed ? "PASS" : "FAIL");
+
+		if (!passed)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+
+		free(values0);
+		free(values1);
+		free(referenceValues0);
+		free(referenceValues1);
+	}
+#endif /* kRandomNumberGeneratorIsX86 */
+
+	return result;
+}
+
+void
+runRandomNumberGeneratorBenchmark(size_t numberOfPairs)
+{
+	static const char *	generatorNames[] =
+				{
+					"uxhw",
+					"xoshiro256",
+					"philox-scalar",
+					"philox",
+				};
+	double *		Aout = (double *) checkedMalloc(numberOfPairs * sizeof(double), __FILE__, __LINE__);
+	double *		Vdd = (double *) checkedMalloc(numberOfPairs * sizeof(double), __FILE__, __LINE__);
+	RandomNumberGenerator	randomNumberGenerator;
+
+	printf("Random number generator benchmark (%zu input pairs, best of %d runs):\n", numberOfPairs, kCalibrationKernelBenchmarkNumberOfRuns);
+
+	for (size_t generator = 0; generator < sizeof(generatorNames) / sizeof(generatorNames[0]); generator++)
+	{
+		double	bestSeconds = INFINITY;
+
+		for (int run = 0; run < kCalibrationKernelBenchmarkNumberOfRuns; run++)
+		{
+			clock_t	start = clock();
+
+			switch (generator)
+			{
+				case 0:
+					for (size_t i = 0; i < numberOfPairs; i++)
+					{
+						Aout[i] = UxHwDoubleUniformDist(kDefaultInputDistributionAoutUniformDistLow, kDefaultInputDistributionAoutUniformDistHigh);
+						Vdd[i] = UxHwDoubleUniformDist(kDefaultInputDistributionVddUniformDistLow, kDefaultInputDistributionVddUniformDistHigh);
+					}
+					break;
+
+				case 1:
+					seedRandomNumberGenerator(&randomNumberGenerator, kDefaultMonteCarloSeed, 0);
+
+					for (size_t i = 0; i < numberOfPairs; i++)
+					{
+						Aout[i] = drawUniformDoubleInRange(
+								&randomNumberGenerator,
+								kDefaultInputDistributionAoutUniformDistLow,
+								kDefaultInputDistributionAoutUniformDistHigh);
+						Vdd[i] = drawUniformDoubleInRange(
+								&randomNumberGenerator,
+								kDefaultInputDistributionVddUniformDistLow,
+								kDefaultInputDistributionVddUniformDistHigh);
+					}
+					break;
+
+				case 2:
+					drawUniformDoublePairsPhiloxScalar(
+						kDefaultMonteCarloSeed,
+						0,
+						kDefaultInputDistributionAoutUniformDistLow,
+						kDefaultInputDistributionAoutUniformDistHigh,
+						kDefaultInputDistributionVddUniformDistLow,
+						kDefaultInputDistributionVddUniformDistHigh,
+						Aout,
+						Vdd,
+						numberOfPairs);
+					break;
+
+				default:
+					drawUniformDoublePairsPhilox(
+						kDefaultMonteCarloSeed,
+						0,
+						kDefaultInputDistributionAoutUniformDistLow,
+						kDefaultInputDistributionAoutUniformDistHigh,
+						kDefaultInputDistributionVddUniformDistLow,
+						kDefaultInputDistributionVddUniformDistHigh,
+						Aout,
+						Vdd,
+						numberOfPairs);
+					break;
+			}
+
+			double	seconds = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+
+			if (seconds < bestSeconds)
+			{
+				bestSeconds = seconds;
+			}
+		}
+
+		printf("\t%-18s: %.3lf ns/pair\n", generatorNames[generator], bestSeconds * 1e9 / numberOfPairs);
+	}
+
+	free(Aout);
+	free(Vdd);
+
+	return;
+}
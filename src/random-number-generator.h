@@ -0,0 +1,157 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "common.h"
+
+/*
+ *	Sources of the input samples of the native Monte Carlo mode:
+ *		kRandomNumberGeneratorTypeUxHw			: One call to `UxHwDoubleUniformDist()` per input, in a single thread.
+ *		kRandomNumberGeneratorTypeXoshiro256		: Seeded xoshiro256** streams, one per thread.
+ *		kRandomNumberGeneratorTypePhilox		: Seeded counter-based Philox4x32-10 generator, which derives the inputs
+ *								  of each iteration from the seed and the index of the iteration only,
+ *								  filling whole blocks of inputs with SIMD where available.
+ *		kRandomNumberGeneratorTypeSobol			: Two-dimensional Sobol low-discrepancy sequence (quasi-Monte Carlo),
+ *								  see `quasi-monte-carlo.h`.
+ *		kRandomNumberGeneratorTypeSobolScrambled	: Sobol sequence with a random linear scrambling and digital shift,
+ *								  derived from the seed.
+ *		kRandomNumberGeneratorTypeHalton		: Two-dimensional Halton low-discrepancy sequence (bases 2 and 3).
+ *		kRandomNumberGeneratorTypeHaltonScrambled	: Halton sequence with a random shift modulo 1, derived from the seed.
+ */
+typedef enum
+{
+	kRandomNumberGeneratorTypeUxHw			= 0,
+	kRandomNumberGeneratorTypeXoshiro256		= 1,
+	kRandomNumberGeneratorTypePhilox		= 2,
+	kRandomNumberGeneratorTypeSobol			= 3,
+	kRandomNumberGeneratorTypeSobolScrambled	= 4,
+	kRandomNumberGeneratorTypeHalton		= 5,
+	kRandomNumberGeneratorTypeHaltonScrambled	= 6,
+	kRandomNumberGeneratorTypeMax,
+} RandomNumberGeneratorType;
+
+/*
+ *	Seedable pseudo-random number generator for the native Monte Carlo mode
+ *	(xoshiro256**). Unlike the UxHw API calls, each generator has its own
+ *	state, so that each thread can draw from its own stream. The state of a
+ *	stream is expanded with SplitMix64 from the seed and a SplitMix64 hash of
+ *	the stream index, in constant time, so that the streams of a seed start
+ *	at distinct, effectively random, points of the 2^256 - 1 period, and in
+ *	practice do not overlap.
+ */
+typedef struct
+{
+	uint64_t	state[4];
+} RandomNumberGenerator;
+
+/**
+ *	@brief  Seeds a generator at the start of one of the streams of the seed.
+ *
+ *	@param  randomNumberGenerator	: Pointer to the generator to seed.
+ *	@param  seed			: The seed.
+ *	@param  streamIndex		: The index of the stream, e.g., the index of the thread that uses the generator.
+ */
+void	seedRandomNumberGenerator(RandomNumberGenerator *  randomNumberGenerator, uint64_t seed, uint64_t streamIndex);
+
+/**
+ *	@brief  Draws a uniformly distributed double from [0, 1), with 53 random bits.
+ *
+ *	@param  randomNumberGenerator	: Pointer to the generator to draw from.
+ *	@return double			: The drawn value.
+ */
+double	drawUniformDouble(RandomNumberGenerator *  randomNumberGenerator);
+
+/**
+ *	@brief  Draws a uniformly distributed double from [low, high).
+ *
+ *	@param  randomNumberGenerator	: Pointer to the generator to draw from.
+ *	@param  low			: The lower bound of the range.
+ *	@param  high			: The upper bound of the range.
+ *	@return double			: The drawn value.
+ */
+double	drawUniformDoubleInRange(RandomNumberGenerator *  randomNumberGenerator, double low, double high);
+
+/**
+ *	@brief  Draws pairs of uniformly distributed doubles from [low0, high0) and [low1, high1) with the
+ *		counter-based Philox4x32-10 generator. The pair of index `i` is derived from the 128-bit
+ *		output for the counter `i` and the key `seed`, with 52 random bits per double, so any
+ *		range of pairs can be drawn independently of all others. On x86 CPUs with AVX2, the
+ *		function draws 8 pairs per iteration, bit-identically to the scalar implementation.
+ *
+ *	@param  seed		: The seed (key) of the generator.
+ *	@param  firstIndex	: The index of the first pair to draw.
+ *	@param  low0		: The lower bound of the range of the first values of the pairs.
+ *	@param  high0		: The upper bound of the range of the first values of the pairs.
+ *	@param  low1		: The lower bound of the range of the second values of the pairs.
+ *	@param  high1		: The upper bound of the range of the second values of the pairs.
+ *	@param  values0		: Array of `numberOfPairs` values, where the function writes the first values of the pairs.
+ *	@param  values1		: Array of `numberOfPairs` values, where the function writes the second values of the pairs.
+ *	@param  numberOfPairs	: The number of pairs to draw.
+ */
+void	drawUniformDoublePairsPhilox(
+		uint64_t	seed,
+		uint64_t	firstIndex,
+		double		low0,
+		double		high0,
+		double		low1,
+		double		high1,
+		double *	values0,
+		double *	values1,
+		size_t		numberOfPairs);
+
+/**
+ *	@brief  Returns the command-line name of a random number generator.
+ *
+ *	@param  type		: The random number generator.
+ *	@return const char *	: The name, or "unknown" if the generator is invalid.
+ */
+const char *	getRandomNumberGeneratorTypeName(RandomNumberGeneratorType type);
+
+/**
+ *	@brief  Parses the command-line name of a random number generator.
+ *
+ *	@param  name	: The name to parse.
+ *	@param  type	: Pointer to where the function writes the generator.
+ *	@return		: `kCommonConstantReturnTypeSuccess` if the name is valid,
+ *			   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	parseRandomNumberGeneratorTypeName(const char *  name, RandomNumberGeneratorType *  type);
+
+/**
+ *	@brief  Checks the Philox4x32-10 generator against known-answer vectors, and its AVX2
+ *		implementation, if supported by the CPU, against the scalar implementation.
+ *
+ *	@return		: `kCommonConstantReturnTypeSuccess` if all checks pass,
+ *			   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runRandomNumberGeneratorSelfTest(void);
+
+/**
+ *	@brief  Times the generation of (Aout, Vdd) input pairs via the UxHw API calls and via each
+ *		seeded generator, and prints the time per pair in nanoseconds.
+ *
+ *	@param  numberOfPairs	: The number of input pairs to draw per measurement.
+ */
+void	runRandomNumberGeneratorBenchmark(size_t numberOfPairs);
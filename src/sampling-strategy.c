@@ -0,0 +1,380 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "sampling-strategy.h"
+#include "random-number-generator.h"
+#include "utilities-config.h"
+
+/**
+ *	@brief  Derives the 32-bit seed of the permutations of a strategy from the seed of the run.
+ *
+ *	@param  seed		: The seed of the run.
+ *	@return uint32_t	: The seed of the permutations.
+ */
+static inline uint32_t
+getPermutationSeed(uint64_t seed)
+{
+	return (uint32_t)((seed * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+/**
+ *	@brief  Returns the element at an index of a random permutation of [0, length), without storing
+ *		the permutation (Kensler, "Correlated Multi-Jittered Sampling", 2013). The hash is a
+ *		bijection on the smallest power-of-two range that contains [0, length), and indices that
+ *		fall outside of [0, length) are hashed again until they fall inside.
+ *
+ *	@param  index		: The index, in [0, length).
+ *	@param  length		: The length of the permutation, at least 1.
+ *	@param  seed		: The seed of the permutation.
+ *	@return uint32_t	: The element at the index.
+ */
+static uint32_t
+permuteIndex(uint32_t index, uint32_t length, uint32_t seed)
+{
+	uint32_t	mask = length - 1;
+
+	mask |= mask >> 1;
+	mask |= mask >> 2;
+	mask |= mask >> 4;
+	mask |= mask >> 8;
+	mask |= mask >> 16;
+
+	do
+	{
+		index ^= seed;
+		index *= 0xE170893DU;
+		index ^= seed >> 16;
+		index ^= (index & mask) >> 4;
+		index ^= seed >> 8;
+		index *= 0x0929EB3FU;
+		index ^= seed >> 23;
+		index ^= (index & mask) >> 1;
+		index *= 1 | seed >> 27;
+		index *= 0x6935FA69U;
+		index ^= (index & mask) >> 11;
+		index *= 0x74DCB303U;
+		index ^= (index & mask) >> 2;
+		index *= 0x9E501CC3U;
+		index ^= (index & mask) >> 2;
+		index *= 0xC860A3DFU;
+		index &= mask;
+		index ^= index >> 5;
+	} while (index >= length);
+
+	return (uint32_t)(((uint64_t)index + seed) % length);
+}
+
+/**
+ *	@brief  Returns the number of rows of the grid of the stratified strategy: the largest divisor of
+ *		the number of samples that is at most its square root.
+ *
+ *	@param  numberOfSamples		: The number of samples, at least 1.
+ *	@return uint64_t		: The number of rows.
+ */
+static uint64_t
+getStratifiedNumberOfRows(uint64_t numberOfSamples)
+{
+	uint64_t	numberOfRows = (uint64_t)sqrt((double)numberOfSamples);
+
+	while ((numberOfRows + 1) * (numberOfRows + 1) <= numberOfSamples)
+	{
+		numberOfRows++;
+	}
+
+	while ((numberOfRows > 1) && ((numberOfSamples % numberOfRows) != 0))
+	{
+		numberOfRows--;
+	}
+
+	return (numberOfRows > 0) ? numberOfRows : 1;
+}
+
+void
+drawInputPairsWithSamplingStrategy(
+	SamplingStrategy	strategy,
+	uint64_t		seed,
+	uint64_t		numberOfSamples,
+	uint64_t		firstIndex,
+	double			low0,
+	double			high0,
+	double			low1,
+	double			high1,
+	double *		values0,
+	double *		values1,
+	size_t			numberOfPairs)
+{
+	const double	range0 = high0 - low0;
+	const double	range1 = high1 - low1;
+
+	switch (strategy)
+	{
+		case kSamplingStrategyStratified:
+		{
+			uint64_t	numberOfRows = getStratifiedNumberOfRows(numberOfSamples);
+			uint64_t	numberOfColumns = numberOfSamples / numberOfRows;
+
+			/*
+			 *	The uniform jitter within each cell comes from the Philox
+			 *	pair of the same index.
+			 */
+			drawUniformDoublePairsPhilox(seed, firstIndex, 0.0, 1.0, 0.0, 1.0, values0, values1, numberOfPairs);
+
+			for (size_t i = 0; i < numberOfPairs; i++)
+			{
+				uint64_t	index = firstIndex + i;
+
+				values0[i] = low0 + range0 * (((double)(index / numberOfColumns) + values0[i]) / (double)numberOfRows);
+				values1[i] = low1 + range1 * (((double)(index % numberOfColumns) + values1[i]) / (double)numberOfColumns);
+			}
+
+			break;
+		}
+
+		case kSamplingStrategyLatinHypercube:
+		{
+			uint32_t	permutationSeed = getPermutationSeed(seed);
+
+			drawUniformDoublePairsPhilox(seed, firstIndex, 0.0, 1.0, 0.0, 1.0, values0, values1, numberOfPairs);
+
+			for (size_t i = 0; i < numberOfPairs; i++)
+			{
+				uint32_t	index = (uint32_t)(firstIndex + i);
+				uint32_t	permutedIndex = permuteIndex(index, (uint32_t)numberOfSamples, permutationSeed);
+
+				values0[i] = low0 + range0 * (((double)index + values0[i]) / (double)numberOfSamples);
+				values1[i] = low1 + range1 * (((double)permutedIndex + values1[i]) / (double)numberOfSamples);
+			}
+
+			break;
+		}
+
+		case kSamplingStrategyAntithetic:
+		{
+			double	uniforms0[kMonteCarloSampleBlockSize];
+			double	uniforms1[kMonteCarloSampleBlockSize];
+
+			/*
+			 *	Samples 2k and 2k + 1 share the Philox pair of index k. The
+			 *	Philox doubles are multiples of 2^-52 in [0, 1 - 2^-52], so
+			 *	the reflection `1 - 2^-52 - u` is exact and in the same set.
+			 */
+			for (size_t chunkStart = 0; chunkStart < numberOfPairs; chunkStart += kMonteCarloSampleBlockSize)
+			{
+				size_t		chunkSize = numberOfPairs - chunkStart;
+				uint64_t	chunkFirstIndex = firstIndex + chunkStart;
+				uint64_t	firstPairIndex;
+
+				if (chunkSize > kMonteCarloSampleBlockSize)
+				{
+					chunkSize = kMonteCarloSampleBlockSize;
+				}
+
+				firstPairIndex = chunkFirstIndex >> 1;
+				drawUniformDoublePairsPhilox(
+					seed,
+					firstPairIndex,
+					0.0,
+					1.0,
+					0.0,
+					1.0,
+					uniforms0,
+					uniforms1,
+					(size_t)(((chunkFirstIndex + chunkSize - 1) >> 1) - firstPairIndex + 1));
+
+				for (size_t i = 0; i < chunkSize; i++)
+				{
+					uint64_t	index = chunkFirstIndex + i;
+					double		u0 = uniforms0[(index >> 1) - firstPairIndex];
+					double		u1 = uniforms1[(index >> 1) - firstPairIndex];
+
+					if (index & 1)
+					{
+						u0 = (1.0 - DBL_EPSILON) - u0;
+						u1 = (1.0 - DBL_EPSILON) - u1;
+					}
+
+					values0[chunkStart + i] = low0 + range0 * u0;
+					values1[chunkStart + i] = low1 + range1 * u1;
+				}
+			}
+
+			break;
+		}
+
+		default:
+			drawUniformDoublePairsPhilox(seed, firstIndex, low0, high0, low1, high1, values0, values1, numberOfPairs);
+			break;
+	}
+
+	return;
+}
+
+const char *
+getSamplingStrategyName(SamplingStrategy strategy)
+{
+	static const char *	names[kSamplingStrategyMax] =
+				{
+					"iid",
+					"stratified",
+					"latin-hypercube",
+					"antithetic",
+				};
+
+	if (strategy >= kSamplingStrategyMax)
+	{
+		return "unknown";
+	}
+
+	return names[strategy];
+}
+
+CommonConstantReturnType
+parseSamplingStrategyName(const char *  name, SamplingStrategy *  strategy)
+{
+	for (SamplingStrategy i = 0; i < kSamplingStrategyMax; i++)
+	{
+		if (strcmp(name, getSamplingStrategyName(i)) == 0)
+		{
+			*strategy = i;
+
+			return kCommonConstantReturnTypeSuccess;
+		}
+	}
+
+	return kCommonConstantReturnTypeError;
+}
+
+CommonConstantReturnType
+runSamplingStrategySelfTest(void)
+{
+	const size_t			numberOfSamples = kSamplingStrategySelfTestNumberOfSamples;
+	double *			values0 = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	double *			values1 = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	uint32_t *			counts = (uint32_t *) checkedMalloc(numberOfSamples * sizeof(uint32_t), __FILE__, __LINE__);
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	printf("Sampling strategy self-test:\n");
+
+	for (SamplingStrategy strategy = 0; strategy < kSamplingStrategyMax; strategy++)
+	{
+		bool	passed = true;
+
+		drawInputPairsWithSamplingStrategy(strategy, kDefaultMonteCarloSeed, numberOfSamples, 0, 0.0, 1.0, 0.0, 1.0, values0, values1, numberOfSamples);
+
+		/*
+		 *	Drawing from an odd index, in ranges of different lengths,
+		 *	must give the same pairs.
+		 */
+		for (size_t i = 1; i < numberOfSamples; i += 7)
+		{
+			double	rangeValues0[7];
+			double	rangeValues1[7];
+			size_t	rangeLength = (numberOfSamples - i < 7) ? (numberOfSamples - i) : 7;
+
+			drawInputPairsWithSamplingStrategy(strategy, kDefaultMonteCarloSeed, numberOfSamples, i, 0.0, 1.0, 0.0, 1.0, rangeValues0, rangeValues1, rangeLength);
+
+			for (size_t j = 0; j < rangeLength; j++)
+			{
+				passed = passed && (rangeValues0[j] == values0[i + j]) && (rangeValues1[j] == values1[i + j]);
+			}
+		}
+
+		for (size_t i = 0; i < numberOfSamples; i++)
+		{
+			passed = passed && (values0[i] >= 0.0) && (values0[i] < 1.0) && (values1[i] >= 0.0) && (values1[i] < 1.0);
+		}
+
+		printf("\t%-18s: ranges of pairs identical to single pairs: %s\n", getSamplingStrategyName(strategy), passed ? "PASS" : "FAIL");
+
+		if (!passed)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+
+		if (strategy == kSamplingStrategyIndependent)
+		{
+			continue;
+		}
+
+		passed = true;
+
+		if (strategy == kSamplingStrategyAntithetic)
+		{
+			for (size_t i = 0; i + 1 < numberOfSamples; i += 2)
+			{
+				passed = passed && (values0[i] + values0[i + 1] == 1.0 - DBL_EPSILON) && (values1[i] + values1[i + 1] == 1.0 - DBL_EPSILON);
+			}
+
+			printf("\t%-18s: second sample of each pair reflects the first: %s\n", getSamplingStrategyName(strategy), passed ? "PASS" : "FAIL");
+		}
+		else
+		{
+			/*
+			 *	Count the samples per cell of the grid (stratified), and per
+			 *	interval of each input (Latin hypercube).
+			 */
+			size_t	numberOfRows = (strategy == kSamplingStrategyStratified) ? (size_t)getStratifiedNumberOfRows(numberOfSamples) : numberOfSamples;
+			size_t	numberOfColumns = numberOfSamples / numberOfRows;
+
+			memset(counts, 0, numberOfSamples * sizeof(uint32_t));
+
+			for (size_t i = 0; i < numberOfSamples; i++)
+			{
+				if (strategy == kSamplingStrategyStratified)
+				{
+					counts[(size_t)(values0[i] * numberOfRows) * numberOfColumns + (size_t)(values1[i] * numberOfColumns)]++;
+				}
+				else
+				{
+					counts[(size_t)(values0[i] * numberOfSamples)] += 1;
+					counts[(size_t)(values1[i] * numberOfSamples)] += 1U << 16;
+				}
+			}
+
+			for (size_t i = 0; i < numberOfSamples; i++)
+			{
+				passed = passed && (counts[i] == ((strategy == kSamplingStrategyStratified) ? 1U : ((1U << 16) | 1U)));
+			}
+
+			printf("\t%-18s: one sample per stratum: %s\n", getSamplingStrategyName(strategy), passed ? "PASS" : "FAIL");
+		}
+
+		if (!passed)
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+	}
+
+	free(values0);
+	free(values1);
+	free(counts);
+
+	return result;
+}
@@ -0,0 +1,113 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "common.h"
+
+/*
+ *	Sampling strategies of the (Aout, Vdd) input pairs of the native Monte Carlo
+ *	mode with the Philox generator. All strategies draw each input uniformly
+ *	from its range, so the sample mean of an output is unbiased, but their
+ *	samples are not independent:
+ *		kSamplingStrategyIndependent	: Independent pairs (plain Monte Carlo).
+ *		kSamplingStrategyStratified	: The input rectangle is divided into a grid of K1 x K2 cells of
+ *						  equal probability, with K1 * K2 equal to the number of samples
+ *						  and K1 the largest divisor of the number of samples up to its
+ *						  square root, and each cell gets one pair, uniformly within the cell.
+ *		kSamplingStrategyLatinHypercube	: Each of the N equal-probability intervals of each input gets
+ *						  one sample, and the intervals of Vdd are paired with those of
+ *						  Aout by a random permutation.
+ *		kSamplingStrategyAntithetic	: Pairs of samples, where the second sample reflects both inputs
+ *						  of the first about the centers of their ranges.
+ *
+ *	Like independent Philox sampling, the pair of sample `i` only depends on the
+ *	seed, `i`, and the number of samples, so any range of samples can be drawn
+ *	independently of all others.
+ */
+typedef enum
+{
+	kSamplingStrategyIndependent	= 0,
+	kSamplingStrategyStratified	= 1,
+	kSamplingStrategyLatinHypercube	= 2,
+	kSamplingStrategyAntithetic	= 3,
+	kSamplingStrategyMax,
+} SamplingStrategy;
+
+/**
+ *	@brief  Draws a range of input pairs of a sampling strategy, scaled to [low0, high0) x [low1, high1).
+ *
+ *	@param  strategy		: The sampling strategy.
+ *	@param  seed			: The seed of the Philox generator and of the permutations of the strategy.
+ *	@param  numberOfSamples		: The total number of samples of the strategy, which determines the strata. At most
+ *					  `kSamplingStrategyMaximumNumberOfSamples` for the stratified and Latin hypercube strategies.
+ *	@param  firstIndex		: The index of the first pair to draw.
+ *	@param  low0			: The lower bound of the range of the first values of the pairs.
+ *	@param  high0			: The upper bound of the range of the first values of the pairs.
+ *	@param  low1			: The lower bound of the range of the second values of the pairs.
+ *	@param  high1			: The upper bound of the range of the second values of the pairs.
+ *	@param  values0			: Array of `numberOfPairs` values, where the function writes the first values of the pairs.
+ *	@param  values1			: Array of `numberOfPairs` values, where the function writes the second values of the pairs.
+ *	@param  numberOfPairs		: The number of pairs to draw.
+ */
+void	drawInputPairsWithSamplingStrategy(
+		SamplingStrategy	strategy,
+		uint64_t		seed,
+		uint64_t		numberOfSamples,
+		uint64_t		firstIndex,
+		double			low0,
+		double			high0,
+		double			low1,
+		double			high1,
+		double *		values0,
+		double *		values1,
+		size_t			numberOfPairs);
+
+/**
+ *	@brief  Returns the command-line name of a sampling strategy.
+ *
+ *	@param  strategy	: The sampling strategy.
+ *	@return const char *	: The name, or "unknown" if the strategy is invalid.
+ */
+const char *	getSamplingStrategyName(SamplingStrategy strategy);
+
+/**
+ *	@brief  Parses the command-line name of a sampling strategy.
+ *
+ *	@param  name		: The name to parse.
+ *	@param  strategy	: Pointer to where the function writes the strategy.
+ *	@return			: `kCommonConstantReturnTypeSuccess` if the name is valid,
+ *				   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	parseSamplingStrategyName(const char *  name, SamplingStrategy *  strategy);
+
+/**
+ *	@brief  Checks that the stratified and Latin hypercube strategies put one sample in each of their
+ *		strata, that the antithetic strategy reflects each pair, and that drawing a range of pairs
+ *		at once gives the same pairs as drawing them one by one.
+ *
+ *	@return		: `kCommonConstantReturnTypeSuccess` if all checks pass,
+ *			   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runSamplingStrategySelfTest(void);
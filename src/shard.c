@@ -0,0 +1,984 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include "shard.h"
+#include "montecarlo.h"
+
+/*
+ *	Settings of the run that a partial-state file comes from, which must be
+ *	the same for all files that are merged.
+ */
+typedef struct
+{
+	uint64_t	shardIndex;
+	uint64_t	numberOfShards;
+	uint64_t	numberOfMonteCarloIterations;
+	uint64_t	seed;
+	uint32_t	randomNumberGeneratorType;
+	uint32_t	samplingStrategy;
+	uint32_t	outputSelect;
+	uint32_t	isSinglePrecisionEnabled;
+	uint32_t	lookupTableNumberOfIntervals;
+	uint32_t	isHistogramEnabled;
+} ShardPartialStateHeader;
+
+/*
+ *	A partial-state file to merge, and the header read from it.
+ */
+typedef struct
+{
+	const char *		filePath;
+	ShardPartialStateHeader	header;
+} ShardPartialStateFile;
+
+/*
+ *	Generates the functions that write and read a value of a fixed-width
+ *	type to and from a partial-state file, in native byte order. They return
+ *	whether they succeeded.
+ */
+#define DEFINE_PARTIAL_STATE_VALUE_IO(writeFunctionName, readFunctionName, valueType)		\
+	static bool										\
+	writeFunctionName(FILE *  file, valueType value)					\
+	{											\
+		return fwrite(&value, sizeof(value), 1, file) == 1;				\
+	}											\
+												\
+	static bool										\
+	readFunctionName(FILE *  file, valueType *  value)					\
+	{											\
+		return fread(value, sizeof(*value), 1, file) == 1;				\
+	}
+
+DEFINE_PARTIAL_STATE_VALUE_IO(writeUint32, readUint32, uint32_t)
+DEFINE_PARTIAL_STATE_VALUE_IO(writeUint64, readUint64, uint64_t)
+DEFINE_PARTIAL_STATE_VALUE_IO(writeDouble, readDouble, double)
+
+
+/**
+ *	@brief  Writes the magic, version, and header of a partial-state file.
+ *
+ *	@param  file	: The file to write to.
+ *	@param  header	: Pointer to the header.
+ *	@return bool	: `true` if successful, else `false`.
+ */
+static bool
+writeShardPartialStateHeader(FILE *  file, const ShardPartialStateHeader *  header)
+{
+	return (fwrite(kShardPartialStateFileMagic, 1, strlen(kShardPartialStateFileMagic), file) == strlen(kShardPartialStateFileMagic)) &&
+		writeUint32(file, kShardPartialStateFileVersion) &&
+		writeUint64(file, header->shardIndex) &&
+		writeUint64(file, header->numberOfShards) &&
+		writeUint64(file, header->numberOfMonteCarloIterations) &&
+		writeUint64(file, header->seed) &&
+		writeUint32(file, header->randomNumberGeneratorType) &&
+		writeUint32(file, header->samplingStrategy) &&
+		writeUint32(file, header->outputSelect) &&
+		writeUint32(file, header->isSinglePrecisionEnabled) &&
+		writeUint32(file, header->lookupTableNumberOfIntervals) &&
+		writeUint32(file, header->isHistogramEnabled);
+}
+
+/**
+ *	@brief  Reads and checks the magic and version, and reads the header, of a partial-state file.
+ *
+ *	@param  file	: The file to read from.
+ *	@param  header	: Pointer to where the function writes the header.
+ *	@return bool	: `true` if successful, else `false`.
+ */
+static bool
+readShardPartialStateHeader(FILE *  file, ShardPartialStateHeader *  header)
+{
+	char		magic[sizeof(kShardPartialStateFileMagic)] = {0};
+	uint32_t	version;
+
+	return (fread(magic, 1, strlen(kShardPartialStateFileMagic), file) == strlen(kShardPartialStateFileMagic)) &&
+		(strcmp(magic, kShardPartialStateFileMagic) == 0) &&
+		readUint32(file, &version) &&
+		(version == kShardPartialStateFileVersion) &&
+		readUint64(file, &header->shardIndex) &&
+		readUint64(file, &header->numberOfShards) &&
+		readUint64(file, &header->numberOfMonteCarloIterations) &&
+		readUint64(file, &header->seed) &&
+		readUint32(file, &header->randomNumberGeneratorType) &&
+		readUint32(file, &header->samplingStrategy) &&
+		readUint32(file, &header->outputSelect) &&
+		readUint32(file, &header->isSinglePrecisionEnabled) &&
+		readUint32(file, &header->lookupTableNumberOfIntervals) &&
+		readUint32(file, &header->isHistogramEnabled) &&
+		(header->numberOfShards >= 1) &&
+		(header->shardIndex < header->numberOfShards) &&
+		(header->outputSelect <= kOutputDistributionIndexCalibratedSensorOutputMax);
+}
+
+/**
+ *	@brief  Writes the statistics, quantile sketch, and optionally the histogram of an output.
+ *
+ *	@param  file			: The file to write to.
+ *	@param  streamingStatistics	: Pointer to the statistics.
+ *	@param  quantileSketch		: Pointer to the quantile sketch.
+ *	@param  histogram		: Pointer to the histogram, or `NULL`.
+ *	@return bool			: `true` if successful, else `false`.
+ */
+static bool
+writeShardPartialStateOutput(FILE *  file, const StreamingStatistics *  streamingStatistics, const QuantileSketch *  quantileSketch, const Histogram *  histogram)
+{
+	bool	isWritten = writeUint64(file, streamingStatistics->numberOfSamples) &&
+				writeDouble(file, streamingStatistics->mean) &&
+				writeDouble(file, streamingStatistics->sumOfSquaredDeviations) &&
+				writeDouble(file, streamingStatistics->minimum) &&
+				writeDouble(file, streamingStatistics->maximum) &&
+				writeUint64(file, quantileSketch->numberOfSamples) &&
+				writeDouble(file, quantileSketch->minimum) &&
+				writeDouble(file, quantileSketch->maximum) &&
+				writeUint64(file, quantileSketch->numberOfCentroids) &&
+				writeUint64(file, quantileSketch->numberOfBufferedSamples);
+
+	for (size_t i = 0; isWritten && (i < quantileSketch->numberOfCentroids); i++)
+	{
+		isWritten = writeDouble(file, quantileSketch->centroids[i].mean) && writeDouble(file, quantileSketch->centroids[i].weight);
+	}
+
+	for (size_t i = 0; isWritten && (i < quantileSketch->numberOfBufferedSamples); i++)
+	{
+		isWritten = writeDouble(file, quantileSketch->bufferedSamples[i]);
+	}
+
+	if (isWritten && (histogram != NULL))
+	{
+		isWritten = writeDouble(file, histogram->low) &&
+				writeDouble(file, histogram->high) &&
+				writeUint64(file, histogram->numberOfBins) &&
+				writeUint64(file, histogram->underflowCount) &&
+				writeUint64(file, histogram->overflowCount) &&
+				(fwrite(histogram->counts, sizeof(uint64_t), histogram->numberOfBins, file) == histogram->numberOfBins);
+	}
+
+	return isWritten;
+}
+
+/**
+ *	@brief  Reads the statistics, quantile sketch, and optionally the histogram of an output.
+ *
+ *	@param  file			: The file to read from.
+ *	@param  streamingStatistics	: Pointer to where the function reads the statistics.
+ *	@param  quantileSketch		: Pointer to where the function reads the quantile sketch.
+ *	@param  histogram		: Pointer to the histogram, or `NULL` if the file has no histograms. If it is not
+ *					  initialized, the function initializes it with the bins of the file, else the bins
+ *					  of the file must be its bins.
+ *	@return bool			: `true` if successful, else `false`.
+ */
+static bool
+readShardPartialStateOutput(FILE *  file, StreamingStatistics *  streamingStatistics, QuantileSketch *  quantileSketch, Histogram *  histogram)
+{
+	uint64_t	numberOfCentroids;
+	uint64_t	numberOfBufferedSamples;
+	bool		isRead = readUint64(file, &streamingStatistics->numberOfSamples) &&
+				readDouble(file, &streamingStatistics->mean) &&
+				readDouble(file, &streamingStatistics->sumOfSquaredDeviations) &&
+				readDouble(file, &streamingStatistics->minimum) &&
+				readDouble(file, &streamingStatistics->maximum) &&
+				readUint64(file, &quantileSketch->numberOfSamples) &&
+				readDouble(file, &quantileSketch->minimum) &&
+				readDouble(file, &quantileSketch->maximum) &&
+				readUint64(file, &numberOfCentroids) &&
+				readUint64(file, &numberOfBufferedSamples) &&
+				(numberOfCentroids <= kQuantileSketchMaximumNumberOfCentroids) &&
+				(numberOfBufferedSamples < kQuantileSketchBufferSize);
+
+	if (!isRead)
+	{
+		return false;
+	}
+
+	quantileSketch->numberOfCentroids = numberOfCentroids;
+	quantileSketch->numberOfBufferedSamples = numberOfBufferedSamples;
+
+	for (size_t i = 0; isRead && (i < numberOfCentroids); i++)
+	{
+		isRead = readDouble(file, &quantileSketch->centroids[i].mean) && readDouble(file, &quantileSketch->centroids[i].weight);
+	}
+
+	for (size_t i = 0; isRead && (i < numberOfBufferedSamples); i++)
+	{
+		isRead = readDouble(file, &quantileSketch->bufferedSamples[i]);
+	}
+
+	if (isRead && (histogram != NULL))
+	{
+		double		low;
+		double		high;
+		uint64_t	numberOfBins;
+
+		if (!readDouble(file, &low) ||
+			!readDouble(file, &high) ||
+			!readUint64(file, &numberOfBins) ||
+			(numberOfBins < 1) ||
+			(numberOfBins > kHistogramMaximumNumberOfBins) ||
+			!(low < high))
+		{
+			return false;
+		}
+
+		if (histogram->counts == NULL)
+		{
+			initializeHistogram(histogram, low, high, numberOfBins);
+		}
+
+		if ((low != histogram->low) || (high != histogram->high) || (numberOfBins != histogram->numberOfBins))
+		{
+			return false;
+		}
+
+		isRead = readUint64(file, &histogram->underflowCount) &&
+				readUint64(file, &histogram->overflowCount) &&
+				(fread(histogram->counts, sizeof(uint64_t), numberOfBins, file) == numberOfBins);
+	}
+
+	return isRead;
+}
+
+/**
+ *	@brief  Gets the header of the partial state of the shard of `arguments`.
+ *
+ *	@param  arguments	: Pointer to command-line arguments struct.
+ *	@param  header		: Pointer to where the function writes the header.
+ */
+static void
+getShardPartialStateHeader(CommandLineArguments *  arguments, ShardPartialStateHeader *  header)
+{
+	*header = (ShardPartialStateHeader)
+		{
+			.shardIndex			= arguments->shardIndex,
+			.numberOfShards			= arguments->numberOfShards,
+			.numberOfMonteCarloIterations	= arguments->common.numberOfMonteCarloIterations,
+			.seed				= arguments->seed,
+			.randomNumberGeneratorType	= arguments->randomNumberGeneratorType,
+			.samplingStrategy		= arguments->samplingStrategy,
+			.outputSelect			= arguments->common.outputSelect,
+			.isSinglePrecisionEnabled	= arguments->isSinglePrecisionEnabled,
+			.lookupTableNumberOfIntervals	= arguments->isLookupTableEnabled ? arguments->lookupTableNumberOfIntervals : 0,
+			.isHistogramEnabled		= arguments->isHistogramEnabled,
+		};
+
+	return;
+}
+
+/**
+ *	@brief  Compares two partial-state files by their shard index, for `qsort()`.
+ *
+ *	@param  a	: Pointer to the first file.
+ *	@param  b	: Pointer to the second file.
+ *	@return int	: Negative, zero, or positive, if the shard of the first file comes before, is, or comes after that of the second.
+ */
+static int
+compareShardPartialStateFiles(const void *  a, const void *  b)
+{
+	uint64_t	x = ((const ShardPartialStateFile *) a)->header.shardIndex;
+	uint64_t	y = ((const ShardPartialStateFile *) b)->header.shardIndex;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ *	@brief  Checks whether two partial-state files come from shards of the same run.
+ *
+ *	@param  header	: Pointer to the header of the first file.
+ *	@param  other	: Pointer to the header of the second file.
+ *	@return bool	: `true` if the settings of their runs are the same, else `false`.
+ */
+static bool
+isSameShardedRun(const ShardPartialStateHeader *  header, const ShardPartialStateHeader *  other)
+{
+	return (header->numberOfShards == other->numberOfShards) &&
+		(header->numberOfMonteCarloIterations == other->numberOfMonteCarloIterations) &&
+		(header->seed == other->seed) &&
+		(header->randomNumberGeneratorType == other->randomNumberGeneratorType) &&
+		(header->samplingStrategy == other->samplingStrategy) &&
+		(header->outputSelect == other->outputSelect) &&
+		(header->isSinglePrecisionEnabled == other->isSinglePrecisionEnabled) &&
+		(header->lookupTableNumberOfIntervals == other->lookupTableNumberOfIntervals) &&
+		(header->isHistogramEnabled == other->isHistogramEnabled);
+}
+
+CommonConstantReturnType
+runShardMonteCarloIterations(
+	CommandLineArguments *		arguments,
+	const CalibrationLookupTable *	lookupTable,
+	StreamingStatistics *		streamingStatistics,
+	QuantileSketch *		quantileSketches,
+	Histogram *			histograms)
+{
+	MonteCarloOutputSamples	monteCarloOutputSamples = {0};
+	size_t			sampleStart;
+	size_t			sampleEnd;
+
+	getShardIterationRange(arguments, &sampleStart, &sampleEnd);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		initializeStreamingStatistics(&streamingStatistics[variant]);
+		initializeQuantileSketch(&quantileSketches[variant]);
+	}
+
+	/*
+	 *	The shards only keep the statistics of their outputs, so the output
+	 *	samples are not stored.
+	 */
+	return runNativeMonteCarloIterationRange(
+			arguments,
+			lookupTable,
+			&monteCarloOutputSamples,
+			streamingStatistics,
+			quantileSketches,
+			histograms,
+			sampleStart,
+			sampleEnd,
+			(uint64_t) arguments->shardIndex * kMonteCarloMaximumNumberOfThreads);
+}
+
+void
+getShardIterationRange(CommandLineArguments *  arguments, size_t *  sampleStart, size_t *  sampleEnd)
+{
+	size_t	numberOfIterations = arguments->common.numberOfMonteCarloIterations;
+
+	*sampleStart = numberOfIterations * arguments->shardIndex / arguments->numberOfShards;
+	*sampleEnd = numberOfIterations * (arguments->shardIndex + 1) / arguments->numberOfShards;
+
+	return;
+}
+
+CommonConstantReturnType
+writeShardPartialState(
+	FILE *				file,
+	CommandLineArguments *		arguments,
+	const StreamingStatistics *	streamingStatistics,
+	const QuantileSketch *		quantileSketches,
+	const Histogram *		histograms)
+{
+	ShardPartialStateHeader	header;
+	OutputDistributionIndex	outputSelectLowerBound;
+	OutputDistributionIndex	outputSelectUpperBound;
+	bool			isWritten;
+
+	getShardPartialStateHeader(arguments, &header);
+	getSelectedOutputBounds(arguments, &outputSelectLowerBound, &outputSelectUpperBound);
+	isWritten = writeShardPartialStateHeader(file, &header);
+
+	for (OutputDistributionIndex variant = outputSelectLowerBound; isWritten && (variant < outputSelectUpperBound); variant++)
+	{
+		isWritten = writeShardPartialStateOutput(
+				file,
+				&streamingStatistics[variant],
+				&quantileSketches[variant],
+				arguments->isHistogramEnabled ? &histograms[variant] : NULL);
+	}
+
+	return isWritten ? kCommonConstantReturnTypeSuccess : kCommonConstantReturnTypeError;
+}
+
+CommonConstantReturnType
+readShardPartialState(
+	FILE *				file,
+	CommandLineArguments *		arguments,
+	StreamingStatistics *		streamingStatistics,
+	QuantileSketch *		quantileSketches,
+	Histogram *			histograms)
+{
+	ShardPartialStateHeader	header;
+	ShardPartialStateHeader	fileHeader;
+	OutputDistributionIndex	outputSelectLowerBound;
+	OutputDistributionIndex	outputSelectUpperBound;
+	bool			isRead;
+
+	getShardPartialStateHeader(arguments, &header);
+	getSelectedOutputBounds(arguments, &outputSelectLowerBound, &outputSelectUpperBound);
+	isRead = readShardPartialStateHeader(file, &fileHeader) &&
+			isSameShardedRun(&header, &fileHeader) &&
+			(header.shardIndex == fileHeader.shardIndex);
+
+	for (OutputDistributionIndex variant = outputSelectLowerBound; isRead && (variant < outputSelectUpperBound); variant++)
+	{
+		isRead = readShardPartialStateOutput(
+				file,
+				&streamingStatistics[variant],
+				&quantileSketches[variant],
+				arguments->isHistogramEnabled ? &histograms[variant] : NULL);
+	}
+
+	return isRead ? kCommonConstantReturnTypeSuccess : kCommonConstantReturnTypeError;
+}
+
+CommonConstantReturnType
+writeShardPartialStateFile(
+	CommandLineArguments *		arguments,
+	const StreamingStatistics *	streamingStatistics,
+	const QuantileSketch *		quantileSketches,
+	const Histogram *		histograms,
+	char *				filePath)
+{
+	bool	isWritten;
+	FILE *	file;
+
+	snprintf(filePath, kCommonConstantMaxCharsPerFilepath, kShardPartialStateFilePathFormat, arguments->shardIndex, arguments->numberOfShards);
+
+	file = fopen(filePath, "wb");
+
+	if (file == NULL)
+	{
+		fprintf(stderr, "Error: Could not open \"%s\" for writing.\n", filePath);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	isWritten = (writeShardPartialState(file, arguments, streamingStatistics, quantileSketches, histograms) == kCommonConstantReturnTypeSuccess);
+
+	if ((fclose(file) != 0) || !isWritten)
+	{
+		fprintf(stderr, "Error: Could not write \"%s\".\n", filePath);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+CommonConstantReturnType
+mergeShardPartialStateFiles(
+	CommandLineArguments *		arguments,
+	StreamingStatistics *		streamingStatistics,
+	QuantileSketch *		quantileSketches,
+	Histogram *			histograms)
+{
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+	char *				filePaths = (char *) checkedMalloc(strlen(arguments->mergeFilePaths) + 1, __FILE__, __LINE__);
+	size_t				numberOfFiles = 1;
+	ShardPartialStateFile *		files;
+	QuantileSketch *		fileQuantileSketch = (QuantileSketch *) checkedMalloc(sizeof(QuantileSketch), __FILE__, __LINE__);
+	OutputDistributionIndex		outputSelectLowerBound;
+	OutputDistributionIndex		outputSelectUpperBound;
+
+	/*
+	 *	Split the comma-separated list of files in place.
+	 */
+	strcpy(filePaths, arguments->mergeFilePaths);
+
+	for (char *  character = filePaths; *character != '\0'; character++)
+	{
+		numberOfFiles += (*character == ',');
+	}
+
+	files = (ShardPartialStateFile *) checkedMalloc(numberOfFiles * sizeof(ShardPartialStateFile), __FILE__, __LINE__);
+	files[0].filePath = filePaths;
+
+	for (size_t i = 1, character = 0; i < numberOfFiles; character++)
+	{
+		if (filePaths[character] == ',')
+		{
+			filePaths[character] = '\0';
+			files[i++].filePath = &filePaths[character + 1];
+		}
+	}
+
+	/*
+	 *	Read the headers first, to check that the files come from distinct
+	 *	shards of the same run, and to merge them in the order of their
+	 *	shards, whatever the order of the list.
+	 */
+	for (size_t i = 0; (i < numberOfFiles) && (result == kCommonConstantReturnTypeSuccess); i++)
+	{
+		FILE *	file = fopen(files[i].filePath, "rb");
+
+		if ((file == NULL) || !readShardPartialStateHeader(file, &files[i].header))
+		{
+			fprintf(stderr, "Error: \"%s\" is not a readable partial-state file of a shard.\n", files[i].filePath);
+			result = kCommonConstantReturnTypeError;
+		}
+		else if (!isSameShardedRun(&files[0].header, &files[i].header))
+		{
+			fprintf(stderr, "Error: \"%s\" and \"%s\" come from different runs.\n", files[0].filePath, files[i].filePath);
+			result = kCommonConstantReturnTypeError;
+		}
+
+		if (file != NULL)
+		{
+			fclose(file);
+		}
+	}
+
+	if (result == kCommonConstantReturnTypeSuccess)
+	{
+		qsort(files, numberOfFiles, sizeof(ShardPartialStateFile), compareShardPartialStateFiles);
+
+		for (size_t i = 1; i < numberOfFiles; i++)
+		{
+			if (files[i].header.shardIndex == files[i - 1].header.shardIndex)
+			{
+				fprintf(stderr, "Error: \"%s\" and \"%s\" are the same shard.\n", files[i - 1].filePath, files[i].filePath);
+				result = kCommonConstantReturnTypeError;
+			}
+		}
+	}
+
+	if ((result == kCommonConstantReturnTypeSuccess) &&
+		arguments->common.isOutputSelected &&
+		(arguments->common.outputSelect != files[0].header.outputSelect))
+	{
+		fprintf(stderr, "Error: The partial-state files have output %" PRIu32 " selected (-S option).\n", files[0].header.outputSelect);
+		result = kCommonConstantReturnTypeError;
+	}
+
+	if (result == kCommonConstantReturnTypeSuccess)
+	{
+		/*
+		 *	Report the merged statistics as those of the run of the shards.
+		 */
+		arguments->common.outputSelect = files[0].header.outputSelect;
+		arguments->common.numberOfMonteCarloIterations = files[0].header.numberOfMonteCarloIterations;
+		arguments->seed = files[0].header.seed;
+		arguments->randomNumberGeneratorType = files[0].header.randomNumberGeneratorType;
+		arguments->isHistogramEnabled = files[0].header.isHistogramEnabled;
+		getSelectedOutputBounds(arguments, &outputSelectLowerBound, &outputSelectUpperBound);
+
+		for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+		{
+			initializeStreamingStatistics(&streamingStatistics[variant]);
+			initializeQuantileSketch(&quantileSketches[variant]);
+		}
+	}
+
+	for (size_t i = 0; (i < numberOfFiles) && (result == kCommonConstantReturnTypeSuccess); i++)
+	{
+		ShardPartialStateHeader	header;
+		FILE *			file = fopen(files[i].filePath, "rb");
+		bool			isRead = (file != NULL) && readShardPartialStateHeader(file, &header);
+
+		for (OutputDistributionIndex variant = outputSelectLowerBound; isRead && (variant < outputSelectUpperBound); variant++)
+		{
+			StreamingStatistics	fileStreamingStatistics;
+			Histogram		fileHistogram = {0};
+
+			isRead = readShardPartialStateOutput(
+					file,
+					&fileStreamingStatistics,
+					fileQuantileSketch,
+					arguments->isHistogramEnabled ? &fileHistogram : NULL);
+
+			/*
+			 *	The histograms of the shards of a run have the same bins.
+			 */
+			if (isRead && arguments->isHistogramEnabled)
+			{
+				if (histograms[variant].counts == NULL)
+				{
+					initializeHistogram(&histograms[variant], fileHistogram.low, fileHistogram.high, fileHistogram.numberOfBins);
+				}
+
+				isRead = (fileHistogram.low == histograms[variant].low) &&
+						(fileHistogram.high == histograms[variant].high) &&
+						(fileHistogram.numberOfBins == histograms[variant].numberOfBins);
+			}
+
+			if (isRead)
+			{
+				mergeStreamingStatistics(&streamingStatistics[variant], &fileStreamingStatistics);
+				mergeQuantileSketch(&quantileSketches[variant], fileQuantileSketch);
+
+				if (arguments->isHistogramEnabled)
+				{
+					mergeHistogram(&histograms[variant], &fileHistogram);
+				}
+			}
+
+			freeHistogram(&fileHistogram);
+		}
+
+		if (!isRead)
+		{
+			fprintf(stderr, "Error: Could not read the partial state of \"%s\".\n", files[i].filePath);
+			result = kCommonConstantReturnTypeError;
+		}
+
+		if (file != NULL)
+		{
+			fclose(file);
+		}
+	}
+
+	/*
+	 *	Without all shards, the merged statistics are those of fewer iterations.
+	 */
+	if ((result == kCommonConstantReturnTypeSuccess) && (numberOfFiles < files[0].header.numberOfShards))
+	{
+		arguments->common.numberOfMonteCarloIterations = streamingStatistics[outputSelectLowerBound].numberOfSamples;
+		fprintf(stderr, "Warning: Merged %zu of the %" PRIu64 " shards of the run.\n", numberOfFiles, files[0].header.numberOfShards);
+	}
+
+	free(filePaths);
+	free(files);
+	free(fileQuantileSketch);
+
+	return result;
+}
+
+bool
+isSameShardOutputState(
+	const StreamingStatistics *	streamingStatistics,
+	const StreamingStatistics *	otherStreamingStatistics,
+	const QuantileSketch *		quantileSketch,
+	const QuantileSketch *		otherQuantileSketch,
+	const Histogram *		histogram,
+	const Histogram *		otherHistogram)
+{
+	bool	isSame = (memcmp(streamingStatistics, otherStreamingStatistics, sizeof(StreamingStatistics)) == 0);
+
+	if (isSame && (quantileSketch != NULL))
+	{
+		isSame = (quantileSketch->numberOfSamples == otherQuantileSketch->numberOfSamples) &&
+				(memcmp(&quantileSketch->minimum, &otherQuantileSketch->minimum, sizeof(double)) == 0) &&
+				(memcmp(&quantileSketch->maximum, &otherQuantileSketch->maximum, sizeof(double)) == 0) &&
+				(quantileSketch->numberOfCentroids == otherQuantileSketch->numberOfCentroids) &&
+				(quantileSketch->numberOfBufferedSamples == otherQuantileSketch->numberOfBufferedSamples) &&
+				(memcmp(
+					quantileSketch->centroids,
+					otherQuantileSketch->centroids,
+					quantileSketch->numberOfCentroids * sizeof(QuantileSketchCentroid)) == 0) &&
+				(memcmp(
+					quantileSketch->bufferedSamples,
+					otherQuantileSketch->bufferedSamples,
+					quantileSketch->numberOfBufferedSamples * sizeof(double)) == 0);
+	}
+
+	if (isSame && (histogram != NULL))
+	{
+		isSame = (histogram->low == otherHistogram->low) &&
+				(histogram->high == otherHistogram->high) &&
+				(histogram->numberOfBins == otherHistogram->numberOfBins) &&
+				(histogram->underflowCount == otherHistogram->underflowCount) &&
+				(histogram->overflowCount == otherHistogram->overflowCount) &&
+				(memcmp(histogram->counts, otherHistogram->counts, histogram->numberOfBins * sizeof(uint64_t)) == 0);
+	}
+
+	return isSame;
+}
+
+/**
+ *	@brief  Merges a comma-separated list of partial-state files, as the -m option does, into
+ *		histograms that it then frees, for the self-test.
+ *
+ *	@param  arguments			: Pointer to the command-line arguments of the shards, which the function does not change.
+ *	@param  mergeFilePaths			: The comma-separated list of files.
+ *	@param  streamingStatistics		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` statistics, where the
+ *						  function writes the merged statistics.
+ *	@param  quantileSketches		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` quantile sketches, where
+ *						  the function writes the merged sketches.
+ *	@param  histograms			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` histograms, not initialized,
+ *						  where the function writes the merged histograms, or `NULL` to free them.
+ *	@return					: The result of `mergeShardPartialStateFiles()`.
+ */
+static CommonConstantReturnType
+mergeShardPartialStateFileList(
+	const CommandLineArguments *	arguments,
+	const char *			mergeFilePaths,
+	StreamingStatistics *		streamingStatistics,
+	QuantileSketch *		quantileSketches,
+	Histogram *			histograms)
+{
+	CommandLineArguments		mergeArguments = *arguments;
+	Histogram			mergedHistograms[kOutputDistributionIndexCalibratedSensorOutputMax] = {0};
+	CommonConstantReturnType	result;
+
+	mergeArguments.isShardSelected = false;
+	mergeArguments.isMergeEnabled = true;
+	mergeArguments.mergeFilePaths = mergeFilePaths;
+	result = mergeShardPartialStateFiles(&mergeArguments, streamingStatistics, quantileSketches, mergedHistograms);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		if (histograms != NULL)
+		{
+			histograms[variant] = mergedHistograms[variant];
+		}
+		else
+		{
+			freeHistogram(&mergedHistograms[variant]);
+		}
+	}
+
+	return result;
+}
+
+CommonConstantReturnType
+runShardSelfTest(void)
+{
+	const size_t			numberOfShards = kShardSelfTestNumberOfShards;
+	char				filePaths[kShardSelfTestNumberOfShards + 2][kCommonConstantMaxCharsPerFilepath];
+	char				mergeFilePaths[(kShardSelfTestNumberOfShards + 2) * (kCommonConstantMaxCharsPerFilepath + 1)];
+	const char *			foreignFilePath = filePaths[numberOfShards];
+	const char *			truncatedFilePath = filePaths[numberOfShards + 1];
+	QuantileSketch *		quantileSketches = (QuantileSketch *) checkedMalloc(
+								3 * kOutputDistributionIndexCalibratedSensorOutputMax * sizeof(QuantileSketch),
+								__FILE__,
+								__LINE__);
+	QuantileSketch *		referenceQuantileSketches = &quantileSketches[kOutputDistributionIndexCalibratedSensorOutputMax];
+	QuantileSketch *		readQuantileSketches = &quantileSketches[2 * kOutputDistributionIndexCalibratedSensorOutputMax];
+	StreamingStatistics		streamingStatistics[kOutputDistributionIndexCalibratedSensorOutputMax];
+	StreamingStatistics		referenceStreamingStatistics[kOutputDistributionIndexCalibratedSensorOutputMax];
+	StreamingStatistics		readStreamingStatistics[kOutputDistributionIndexCalibratedSensorOutputMax];
+	Histogram			histograms[kOutputDistributionIndexCalibratedSensorOutputMax];
+	Histogram			referenceHistograms[kOutputDistributionIndexCalibratedSensorOutputMax];
+	Histogram			readHistograms[kOutputDistributionIndexCalibratedSensorOutputMax];
+	MonteCarloOutputSamples		monteCarloOutputSamples = {0};
+	CommandLineArguments		arguments = {0};
+	bool				isRoundTripPassed = true;
+	bool				isMergePassed;
+	bool				isDuplicateRejected;
+	bool				isForeignSeedRejected;
+	bool				isTruncatedRejected;
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	printf(
+		"Shard self-test (%zu shards of %zu Philox iterations, merged in shuffled order):\n",
+		numberOfShards,
+		(size_t) kShardSelfTestNumberOfSamples);
+
+	arguments.common.outputSelect = kOutputDistributionIndexCalibratedSensorOutputMax;
+	arguments.common.numberOfMonteCarloIterations = kShardSelfTestNumberOfSamples;
+	arguments.seed = kDefaultMonteCarloSeed;
+	arguments.randomNumberGeneratorType = kRandomNumberGeneratorTypePhilox;
+	arguments.samplingStrategy = kSamplingStrategyIndependent;
+	arguments.isStreamingStatisticsEnabled = true;
+	arguments.isQuantileSketchEnabled = true;
+	arguments.isHistogramEnabled = true;
+	arguments.histogramNumberOfBins = kShardSelfTestNumberOfBins;
+	arguments.numberOfShards = numberOfShards;
+
+	for (size_t i = 0; i < numberOfShards + 2; i++)
+	{
+		snprintf(filePaths[i], kCommonConstantMaxCharsPerFilepath, kShardSelfTestFilePathFormat, i);
+	}
+
+	/*
+	 *	The reference is the run without shards, with one thread per shard:
+	 *	its threads fold the iterations of the shards, and merge them in the
+	 *	same order as the merge of the files, so the results are bitwise
+	 *	the same.
+	 */
+	arguments.numberOfThreads = numberOfShards;
+	initializeOutputHistograms(&arguments, referenceHistograms);
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		initializeStreamingStatistics(&referenceStreamingStatistics[variant]);
+		initializeQuantileSketch(&referenceQuantileSketches[variant]);
+	}
+
+	if (runNativeMonteCarloIterationRange(
+		&arguments,
+		NULL,
+		&monteCarloOutputSamples,
+		referenceStreamingStatistics,
+		referenceQuantileSketches,
+		referenceHistograms,
+		0,
+		kShardSelfTestNumberOfSamples,
+		0) != kCommonConstantReturnTypeSuccess)
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	/*
+	 *	Run the shards, write their partial states, and check that the
+	 *	partial state of each reads back exactly.
+	 */
+	arguments.isShardSelected = true;
+	arguments.numberOfThreads = 1;
+
+	for (size_t shard = 0; (shard < numberOfShards) && (result == kCommonConstantReturnTypeSuccess); shard++)
+	{
+		FILE *	file = fopen(filePaths[shard], "w+b");
+
+		arguments.shardIndex = shard;
+		initializeOutputHistograms(&arguments, histograms);
+
+		if ((file == NULL) ||
+			(runShardMonteCarloIterations(&arguments, NULL, streamingStatistics, quantileSketches, histograms) != kCommonConstantReturnTypeSuccess) ||
+			(writeShardPartialState(file, &arguments, streamingStatistics, quantileSketches, histograms) != kCommonConstantReturnTypeSuccess))
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+		else
+		{
+			rewind(file);
+			memset(readHistograms, 0, sizeof(readHistograms));
+			isRoundTripPassed = isRoundTripPassed &&
+						(readShardPartialState(file, &arguments, readStreamingStatistics, readQuantileSketches, readHistograms) == kCommonConstantReturnTypeSuccess);
+
+			for (OutputDistributionIndex variant = 0; isRoundTripPassed && (variant < kOutputDistributionIndexCalibratedSensorOutputMax); variant++)
+			{
+				isRoundTripPassed = isSameShardOutputState(
+							&streamingStatistics[variant],
+							&readStreamingStatistics[variant],
+							&quantileSketches[variant],
+							&readQuantileSketches[variant],
+							&histograms[variant],
+							&readHistograms[variant]);
+			}
+
+			for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+			{
+				freeHistogram(&readHistograms[variant]);
+			}
+		}
+
+		/*
+		 *	A copy of the first shard with another seed, and a copy of the
+		 *	second shard without its last counter.
+		 */
+		if ((result == kCommonConstantReturnTypeSuccess) && (shard <= 1))
+		{
+			FILE *	copyFile = fopen((shard == 0) ? foreignFilePath : truncatedFilePath, "wb");
+
+			if (copyFile == NULL)
+			{
+				result = kCommonConstantReturnTypeError;
+			}
+			else if (shard == 0)
+			{
+				arguments.seed++;
+				if (writeShardPartialState(copyFile, &arguments, streamingStatistics, quantileSketches, histograms) != kCommonConstantReturnTypeSuccess)
+				{
+					result = kCommonConstantReturnTypeError;
+				}
+				arguments.seed--;
+			}
+			else
+			{
+				long	fileSize;
+
+				fseek(file, 0, SEEK_END);
+				fileSize = ftell(file) - (long) sizeof(uint64_t);
+				rewind(file);
+
+				for (long i = 0; i < fileSize; i++)
+				{
+					fputc(fgetc(file), copyFile);
+				}
+			}
+
+			if ((copyFile != NULL) && (fclose(copyFile) != 0))
+			{
+				result = kCommonConstantReturnTypeError;
+			}
+		}
+
+		if ((file != NULL) && (fclose(file) != 0))
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+
+		for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+		{
+			freeHistogram(&histograms[variant]);
+		}
+	}
+
+	if (result != kCommonConstantReturnTypeSuccess)
+	{
+		printf("\tCould not run the shards or write their partial-state files: FAIL\n");
+	}
+	else
+	{
+		/*
+		 *	Merge the shards in the shuffled order (2 s + 1) mod n, which
+		 *	the merge sorts by shard.
+		 */
+		mergeFilePaths[0] = '\0';
+
+		for (size_t i = 0; i < numberOfShards; i++)
+		{
+			strcat(mergeFilePaths, filePaths[(2 * i + 1) % numberOfShards]);
+			strcat(mergeFilePaths, (i + 1 < numberOfShards) ? "," : "");
+		}
+
+		isMergePassed = (mergeShardPartialStateFileList(&arguments, mergeFilePaths, streamingStatistics, quantileSketches, histograms) == kCommonConstantReturnTypeSuccess);
+
+		for (OutputDistributionIndex variant = 0; isMergePassed && (variant < kOutputDistributionIndexCalibratedSensorOutputMax); variant++)
+		{
+			isMergePassed = isSameShardOutputState(
+						&streamingStatistics[variant],
+						&referenceStreamingStatistics[variant],
+						NULL,
+						NULL,
+						&histograms[variant],
+						&referenceHistograms[variant]);
+		}
+
+		for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+		{
+			freeHistogram(&histograms[variant]);
+		}
+
+		/*
+		 *	The merge prints the error of each of the files that it must reject.
+		 */
+		snprintf(mergeFilePaths, sizeof(mergeFilePaths), "%s,%s,%s", filePaths[0], filePaths[1], filePaths[1]);
+		isDuplicateRejected = (mergeShardPartialStateFileList(&arguments, mergeFilePaths, streamingStatistics, quantileSketches, NULL) != kCommonConstantReturnTypeSuccess);
+		snprintf(mergeFilePaths, sizeof(mergeFilePaths), "%s,%s", foreignFilePath, filePaths[1]);
+		isForeignSeedRejected = (mergeShardPartialStateFileList(&arguments, mergeFilePaths, streamingStatistics, quantileSketches, NULL) != kCommonConstantReturnTypeSuccess);
+		snprintf(mergeFilePaths, sizeof(mergeFilePaths), "%s,%s", filePaths[0], truncatedFilePath);
+		isTruncatedRejected = (mergeShardPartialStateFileList(&arguments, mergeFilePaths, streamingStatistics, quantileSketches, NULL) != kCommonConstantReturnTypeSuccess);
+
+		printf("\tPartial states read back exactly: %s\n", isRoundTripPassed ? "PASS" : "FAIL");
+		printf(
+			"\tMerged count, mean, variance, minimum, maximum, and histograms bitwise the same as without shards: %s\n",
+			isMergePassed ? "PASS" : "FAIL");
+		printf("\tDuplicate shard rejected: %s\n", isDuplicateRejected ? "PASS" : "FAIL");
+		printf("\tShard of another seed rejected: %s\n", isForeignSeedRejected ? "PASS" : "FAIL");
+		printf("\tTruncated file rejected: %s\n", isTruncatedRejected ? "PASS" : "FAIL");
+
+		if (!(isRoundTripPassed && isMergePassed && isDuplicateRejected && isForeignSeedRejected && isTruncatedRejected))
+		{
+			result = kCommonConstantReturnTypeError;
+		}
+	}
+
+	for (size_t i = 0; i < numberOfShards + 2; i++)
+	{
+		remove(filePaths[i]);
+	}
+
+	for (OutputDistributionIndex variant = 0; variant < kOutputDistributionIndexCalibratedSensorOutputMax; variant++)
+	{
+		freeHistogram(&referenceHistograms[variant]);
+	}
+
+	free(quantileSketches);
+
+	return result;
+}
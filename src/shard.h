@@ -0,0 +1,191 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "utilities.h"
+#include "calibration-lookup-table.h"
+#include "streaming-statistics.h"
+#include "quantile-sketch.h"
+#include "histogram.h"
+
+/**
+ *	@brief  Runs the iterations of the shard of `arguments->shardIndex` of `arguments->numberOfShards`
+ *		of the native Monte Carlo iterations, and folds their outputs into the statistics, sketches,
+ *		and histograms of the shard. With Philox, the sampling strategies, and the quasi-random
+ *		sequences, the samples of the shards together are the samples of the run without shards.
+ *		With xoshiro256**, each shard draws from its own streams of the seed, which start at
+ *		distinct, effectively random, points of the 2^256 - 1 period, and in practice do not overlap.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  lookupTable			: Pointer to the lookup tables of the selected variants, or `NULL`.
+ *	@param  streamingStatistics		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` statistics, which the
+ *						  function initializes and folds the output samples into.
+ *	@param  quantileSketches		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` quantile sketches, which the
+ *						  function initializes and adds the output samples to.
+ *	@param  histograms			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` initialized histograms,
+ *						  where the function counts the output samples, or `NULL`.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runShardMonteCarloIterations(
+					CommandLineArguments *		arguments,
+					const CalibrationLookupTable *	lookupTable,
+					StreamingStatistics *		streamingStatistics,
+					QuantileSketch *		quantileSketches,
+					Histogram *			histograms);
+
+/**
+ *	@brief  Gets the range of the iterations of the shard of `arguments->shardIndex` of `arguments->numberOfShards`,
+ *		of the `arguments->common.numberOfMonteCarloIterations` iterations of the run.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  sampleStart			: Pointer to where the function writes the index of the first iteration of the shard.
+ *	@param  sampleEnd			: Pointer to where the function writes one past the index of the last iteration.
+ */
+void				getShardIterationRange(
+					CommandLineArguments *		arguments,
+					size_t *			sampleStart,
+					size_t *			sampleEnd);
+
+/**
+ *	@brief  Writes the partial state of the shard of `arguments` (the settings of the run, and the
+ *		statistics, quantile sketches, and histograms of the selected outputs) to an open file.
+ *
+ *	@param  file				: The file to write to.
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  streamingStatistics		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` statistics.
+ *	@param  quantileSketches		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` quantile sketches.
+ *	@param  histograms			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` histograms,
+ *						  written if `arguments->isHistogramEnabled`.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	writeShardPartialState(
+					FILE *				file,
+					CommandLineArguments *		arguments,
+					const StreamingStatistics *	streamingStatistics,
+					const QuantileSketch *		quantileSketches,
+					const Histogram *		histograms);
+
+/**
+ *	@brief  Reads the partial state that `writeShardPartialState()` wrote for the same shard of the same
+ *		run as `arguments`, exactly as it was written.
+ *
+ *	@param  file				: The file to read from.
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  streamingStatistics		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` statistics, where the
+ *						  function reads the statistics of the selected outputs.
+ *	@param  quantileSketches		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` quantile sketches, where
+ *						  the function reads the sketches of the selected outputs.
+ *	@param  histograms			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` histograms, initialized with
+ *						  the bins of the file, where the function reads the counts, if `arguments->isHistogramEnabled`.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful, else
+ *						  `kCommonConstantReturnTypeError`, e.g., if the file is of another shard or run.
+ */
+CommonConstantReturnType	readShardPartialState(
+					FILE *				file,
+					CommandLineArguments *		arguments,
+					StreamingStatistics *		streamingStatistics,
+					QuantileSketch *		quantileSketches,
+					Histogram *			histograms);
+
+/**
+ *	@brief  Writes the partial state of a shard (the settings of the run, and the statistics, quantile
+ *		sketches, and histograms of the selected outputs) to its partial-state file, whose path
+ *		follows `kShardPartialStateFilePathFormat`.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  streamingStatistics		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` statistics of the shard.
+ *	@param  quantileSketches		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` quantile sketches of the shard.
+ *	@param  histograms			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` histograms of the shard,
+ *						  written if `arguments->isHistogramEnabled`.
+ *	@param  filePath			: Array of `kCommonConstantMaxCharsPerFilepath` characters, where the function writes
+ *						  the path of the file.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	writeShardPartialStateFile(
+					CommandLineArguments *		arguments,
+					const StreamingStatistics *	streamingStatistics,
+					const QuantileSketch *		quantileSketches,
+					const Histogram *		histograms,
+					char *				filePath);
+
+/**
+ *	@brief  Merges the partial-state files of `arguments->mergeFilePaths`, a comma-separated list, in the
+ *		order of their shards. The files must come from shards of the same run, i.e., with the
+ *		same number of shards, iterations, seed, generator, sampling strategy, selected output,
+ *		precision, lookup tables, and histogram bins. Sets the selected output, number of iterations,
+ *		seed, generator, and histograms of `arguments` to those of the run, so that the merged
+ *		statistics are reported like those of a run with streaming statistics.
+ *
+ *	@param  arguments			: Pointer to command-line arguments struct.
+ *	@param  streamingStatistics		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` statistics, where the
+ *						  function writes the merged statistics.
+ *	@param  quantileSketches		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` quantile sketches, where
+ *						  the function writes the merged sketches.
+ *	@param  histograms			: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` histograms, whose entries of
+ *						  the selected outputs the function initializes to the merged histograms, if the files
+ *						  contain histograms.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	mergeShardPartialStateFiles(
+					CommandLineArguments *		arguments,
+					StreamingStatistics *		streamingStatistics,
+					QuantileSketch *		quantileSketches,
+					Histogram *			histograms);
+
+/**
+ *	@brief  Checks whether the state of an output (statistics, and optionally quantile sketch and
+ *		histogram) is bitwise the same as another.
+ *
+ *	@param  streamingStatistics		: Pointer to the statistics.
+ *	@param  otherStreamingStatistics	: Pointer to the other statistics.
+ *	@param  quantileSketch			: Pointer to the quantile sketch, or `NULL` to skip the sketches.
+ *	@param  otherQuantileSketch		: Pointer to the other quantile sketch, or `NULL`.
+ *	@param  histogram			: Pointer to the histogram, or `NULL` to skip the histograms.
+ *	@param  otherHistogram			: Pointer to the other histogram, or `NULL`.
+ *	@return					: `true` if the states are the same, else `false`.
+ */
+bool				isSameShardOutputState(
+					const StreamingStatistics *	streamingStatistics,
+					const StreamingStatistics *	otherStreamingStatistics,
+					const QuantileSketch *		quantileSketch,
+					const QuantileSketch *		otherQuantileSketch,
+					const Histogram *		histogram,
+					const Histogram *		otherHistogram);
+
+/**
+ *	@brief  Checks that the partial states of the shards of a Philox run read back exactly, that
+ *		merging them in shuffled order gives bitwise the statistics and histograms of the run
+ *		without shards, and that the merge rejects a duplicate shard, a shard of another seed,
+ *		and a truncated file. Writes the files to the working directory, and removes them.
+ *
+ *	@return		: `kCommonConstantReturnTypeSuccess` if all checks pass,
+ *			   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runShardSelfTest(void);
@@ -0,0 +1,298 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include "streaming-statistics.h"
+#include "utilities-config.h"
+
+/*
+ *	Generates the function that folds a block of samples of a floating-point
+ *	type into streaming statistics.
+ */
+#define DEFINE_ADD_SAMPLES_TO_STREAMING_STATISTICS(functionName, sampleType)				\
+	void												\
+	functionName(StreamingStatistics *  statistics, const sampleType *  samples, size_t numberOfSamples)	\
+	{												\
+		StreamingStatistics	block;								\
+		double			sum = 0.0;							\
+														\
+		if (numberOfSamples == 0)								\
+		{											\
+			return;										\
+		}											\
+														\
+		block.numberOfSamples = numberOfSamples;						\
+		block.minimum = INFINITY;								\
+		block.maximum = -INFINITY;								\
+		block.sumOfSquaredDeviations = 0.0;							\
+														\
+		for (size_t i = 0; i < numberOfSamples; i++)						\
+		{											\
+			sum += samples[i];								\
+			block.minimum = (samples[i] < block.minimum) ? samples[i] : block.minimum;	\
+			block.maximum = (samples[i] > block.maximum) ? samples[i] : block.maximum;	\
+		}											\
+														\
+		block.mean = sum / numberOfSamples;							\
+														\
+		for (size_t i = 0; i < numberOfSamples; i++)						\
+		{											\
+			double	deviation = samples[i] - block.mean;					\
+														\
+			block.sumOfSquaredDeviations += deviation * deviation;				\
+		}											\
+														\
+		mergeStreamingStatistics(statistics, &block);						\
+														\
+		return;											\
+	}
+
+DEFINE_ADD_SAMPLES_TO_STREAMING_STATISTICS(addDoubleSamplesToStreamingStatistics, double)
+DEFINE_ADD_SAMPLES_TO_STREAMING_STATISTICS(addFloatSamplesToStreamingStatistics, float)
+
+/**
+ *	@brief  Checks streaming statistics against the two-pass mean and variance, and the exact
+ *		number of samples, minimum, and maximum, of the same samples, and prints the
+ *		relative errors of the mean and variance.
+ *
+ *	@param  statistics		: Pointer to the statistics to check.
+ *	@param  reference		: The two-pass mean and variance.
+ *	@param  numberOfSamples		: The number of samples.
+ *	@param  minimum			: The minimum of the samples.
+ *	@param  maximum			: The maximum of the samples.
+ *	@param  description		: The description of the case.
+ *	@return bool			: Whether the statistics match.
+ */
+static bool
+checkStreamingStatistics(
+	const StreamingStatistics *	statistics,
+	MeanAndVariance			reference,
+	size_t				numberOfSamples,
+	double				minimum,
+	double				maximum,
+	const char *			description)
+{
+	MeanAndVariance	meanAndVariance = getStreamingStatisticsMeanAndVariance(statistics);
+	double		meanRelativeError = fabs(meanAndVariance.mean - reference.mean) / fabs(reference.mean);
+	double		varianceRelativeError = fabs(meanAndVariance.variance - reference.variance) / fabs(reference.variance);
+	bool		passed;
+
+	passed =	(statistics->numberOfSamples == numberOfSamples) &&
+			(statistics->minimum == minimum) &&
+			(statistics->maximum == maximum) &&
+			(meanRelativeError <= kStreamingStatisticsSelfTestMaximumRelativeError) &&
+			(varianceRelativeError <= kStreamingStatisticsSelfTestMaximumRelativeError);
+	printf(
+		"\t%s: relative error of the mean %.2e, of the variance %.2e: %s\n",
+		description,
+		meanRelativeError,
+		varianceRelativeError,
+		passed ? "PASS" : "FAIL");
+
+	return passed;
+}
+
+
+void
+initializeStreamingStatistics(StreamingStatistics *  statistics)
+{
+	*statistics = (StreamingStatistics)
+			{
+				.numberOfSamples	= 0,
+				.mean			= 0.0,
+				.sumOfSquaredDeviations	= 0.0,
+				.minimum		= INFINITY,
+				.maximum		= -INFINITY,
+			};
+
+	return;
+}
+
+void
+mergeStreamingStatistics(StreamingStatistics *  statistics, const StreamingStatistics *  other)
+{
+	uint64_t	numberOfSamples = statistics->numberOfSamples + other->numberOfSamples;
+	double		delta;
+
+	if (other->numberOfSamples == 0)
+	{
+		return;
+	}
+
+	if (statistics->numberOfSamples == 0)
+	{
+		*statistics = *other;
+
+		return;
+	}
+
+	delta = other->mean - statistics->mean;
+
+	statistics->mean += delta * ((double)other->numberOfSamples / numberOfSamples);
+	statistics->sumOfSquaredDeviations += other->sumOfSquaredDeviations +
+						delta * delta * ((double)statistics->numberOfSamples * other->numberOfSamples / numberOfSamples);
+	statistics->minimum = fmin(statistics->minimum, other->minimum);
+	statistics->maximum = fmax(statistics->maximum, other->maximum);
+	statistics->numberOfSamples = numberOfSamples;
+
+	return;
+}
+
+MeanAndVariance
+getStreamingStatisticsMeanAndVariance(const StreamingStatistics *  statistics)
+{
+	MeanAndVariance	meanAndVariance =
+			{
+				.mean		= statistics->mean,
+				.variance	= 0.0,
+			};
+
+	if (statistics->numberOfSamples > 1)
+	{
+		meanAndVariance.variance = statistics->sumOfSquaredDeviations / (statistics->numberOfSamples - 1);
+	}
+
+	return meanAndVariance;
+}
+
+void
+printStreamingStatistics(FILE *  stream, const StreamingStatistics *  statistics, const char *  variableDescription)
+{
+	MeanAndVariance	meanAndVariance = getStreamingStatisticsMeanAndVariance(statistics);
+
+	fprintf(
+		stream,
+		"\t%s: %" PRIu64 " samples, mean %.6lf Pa, standard deviation %.6lf Pa, minimum %.6lf Pa, maximum %.6lf Pa\n",
+		variableDescription,
+		statistics->numberOfSamples,
+		meanAndVariance.mean,
+		sqrt(meanAndVariance.variance),
+		statistics->minimum,
+		statistics->maximum);
+
+	return;
+}
+
+CommonConstantReturnType
+runStreamingStatisticsSelfTest(void)
+{
+	const size_t			numberOfSamples = kStreamingStatisticsSelfTestNumberOfSamples;
+	const size_t			numberOfSlices = kStreamingStatisticsSelfTestNumberOfSlices;
+	const size_t			blockSizes[] = kStreamingStatisticsSelfTestBlockSizes;
+	const size_t			numberOfBlockSizes = sizeof(blockSizes) / sizeof(blockSizes[0]);
+	double *			samples = (double *) checkedMalloc(numberOfSamples * sizeof(double), __FILE__, __LINE__);
+	StreamingStatistics		slices[kStreamingStatisticsSelfTestNumberOfSlices];
+	StreamingStatistics		statistics;
+	MeanAndVariance			reference;
+	double				minimum = INFINITY;
+	double				maximum = -INFINITY;
+	size_t				sliceStart = 0;
+	bool				passed;
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	printf("Streaming statistics self-test (%zu samples):\n", numberOfSamples);
+
+	/*
+	 *	A large offset makes the one-pass sum of squares lose most of the digits
+	 *	of the variance, so that only a stable update passes.
+	 */
+	for (size_t i = 0; i < numberOfSamples; i++)
+	{
+		samples[i] = 1e6 + (double)((i * 7919) % 1000) / 7.0;
+		minimum = fmin(minimum, samples[i]);
+		maximum = fmax(maximum, samples[i]);
+	}
+
+	reference = calculateMeanAndVarianceOfDoubleSamples(samples, numberOfSamples);
+
+	/*
+	 *	Block-wise: fold blocks of the sizes of the list in turn, including
+	 *	empty and single-sample blocks.
+	 */
+	initializeStreamingStatistics(&statistics);
+	for (size_t i = 0, block = 0; i < numberOfSamples; block++)
+	{
+		size_t	blockSize = blockSizes[block % numberOfBlockSizes];
+
+		blockSize = (blockSize < numberOfSamples - i) ? blockSize : numberOfSamples - i;
+		addDoubleSamplesToStreamingStatistics(&statistics, &samples[i], blockSize);
+		i += blockSize;
+	}
+
+	if (!checkStreamingStatistics(&statistics, reference, numberOfSamples, minimum, maximum, "Block-wise"))
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	/*
+	 *	Thread-wise: fold slices of uneven lengths separately, the first
+	 *	empty and the second of a single sample, and merge them in order into
+	 *	empty statistics. Then merge the empty slice into the result, which
+	 *	must leave it unchanged.
+	 */
+	initializeStreamingStatistics(&statistics);
+	for (size_t slice = 0; slice < numberOfSlices; slice++)
+	{
+		size_t	sliceEnd = (slice < 2) ? slice : 1 + (numberOfSamples - 1) * (slice - 1) * (slice - 1) / ((numberOfSlices - 2) * (numberOfSlices - 2));
+
+		initializeStreamingStatistics(&slices[slice]);
+		addDoubleSamplesToStreamingStatistics(&slices[slice], &samples[sliceStart], sliceEnd - sliceStart);
+		mergeStreamingStatistics(&statistics, &slices[slice]);
+		sliceStart = sliceEnd;
+	}
+	mergeStreamingStatistics(&statistics, &slices[0]);
+
+	if (!checkStreamingStatistics(&statistics, reference, numberOfSamples, minimum, maximum, "Thread-wise"))
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	/*
+	 *	A single sample: its own mean, with a variance of 0.
+	 */
+	initializeStreamingStatistics(&statistics);
+	addDoubleSamplesToStreamingStatistics(&statistics, samples, 0);
+	passed = (statistics.numberOfSamples == 0) && (getStreamingStatisticsMeanAndVariance(&statistics).variance == 0.0);
+	addDoubleSamplesToStreamingStatistics(&statistics, samples, 1);
+	passed =	passed &&
+			(statistics.numberOfSamples == 1) &&
+			(statistics.mean == samples[0]) &&
+			(statistics.minimum == samples[0]) &&
+			(statistics.maximum == samples[0]) &&
+			(getStreamingStatisticsMeanAndVariance(&statistics).variance == 0.0);
+	printf("\tEmpty and single-sample: %s\n", passed ? "PASS" : "FAIL");
+
+	if (!passed)
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	free(samples);
+
+	return result;
+}
@@ -0,0 +1,107 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "common.h"
+
+/*
+ *	Constant-memory statistics of a stream of samples. Samples are folded in
+ *	per block: the mean and sum of squared deviations of each block are
+ *	calculated with two passes over the block, and then merged into the
+ *	running statistics with the pairwise update of Chan et al., which is also
+ *	used to merge the statistics of several streams (e.g., of several threads).
+ */
+typedef struct
+{
+	uint64_t	numberOfSamples;
+	double		mean;
+	double		sumOfSquaredDeviations;
+	double		minimum;
+	double		maximum;
+} StreamingStatistics;
+
+/**
+ *	@brief  Initializes streaming statistics to those of an empty stream.
+ *
+ *	@param  statistics	: Pointer to the statistics to initialize.
+ */
+void	initializeStreamingStatistics(StreamingStatistics *  statistics);
+
+/**
+ *	@brief  Folds a block of double-precision samples into streaming statistics.
+ *
+ *	@param  statistics		: Pointer to the statistics to update.
+ *	@param  samples			: Array of `numberOfSamples` samples.
+ *	@param  numberOfSamples		: The number of samples of the block.
+ */
+void	addDoubleSamplesToStreamingStatistics(StreamingStatistics *  statistics, const double *  samples, size_t numberOfSamples);
+
+/**
+ *	@brief  Folds a block of single-precision samples into streaming statistics. The statistics
+ *		are accumulated in double precision.
+ *
+ *	@param  statistics		: Pointer to the statistics to update.
+ *	@param  samples			: Array of `numberOfSamples` samples.
+ *	@param  numberOfSamples		: The number of samples of the block.
+ */
+void	addFloatSamplesToStreamingStatistics(StreamingStatistics *  statistics, const float *  samples, size_t numberOfSamples);
+
+/**
+ *	@brief  Merges the statistics of another stream into streaming statistics, as if the samples
+ *		of the other stream had been folded in one by one.
+ *
+ *	@param  statistics	: Pointer to the statistics to update.
+ *	@param  other		: Pointer to the statistics of the other stream.
+ */
+void	mergeStreamingStatistics(StreamingStatistics *  statistics, const StreamingStatistics *  other);
+
+/**
+ *	@brief  Returns the mean and the (unbiased) sample variance of streaming statistics.
+ *
+ *	@param  statistics		: Pointer to the statistics.
+ *	@return MeanAndVariance		: The mean and variance, with a variance of 0 for fewer than 2 samples.
+ */
+MeanAndVariance	getStreamingStatisticsMeanAndVariance(const StreamingStatistics *  statistics);
+
+/**
+ *	@brief  Prints the number of samples, mean, standard deviation, minimum, and maximum of
+ *		streaming statistics.
+ *
+ *	@param  stream			: The stream to print to.
+ *	@param  statistics		: Pointer to the statistics.
+ *	@param  variableDescription	: The description of the variable.
+ */
+void	printStreamingStatistics(FILE *  stream, const StreamingStatistics *  statistics, const char *  variableDescription);
+
+/**
+ *	@brief  Checks that streaming statistics folded in blocks of uneven sizes, and merged from
+ *		uneven slices, match the two-pass mean and variance of the same samples, including
+ *		for empty and single-sample blocks.
+ *
+ *	@return		: `kCommonConstantReturnTypeSuccess` if all checks pass,
+ *			   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runStreamingStatisticsSelfTest(void);
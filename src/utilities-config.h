@@ -20,6 +20,8 @@
  *	SOFTWARE.
  */
 
+#pragma once
+
 /*
  *	These constant values are taken from page 4 of
  *	SDP8xx Analog Datasheet, 2024-07-03.
@@ -76,3 +78,377 @@ typedef enum
 #define kDefaultInputDistributionAoutUniformDistHigh			(1.7)
 #define kDefaultInputDistributionVddUniformDistLow			(3.5)
 #define kDefaultInputDistributionVddUniformDistHigh			(3.9)
+
+/*
+ *	Calibration kernel self-test parameters: the self-test sweeps
+ *	`kCalibrationKernelSelfTestNumberOfRatios` values of Aout/Vdd in [0, 1],
+ *	plus the two neighbours of the sign change of the square root
+ *	configurations, for `kCalibrationKernelSelfTestNumberOfSupplyVoltages`
+ *	supply voltages. All kernels are expected to be bit-identical to the
+ *	scalar reference.
+ */
+#define kCalibrationKernelSelfTestNumberOfRatios			(1001)
+#define kCalibrationKernelSelfTestNumberOfSupplyVoltages		(9)
+#define kCalibrationKernelSelfTestNumberOfSamples			(kCalibrationKernelSelfTestNumberOfSupplyVoltages * (kCalibrationKernelSelfTestNumberOfRatios + 2))
+#define kCalibrationKernelMaximumUlpDistance				(0)
+
+/*
+ *	Maximum absolute difference (in Pascal) between the fused all-variants batch
+ *	kernel, which reuses `Aout / Vdd` across variants, and the scalar reference.
+ *	The outputs are at most a few hundred Pascal, so a few ULP of rounding
+ *	difference are well below this bound.
+ */
+#define kCalibrationFusedKernelMaximumAbsoluteError			(1e-9)
+
+/*
+ *	Calibration kernel benchmark parameters.
+ */
+#define kCalibrationKernelBenchmarkDefaultNumberOfSamples		(1 << 20)
+#define kCalibrationKernelBenchmarkNumberOfRuns				(5)
+
+/*
+ *	Number of samples that the native Monte Carlo mode generates and
+ *	calibrates per batch.
+ */
+#define kMonteCarloSampleBlockSize					(1024)
+
+/*
+ *	Multithreaded native Monte Carlo mode: maximum number of threads, and seed
+ *	of the random number generator streams if none is provided.
+ */
+#define kMonteCarloMaximumNumberOfThreads				(1024)
+#define kDefaultMonteCarloSeed						(1)
+
+/*
+ *	When all outputs are calculated in the native Monte Carlo mode, the samples
+ *	of each output are saved in their own file instead of `data.out`. The
+ *	format is applied to the `OutputDistributionIndex` of the output.
+ */
+#define kMonteCarloAllOutputsDataFilePathFormat				"data-%d.out"
+
+/*
+ *	Number of samples below which pairwise summation (used for the
+ *	single-precision Monte Carlo statistics) falls back to a plain loop.
+ */
+#define kPairwiseSummationBaseCaseSize					(128)
+
+/*
+ *	Number of input samples used to compare the single-precision calibration
+ *	against the double-precision calibration, in single precision mode.
+ */
+#define kSinglePrecisionAccuracyCheckNumberOfSamples			(1 << 16)
+
+/*
+ *	ADC code input: the fixed-point calibration kernels take the raw codes of
+ *	the Aout and Vdd channels of an ADC. The ratio `AoutCode / VddCode` has
+ *	`kFixedPointRatioFractionalBits` fractional bits, the calibration constants
+ *	have `kFixedPointCoefficientFractionalBits` fractional bits, and the outputs
+ *	are in Pascal with `kFixedPointOutputFractionalBits` fractional bits (Q16.16).
+ *	The codes must be less than 2^`kAdcMaximumBitDepth`, so that the shifted
+ *	Aout code and all intermediate products fit in 64-bit integers.
+ */
+#define kFixedPointRatioFractionalBits					(24)
+#define kFixedPointCoefficientFractionalBits				(16)
+#define kFixedPointOutputFractionalBits					(16)
+#define kAdcMaximumBitDepth						(24)
+#define kDefaultAdcBitDepth						(12)
+#define kDefaultAdcReferenceVoltage					(4.096)
+
+/*
+ *	Maximum absolute difference (in Pascal) between the fixed-point calibration
+ *	kernels and the double-precision reference, for all pairs of codes of a
+ *	`kDefaultAdcBitDepth`-bit ADC with `kFixedPointSelfTestVddCodeStride` between
+ *	the tested Vdd codes. This is far below the quantization step of the ADC.
+ */
+#define kFixedPointCalibrationMaximumAbsoluteError			(1e-3)
+#define kFixedPointSelfTestVddCodeStride				(16)
+
+/*
+ *	Lookup table calibration: the tables sample the output of each variant at
+ *	`numberOfIntervals + 1` evenly spaced ratios `Aout / Vdd` in [0, 1] and
+ *	interpolate linearly in between. The self-test and benchmark use tables of
+ *	`kCalibrationLookupTableDefaultNumberOfIntervals` intervals, which are expected
+ *	to be within `kCalibrationLookupTableMaximumAbsoluteError` Pascal of the
+ *	analytic formulas. The error is measured at
+ *	`kCalibrationLookupTableErrorCheckNumberOfRatios` evenly spaced ratios, a
+ *	number chosen so that they do not line up with the table entries.
+ */
+#define kCalibrationLookupTableDefaultNumberOfIntervals			(4096)
+#define kCalibrationLookupTableMaximumNumberOfIntervals			(1 << 24)
+#define kCalibrationLookupTableMaximumAbsoluteError			(1e-3)
+#define kCalibrationLookupTableErrorCheckNumberOfRatios			(1000003)
+
+/*
+ *	Maximum round-trip errors of the inverse calibration, checked by the self-test:
+ *	Aout -> Pa -> Aout (in Volts) and Pa -> Aout -> Pa (in Pascal). The inverse
+ *	kernels are expected to be bit-identical to the scalar inverse, as per
+ *	`kCalibrationKernelMaximumUlpDistance`.
+ */
+#define kInverseCalibrationMaximumAoutRoundTripError			(1e-12)
+#define kInverseCalibrationMaximumPaRoundTripError			(1e-9)
+
+/*
+ *	Cached-reciprocal calibration: maximum absolute difference (in Pascal) to
+ *	the scalar reference, which divides by Vdd per sample instead of
+ *	multiplying by a cached reciprocal. The benchmark multiplies the number of
+ *	Aout samples per Vdd sample by `kCachedReciprocalBenchmarkUpdateRatioStep`,
+ *	from 1 up to `kCachedReciprocalBenchmarkMaximumUpdateRatio`.
+ */
+#define kCachedReciprocalCalibrationMaximumAbsoluteError		(1e-9)
+#define kCachedReciprocalBenchmarkMaximumUpdateRatio			(1024)
+#define kCachedReciprocalBenchmarkUpdateRatioStep			(4)
+
+/*
+ *	Quasi-Monte Carlo mode: the Sobol and Halton sequences have one dimension
+ *	per input (Aout and Vdd). The Sobol sequence has 32-bit direction numbers,
+ *	so it has `kSobolSequenceMaximumNumberOfPoints` distinct points.
+ */
+#define kQuasiMonteCarloNumberOfDimensions				(2)
+#define kSobolNumberOfBits						(32)
+#define kSobolSequenceMaximumNumberOfPoints				((uint64_t)1 << kSobolNumberOfBits)
+
+/*
+ *	Quasi-Monte Carlo convergence report: each method estimates the mean and
+ *	variance of the outputs with `kQuasiMonteCarloConvergenceNumberOfReplicates`
+ *	independent seeds, for 2^m samples with m from
+ *	`kQuasiMonteCarloConvergenceMinimumLog2NumberOfSamples` up to
+ *	`kQuasiMonteCarloConvergenceMaximumLog2NumberOfSamples`, in steps of
+ *	`kQuasiMonteCarloConvergenceLog2NumberOfSamplesStep`. The self-test checks
+ *	the net property of the first 2^`kSobolSelfTestLog2NumberOfPoints` points of
+ *	the scrambled Sobol sequence.
+ */
+#define kQuasiMonteCarloConvergenceNumberOfReplicates			(16)
+#define kQuasiMonteCarloConvergenceMinimumLog2NumberOfSamples		(8)
+#define kQuasiMonteCarloConvergenceMaximumLog2NumberOfSamples		(16)
+#define kQuasiMonteCarloConvergenceLog2NumberOfSamplesStep		(2)
+#define kSobolSelfTestLog2NumberOfPoints				(10)
+
+/*
+ *	Variance-reduction sampling strategies: the stratified and Latin hypercube
+ *	strategies index their strata with 32-bit integers, so they support at most
+ *	`kSamplingStrategyMaximumNumberOfSamples` samples. The report of the
+ *	variance reduction compares `kSamplingStrategyReportNumberOfReplicates`
+ *	independent runs of at most `kSamplingStrategyReportMaximumNumberOfSamples`
+ *	samples of the strategy and of independent sampling. The self-test checks
+ *	the strata of `kSamplingStrategySelfTestNumberOfSamples` samples.
+ */
+#define kSamplingStrategyMaximumNumberOfSamples				(0xFFFFFFFFULL)
+#define kSamplingStrategyReportNumberOfReplicates			(32)
+#define kSamplingStrategyReportMaximumNumberOfSamples			(1 << 16)
+#define kSamplingStrategySelfTestNumberOfSamples			(1000)
+
+/*
+ *	Self-test of the streaming statistics: `kStreamingStatisticsSelfTestNumberOfSamples`
+ *	samples, with a large offset, folded in blocks of the sizes of
+ *	`kStreamingStatisticsSelfTestBlockSizes` (in turn), and in
+ *	`kStreamingStatisticsSelfTestNumberOfSlices` slices of uneven lengths
+ *	merged in order, must match the two-pass mean and variance to within
+ *	`kStreamingStatisticsSelfTestMaximumRelativeError`.
+ */
+#define kStreamingStatisticsSelfTestNumberOfSamples			(10007)
+#define kStreamingStatisticsSelfTestBlockSizes				{ 0, 1, 37, 0, 1, 512, 3 }
+#define kStreamingStatisticsSelfTestNumberOfSlices			(16)
+#define kStreamingStatisticsSelfTestMaximumRelativeError		(1e-9)
+
+/*
+ *	Adaptive stopping of the native Monte Carlo mode: the iterations run in
+ *	batches until the half-width of the two-sided confidence interval, at the
+ *	confidence level of the standard normal quantile
+ *	`kAdaptiveStoppingConfidenceIntervalZ` (95%), meets the target. The first
+ *	batch has `kAdaptiveStoppingInitialNumberOfSamples` samples, and each next
+ *	batch brings the number of samples to the number projected to meet the
+ *	target (the half-width shrinks with the square root of the number of
+ *	samples), with at least `kAdaptiveStoppingInitialNumberOfSamples` more
+ *	samples, and at most `kAdaptiveStoppingMaximumGrowthFactor` times as many.
+ *	The self-test sets the target of each output from its exact variance, so
+ *	that about `kAdaptiveStoppingSelfTestNumberOfSamples` samples meet it, with
+ *	at most `kAdaptiveStoppingSelfTestMaximumNumberOfSamples` samples, and
+ *	checks the interval of the quantile `kAdaptiveStoppingSelfTestQuantile`.
+ */
+#define kAdaptiveStoppingConfidenceIntervalZ				(1.959963984540054)
+#define kAdaptiveStoppingInitialNumberOfSamples				(4096)
+#define kAdaptiveStoppingMaximumGrowthFactor				(8)
+#define kAdaptiveStoppingSelfTestNumberOfSamples			(1 << 16)
+#define kAdaptiveStoppingSelfTestMaximumNumberOfSamples			(1 << 20)
+#define kAdaptiveStoppingSelfTestQuantile				(0.95)
+
+/*
+ *	Streaming quantile sketch (merging t-digest) of the Monte Carlo outputs.
+ *	With the arcsine scale function, `kQuantileSketchCompression` bounds the
+ *	number of centroids to about the compression, and keeps the centroids near
+ *	the tails small, so that the rank error of the tail quantiles is smaller
+ *	than that of the median. Samples are buffered, `kQuantileSketchBufferSize`
+ *	at a time, and merged into the centroids in sorted order. The sketch
+ *	reports the quantiles of `kQuantileSketchProbabilities`.
+ */
+#define kQuantileSketchCompression					(200)
+#define kQuantileSketchMaximumNumberOfCentroids				(kQuantileSketchCompression + 2)
+#define kQuantileSketchBufferSize					(5 * kQuantileSketchCompression)
+#define kQuantileSketchNumberOfQuantiles				(5)
+#define kQuantileSketchProbabilities					{ 0.01, 0.05, 0.50, 0.95, 0.99 }
+#define kQuantileSketchSelfTestNumberOfSamples				(200000)
+#define kQuantileSketchSelfTestMaximumRankError				(1e-3)
+
+/*
+ *	Fixed-bin histograms of the Monte Carlo outputs. Without a range, the range
+ *	of each output is the range of `kHistogramPilotNumberOfSamples` outputs of
+ *	independent Philox inputs (the pilot batch), widened by
+ *	`kHistogramAutoRangeMargin` of its width at both ends. The histograms count
+ *	the samples below and above the range in an underflow and an overflow bin.
+ *	The histograms are written as JSON if their file path ends with
+ *	`kHistogramJSONFileExtension`, else as CSV. The self-test counts samples on
+ *	the edges of `kHistogramSelfTestNumberOfBins` bins, and checks that the
+ *	histograms of `kHistogramSelfTestNumberOfSamples` outputs counted by
+ *	`kHistogramSelfTestNumberOfThreads` threads match those of one thread.
+ */
+#define kHistogramMaximumNumberOfBins					(1 << 20)
+#define kHistogramPilotNumberOfSamples					(1 << 14)
+#define kHistogramAutoRangeMargin					(0.05)
+#define kHistogramDefaultOutputFilePath					"histogram.csv"
+#define kHistogramJSONFileExtension					".json"
+#define kHistogramSelfTestNumberOfBins					(10)
+#define kHistogramSelfTestNumberOfSamples				(1 << 16)
+#define kHistogramSelfTestNumberOfThreads				(7)
+
+/*
+ *	Sharded runs of the native Monte Carlo mode: shard k of n runs the
+ *	iterations [k N / n, (k + 1) N / n) of the N iterations of the -M option.
+ *	With the xoshiro256** generator, its threads draw from the streams from
+ *	k * `kMonteCarloMaximumNumberOfThreads` on, so that no two threads of the
+ *	shards share a stream index for any number of threads per shard, and
+ *	their streams start at distinct, effectively random, points of the
+ *	2^256 - 1 period, and in practice do not overlap. Each shard writes
+ *	its partial state (statistics, quantile sketches, and histograms) to the
+ *	file of `kShardPartialStateFilePathFormat`, in native byte order, starting
+ *	with `kShardPartialStateFileMagic` and `kShardPartialStateFileVersion`,
+ *	which changes with the streams and the bins that the state depends on.
+ *	The self-test merges the files of `kShardSelfTestNumberOfShards` shards of
+ *	`kShardSelfTestNumberOfSamples` Philox iterations, written to the paths of
+ *	`kShardSelfTestFilePathFormat` in the working directory, and removed.
+ */
+#define kShardMaximumNumberOfShards					(1024)
+#define kShardPartialStateFilePathFormat				"shard-%zu-of-%zu.partial"
+#define kShardPartialStateFileMagic					"SDP8SHRD"
+#define kShardPartialStateFileVersion					(2)
+#define kShardSelfTestNumberOfShards					(5)
+#define kShardSelfTestNumberOfSamples					(100003)
+#define kShardSelfTestNumberOfBins					(64)
+#define kShardSelfTestFilePathFormat					"shard-self-test-%zu.partial"
+
+/*
+ *	Checkpoints of long runs of the native Monte Carlo mode: after each
+ *	interval of iterations, the run writes the partial state of its shard
+ *	(see above) and its progress to a temporary file, which it then renames
+ *	to the checkpoint file, so that a run stopped at any point leaves the
+ *	complete checkpoint of its last interval. Interval c of shard k of n
+ *	draws from the xoshiro256** streams from (c n + k) *
+ *	`kMonteCarloMaximumNumberOfThreads` on, whose seeding takes constant time
+ *	for any interval. The self-test stops a run after interval
+ *	`kCheckpointSelfTestNumberOfIntervalsBeforeStop`, resumes it from its
+ *	checkpoint, at `kCheckpointSelfTestFilePath` in the working directory, and
+ *	removes the checkpoint.
+ */
+#define kCheckpointDefaultFilePath					"monte-carlo.checkpoint"
+#define kCheckpointShardDefaultFilePathFormat				"shard-%zu-of-%zu.checkpoint"
+#define kCheckpointTemporaryFilePathSuffix				".tmp"
+#define kCheckpointSelfTestNumberOfSamples				(100003)
+#define kCheckpointSelfTestInterval					(10000)
+#define kCheckpointSelfTestNumberOfIntervalsBeforeStop			(4)
+#define kCheckpointSelfTestNumberOfThreads				(3)
+#define kCheckpointSelfTestNumberOfBins					(64)
+#define kCheckpointSelfTestFilePath					"checkpoint-self-test.checkpoint"
+
+/*
+ *	Importance sampling of the tail probabilities of the outputs, at relative
+ *	deviations from the mean of the run (-I option), like those that
+ *	`printCalibratedValueAndProbabilities()` asks for. Each query draws
+ *	`kImportanceSamplingNumberOfSamples` input pairs from the smallest box of
+ *	inputs that contains its exceedance region, whose bounds are found by
+ *	bisection. The self-test compares the estimates for thresholds within
+ *	`kImportanceSamplingSelfTestTailFraction` of the range of each output from
+ *	its extremes to the exact probabilities, integrated over Vdd with the
+ *	inverse calibration.
+ */
+#define kImportanceSamplingNumberOfSamples				(1 << 16)
+#define kImportanceSamplingMaximumNumberOfDeviations			(16)
+#define kImportanceSamplingNumberOfBisections				(64)
+#define kImportanceSamplingSelfTestTailFraction				(0.02)
+#define kImportanceSamplingSelfTestNumberOfIntegrationPoints		(1 << 16)
+#define kImportanceSamplingSelfTestMaximumStandardErrors		(5.0)
+#define kImportanceSamplingSelfTestMaximumRelativeStandardError		(0.05)
+
+/*
+ *	Exact distribution of the outputs for the uniform inputs above (-x
+ *	option). The ratio Aout / Vdd of independent uniform inputs has a
+ *	closed-form CDF and a piecewise PDF of the form a + b / r^2, so the CDF,
+ *	mean, and variance of each output are closed-form, and quantiles invert
+ *	the CDF by at most `kAnalyticDistributionNumberOfBisections` bisections.
+ *	The report times `kAnalyticDistributionTimingNumberOfQueries` of each
+ *	query. The self-test compares the moments to a midpoint rule over a grid
+ *	of `kAnalyticDistributionSelfTestNumberOfGridPoints` squared inputs, and
+ *	the CDF to an integral over Vdd with the inverse calibration.
+ */
+#define kAnalyticDistributionNumberOfBisections				(128)
+#define kAnalyticDistributionTimingNumberOfQueries			(10000)
+#define kAnalyticDistributionSelfTestNumberOfGridPoints			(2048)
+#define kAnalyticDistributionSelfTestNumberOfIntegrationPoints		(1 << 16)
+#define kAnalyticDistributionSelfTestNumberOfThresholds			(9)
+#define kAnalyticDistributionSelfTestMaximumRelativeError		(1e-6)
+#define kAnalyticDistributionSelfTestMaximumProbabilityError		(1e-9)
+
+/*
+ *	Deterministic grid propagation of the inputs (-n option): each input is
+ *	discretized onto G nodes at the midpoints in probability of G intervals
+ *	of equal probability, so the nodes adapt to the density of the input, and
+ *	the G^2 pairs of nodes, of equal weight, are calibrated and binned into
+ *	`kGridPropagationNumberOfBins` bins over the range of the outputs of the
+ *	grid. The Gaussian inputs have the mean and variance of the uniform inputs
+ *	above, and the triangular inputs their range, with the mode at the
+ *	middle. The convergence report (-w option) compares grids from
+ *	`kGridPropagationConvergenceMinimumGridSize` points, doubling up to G, to
+ *	Monte Carlo with `kGridPropagationReferenceNumberOfSamples` samples, or
+ *	those of the -M option. The self-test compares uniform grids of
+ *	`kGridPropagationSelfTestGridSize` points to the exact distribution.
+ */
+#define kGridPropagationMaximumGridSize					(1 << 14)
+#define kGridPropagationNumberOfBins					(4096)
+#define kGridPropagationNormalQuantileBound				(40.0)
+#define kGridPropagationNumberOfBisections				(128)
+#define kGridPropagationMaxCharsPerLine					(256)
+#define kGridPropagationConvergenceMinimumGridSize			(4)
+#define kGridPropagationReferenceNumberOfSamples			(1 << 22)
+#define kGridPropagationSelfTestGridSize				(512)
+#define kGridPropagationSelfTestMaximumRelativeError			(1e-5)
+#define kGridPropagationSelfTestMaximumProbabilityError			(1e-12)
+
+/*
+ *	Particle propagation of the inputs (-D option): each value is a mixture
+ *	of K weighted particles, and the operations between the independent
+ *	inputs combine their K^2 pairs of particles and resample them to K, so
+ *	their cost grows as K^2 log K. At most
+ *	`kParticleDistributionMaximumNumberOfParticles` particles. The self-test
+ *	compares the outputs with `kParticleDistributionSelfTestNumberOfParticles`
+ *	particles to the exact distribution: the errors of the mean, in standard
+ *	deviations, and of the standard deviation, relative, at most
+ *	`kParticleDistributionSelfTestMaximumRelativeError`, and the largest
+ *	difference of the CDFs at most `kParticleDistributionSelfTestMaximumCdfError`.
+ */
+#define kParticleDistributionMaximumNumberOfParticles			(2048)
+#define kParticleDistributionSelfTestNumberOfParticles			(256)
+#define kParticleDistributionSelfTestMaximumRelativeError		(1e-3)
+#define kParticleDistributionSelfTestMaximumCdfError			(1e-2)
+
+/*
+ *	Wasserstein distance of the benchmarking mode (-Z option) to a reference
+ *	file, with lines of at most `kWassersteinDistanceMaxCharsPerLine`
+ *	characters. The last point of a reference CDF must have a probability
+ *	within `kWassersteinDistanceMaximumProbabilityError` of one. The self-test
+ *	compares the distance of `kWassersteinDistanceSelfTestNumberOfSamples`
+ *	samples to the same samples shifted by `kWassersteinDistanceSelfTestShift`,
+ *	and of midpoints to a uniform CDF, to the exact distances.
+ */
+#define kWassersteinDistanceMaxCharsPerLine				(256)
+#define kWassersteinDistanceMaximumProbabilityError			(1e-9)
+#define kWassersteinDistanceSelfTestNumberOfSamples			(4096)
+#define kWassersteinDistanceSelfTestShift				(0.25)
+#define kWassersteinDistanceSelfTestMaximumError			(1e-12)
@@ -22,8 +22,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <math.h>
 #include <uxhw.h>
 #include "utilities.h"
+#include "adc.h"
 
 void
 printUsage(void)
@@ -39,93 +43,1072 @@ printUsage(void)
 		"\t[-T, --time] (Timing mode: Times and prints the timing of the kernel execution.)\n"
 		"\t[-b, --benchmarking] (Benchmarking mode: Generate outputs in format for benchmarking.)\n"
 		"\t[-j, --json] (Print output in JSON format.)\n"
+		"\t[-k, --kernel <implementation : str>] (Batch calibration kernel: scalar, scalar-branch-free, sse2, avx2, or avx512. Default: widest supported by the CPU.)\n"
+		"\t[-K, --kernel-self-test] (Check the batch calibration kernels against the scalar reference and exit.)\n"
+		"\t[-B, --kernel-benchmark] (Print the time per sample of the batch calibration kernels and exit. Uses the -M value as the number of samples, if provided.)\n"
+		"\t[-F, --single-precision] (Monte Carlo mode: Calibrate and accumulate statistics in single precision (float32), and report the difference to double precision. ADC code input mode: Calibrate the input file in single precision instead of fixed point.)\n"
+		"\t[-a, --adc-codes <AoutCode,VddCode : int,int>] (ADC code input mode: Calibrate a single pair of raw ADC codes in fixed point, single precision, and double precision.)\n"
+		"\t[-i, --input <Path to input file : str>] (ADC code input mode: Calibrate the raw ADC code pairs of the file, one `AoutCode,VddCode` pair per line, in fixed point, and write the outputs in CSV format to the output file (-o option), or else to the standard output.)\n"
+		"\t[-q, --adc-bit-depth <bits : int>] (ADC code input mode: Bit depth of the ADC. Default value: %d.)\n"
+		"\t[-R, --adc-reference <voltage : double>] (ADC code input mode: Reference voltage of the ADC, in Volts. Only used to convert the codes to Volts. Default value: %.3lf.)\n"
+		"\t[-L, --lookup-table <number of intervals : int>] (Monte Carlo mode and ADC code input files only: Calibrate via lookup tables of the outputs over the given number of intervals of Aout/Vdd in [0, 1], with linear interpolation, e.g., %d. Reports the memory footprint and maximum error of the tables.)\n"
+		"\t[-W, --streaming-statistics] (Monte Carlo mode only: Fold the output samples into constant-memory running statistics (mean, variance, minimum, maximum) instead of storing them, and print the statistics. Does not write data.out, and the JSON output (-j) prints the mean of each output instead of its samples.)\n"
+		"\t[-P, --quantiles] (Monte Carlo mode only: Add the output samples to constant-memory, mergeable quantile sketches (t-digest), one per thread, merged at the end, and print the p1, p5, p50, p95, and p99 quantiles of each output, also in the JSON output (-j).)\n"
+		"\t[-H, --histogram <bins : int>[,<low : double>,<high : double>]] (Monte Carlo mode only: Count the output samples in the given number of bins of equal width, at most %d, over [low, high) in Pascal, with an underflow and overflow bin, in histograms per thread, merged at the end, and write the histograms to the file of the -g option. Without a range, uses the range of a pilot batch of %d samples, widened by %g%% at both ends.)\n"
+		"\t[-g, --histogram-output <Path to histogram file : str>] (Histogram only: Write the histograms to this file, as JSON if the path ends with %s, else as CSV with one output,bin_low,bin_high,count row per bin. Default: %s.)\n"
+		"\t[-r, --random-number-generator <generator : str>] (Monte Carlo mode only: Source of the input samples: uxhw (UxHw API calls), xoshiro256 (seeded streams, one per thread), philox (seeded counter-based generator, vectorized), or the quasi-Monte Carlo low-discrepancy sequences sobol, sobol-scrambled, halton, or halton-scrambled (scrambled with the seed). Default: uxhw, or xoshiro256 if -t or -s is provided.)\n"
+		"\t[-V, --sampling-strategy <strategy : str>] (Monte Carlo mode only: Sampling strategy of the input samples, drawn with the philox generator: iid (independent samples), stratified (one sample per cell of a grid over the Aout x Vdd rectangle), latin-hypercube (one sample per interval of each input), or antithetic (pairs of samples with both inputs reflected). Reports the variance reduction factor and effective sample size of the strategy. Default: iid.)\n"
+		"\t[-e, --target-half-width <width : double>[%%]] (Monte Carlo mode only: Run the iterations in batches until the half-width of the 95%% confidence interval of the mean (or of the quantile of the -p option) of each selected output is at most the given width in Pascal, or, with a %% suffix, the given percentage of the estimate, or until the number of iterations of the -M option or the time limit of the -l option is reached. Reports the number of samples used.)\n"
+		"\t[-p, --target-quantile <probability : double>] (Adaptive stopping only: Apply the target half-width of the -e option to the confidence interval of this quantile, in (0, 1), instead of the mean.)\n"
+		"\t[-l, --time-limit <seconds : double>] (Adaptive stopping only: Stop after the first batch that ends after this wall-clock time, in seconds, even if the target half-width is not met.)\n"
+		"\t[-d, --shard <k/n : int/int>] (Monte Carlo mode only: Run only shard k (0-indexed) of n shards, at most %d, of the iterations of the -M option, with streaming statistics (-W) and quantile sketches (-P), and write their partial state, with the histograms of the -H option, to shard-<k>-of-<n>.partial. The xoshiro256 streams of the shards start at distinct, effectively random points of the 2^256 - 1 period, and in practice do not overlap, and with philox the shards together draw the samples of the run without shards. Default generator: xoshiro256.)\n"
+		"\t[-m, --merge <Path to partial-state file : str>[,<Path to partial-state file : str>...]] (Merge the partial-state files of shards of the same run, in any order, and print the statistics, quantiles, and histograms of the run, as with -W and -P, also in the JSON output (-j). Writes the histograms to the file of the -g option.)\n"
+		"\t[-c, --checkpoint <iterations : int>] (Monte Carlo mode only: Run the iterations (of the shard of the -d option) in intervals of this many iterations, with streaming statistics (-W) and quantile sketches (-P), and after each interval write the statistics, sketches, and histograms so far, and the next iteration, to the checkpoint file. Default generator: xoshiro256.)\n"
+		"\t[-C, --checkpoint-file <Path to checkpoint file : str>] (Checkpoints only: Path of the checkpoint file. Default: %s, or shard-<k>-of-<n>.checkpoint with the -d option.)\n"
+		"\t[-u, --resume] (Checkpoints only: Continue from the checkpoint file, if it exists, with bit-identical results to an uninterrupted run. Requires the arguments of the interrupted run.)\n"
+		"\t[-I, --importance-sampling <deviation : double>[,<deviation : double>...]] (Monte Carlo mode only: Estimate, for each selected output and each deviation in (0, 1), the probabilities that the output is that fraction of the mean or more smaller or greater than the mean of the run, with %d input samples each, drawn with the philox generator (and the seed of the -s option) from the smallest box of inputs that reaches the threshold, and print them with their standard errors and the number of plain Monte Carlo samples with the same standard error, e.g., 0.05,0.3.)\n"
+		"\t[-x, --exact] (Print the exact distribution of each selected output for the uniform Aout and Vdd inputs, from the closed-form distribution of their ratio: its mean, standard deviation, quantiles, and the probabilities of the output report, and the time per query. In Monte Carlo mode, also print the error of the mean of the run, in standard errors, and, with quantile sketches (-P), the errors in probability of its quantiles.)\n"
+		"\t[-n, --grid <points : int>] (Grid propagation mode: Discretize each input onto the given number of points, at most %d, at the midpoints in probability of intervals of equal probability, calibrate all pairs of points, and print the mean, standard deviation, and quantiles of each output, binned into %d bins, and exit.)\n"
+		"\t[-w, --grid-convergence-report] (Grid propagation only: Also print the errors of the mean, standard deviation, and CDF of each output for grids of %d points per input, doubling up to the -n value, relative to Monte Carlo with the -M number of samples, or %d, and their times.)\n"
+		"\t[-E, --input-distribution <distribution : str>] (Grid propagation only: Distribution of the inputs: uniform, gaussian (with the mean and variance of the uniform inputs), triangular (over the range of the uniform inputs), or the path to a file of Aout,Vdd samples, one pair per line. Default: uniform.)\n"
+		"\t[-D, --particles <particles : int>] (Particle propagation mode: Represent each value as the given number of weighted particles, at most %d, propagate the uniform inputs through the calibration of each output in one pass, resampling the pairs of particles of the independent inputs to that number, print the mean, standard deviation, and quantiles of each output, their time, and their errors relative to the exact distribution, and exit.)\n"
+		"\t[-Z, --wasserstein-reference <Path to reference file : str>] (Benchmarking mode (-b) in Monte Carlo mode only: Instead of the output and the time, print the 1-Wasserstein distance of the output samples to the reference distribution of the file, the time in microseconds, and the number of samples, in one line. The file has either one sample per line, or one `value,probability` point of a CDF per line, in increasing order, which is linear between the points and ends at probability 1.)\n"
+		"\t[-Q, --qmc-convergence-report] (Print, for each output, the errors of the mean and variance estimates of plain Monte Carlo and of the scrambled Sobol and Halton sequences for increasing numbers of samples, and how many times more samples plain Monte Carlo needs for the same error, and exit.)\n"
+		"\t[-t, --threads <number of threads : int>] (Monte Carlo mode only: Split the iterations across the given number of threads, each drawing its inputs from a seeded random number generator instead of via the UxHw API calls. The samples are reproducible for a given seed and number of threads, and, with philox and the quasi-random sequences, for a given seed only. Default value: 1.)\n"
+		"\t[-s, --seed <seed : int>] (Monte Carlo mode only: Seed of the random number generators. Default value: %d.)\n"
 		"\t[-h, --help] (Display this help message.)\n",
 		kOutputDistributionIndexCalibratedSensorOutputMax,
-		kOutputDistributionIndexCalibratedSensorOutputMax);
+		kOutputDistributionIndexCalibratedSensorOutputMax,
+		kDefaultAdcBitDepth,
+		kDefaultAdcReferenceVoltage,
+		kCalibrationLookupTableDefaultNumberOfIntervals,
+		kHistogramMaximumNumberOfBins,
+		kHistogramPilotNumberOfSamples,
+		kHistogramAutoRangeMargin * 100.0,
+		kHistogramJSONFileExtension,
+		kHistogramDefaultOutputFilePath,
+		kShardMaximumNumberOfShards,
+		kCheckpointDefaultFilePath,
+		kImportanceSamplingNumberOfSamples,
+		kGridPropagationMaximumGridSize,
+		kGridPropagationNumberOfBins,
+		kGridPropagationConvergenceMinimumGridSize,
+		kGridPropagationReferenceNumberOfSamples,
+		kParticleDistributionMaximumNumberOfParticles,
+		kDefaultMonteCarloSeed);
 	fprintf(stderr, "\n");
 
 	return;
 }
 
+/**
+ *	@brief  Parses a non-negative 64-bit integer seed, in decimal or, with a `0x` prefix, in hexadecimal.
+ *
+ *	@param  string	: The string to parse.
+ *	@param  seed	: Pointer to where the function writes the seed.
+ *	@return		: `kCommonConstantReturnTypeSuccess` if successful,
+ *			   else `kCommonConstantReturnTypeError`.
+ */
+static CommonConstantReturnType
+parseSeed(const char *  string, uint64_t *  seed)
+{
+	char *			end;
+	unsigned long long	value;
+
+	if ((string == NULL) || (*string == '\0') || (*string == '-'))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	errno = 0;
+	value = strtoull(string, &end, 0);
+
+	if ((errno != 0) || (*end != '\0'))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	*seed = (uint64_t)value;
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+/**
+ *	@brief  Parses a histogram specification: the number of bins, optionally followed by the lower
+ *		and upper end of the range, as `bins` or `bins,low,high`.
+ *
+ *	@param  string		: The string to parse.
+ *	@param  numberOfBins	: Pointer to where the function writes the number of bins.
+ *	@param  isRangeSelected	: Pointer to where the function writes whether the string specifies the range.
+ *	@param  low		: Pointer to where the function writes the lower end of the range, if specified.
+ *	@param  high		: Pointer to where the function writes the upper end of the range, if specified.
+ *	@return			: `kCommonConstantReturnTypeSuccess` if successful,
+ *				   else `kCommonConstantReturnTypeError`.
+ */
+static CommonConstantReturnType
+parseHistogramSpecification(const char *  string, size_t *  numberOfBins, bool *  isRangeSelected, double *  low, double *  high)
+{
+	char *			end;
+	unsigned long long	value;
+
+	if ((string == NULL) || (*string == '\0') || (*string == '-'))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	errno = 0;
+	value = strtoull(string, &end, 10);
+
+	if ((errno != 0) || (value < 1) || (value > kHistogramMaximumNumberOfBins) || ((*end != '\0') && (*end != ',')))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	*numberOfBins = (size_t)value;
+	*isRangeSelected = (*end == ',');
+
+	if (!*isRangeSelected)
+	{
+		return kCommonConstantReturnTypeSuccess;
+	}
+
+	*low = strtod(end + 1, &end);
+
+	if ((errno != 0) || (*end != ','))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	*high = strtod(end + 1, &end);
+
+	if ((errno != 0) || (*end != '\0') || !isfinite(*low) || !isfinite(*high) || !(*low < *high))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+/**
+ *	@brief  Parses a shard specification `k/n`: the 0-indexed shard `k` of `n` shards.
+ *
+ *	@param  string		: The string to parse.
+ *	@param  shardIndex	: Pointer to where the function writes the index of the shard.
+ *	@param  numberOfShards	: Pointer to where the function writes the number of shards.
+ *	@return			: `kCommonConstantReturnTypeSuccess` if successful,
+ *				   else `kCommonConstantReturnTypeError`.
+ */
+static CommonConstantReturnType
+parseShardSpecification(const char *  string, size_t *  shardIndex, size_t *  numberOfShards)
+{
+	char *	end;
+	long	index;
+	long	count;
+
+	if ((string == NULL) || (*string == '\0') || (*string == '-'))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	errno = 0;
+	index = strtol(string, &end, 10);
+
+	if ((errno != 0) || (end == string) || (*end != '/'))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	string = end + 1;
+	count = strtol(string, &end, 10);
+
+	if ((errno != 0) || (end == string) || (*end != '\0') || (count < 1) || (count > kShardMaximumNumberOfShards) || (index >= count))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	*shardIndex = (size_t)index;
+	*numberOfShards = (size_t)count;
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+/**
+ *	@brief  Parses a target confidence interval half-width: a positive number, in Pascal, or, with a
+ *		`%` suffix, a percentage of the magnitude of the estimate.
+ *
+ *	@param  string		: The string to parse.
+ *	@param  halfWidth	: Pointer to where the function writes the half-width, in Pascal or as a fraction.
+ *	@param  isRelative	: Pointer to where the function writes whether the half-width is relative.
+ *	@return			: `kCommonConstantReturnTypeSuccess` if successful,
+ *				   else `kCommonConstantReturnTypeError`.
+ */
+static CommonConstantReturnType
+parseTargetHalfWidth(const char *  string, double *  halfWidth, bool *  isRelative)
+{
+	char *	end;
+	double	value;
+
+	if ((string == NULL) || (*string == '\0'))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	errno = 0;
+	value = strtod(string, &end);
+	*isRelative = (*end == '%');
+
+	if (*isRelative)
+	{
+		end++;
+		value /= 100.0;
+	}
+
+	if ((errno != 0) || (*end != '\0') || !(value > 0.0) || !isfinite(value))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	*halfWidth = value;
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+/**
+ *	@brief  Parses a comma-separated list of relative deviations from the mean, each in (0, 1).
+ *
+ *	@param  string			: The string to parse.
+ *	@param  tailDeviations		: Array of `kImportanceSamplingMaximumNumberOfDeviations` elements, to which the function writes the deviations.
+ *	@param  numberOfTailDeviations	: Pointer to where the function writes the number of deviations.
+ *	@return				: `kCommonConstantReturnTypeSuccess` if successful,
+ *					   else `kCommonConstantReturnTypeError`.
+ */
+static CommonConstantReturnType
+parseTailDeviations(const char *  string, double *  tailDeviations, size_t *  numberOfTailDeviations)
+{
+	char *	end;
+	size_t	count = 0;
+
+	if ((string == NULL) || (*string == '\0'))
+	{
+		return kCommonConstantReturnTypeError;
+	}
+
+	do
+	{
+		double	value;
+
+		if (count == kImportanceSamplingMaximumNumberOfDeviations)
+		{
+			return kCommonConstantReturnTypeError;
+		}
+
+		errno = 0;
+		value = strtod(string, &end);
+
+		if ((errno != 0) || (end == string) || ((*end != '\0') && (*end != ',')) || !(value > 0.0) || !(value < 1.0))
+		{
+			return kCommonConstantReturnTypeError;
+		}
+
+		tailDeviations[count++] = value;
+		string = end + 1;
+	} while (*end == ',');
+
+	*numberOfTailDeviations = count;
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
 static void
 setDefaultCommandLineArguments(CommandLineArguments *  arguments)
 {
 	/*
-	 *	Older GCC versions have a bug which gives a spurious warning for
-	 *	the C universal zero initializer `{0}`. Any workaround makes the
-	 *	code less portable or prevents the common code from adding new
-	 *	fields to the `CommonCommandLineArguments` struct. Therefore, we
-	 *	surpress this warning.
-	 *
-	 *	See https://gcc.gnu.org/bugzilla/show_bug.cgi?id=53119.
+	 *	Older GCC versions have a bug which gives a spurious warning for
+	 *	the C universal zero initializer `{0}`. Any workaround makes the
+	 *	code less portable or prevents the common code from adding new
+	 *	fields to the `CommonCommandLineArguments` struct. Therefore, we
+	 *	surpress this warning.
+	 *
+	 *	See https://gcc.gnu.org/bugzilla/show_bug.cgi?id=53119.
+	 */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-braces"
+
+	*arguments = (CommandLineArguments)
+	{
+		.common					= (CommonCommandLineArguments) {0},
+		.isCalibrationKernelSelected		= false,
+		.calibrationKernelImplementation	= kCalibrationKernelImplementationScalar,
+		.isCalibrationKernelSelfTestEnabled	= false,
+		.isCalibrationKernelBenchmarkEnabled	= false,
+		.isSinglePrecisionEnabled		= false,
+		.isAdcCodeInputEnabled			= false,
+		.isAdcCodePairSelected			= false,
+		.adcAoutCode				= 0,
+		.adcVddCode				= 0,
+		.isAdcBitDepthSelected			= false,
+		.adcBitDepth				= kDefaultAdcBitDepth,
+		.isAdcReferenceVoltageSelected		= false,
+		.adcReferenceVoltage			= kDefaultAdcReferenceVoltage,
+		.isLookupTableEnabled			= false,
+		.lookupTableNumberOfIntervals		= kCalibrationLookupTableDefaultNumberOfIntervals,
+		.isNumberOfThreadsSelected		= false,
+		.numberOfThreads			= 1,
+		.isSeedSelected				= false,
+		.seed					= kDefaultMonteCarloSeed,
+		.isRandomNumberGeneratorSelected	= false,
+		.randomNumberGeneratorType		= kRandomNumberGeneratorTypeUxHw,
+		.isStreamingStatisticsEnabled		= false,
+		.isQuantileSketchEnabled		= false,
+		.isHistogramEnabled			= false,
+		.histogramNumberOfBins			= 0,
+		.isHistogramRangeSelected		= false,
+		.histogramLow				= 0.0,
+		.histogramHigh				= 0.0,
+		.isHistogramFilePathSelected		= false,
+		.histogramFilePath			= kHistogramDefaultOutputFilePath,
+		.isQuasiMonteCarloConvergenceReportEnabled	= false,
+		.isSamplingStrategySelected		= false,
+		.samplingStrategy			= kSamplingStrategyIndependent,
+		.isAdaptiveStoppingEnabled		= false,
+		.targetHalfWidth			= 0.0,
+		.isTargetHalfWidthRelative		= false,
+		.isTargetQuantileSelected		= false,
+		.targetQuantile				= 0.5,
+		.isTimeLimitSelected			= false,
+		.timeLimitSeconds			= 0.0,
+		.isShardSelected			= false,
+		.shardIndex				= 0,
+		.numberOfShards				= 1,
+		.isMergeEnabled				= false,
+		.mergeFilePaths				= NULL,
+		.isCheckpointEnabled			= false,
+		.checkpointInterval			= 0,
+		.isCheckpointFilePathSelected		= false,
+		.checkpointFilePath			= kCheckpointDefaultFilePath,
+		.isResumeEnabled			= false,
+		.isImportanceSamplingEnabled		= false,
+		.numberOfTailDeviations			= 0,
+		.tailDeviations				= {0},
+		.isAnalyticDistributionEnabled		= false,
+		.isGridPropagationEnabled		= false,
+		.gridSize				= 0,
+		.isGridConvergenceReportEnabled		= false,
+		.isGridInputDistributionSelected	= false,
+		.gridInputDistributionType		= kGridInputDistributionUniform,
+		.gridInputFilePath			= NULL,
+		.isParticlePropagationEnabled		= false,
+		.numberOfParticles			= 0,
+		.isWassersteinReferenceSelected		= false,
+		.wassersteinReferenceFilePath		= NULL,
+	};
+#pragma GCC diagnostic pop
+
+	return;
+}
+
+CommonConstantReturnType
+getCommandLineArguments(
+	int			argc,
+	char *			argv[],
+	CommandLineArguments *	arguments)
+{
+	char *			kernelArg = NULL;
+	char *			adcCodesArg = NULL;
+	char *			adcBitDepthArg = NULL;
+	char *			adcReferenceVoltageArg = NULL;
+	char *			lookupTableArg = NULL;
+	char *			numberOfThreadsArg = NULL;
+	char *			seedArg = NULL;
+	char *			randomNumberGeneratorArg = NULL;
+	char *			samplingStrategyArg = NULL;
+	char *			targetHalfWidthArg = NULL;
+	char *			targetQuantileArg = NULL;
+	char *			timeLimitArg = NULL;
+	char *			histogramArg = NULL;
+	char *			histogramFilePathArg = NULL;
+	char *			shardArg = NULL;
+	char *			mergeArg = NULL;
+	char *			checkpointIntervalArg = NULL;
+	char *			checkpointFilePathArg = NULL;
+	char *			tailDeviationsArg = NULL;
+	char *			gridSizeArg = NULL;
+	char *			gridInputDistributionArg = NULL;
+	char *			numberOfParticlesArg = NULL;
+	char *			wassersteinReferenceArg = NULL;
+
+	if (arguments == NULL)
+	{
+		fprintf(stderr, "Arguments pointer is NULL.\n");
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	setDefaultCommandLineArguments(arguments);
+
+	DemoOption		demoSpecificOptions[] =
+				{
+					{ .opt = "k", .optAlternative = "kernel", .hasArg = true, .foundArg = &kernelArg, .foundOpt = &arguments->isCalibrationKernelSelected },
+					{ .opt = "K", .optAlternative = "kernel-self-test", .hasArg = false, .foundArg = NULL, .foundOpt = &arguments->isCalibrationKernelSelfTestEnabled },
+					{ .opt = "B", .optAlternative = "kernel-benchmark", .hasArg = false, .foundArg = NULL, .foundOpt = &arguments->isCalibrationKernelBenchmarkEnabled },
+					{ .opt = "F", .optAlternative = "single-precision", .hasArg = false, .foundArg = NULL, .foundOpt = &arguments->isSinglePrecisionEnabled },
+					{ .opt = "a", .optAlternative = "adc-codes", .hasArg = true, .foundArg = &adcCodesArg, .foundOpt = &arguments->isAdcCodePairSelected },
+					{ .opt = "q", .optAlternative = "adc-bit-depth", .hasArg = true, .foundArg = &adcBitDepthArg, .foundOpt = &arguments->isAdcBitDepthSelected },
+					{ .opt = "R", .optAlternative = "adc-reference", .hasArg = true, .foundArg = &adcReferenceVoltageArg, .foundOpt = &arguments->isAdcReferenceVoltageSelected },
+					{ .opt = "L", .optAlternative = "lookup-table", .hasArg = true, .foundArg = &lookupTableArg, .foundOpt = &arguments->isLookupTableEnabled },
+					{ .opt = "t", .optAlternative = "threads", .hasArg = true, .foundArg = &numberOfThreadsArg, .foundOpt = &arguments->isNumberOfThreadsSelected },
+					{ .opt = "s", .optAlternative = "seed", .hasArg = true, .foundArg = &seedArg, .foundOpt = &arguments->isSeedSelected },
+					{ .opt = "W", .optAlternative = "streaming-statistics", .hasArg = false, .foundArg = NULL, .foundOpt = &arguments->isStreamingStatisticsEnabled },
+					{ .opt = "P", .optAlternative = "quantiles", .hasArg = false, .foundArg = NULL, .foundOpt = &arguments->isQuantileSketchEnabled },
+					{ .opt = "H", .optAlternative = "histogram", .hasArg = true, .foundArg = &histogramArg, .foundOpt = &arguments->isHistogramEnabled },
+					{ .opt = "g", .optAlternative = "histogram-output", .hasArg = true, .foundArg = &histogramFilePathArg, .foundOpt = &arguments->isHistogramFilePathSelected },
+					{ .opt = "r", .optAlternative = "random-number-generator", .hasArg = true, .foundArg = &randomNumberGeneratorArg, .foundOpt = &arguments->isRandomNumberGeneratorSelected },
+					{ .opt = "V", .optAlternative = "sampling-strategy", .hasArg = true, .foundArg = &samplingStrategyArg, .foundOpt = &arguments->isSamplingStrategySelected },
+					{ .opt = "e", .optAlternative = "target-half-width", .hasArg = true, .foundArg = &targetHalfWidthArg, .foundOpt = &arguments->isAdaptiveStoppingEnabled },
+					{ .opt = "p", .optAlternative = "target-quantile", .hasArg = true, .foundArg = &targetQuantileArg, .foundOpt = &arguments->isTargetQuantileSelected },
+					{ .opt = "l", .optAlternative = "time-limit", .hasArg = true, .foundArg = &timeLimitArg, .foundOpt = &arguments->isTimeLimitSelected },
+					{ .opt = "Q", .optAlternative = "qmc-convergence-report", .hasArg = false, .foundArg = NULL, .foundOpt = &arguments->isQuasiMonteCarloConvergenceReportEnabled },
+					{ .opt = "d", .optAlternative = "shard", .hasArg = true, .foundArg = &shardArg, .foundOpt = &arguments->isShardSelected },
+					{ .opt = "m", .optAlternative = "merge", .hasArg = true, .foundArg = &mergeArg, .foundOpt = &arguments->isMergeEnabled },
+					{ .opt = "c", .optAlternative = "checkpoint", .hasArg = true, .foundArg = &checkpointIntervalArg, .foundOpt = &arguments->isCheckpointEnabled },
+					{ .opt = "C", .optAlternative = "checkpoint-file", .hasArg = true, .foundArg = &checkpointFilePathArg, .foundOpt = &arguments->isCheckpointFilePathSelected },
+					{ .opt = "u", .optAlternative = "resume", .hasArg = false, .foundArg = NULL, .foundOpt = &arguments->isResumeEnabled },
+					{ .opt = "I", .optAlternative = "importance-sampling", .hasArg = true, .foundArg = &tailDeviationsArg, .foundOpt = &arguments->isImportanceSamplingEnabled },
+					{ .opt = "x", .optAlternative = "exact", .hasArg = false, .foundArg = NULL, .foundOpt = &arguments->isAnalyticDistributionEnabled },
+					{ .opt = "n", .optAlternative = "grid", .hasArg = true, .foundArg = &gridSizeArg, .foundOpt = &arguments->isGridPropagationEnabled },
+					{ .opt = "w", .optAlternative = "grid-convergence-report", .hasArg = false, .foundArg = NULL, .foundOpt = &arguments->isGridConvergenceReportEnabled },
+					{ .opt = "E", .optAlternative = "input-distribution", .hasArg = true, .foundArg = &gridInputDistributionArg, .foundOpt = &arguments->isGridInputDistributionSelected },
+					{ .opt = "D", .optAlternative = "particles", .hasArg = true, .foundArg = &numberOfParticlesArg, .foundOpt = &arguments->isParticlePropagationEnabled },
+					{ .opt = "Z", .optAlternative = "wasserstein-reference", .hasArg = true, .foundArg = &wassersteinReferenceArg, .foundOpt = &arguments->isWassersteinReferenceSelected },
+					{0},
+				};
+
+	if (parseArgs(argc, argv, &arguments->common, demoSpecificOptions) != 0)
+	{
+		fprintf(stderr, "Parsing command line arguments failed\n");
+		printUsage();
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	/*
+	 *	Process command-line arguments
+	 */
+	if (arguments->common.isHelpEnabled)
+	{
+		printUsage();
+
+		exit(EXIT_SUCCESS);
+	}
+
+	if (arguments->isCalibrationKernelSelected)
+	{
+		if (parseCalibrationKernelImplementationName(kernelArg, &arguments->calibrationKernelImplementation) != kCommonConstantReturnTypeSuccess)
+		{
+			fprintf(stderr, "Error: The calibration kernel (-k option) must be one of scalar, scalar-branch-free, sse2, avx2, or avx512.\n");
+			printUsage();
+
+			return kCommonConstantReturnTypeError;
+		}
+	}
+
+	/*
+	 *	The calibration kernel self-test and benchmark do not use any of the
+	 *	remaining arguments.
+	 */
+	if (arguments->isCalibrationKernelSelfTestEnabled || arguments->isCalibrationKernelBenchmarkEnabled)
+	{
+		return kCommonConstantReturnTypeSuccess;
+	}
+
+	/*
+	 *	Inputs are only read from a file in the ADC code input mode, as raw ADC code pairs.
+	 */
+	arguments->isAdcCodeInputEnabled = arguments->isAdcCodePairSelected || arguments->common.isInputFromFileEnabled;
+
+	if (arguments->isAdcCodeInputEnabled)
+	{
+		if (arguments->isAdcCodePairSelected && arguments->common.isInputFromFileEnabled)
+		{
+			fprintf(stderr, "Error: Please provide either a pair of ADC codes (-a option) or an input file (-i option), not both.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (arguments->common.isMonteCarloMode || arguments->common.isBenchmarkingMode || arguments->common.isOutputJSONMode)
+		{
+			fprintf(stderr, "Error: The ADC code input mode does not support Monte Carlo (-M), benchmarking (-b), or JSON (-j) output.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (arguments->isAdcCodePairSelected &&
+			(parseAdcCodePair(adcCodesArg, &arguments->adcAoutCode, &arguments->adcVddCode) != kCommonConstantReturnTypeSuccess))
+		{
+			fprintf(stderr, "Error: The ADC codes (-a option) must be in the format AoutCode,VddCode.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (arguments->isAdcBitDepthSelected)
+		{
+			int	adcBitDepth;
+
+			if ((parseIntChecked(adcBitDepthArg, &adcBitDepth) != kCommonConstantReturnTypeSuccess) ||
+				(adcBitDepth < 1) ||
+				(adcBitDepth > kAdcMaximumBitDepth))
+			{
+				fprintf(stderr, "Error: The ADC bit depth (-q option) must be an integer between 1 and %d.\n", kAdcMaximumBitDepth);
+
+				return kCommonConstantReturnTypeError;
+			}
+
+			arguments->adcBitDepth = (uint32_t)adcBitDepth;
+		}
+
+		if (arguments->isAdcReferenceVoltageSelected)
+		{
+			if ((parseDoubleChecked(adcReferenceVoltageArg, &arguments->adcReferenceVoltage) != kCommonConstantReturnTypeSuccess) ||
+				!(arguments->adcReferenceVoltage > 0.0))
+			{
+				fprintf(stderr, "Error: The ADC reference voltage (-R option) must be a positive number.\n");
+
+				return kCommonConstantReturnTypeError;
+			}
+		}
+	}
+	else if (arguments->isAdcBitDepthSelected || arguments->isAdcReferenceVoltageSelected)
+	{
+		fprintf(stderr, "Error: The ADC bit depth (-q option) and reference voltage (-R option) are only used in the ADC code input mode.\n");
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	/*
+	 *	Write to output file is not supported in MonteCarlo Mode.
+	 */
+	if (arguments->common.isWriteToFileEnabled && arguments->common.isMonteCarloMode)
+	{
+		fprintf(stderr, "Writing to output file is not supported in MonteCarlo Mode.\n");
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	/*
+	 *	Single precision is only supported for the plain samples of Monte Carlo mode
+	 *	and for the ADC codes of an input file.
+	 */
+	if (arguments->isSinglePrecisionEnabled && !arguments->common.isMonteCarloMode && !arguments->common.isInputFromFileEnabled)
+	{
+		fprintf(stderr, "Error: Single precision mode (-F option) is only supported in Monte Carlo mode and for ADC code input files.\n");
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	/*
+	 *	The lookup tables interpolate plain samples in double precision.
+	 */
+	if (arguments->isLookupTableEnabled)
+	{
+		int	lookupTableNumberOfIntervals;
+
+		if (!arguments->common.isMonteCarloMode && !arguments->common.isInputFromFileEnabled)
+		{
+			fprintf(stderr, "Error: Lookup table calibration (-L option) is only supported in Monte Carlo mode and for ADC code input files.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (arguments->isSinglePrecisionEnabled)
+		{
+			fprintf(stderr, "Error: Lookup table calibration (-L option) is not supported in single precision mode (-F option).\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if ((parseIntChecked(lookupTableArg, &lookupTableNumberOfIntervals) != kCommonConstantReturnTypeSuccess) ||
+			(lookupTableNumberOfIntervals < 1) ||
+			(lookupTableNumberOfIntervals > kCalibrationLookupTableMaximumNumberOfIntervals))
+		{
+			fprintf(
+				stderr,
+				"Error: The number of lookup table intervals (-L option) must be an integer between 1 and %d.\n",
+				kCalibrationLookupTableMaximumNumberOfIntervals);
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		arguments->lookupTableNumberOfIntervals = (size_t)lookupTableNumberOfIntervals;
+	}
+
+	if (arguments->isSamplingStrategySelected &&
+		(parseSamplingStrategyName(samplingStrategyArg, &arguments->samplingStrategy) != kCommonConstantReturnTypeSuccess))
+	{
+		fprintf(stderr, "Error: The sampling strategy (-V option) must be one of iid, stratified, latin-hypercube, or antithetic.\n");
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	/*
+	 *	The seeded random number generators replace the UxHw API calls of the
+	 *	native Monte Carlo mode. Selecting a number of threads or a seed
+	 *	without a generator selects the xoshiro256** streams, as do a shard or
+	 *	checkpoints, whose samples must be reproducible, and selecting a sampling strategy
+	 *	selects the Philox generator, which the strategies draw from.
+	 */
+	if (arguments->isRandomNumberGeneratorSelected)
+	{
+		if (parseRandomNumberGeneratorTypeName(randomNumberGeneratorArg, &arguments->randomNumberGeneratorType) != kCommonConstantReturnTypeSuccess)
+		{
+			fprintf(stderr, "Error: The random number generator (-r option) must be one of uxhw, xoshiro256, philox, sobol, sobol-scrambled, halton, or halton-scrambled.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if ((arguments->randomNumberGeneratorType == kRandomNumberGeneratorTypeUxHw) &&
+			(arguments->isNumberOfThreadsSelected || arguments->isSeedSelected || arguments->isShardSelected || arguments->isCheckpointEnabled))
+		{
+			fprintf(
+				stderr,
+				"Error: The number of threads (-t option), seed (-s option), shard (-d option), and checkpoints (-c option) require a seeded random number generator (-r option).\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+	}
+	else if (arguments->isSamplingStrategySelected)
+	{
+		arguments->randomNumberGeneratorType = kRandomNumberGeneratorTypePhilox;
+	}
+	else if (arguments->isNumberOfThreadsSelected || arguments->isSeedSelected || arguments->isShardSelected || arguments->isCheckpointEnabled)
+	{
+		arguments->randomNumberGeneratorType = kRandomNumberGeneratorTypeXoshiro256;
+	}
+
+	if (arguments->isSamplingStrategySelected && (arguments->randomNumberGeneratorType != kRandomNumberGeneratorTypePhilox))
+	{
+		fprintf(stderr, "Error: The sampling strategies (-V option) require the philox random number generator (-r option).\n");
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	if (arguments->isRandomNumberGeneratorSelected ||
+		arguments->isNumberOfThreadsSelected ||
+		arguments->isSeedSelected ||
+		arguments->isSamplingStrategySelected ||
+		arguments->isShardSelected)
+	{
+		if (!arguments->common.isMonteCarloMode)
+		{
+			fprintf(
+				stderr,
+				"Error: The random number generator (-r option), number of threads (-t option), seed (-s option), sampling strategy (-V option), and shard (-d option) are only supported in Monte Carlo mode.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (arguments->isNumberOfThreadsSelected)
+		{
+			int	numberOfThreads;
+
+			if ((parseIntChecked(numberOfThreadsArg, &numberOfThreads) != kCommonConstantReturnTypeSuccess) ||
+				(numberOfThreads < 1) ||
+				(numberOfThreads > kMonteCarloMaximumNumberOfThreads))
+			{
+				fprintf(stderr, "Error: The number of threads (-t option) must be an integer between 1 and %d.\n", kMonteCarloMaximumNumberOfThreads);
+
+				return kCommonConstantReturnTypeError;
+			}
+
+			arguments->numberOfThreads = (size_t)numberOfThreads;
+		}
+
+		if (arguments->isSeedSelected && (parseSeed(seedArg, &arguments->seed) != kCommonConstantReturnTypeSuccess))
+		{
+			fprintf(stderr, "Error: The seed (-s option) must be a non-negative 64-bit integer.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (((arguments->randomNumberGeneratorType == kRandomNumberGeneratorTypeSobol) ||
+			(arguments->randomNumberGeneratorType == kRandomNumberGeneratorTypeSobolScrambled)) &&
+			((uint64_t)arguments->common.numberOfMonteCarloIterations > kSobolSequenceMaximumNumberOfPoints))
+		{
+			fprintf(stderr, "Error: The Sobol sequence has at most %" PRIu64 " points (-M option).\n", kSobolSequenceMaximumNumberOfPoints);
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (((arguments->samplingStrategy == kSamplingStrategyStratified) || (arguments->samplingStrategy == kSamplingStrategyLatinHypercube)) &&
+			((uint64_t)arguments->common.numberOfMonteCarloIterations > kSamplingStrategyMaximumNumberOfSamples))
+		{
+			fprintf(
+				stderr,
+				"Error: The stratified and Latin hypercube sampling strategies (-V option) support at most %llu samples (-M option).\n",
+				kSamplingStrategyMaximumNumberOfSamples);
+
+			return kCommonConstantReturnTypeError;
+		}
+	}
+
+	/*
+	 *	A shard keeps only the statistics and quantile sketches of its outputs
+	 *	(and its histograms), which merge exactly. Adaptive stopping would end
+	 *	the shards of a run after different numbers of iterations.
+	 */
+	if (arguments->isShardSelected)
+	{
+		if (parseShardSpecification(shardArg, &arguments->shardIndex, &arguments->numberOfShards) != kCommonConstantReturnTypeSuccess)
+		{
+			fprintf(stderr, "Error: The shard (-d option) must be k/n, the 0-indexed shard k of n shards, with n at most %d.\n", kShardMaximumNumberOfShards);
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (arguments->numberOfShards > arguments->common.numberOfMonteCarloIterations)
+		{
+			fprintf(stderr, "Error: The number of shards (-d option) must be at most the number of iterations (-M option).\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (arguments->isAdaptiveStoppingEnabled)
+		{
+			fprintf(stderr, "Error: The shard (-d option) does not support the target half-width (-e option).\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		arguments->isStreamingStatisticsEnabled = true;
+		arguments->isQuantileSketchEnabled = true;
+	}
+
+	/*
+	 *	Merging the partial-state files of shards runs no iterations, and
+	 *	reports the merged statistics like a Monte Carlo run with streaming
+	 *	statistics and quantile sketches. The files set the histograms.
+	 */
+	if (arguments->isMergeEnabled)
+	{
+		if (arguments->common.isMonteCarloMode ||
+			arguments->isAdcCodeInputEnabled ||
+			arguments->isHistogramEnabled ||
+			arguments->isAdaptiveStoppingEnabled ||
+			arguments->isCheckpointEnabled)
+		{
+			fprintf(
+				stderr,
+				"Error: The merge (-m option) runs no iterations, so it does not support the Monte Carlo mode (-M option), ADC code input, histogram (-H option), target half-width (-e option), or checkpoints (-c option).\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		arguments->mergeFilePaths = mergeArg;
+		arguments->common.isMonteCarloMode = true;
+		arguments->isStreamingStatisticsEnabled = true;
+		arguments->isQuantileSketchEnabled = true;
+	}
+
+	/*
+	 *	A checkpoint holds the partial state of the run (or of its shard), so,
+	 *	like a shard, it keeps only the statistics and quantile sketches of the
+	 *	outputs, and the intervals do not support adaptive stopping.
 	 */
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wmissing-braces"
+	if (arguments->isCheckpointEnabled)
+	{
+		int	checkpointInterval;
 
-	*arguments = (CommandLineArguments)
+		if (!arguments->common.isMonteCarloMode)
+		{
+			fprintf(stderr, "Error: Checkpoints (-c option) are only supported in Monte Carlo mode.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if ((parseIntChecked(checkpointIntervalArg, &checkpointInterval) != kCommonConstantReturnTypeSuccess) || (checkpointInterval < 1))
+		{
+			fprintf(stderr, "Error: The checkpoint interval (-c option) must be a positive number of iterations.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (arguments->isAdaptiveStoppingEnabled)
+		{
+			fprintf(stderr, "Error: Checkpoints (-c option) do not support the target half-width (-e option).\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		arguments->checkpointInterval = (size_t)checkpointInterval;
+		arguments->isStreamingStatisticsEnabled = true;
+		arguments->isQuantileSketchEnabled = true;
+
+		if (arguments->isCheckpointFilePathSelected)
+		{
+			if (snprintf(arguments->checkpointFilePath, sizeof(arguments->checkpointFilePath), "%s", checkpointFilePathArg) >= (int)sizeof(arguments->checkpointFilePath))
+			{
+				fprintf(stderr, "Error: The checkpoint file path (-C option) is too long.\n");
+
+				return kCommonConstantReturnTypeError;
+			}
+		}
+		else if (arguments->isShardSelected)
+		{
+			snprintf(
+				arguments->checkpointFilePath,
+				sizeof(arguments->checkpointFilePath),
+				kCheckpointShardDefaultFilePathFormat,
+				arguments->shardIndex,
+				arguments->numberOfShards);
+		}
+	}
+	else if (arguments->isCheckpointFilePathSelected || arguments->isResumeEnabled)
 	{
-		.common	= (CommonCommandLineArguments) {0}
-	};
-#pragma GCC diagnostic pop
+		fprintf(stderr, "Error: The checkpoint file (-C option) and resume (-u option) require checkpoints (-c option).\n");
 
-	return;
-}
+		return kCommonConstantReturnTypeError;
+	}
 
-CommonConstantReturnType
-getCommandLineArguments(
-	int			argc,
-	char *			argv[],
-	CommandLineArguments *	arguments)
-{
-	DemoOption		demoSpecificOptions = {0};
+	if (arguments->isStreamingStatisticsEnabled && !arguments->common.isMonteCarloMode)
+	{
+		fprintf(stderr, "Error: Streaming statistics (-W option) are only supported in Monte Carlo mode.\n");
 
-	if (arguments == NULL)
+		return kCommonConstantReturnTypeError;
+	}
+
+	if (arguments->isQuantileSketchEnabled && !arguments->common.isMonteCarloMode)
 	{
-		fprintf(stderr, "Arguments pointer is NULL.\n");
+		fprintf(stderr, "Error: Quantile sketches (-P option) are only supported in Monte Carlo mode.\n");
 
 		return kCommonConstantReturnTypeError;
 	}
 
-	setDefaultCommandLineArguments(arguments);
+	if (arguments->isHistogramEnabled)
+	{
+		if (!arguments->common.isMonteCarloMode)
+		{
+			fprintf(stderr, "Error: Histograms (-H option) are only supported in Monte Carlo mode.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (parseHistogramSpecification(
+			histogramArg,
+			&arguments->histogramNumberOfBins,
+			&arguments->isHistogramRangeSelected,
+			&arguments->histogramLow,
+			&arguments->histogramHigh) != kCommonConstantReturnTypeSuccess)
+		{
+			fprintf(
+				stderr,
+				"Error: The histogram (-H option) must be a number of bins between 1 and %d, optionally followed by a range low,high with low < high.\n",
+				kHistogramMaximumNumberOfBins);
+
+			return kCommonConstantReturnTypeError;
+		}
+	}
+
+	if (arguments->isHistogramFilePathSelected)
+	{
+		if (!arguments->isHistogramEnabled && !arguments->isMergeEnabled)
+		{
+			fprintf(stderr, "Error: The histogram file path (-g option) requires a histogram (-H option) or a merge (-m option).\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (snprintf(arguments->histogramFilePath, sizeof(arguments->histogramFilePath), "%s", histogramFilePathArg) >= (int)sizeof(arguments->histogramFilePath))
+		{
+			fprintf(stderr, "Error: The histogram file path (-g option) is too long.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+	}
 
 	/*
-	 *	This application example has no application specific arguments.
+	 *	Adaptive stopping runs the iterations in batches, so the stratified
+	 *	and Latin hypercube strategies, whose strata span all iterations of
+	 *	the -M option, would only cover part of the inputs when it stops early.
 	 */
-	if (parseArgs(argc, argv, &arguments->common, &demoSpecificOptions) != 0)
+	if (arguments->isAdaptiveStoppingEnabled)
 	{
-		fprintf(stderr, "Parsing command line arguments failed\n");
-		printUsage();
+		if (!arguments->common.isMonteCarloMode)
+		{
+			fprintf(stderr, "Error: The target half-width (-e option) is only supported in Monte Carlo mode.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (parseTargetHalfWidth(targetHalfWidthArg, &arguments->targetHalfWidth, &arguments->isTargetHalfWidthRelative) != kCommonConstantReturnTypeSuccess)
+		{
+			fprintf(stderr, "Error: The target half-width (-e option) must be a positive number of Pascal, or a positive percentage with a %% suffix.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if ((arguments->samplingStrategy == kSamplingStrategyStratified) || (arguments->samplingStrategy == kSamplingStrategyLatinHypercube))
+		{
+			fprintf(stderr, "Error: The target half-width (-e option) does not support the stratified and Latin hypercube sampling strategies (-V option).\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (arguments->isTargetQuantileSelected)
+		{
+			if ((parseDoubleChecked(targetQuantileArg, &arguments->targetQuantile) != kCommonConstantReturnTypeSuccess) ||
+				!(arguments->targetQuantile > 0.0) ||
+				!(arguments->targetQuantile < 1.0))
+			{
+				fprintf(stderr, "Error: The target quantile (-p option) must be a number between 0 and 1.\n");
+
+				return kCommonConstantReturnTypeError;
+			}
+
+			if (arguments->isStreamingStatisticsEnabled)
+			{
+				fprintf(stderr, "Error: The target quantile (-p option) requires the output samples, which streaming statistics (-W option) do not store.\n");
+
+				return kCommonConstantReturnTypeError;
+			}
+		}
+
+		if (arguments->isTimeLimitSelected &&
+			((parseDoubleChecked(timeLimitArg, &arguments->timeLimitSeconds) != kCommonConstantReturnTypeSuccess) ||
+			!(arguments->timeLimitSeconds > 0.0)))
+		{
+			fprintf(stderr, "Error: The time limit (-l option) must be a positive number of seconds.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+	}
+	else if (arguments->isTargetQuantileSelected || arguments->isTimeLimitSelected)
+	{
+		fprintf(stderr, "Error: The target quantile (-p option) and time limit (-l option) require a target half-width (-e option).\n");
 
 		return kCommonConstantReturnTypeError;
 	}
 
 	/*
-	 *	Process command-line arguments
+	 *	The importance sampling queries are relative to the means of the
+	 *	outputs of the run, which the merge of partial-state files also has,
+	 *	but they draw their own inputs from the Philox generator.
 	 */
-	if (arguments->common.isHelpEnabled)
+	if (arguments->isImportanceSamplingEnabled)
 	{
-		printUsage();
+		if (!arguments->common.isMonteCarloMode)
+		{
+			fprintf(stderr, "Error: Importance sampling (-I option) is only supported in Monte Carlo mode.\n");
 
-		exit(EXIT_SUCCESS);
+			return kCommonConstantReturnTypeError;
+		}
+
+		if (parseTailDeviations(tailDeviationsArg, arguments->tailDeviations, &arguments->numberOfTailDeviations) != kCommonConstantReturnTypeSuccess)
+		{
+			fprintf(
+				stderr,
+				"Error: The importance sampling deviations (-I option) must be a comma-separated list of at most %d numbers between 0 and 1.\n",
+				kImportanceSamplingMaximumNumberOfDeviations);
+
+			return kCommonConstantReturnTypeError;
+		}
 	}
 
-	if (arguments->common.isInputFromFileEnabled)
+	if (arguments->isAnalyticDistributionEnabled && arguments->isAdcCodeInputEnabled)
 	{
-		fprintf(stderr, "Reading inputs from CSV file is not currently supported\n");
+		fprintf(stderr, "Error: The exact distribution (-x option) is for the uniform inputs, so it does not support the ADC code input mode.\n");
 
 		return kCommonConstantReturnTypeError;
 	}
 
 	/*
-	 *	Write to output file is not supported in MonteCarlo Mode.
+	 *	The grid propagation mode calibrates a grid of the inputs instead of
+	 *	running the application, and only uses the -M option as the number of
+	 *	samples of the Monte Carlo reference of its convergence report.
 	 */
-	if (arguments->common.isWriteToFileEnabled && arguments->common.isMonteCarloMode)
+	if (arguments->isGridPropagationEnabled)
 	{
-		fprintf(stderr, "Writing to output file is not supported in MonteCarlo Mode.\n");
+		int	gridSize;
+
+		if (arguments->isAdcCodeInputEnabled)
+		{
+			fprintf(stderr, "Error: The grid propagation mode (-n option) does not support the ADC code input mode.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if ((parseIntChecked(gridSizeArg, &gridSize) != kCommonConstantReturnTypeSuccess) ||
+			(gridSize < 2) ||
+			(gridSize > kGridPropagationMaximumGridSize))
+		{
+			fprintf(stderr, "Error: The number of grid points per input (-n option) must be an integer between 2 and %d.\n", kGridPropagationMaximumGridSize);
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		arguments->gridSize = (size_t)gridSize;
+
+		/*
+		 *	Any input distribution that is not one of the named ones is the
+		 *	path of a file of samples.
+		 */
+		if (arguments->isGridInputDistributionSelected &&
+			(parseGridInputDistributionName(gridInputDistributionArg, &arguments->gridInputDistributionType) != kCommonConstantReturnTypeSuccess))
+		{
+			arguments->gridInputDistributionType = kGridInputDistributionEmpirical;
+			arguments->gridInputFilePath = gridInputDistributionArg;
+		}
+		else if (arguments->gridInputDistributionType == kGridInputDistributionEmpirical)
+		{
+			fprintf(stderr, "Error: The empirical input distribution (-E option) is given by the path of its file of samples.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+	}
+	else if (arguments->isGridConvergenceReportEnabled || arguments->isGridInputDistributionSelected)
+	{
+		fprintf(stderr, "Error: The grid convergence report (-w option) and input distribution (-E option) require the grid propagation mode (-n option).\n");
 
 		return kCommonConstantReturnTypeError;
 	}
 
+	if (arguments->isParticlePropagationEnabled)
+	{
+		int	numberOfParticles;
+
+		if (arguments->isAdcCodeInputEnabled || arguments->isGridPropagationEnabled)
+		{
+			fprintf(stderr, "Error: The particle propagation mode (-D option) does not support the ADC code input mode or the grid propagation mode (-n option).\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		if ((parseIntChecked(numberOfParticlesArg, &numberOfParticles) != kCommonConstantReturnTypeSuccess) ||
+			(numberOfParticles < 2) ||
+			(numberOfParticles > kParticleDistributionMaximumNumberOfParticles))
+		{
+			fprintf(stderr, "Error: The number of particles (-D option) must be an integer between 2 and %d.\n", kParticleDistributionMaximumNumberOfParticles);
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		arguments->numberOfParticles = (size_t)numberOfParticles;
+	}
+
+	/*
+	 *	The Wasserstein distance needs the stored output samples of a
+	 *	benchmarking run in Monte Carlo mode.
+	 */
+	if (arguments->isWassersteinReferenceSelected)
+	{
+		if (!arguments->common.isBenchmarkingMode || !arguments->common.isMonteCarloMode || arguments->isStreamingStatisticsEnabled)
+		{
+			fprintf(stderr, "Error: The Wasserstein distance (-Z option) requires the benchmarking mode (-b) in Monte Carlo mode (-M), with the output samples stored, so not with the -W, -d, -m, or -c options.\n");
+
+			return kCommonConstantReturnTypeError;
+		}
+
+		arguments->wassersteinReferenceFilePath = wassersteinReferenceArg;
+	}
+
 	if (arguments->common.isVerbose)
 	{
 		fprintf(stderr, "Warning: Verbose mode not supported. Continuing in non-verbose mode.\n");
@@ -149,15 +1132,18 @@ getCommandLineArguments(
 			"Output select value (-S option) is greater than the possible number of outputs: Provided %zd. Max: %d\n",
 			arguments->common.outputSelect,
 			kOutputDistributionIndexCalibratedSensorOutputMax);
+
+		return kCommonConstantReturnTypeError;
 	}
 	/*
-	 *	When all outputs are selected, we cannot be in benchmarking mode or Monte Carlo mode.
+	 *	When all outputs are selected, we cannot be in benchmarking mode. In Monte Carlo
+	 *	mode, all outputs are calculated from the same input samples.
 	 */
 	else if (arguments->common.outputSelect == kOutputDistributionIndexCalibratedSensorOutputMax)
 	{
-		if ((arguments->common.isBenchmarkingMode) || (arguments->common.isMonteCarloMode))
+		if (arguments->common.isBenchmarkingMode)
 		{
-			fprintf(stderr, "Error: Please select a single output when in benchmarking mode or Monte Carlo mode.\n");
+			fprintf(stderr, "Error: Please select a single output when in benchmarking mode.\n");
 
 			return kCommonConstantReturnTypeError;
 		}
@@ -166,6 +1152,26 @@ getCommandLineArguments(
 	return kCommonConstantReturnTypeSuccess;
 }
 
+void
+getSelectedOutputBounds(
+	CommandLineArguments *		arguments,
+	OutputDistributionIndex *	outputSelectLowerBound,
+	OutputDistributionIndex *	outputSelectUpperBound)
+{
+	if (arguments->common.outputSelect == kOutputDistributionIndexCalibratedSensorOutputMax)
+	{
+		*outputSelectLowerBound = (OutputDistributionIndex)0;
+		*outputSelectUpperBound = kOutputDistributionIndexCalibratedSensorOutputMax;
+	}
+	else
+	{
+		*outputSelectLowerBound = arguments->common.outputSelect;
+		*outputSelectUpperBound = *outputSelectLowerBound + 1;
+	}
+
+	return;
+}
+
 void
 printCalibratedValueAndProbabilities(double calibratedSensorOutput, const char *  variableDescription)
 {
@@ -234,48 +1240,202 @@ populateJSONVariableStruct(
 
 void
 printJSONFormattedOutput(
-	CommandLineArguments *	arguments,
-	double *		monteCarloOutputSamples,
-	double *		outputDistributions,
-	const char **		outputVariableDescriptions)
+	CommandLineArguments *		arguments,
+	MonteCarloOutputSamples *	monteCarloOutputSamples,
+	double *			outputDistributions,
+	QuantileSketch *		quantileSketches,
+	const char **			outputVariableDescriptions)
 {
-	JSONVariable			jsonVariables[kOutputDistributionIndexCalibratedSensorOutputMax];
+	JSONVariable			jsonVariables[2 * kOutputDistributionIndexCalibratedSensorOutputMax];
+	double				quantiles[kOutputDistributionIndexCalibratedSensorOutputMax][kQuantileSketchNumberOfQuantiles];
+	const double			probabilities[kQuantileSketchNumberOfQuantiles] = kQuantileSketchProbabilities;
+	size_t				numberOfJSONVariables = 0;
 	OutputDistributionIndex		outputSelectLowerBound;
 	OutputDistributionIndex		outputSelectUpperBound;
 
-	if (arguments->common.outputSelect == kOutputDistributionIndexCalibratedSensorOutputMax)
-	{
-		outputSelectLowerBound = (OutputDistributionIndex)0;
-		outputSelectUpperBound = kOutputDistributionIndexCalibratedSensorOutputMax;
-	}
-	else
-	{
-		outputSelectLowerBound = arguments->common.outputSelect;
-		outputSelectUpperBound = outputSelectLowerBound + 1;
-	}
+	getSelectedOutputBounds(arguments, &outputSelectLowerBound, &outputSelectUpperBound);
 
 	for (OutputDistributionIndex outputSelect = outputSelectLowerBound; outputSelect < outputSelectUpperBound; outputSelect++)
 	{
 		/*
-		 *	If in Monte Carlo mode, `pointerToOutputVariable` points to the beginning of the `monteCarloOutputSamples` array.
-		 *	In this case, `arguments.common.numberOfMonteCarloIterations` is the length of the `monteCarloOutputSamples` array.
-		 *	Else, it points to the entry of the `outputVariables` to be used.
-		 *	In this case, `arguments.common.numberOfMonteCarloIterations` equals 1.
+		 *	If in Monte Carlo mode, `pointerToOutputVariable` points to the beginning of the `monteCarloOutputSamples` array
+		 *	of the output. In this case, `arguments.common.numberOfMonteCarloIterations` is the length of that array.
+		 *	Else, or if the streaming statistics mode does not store the samples, it points to the entry of the
+		 *	`outputVariables` to be used (the mean, in Monte Carlo mode), and there is one value.
 		 */
-		double *	pointerToOutputVariable = arguments->common.isMonteCarloMode ? monteCarloOutputSamples : &outputDistributions[outputSelect];
+		bool		isSamplesStored = arguments->common.isMonteCarloMode && !arguments->isStreamingStatisticsEnabled;
+		double *	pointerToOutputVariable = isSamplesStored ? monteCarloOutputSamples->asDouble[outputSelect] : &outputDistributions[outputSelect];
 
 		populateJSONVariableStruct(
-			&jsonVariables[outputSelect],
+			&jsonVariables[numberOfJSONVariables],
 			pointerToOutputVariable,
 			outputVariableDescriptions[outputSelect],
 			outputSelect,
-			arguments->common.numberOfMonteCarloIterations);
+			isSamplesStored ? arguments->common.numberOfMonteCarloIterations : 1);
+
+		/*
+		 *	In single precision mode, the samples are floats.
+		 */
+		if (isSamplesStored && arguments->isSinglePrecisionEnabled)
+		{
+			jsonVariables[numberOfJSONVariables].values = (JSONVariablePointer){ .asFloat = monteCarloOutputSamples->asFloat[outputSelect] };
+			jsonVariables[numberOfJSONVariables].type = kJSONVariableTypeFloat;
+		}
+
+		numberOfJSONVariables++;
+	}
+
+	/*
+	 *	With quantile sketches, print the quantiles of each output as one
+	 *	more variable, e.g., `outputQuantiles[0]`, whose description lists
+	 *	their probabilities.
+	 */
+	if (quantileSketches != NULL)
+	{
+		for (OutputDistributionIndex outputSelect = outputSelectLowerBound; outputSelect < outputSelectUpperBound; outputSelect++)
+		{
+			JSONVariable *	jsonVariable = &jsonVariables[numberOfJSONVariables++];
+			int		descriptionLength;
+
+			getQuantileSketchQuantiles(&quantileSketches[outputSelect], quantiles[outputSelect]);
+			populateJSONVariableStruct(
+				jsonVariable,
+				quantiles[outputSelect],
+				outputVariableDescriptions[outputSelect],
+				outputSelect,
+				kQuantileSketchNumberOfQuantiles);
+			snprintf(jsonVariable->variableSymbol, kCommonConstantMaxCharsPerJSONVariableSymbol, "outputQuantiles[%u]", outputSelect);
+			descriptionLength = snprintf(
+						jsonVariable->variableDescription,
+						kCommonConstantMaxCharsPerJSONVariableDescription,
+						"%s quantiles",
+						outputVariableDescriptions[outputSelect]);
+
+			for (size_t i = 0; (i < kQuantileSketchNumberOfQuantiles) && (descriptionLength < kCommonConstantMaxCharsPerJSONVariableDescription); i++)
+			{
+				descriptionLength += snprintf(
+							&jsonVariable->variableDescription[descriptionLength],
+							kCommonConstantMaxCharsPerJSONVariableDescription - descriptionLength,
+							"%s p%g",
+							(i == 0) ? "" : ",",
+							probabilities[i] * 100.0);
+			}
+		}
 	}
 
 	printJSONVariables(
-		&jsonVariables[outputSelectLowerBound],
-		outputSelectUpperBound - outputSelectLowerBound,
+		jsonVariables,
+		numberOfJSONVariables,
 		"SDP8x6 Sensor Calibration Use Case");
 
 	return;
 }
+
+CommonConstantReturnType
+saveMonteCarloDoubleDataToFile(
+	const char *	filePath,
+	double *	monteCarloOutputSamples,
+	uint64_t	cpuTimeUsedInMicroSeconds,
+	size_t		numberOfMonteCarloIterations)
+{
+	FILE *	file = fopen(filePath, "w");
+
+	if (file == NULL)
+	{
+		fprintf(stderr, "Error: Could not open \"%s\" for writing.\n", filePath);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	fprintf(file, "%" PRIu64 "\n", cpuTimeUsedInMicroSeconds);
+
+	for (size_t i = 0; i < numberOfMonteCarloIterations; i++)
+	{
+		fprintf(file, "%lf\n", monteCarloOutputSamples[i]);
+	}
+
+	fclose(file);
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+CommonConstantReturnType
+saveMonteCarloFloatDataToFile(
+	const char *	filePath,
+	float *		monteCarloOutputSamples,
+	uint64_t	cpuTimeUsedInMicroSeconds,
+	size_t		numberOfMonteCarloIterations)
+{
+	FILE *	file = fopen(filePath, "w");
+
+	if (file == NULL)
+	{
+		fprintf(stderr, "Error: Could not open \"%s\" for writing.\n", filePath);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	fprintf(file, "%" PRIu64 "\n", cpuTimeUsedInMicroSeconds);
+
+	for (size_t i = 0; i < numberOfMonteCarloIterations; i++)
+	{
+		fprintf(file, "%f\n", monteCarloOutputSamples[i]);
+	}
+
+	fclose(file);
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+/**
+ *	@brief  Sums `f(samples[i])` for `f(x) = (x - offset)^power`, with `power` either 1 or 2,
+ *		using pairwise summation in single precision.
+ *
+ *	@param  samples			: The array of samples.
+ *	@param  numberOfSamples		: The number of samples in `samples`.
+ *	@param  offset			: The offset subtracted from each sample.
+ *	@param  power			: 1 to sum the offset samples, 2 to sum their squares.
+ *	@return float			: The sum.
+ */
+static float
+calculatePairwiseSumOfFloatSamples(float *  samples, size_t numberOfSamples, float offset, int power)
+{
+	float	sum = 0.0f;
+
+	if (numberOfSamples <= kPairwiseSummationBaseCaseSize)
+	{
+		for (size_t i = 0; i < numberOfSamples; i++)
+		{
+			float	deviation = samples[i] - offset;
+
+			sum += (power == 2) ? (deviation * deviation) : deviation;
+		}
+
+		return sum;
+	}
+
+	return	calculatePairwiseSumOfFloatSamples(samples, numberOfSamples / 2, offset, power) +
+		calculatePairwiseSumOfFloatSamples(&samples[numberOfSamples / 2], numberOfSamples - numberOfSamples / 2, offset, power);
+}
+
+MeanAndVariance
+calculateMeanAndVarianceOfFloatSamples(float *  samples, size_t numberOfSamples)
+{
+	MeanAndVariance	meanAndVariance = {0};
+	float		mean;
+
+	if (numberOfSamples == 0)
+	{
+		return meanAndVariance;
+	}
+
+	mean = calculatePairwiseSumOfFloatSamples(samples, numberOfSamples, 0.0f, 1) / (float)numberOfSamples;
+	meanAndVariance.mean = mean;
+
+	if (numberOfSamples > 1)
+	{
+		meanAndVariance.variance = calculatePairwiseSumOfFloatSamples(samples, numberOfSamples, mean, 2) / (float)(numberOfSamples - 1);
+	}
+
+	return meanAndVariance;
+}
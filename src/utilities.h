@@ -24,12 +24,92 @@
 
 #include "common.h"
 #include "utilities-config.h"
+#include "calibration.h"
+#include "random-number-generator.h"
+#include "sampling-strategy.h"
+#include "quantile-sketch.h"
+#include "grid-propagation.h"
 
 typedef struct
 {
 	CommonCommandLineArguments	common;
+	bool				isCalibrationKernelSelected;
+	CalibrationKernelImplementation	calibrationKernelImplementation;
+	bool				isCalibrationKernelSelfTestEnabled;
+	bool				isCalibrationKernelBenchmarkEnabled;
+	bool				isSinglePrecisionEnabled;
+	bool				isAdcCodeInputEnabled;
+	bool				isAdcCodePairSelected;
+	uint32_t			adcAoutCode;
+	uint32_t			adcVddCode;
+	bool				isAdcBitDepthSelected;
+	uint32_t			adcBitDepth;
+	bool				isAdcReferenceVoltageSelected;
+	double				adcReferenceVoltage;
+	bool				isLookupTableEnabled;
+	size_t				lookupTableNumberOfIntervals;
+	bool				isNumberOfThreadsSelected;
+	size_t				numberOfThreads;
+	bool				isSeedSelected;
+	uint64_t			seed;
+	bool				isRandomNumberGeneratorSelected;
+	RandomNumberGeneratorType	randomNumberGeneratorType;
+	bool				isStreamingStatisticsEnabled;
+	bool				isQuantileSketchEnabled;
+	bool				isHistogramEnabled;
+	size_t				histogramNumberOfBins;
+	bool				isHistogramRangeSelected;
+	double				histogramLow;
+	double				histogramHigh;
+	bool				isHistogramFilePathSelected;
+	char				histogramFilePath[kCommonConstantMaxCharsPerFilepath];
+	bool				isQuasiMonteCarloConvergenceReportEnabled;
+	bool				isSamplingStrategySelected;
+	SamplingStrategy		samplingStrategy;
+	bool				isAdaptiveStoppingEnabled;
+	double				targetHalfWidth;
+	bool				isTargetHalfWidthRelative;
+	bool				isTargetQuantileSelected;
+	double				targetQuantile;
+	bool				isTimeLimitSelected;
+	double				timeLimitSeconds;
+	bool				isShardSelected;
+	size_t				shardIndex;
+	size_t				numberOfShards;
+	bool				isMergeEnabled;
+	const char *			mergeFilePaths;
+	bool				isCheckpointEnabled;
+	size_t				checkpointInterval;
+	bool				isCheckpointFilePathSelected;
+	char				checkpointFilePath[kCommonConstantMaxCharsPerFilepath];
+	bool				isResumeEnabled;
+	bool				isImportanceSamplingEnabled;
+	size_t				numberOfTailDeviations;
+	double				tailDeviations[kImportanceSamplingMaximumNumberOfDeviations];
+	bool				isAnalyticDistributionEnabled;
+	bool				isGridPropagationEnabled;
+	size_t				gridSize;
+	bool				isGridConvergenceReportEnabled;
+	bool				isGridInputDistributionSelected;
+	GridInputDistributionType	gridInputDistributionType;
+	const char *			gridInputFilePath;
+	bool				isParticlePropagationEnabled;
+	size_t				numberOfParticles;
+	bool				isWassersteinReferenceSelected;
+	const char *			wassersteinReferenceFilePath;
 } CommandLineArguments;
 
+/*
+ *	The output samples of the native Monte Carlo mode, per output, indexed by
+ *	`OutputDistributionIndex`. Depending on `CommandLineArguments.isSinglePrecisionEnabled`,
+ *	either the `asDouble` or the `asFloat` arrays of the selected outputs are used.
+ */
+typedef struct
+{
+	double *	asDouble[kOutputDistributionIndexCalibratedSensorOutputMax];
+	float *		asFloat[kOutputDistributionIndexCalibratedSensorOutputMax];
+} MonteCarloOutputSamples;
+
 /**
  *	@brief	Print out command-line usage.
  */
@@ -46,6 +126,19 @@ void	printUsage(void);
  */
 CommonConstantReturnType getCommandLineArguments(int argc, char *  argv[], CommandLineArguments *  arguments);
 
+/**
+ *	@brief  Gets the range of outputs selected via the command-line arguments: either a single
+ *		output, or all outputs.
+ *
+ *	@param  arguments		: Pointer to command-line arguments struct.
+ *	@param  outputSelectLowerBound	: Pointer to where the function writes the first selected output.
+ *	@param  outputSelectUpperBound	: Pointer to where the function writes one past the last selected output.
+ */
+void	getSelectedOutputBounds(
+		CommandLineArguments *		arguments,
+		OutputDistributionIndex *	outputSelectLowerBound,
+		OutputDistributionIndex *	outputSelectUpperBound);
+
 /**
  *	@brief  Prints the output of the evaluation in a human-readable form.
  *
@@ -75,12 +168,60 @@ void	populateJSONVariableStruct(
  *		a single value or all values stored in `outputDistributions`.
  *
  *	@param  arguments			: The command-line arguments, specifying which outputs will be printed.
- *	@param  monteCarloOutputSamples		: The array of data samples of Monte Carlo.
+ *	@param  monteCarloOutputSamples		: The data samples of Monte Carlo.
  *	@param  outputDistributions 		: The array that stores the distributions to be printed.
+ *	@param  quantileSketches		: Array of `kOutputDistributionIndexCalibratedSensorOutputMax` quantile sketches of the
+ *						  outputs, whose quantiles are printed as one more variable per output, or `NULL`.
  *	@param  outputVariableDescriptions	: An array of strings containing the descriptions of the variables to be printed.
  */
 void	printJSONFormattedOutput(
-		CommandLineArguments *	arguments,
-		double *		monteCarloOutputSamples,
-		double *		outputDistributions,
-		const char **		outputVariableDescriptions);
+		CommandLineArguments *		arguments,
+		MonteCarloOutputSamples *	monteCarloOutputSamples,
+		double *			outputDistributions,
+		QuantileSketch *		quantileSketches,
+		const char **			outputVariableDescriptions);
+
+/**
+ *	@brief  Saves Monte Carlo output samples to a file, in the same format as `data.out`:
+ *		the first line contains the execution time in microseconds and each next line
+ *		contains an output sample value.
+ *
+ *	@param  filePath			: The path of the file to write.
+ *	@param  monteCarloOutputSamples		: The array of data samples of Monte Carlo.
+ *	@param  cpuTimeUsedInMicroSeconds	: The execution time in microseconds.
+ *	@param  numberOfMonteCarloIterations	: The number of samples in `monteCarloOutputSamples`.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	saveMonteCarloDoubleDataToFile(
+					const char *	filePath,
+					double *	monteCarloOutputSamples,
+					uint64_t	cpuTimeUsedInMicroSeconds,
+					size_t		numberOfMonteCarloIterations);
+
+/**
+ *	@brief  Saves single-precision Monte Carlo output samples to a file, in the same format as `data.out`.
+ *
+ *	@param  filePath			: The path of the file to write.
+ *	@param  monteCarloOutputSamples		: The array of data samples of Monte Carlo.
+ *	@param  cpuTimeUsedInMicroSeconds	: The execution time in microseconds.
+ *	@param  numberOfMonteCarloIterations	: The number of samples in `monteCarloOutputSamples`.
+ *	@return					: `kCommonConstantReturnTypeSuccess` if successful,
+ *						   else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	saveMonteCarloFloatDataToFile(
+					const char *	filePath,
+					float *		monteCarloOutputSamples,
+					uint64_t	cpuTimeUsedInMicroSeconds,
+					size_t		numberOfMonteCarloIterations);
+
+/**
+ *	@brief  Calculates the mean and variance of single-precision samples, in single precision.
+ *		Uses pairwise summation, so that the rounding error grows with the logarithm of
+ *		the number of samples rather than linearly.
+ *
+ *	@param  samples			: The array of samples.
+ *	@param  numberOfSamples		: The number of samples in `samples`.
+ *	@return MeanAndVariance		: The mean and (unbiased) variance of the samples.
+ */
+MeanAndVariance	calculateMeanAndVarianceOfFloatSamples(float *  samples, size_t numberOfSamples);
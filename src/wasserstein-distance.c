@@ -0,0 +1,387 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "wasserstein-distance.h"
+#include "utilities-config.h"
+#include "random-number-generator.h"
+
+/**
+ *	@brief  Compares two doubles, for `qsort()`.
+ *
+ *	@param  a	: Pointer to the first double.
+ *	@param  b	: Pointer to the second double.
+ *	@return int	: Negative, zero, or positive if the first is smaller than, equal to, or greater than the second.
+ */
+static int
+compareDoubles(const void *  a, const void *  b)
+{
+	double	x = *(const double *)a;
+	double	y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ *	@brief  Returns the CDF of the reference distribution between two consecutive points: after
+ *		the points before `pointIndex`, and before the point `pointIndex`.
+ *
+ *	@param  reference	: Pointer to the reference distribution.
+ *	@param  pointIndex	: The number of points at or before the value.
+ *	@param  value		: The value, which must be between the points `pointIndex - 1` and `pointIndex`.
+ *	@return double		: The CDF at the value.
+ */
+static double
+getReferenceCdf(const WassersteinReference *  reference, size_t pointIndex, double value)
+{
+	double	previousProbability;
+	double	fraction;
+
+	if (pointIndex == 0)
+	{
+		return 0.0;
+	}
+
+	previousProbability = reference->cumulativeProbabilities[pointIndex - 1];
+
+	if (!reference->isPiecewiseLinear || (pointIndex == reference->numberOfPoints))
+	{
+		return previousProbability;
+	}
+
+	fraction = (value - reference->values[pointIndex - 1]) / (reference->values[pointIndex] - reference->values[pointIndex - 1]);
+
+	return previousProbability + fraction * (reference->cumulativeProbabilities[pointIndex] - previousProbability);
+}
+
+/**
+ *	@brief  Returns the integral of the absolute difference of a constant and of a linear function
+ *		over an interval, given the differences at its ends, which may have opposite signs.
+ *
+ *	@param  width			: The width of the interval.
+ *	@param  startDifference		: The difference at the start of the interval.
+ *	@param  endDifference		: The difference at the end of the interval.
+ *	@return double			: The integral.
+ */
+static double
+getAbsoluteDifferenceIntegral(double width, double startDifference, double endDifference)
+{
+	if ((startDifference >= 0.0) == (endDifference >= 0.0))
+	{
+		return width * fabs(0.5 * (startDifference + endDifference));
+	}
+
+	/*
+	 *	The difference changes sign inside the interval: two triangles.
+	 */
+	return 0.5 * width * (startDifference * startDifference + endDifference * endDifference) / (fabs(startDifference) + fabs(endDifference));
+}
+
+CommonConstantReturnType
+loadWassersteinReference(const char *  filePath, WassersteinReference *  reference)
+{
+	char				line[kWassersteinDistanceMaxCharsPerLine];
+	size_t				capacity = kMonteCarloSampleBlockSize;
+	size_t				lineNumber = 0;
+	FILE *				file;
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	*reference = (WassersteinReference)
+			{
+				.values				= NULL,
+				.cumulativeProbabilities	= NULL,
+				.numberOfPoints			= 0,
+				.isPiecewiseLinear		= false,
+			};
+
+	file = fopen(filePath, "r");
+
+	if (file == NULL)
+	{
+		fprintf(stderr, "Error: Could not open Wasserstein reference file \"%s\".\n", filePath);
+
+		return kCommonConstantReturnTypeError;
+	}
+
+	reference->values = (double *) checkedMalloc(capacity * sizeof(double), __FILE__, __LINE__);
+	reference->cumulativeProbabilities = (double *) checkedMalloc(capacity * sizeof(double), __FILE__, __LINE__);
+
+	while (fgets(line, sizeof(line), file) != NULL)
+	{
+		double	value;
+		double	probability = 0.0;
+		char	trailing;
+		int	numberOfFields;
+
+		lineNumber++;
+
+		if ((line[0] == '#') || (strspn(line, " \t\r\n") == strlen(line)))
+		{
+			continue;
+		}
+
+		numberOfFields = sscanf(line, "%lf ,%lf %c", &value, &probability, &trailing);
+
+		if (reference->numberOfPoints == 0)
+		{
+			reference->isPiecewiseLinear = (numberOfFields == 2);
+		}
+
+		if ((numberOfFields != (reference->isPiecewiseLinear ? 2 : 1)) ||
+			(!reference->isPiecewiseLinear && (sscanf(line, "%lf %c", &value, &trailing) != 1)) ||
+			!isfinite(value))
+		{
+			fprintf(
+				stderr,
+				"Error: Line %zu of \"%s\" is not a valid %s.\n",
+				lineNumber,
+				filePath,
+				reference->isPiecewiseLinear ? "point `value,probability` of a CDF" : "sample");
+			result = kCommonConstantReturnTypeError;
+
+			break;
+		}
+
+		if (reference->isPiecewiseLinear &&
+			(!(probability >= 0.0) || !(probability <= 1.0) ||
+			((reference->numberOfPoints > 0) &&
+				((value < reference->values[reference->numberOfPoints - 1]) ||
+				(probability < reference->cumulativeProbabilities[reference->numberOfPoints - 1])))))
+		{
+			fprintf(stderr, "Error: Line %zu of \"%s\" is not a point of a CDF in [0, 1] after the points before it.\n", lineNumber, filePath);
+			result = kCommonConstantReturnTypeError;
+
+			break;
+		}
+
+		if (reference->numberOfPoints == capacity)
+		{
+			double *	values;
+			double *	cumulativeProbabilities;
+
+			capacity *= 2;
+			values = (double *) realloc(reference->values, capacity * sizeof(double));
+			reference->values = (values != NULL) ? values : reference->values;
+			cumulativeProbabilities = (double *) realloc(reference->cumulativeProbabilities, capacity * sizeof(double));
+			reference->cumulativeProbabilities = (cumulativeProbabilities != NULL) ? cumulativeProbabilities : reference->cumulativeProbabilities;
+
+			if ((values == NULL) || (cumulativeProbabilities == NULL))
+			{
+				fprintf(stderr, "Error: Could not allocate memory for the points of \"%s\".\n", filePath);
+				result = kCommonConstantReturnTypeError;
+
+				break;
+			}
+		}
+
+		reference->values[reference->numberOfPoints] = value;
+		reference->cumulativeProbabilities[reference->numberOfPoints] = probability;
+		reference->numberOfPoints++;
+	}
+
+	fclose(file);
+
+	if ((result == kCommonConstantReturnTypeSuccess) && (reference->numberOfPoints == 0))
+	{
+		fprintf(stderr, "Error: The Wasserstein reference file \"%s\" has no points.\n", filePath);
+		result = kCommonConstantReturnTypeError;
+	}
+
+	if ((result == kCommonConstantReturnTypeSuccess) && reference->isPiecewiseLinear &&
+		(fabs(reference->cumulativeProbabilities[reference->numberOfPoints - 1] - 1.0) > kWassersteinDistanceMaximumProbabilityError))
+	{
+		fprintf(stderr, "Error: The probability of the last point of the CDF in \"%s\" must be 1.\n", filePath);
+		result = kCommonConstantReturnTypeError;
+	}
+
+	if (result != kCommonConstantReturnTypeSuccess)
+	{
+		freeWassersteinReference(reference);
+
+		return result;
+	}
+
+	if (reference->isPiecewiseLinear)
+	{
+		reference->cumulativeProbabilities[reference->numberOfPoints - 1] = 1.0;
+	}
+	else
+	{
+		qsort(reference->values, reference->numberOfPoints, sizeof(double), compareDoubles);
+
+		for (size_t i = 0; i < reference->numberOfPoints; i++)
+		{
+			reference->cumulativeProbabilities[i] = (double)(i + 1) / (double)reference->numberOfPoints;
+		}
+	}
+
+	return kCommonConstantReturnTypeSuccess;
+}
+
+void
+freeWassersteinReference(WassersteinReference *  reference)
+{
+	free(reference->values);
+	free(reference->cumulativeProbabilities);
+	reference->values = NULL;
+	reference->cumulativeProbabilities = NULL;
+	reference->numberOfPoints = 0;
+
+	return;
+}
+
+double
+calculateWassersteinDistance(const WassersteinReference *  reference, double *  samples, size_t numberOfSamples)
+{
+	size_t	sampleIndex = 0;
+	size_t	pointIndex = 0;
+	double	previous;
+	double	distance = 0.0;
+
+	qsort(samples, numberOfSamples, sizeof(double), compareDoubles);
+
+	/*
+	 *	Both CDFs are zero before the smallest sample or point. Between each
+	 *	pair of consecutive samples or points, the CDF of the samples is
+	 *	constant and that of the reference is constant or linear.
+	 */
+	previous = fmin(samples[0], reference->values[0]);
+
+	while ((sampleIndex < numberOfSamples) || (pointIndex < reference->numberOfPoints))
+	{
+		double	next;
+		double	sampleCdf = (double)sampleIndex / (double)numberOfSamples;
+
+		if ((pointIndex == reference->numberOfPoints) ||
+			((sampleIndex < numberOfSamples) && (samples[sampleIndex] <= reference->values[pointIndex])))
+		{
+			next = samples[sampleIndex];
+		}
+		else
+		{
+			next = reference->values[pointIndex];
+		}
+
+		if (next > previous)
+		{
+			distance += getAbsoluteDifferenceIntegral(
+					next - previous,
+					getReferenceCdf(reference, pointIndex, previous) - sampleCdf,
+					getReferenceCdf(reference, pointIndex, next) - sampleCdf);
+		}
+
+		while ((sampleIndex < numberOfSamples) && (samples[sampleIndex] == next))
+		{
+			sampleIndex++;
+		}
+
+		while ((pointIndex < reference->numberOfPoints) && (reference->values[pointIndex] == next))
+		{
+			pointIndex++;
+		}
+
+		previous = next;
+	}
+
+	return distance;
+}
+
+CommonConstantReturnType
+runWassersteinDistanceSelfTest(void)
+{
+	double				samples[kWassersteinDistanceSelfTestNumberOfSamples];
+	double				unused[kWassersteinDistanceSelfTestNumberOfSamples];
+	double				values[kWassersteinDistanceSelfTestNumberOfSamples];
+	double				cumulativeProbabilities[kWassersteinDistanceSelfTestNumberOfSamples];
+	double				uniformValues[2] = { 0.0, 1.0 };
+	double				uniformCumulativeProbabilities[2] = { 0.0, 1.0 };
+	WassersteinReference		reference =
+					{
+						.values				= values,
+						.cumulativeProbabilities	= cumulativeProbabilities,
+						.numberOfPoints			= kWassersteinDistanceSelfTestNumberOfSamples,
+						.isPiecewiseLinear		= false,
+					};
+	double				distance;
+	bool				passed;
+	CommonConstantReturnType	result = kCommonConstantReturnTypeSuccess;
+
+	printf("Wasserstein distance self-test (%d samples):\n", kWassersteinDistanceSelfTestNumberOfSamples);
+
+	/*
+	 *	The distance between samples and the same samples, shifted, is the shift.
+	 */
+	drawUniformDoublePairsPhilox(kDefaultMonteCarloSeed, 0, 0.0, 1.0, 0.0, 1.0, samples, unused, kWassersteinDistanceSelfTestNumberOfSamples);
+	qsort(samples, kWassersteinDistanceSelfTestNumberOfSamples, sizeof(double), compareDoubles);
+
+	for (size_t i = 0; i < kWassersteinDistanceSelfTestNumberOfSamples; i++)
+	{
+		values[i] = samples[i] + kWassersteinDistanceSelfTestShift;
+		cumulativeProbabilities[i] = (double)(i + 1) / (double)kWassersteinDistanceSelfTestNumberOfSamples;
+	}
+
+	distance = calculateWassersteinDistance(&reference, samples, kWassersteinDistanceSelfTestNumberOfSamples);
+	passed = (fabs(distance - kWassersteinDistanceSelfTestShift) <= kWassersteinDistanceSelfTestMaximumError);
+	printf("\tShifted samples: distance %.15lf (exact %.15lf): %s\n", distance, kWassersteinDistanceSelfTestShift, passed ? "PASS" : "FAIL");
+
+	if (!passed)
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	/*
+	 *	The distance between the midpoints of N intervals of equal width and
+	 *	the uniform distribution over them is 1 / (4 N).
+	 */
+	for (size_t i = 0; i < kWassersteinDistanceSelfTestNumberOfSamples; i++)
+	{
+		samples[i] = ((double)i + 0.5) / (double)kWassersteinDistanceSelfTestNumberOfSamples;
+	}
+
+	reference = (WassersteinReference)
+			{
+				.values				= uniformValues,
+				.cumulativeProbabilities	= uniformCumulativeProbabilities,
+				.numberOfPoints			= 2,
+				.isPiecewiseLinear		= true,
+			};
+	distance = calculateWassersteinDistance(&reference, samples, kWassersteinDistanceSelfTestNumberOfSamples);
+	passed = (fabs(distance - 0.25 / kWassersteinDistanceSelfTestNumberOfSamples) <= kWassersteinDistanceSelfTestMaximumError);
+	printf(
+		"\tMidpoints against the uniform CDF: distance %.15lf (exact %.15lf): %s\n",
+		distance,
+		0.25 / kWassersteinDistanceSelfTestNumberOfSamples,
+		passed ? "PASS" : "FAIL");
+
+	if (!passed)
+	{
+		result = kCommonConstantReturnTypeError;
+	}
+
+	return result;
+}
@@ -0,0 +1,81 @@
+/*
+ *	Copyright (c) 2024, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "common.h"
+
+/*
+ *	Reference distribution of the Wasserstein distance, from a file of either
+ *	samples, one per line, or points `value,probability` of a CDF, one per
+ *	line, in increasing order of value. The CDF of the samples is a step
+ *	function, and the CDF of the points is linear between them, zero before the
+ *	first point, and one from the last point, whose probability must be one.
+ *	For the samples, `cumulativeProbabilities[i]` is `(i + 1) / numberOfPoints`.
+ */
+typedef struct
+{
+	double *	values;
+	double *	cumulativeProbabilities;
+	size_t		numberOfPoints;
+	bool		isPiecewiseLinear;
+} WassersteinReference;
+
+/**
+ *	@brief  Loads the reference distribution of the Wasserstein distance from a file of samples or of
+ *		points of a CDF, as decided by its first line that is not empty or a comment (`#`).
+ *
+ *	@param  filePath	: Path to the file.
+ *	@param  reference	: Pointer to where the function writes the reference distribution.
+ *	@return			: `kCommonConstantReturnTypeSuccess` if successful, else `kCommonConstantReturnTypeError`
+ *				  if the file cannot be read, has no points, or has invalid lines or points.
+ */
+CommonConstantReturnType	loadWassersteinReference(const char *  filePath, WassersteinReference *  reference);
+
+/**
+ *	@brief  Frees the points of a reference distribution.
+ *
+ *	@param  reference	: Pointer to the reference distribution.
+ */
+void	freeWassersteinReference(WassersteinReference *  reference);
+
+/**
+ *	@brief  Calculates the 1-Wasserstein distance between the empirical distribution of samples and
+ *		the reference distribution, as the integral of the absolute difference of their CDFs,
+ *		exactly, in one pass over the sorted samples and points.
+ *
+ *	@param  reference		: Pointer to the reference distribution.
+ *	@param  samples			: The samples, which the function sorts in place.
+ *	@param  numberOfSamples		: The number of samples, at least one.
+ *	@return double			: The distance, in the unit of the samples.
+ */
+double	calculateWassersteinDistance(const WassersteinReference *  reference, double *  samples, size_t numberOfSamples);
+
+/**
+ *	@brief  Checks the Wasserstein distance against closed-form distances of shifted samples and of
+ *		samples of a uniform distribution.
+ *
+ *	@return		: `kCommonConstantReturnTypeSuccess` if all checks pass, else `kCommonConstantReturnTypeError`.
+ */
+CommonConstantReturnType	runWassersteinDistanceSelfTest(void);